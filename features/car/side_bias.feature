@@ -76,6 +76,7 @@ Feature: Testbot - side bias
            | a,h       | ab,gh,gh | left,left,left | depart,roundabout turn right exit-3,arrive    |
 
 
+    @location_dependent_data
     Scenario: Left-hand bias via location-dependent tags
         Given the profile "car"
         And the node map
@@ -97,6 +98,7 @@ Feature: Testbot - side bias
             | d    | c  | bd,bc,bc | left,left,left | 27s +-1    |
 
 
+    @location_dependent_data
     Scenario: Left-hand bias via OSM tags
         Given the profile "car"
         And the node map
@@ -117,6 +119,7 @@ Feature: Testbot - side bias
             | d    | a  | bd,ab,ab | right,right,right | 27s +-1    |
             | d    | c  | bd,bc,bc | right,right,right | 24s +-1    |
 
+    @location_dependent_data
     Scenario: changing sides
         Given the profile "car"
 
@@ -0,0 +1,44 @@
+@extract @options @checkpoints
+Feature: osrm-extract command line options: checkpoints
+
+    Background:
+        Given the profile "testbot"
+        And the node map
+            """
+            a b c
+              d
+            """
+        And the ways
+            | nodes |
+            | abc   |
+            | bd    |
+        And the data has been saved to disk
+
+    Scenario: osrm-extract - Resume from the parse checkpoint
+        When I run "osrm-extract --profile {profile_file} {osm_file} --checkpoints"
+        Then it should exit successfully
+        When I run "osrm-extract --profile {profile_file} {osm_file} --start-stage expansion"
+        Then it should exit successfully
+        And stderr should be empty
+        And stdout should contain "Resuming from checkpoint"
+        And stdout should not contain "Parsing in progress"
+
+    Scenario: osrm-extract - Resume from the r-tree checkpoint
+        When I run "osrm-extract --profile {profile_file} {osm_file} --checkpoints"
+        Then it should exit successfully
+        When I run "osrm-extract --profile {profile_file} {osm_file} --start-stage rtree"
+        Then it should exit successfully
+        And stdout should contain "Resuming from checkpoint"
+        And stdout should not contain "Generating edge-expanded graph representation"
+
+    Scenario: osrm-extract - Resuming needs a checkpoint
+        When I run "osrm-extract --profile {profile_file} {osm_file}"
+        Then it should exit successfully
+        When I try to run "osrm-extract --profile {profile_file} {osm_file} --start-stage expansion"
+        Then it should exit with an error
+        And stderr should contain "--checkpoints"
+
+    Scenario: osrm-extract - Unknown stage
+        When I try to run "osrm-extract --profile {profile_file} {osm_file} --start-stage partition"
+        Then it should exit with an error
+        And stderr should contain "start-stage"
@@ -155,6 +155,111 @@ Feature: osrm-extract lua ways:get_nodes()
         And stdout should contain "node 42"
         And stdout should contain "way 42"
 
+    Scenario: osrm-extract batched way processing
+        Given the profile file
+        """
+        functions = require('testbot')
+        api_version = 5
+
+        local setup = functions.setup
+        functions.setup = function()
+          local profile = setup()
+          profile.batch_tags = {'highway', 'name'}
+          return profile
+        end
+
+        functions.process_ways = function(profile, batch, results, relations)
+          print('batch of ' .. batch.count .. ' ways')
+          for i = 1, batch.count do
+            print('way ' .. batch.ways[i]:id() .. ' highway ' .. tostring(batch.tags.highway[i]) .. ' name ' .. tostring(batch.tags.name[i]))
+            results[i].forward_mode = mode.driving
+            results[i].forward_speed = 1
+          end
+        end
+
+        return functions
+        """
+        And the node map
+            """
+            a b c
+            """
+        And the ways
+            | nodes | highway   | name |
+            | ab    | primary   | A    |
+            | bc    | secondary |      |
+        And the data has been saved to disk
+
+        When I run "osrm-extract --profile {profile_file} {osm_file}"
+        Then it should exit successfully
+        And stdout should contain "batch of 2 ways"
+        And stdout should contain "highway primary name A"
+        And stdout should contain "highway secondary name nil"
+
+    Scenario: osrm-extract batched turn processing
+        Given the profile file
+        """
+        functions = require('testbot')
+        api_version = 5
+
+        functions.process_turn = function(profile, turn)
+          print('single turn')
+        end
+
+        functions.process_turns = function(profile, turns)
+          print('batch of ' .. #turns .. ' turns')
+          for i = 1, #turns do
+            if turns[i].is_u_turn then
+              turns[i].duration = 20
+              turns[i].weight = 20
+            end
+          end
+        end
+
+        return functions
+        """
+        And the node map
+            """
+            a b c
+              d
+            """
+        And the ways
+            | nodes |
+            | ab    |
+            | bc    |
+            | bd    |
+        And the data has been saved to disk
+
+        When I run "osrm-extract --profile {profile_file} {osm_file}"
+        Then it should exit successfully
+        And stdout should contain /batch of \d+ turns/
+        And stdout should not contain "single turn"
+
+    Scenario: osrm-extract location-dependent data via file-backed locations cache
+        Given the profile file
+        """
+        functions = require('testbot')
+
+        functions.process_way = function(profile, way, result, relations)
+           print ('way ' .. tostring(way:get_location_tag('answer')))
+           result.forward_mode = mode.driving
+           result.forward_speed = 1
+        end
+
+        return functions
+        """
+        And the node map
+            """
+            a b
+            """
+        And the ways
+            | nodes |
+            | ab    |
+        And the data has been saved to disk
+
+        When I run "osrm-extract --profile {profile_file} {osm_file} --location-dependent-data test/data/regions/null-island.geojson --location-index-file {processed_file}.locations"
+        Then it should exit successfully
+        And stdout should contain "way 42"
+
     Scenario: osrm-extract flags accessible in process_segment function
         Given the profile file
         """
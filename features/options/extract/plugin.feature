@@ -0,0 +1,20 @@
+@extract @options
+Feature: osrm-extract with a compiled profile plugin
+
+    Background:
+        Given the profile "car"
+        And the node map
+            """
+            a b c
+            """
+        And the ways
+            | nodes | highway | oneway |
+            | ab    | primary |        |
+            | bc    | service | yes    |
+        And the data has been saved to disk
+
+    Scenario: osrm-extract - Compiled car profile
+        When I run "osrm-extract --profile {bin_path}/profiles/car.so {osm_file}"
+        Then it should exit successfully
+        And stdout should contain "Using profile plugin"
+        And stdout should contain "2 ways"
@@ -15,6 +15,10 @@ Feature: osrm-partition command line options: files
         When I run "osrm-partition {processed_file}"
         Then it should exit successfully
 
+    Scenario: osrm-partition - Passing base file with multilevel bisections
+        When I run "osrm-partition --bisection multilevel {processed_file}"
+        Then it should exit successfully
+
     Scenario: osrm-partition - Missing input file
         When I try to run "osrm-partition over-the-rainbow.osrm"
         And stderr should contain "over-the-rainbow.osrm"
@@ -129,11 +129,25 @@ module.exports = function () {
       });
     };
 
+    var addPluginFiles = (directory, callback) => {
+      if (!this.OSRM_PROFILE_PLUGINS) return callback();
+
+      fs.readdir(path.normalize(directory), (err, files) => {
+        if (err) return callback(err);
+
+        var pluginFiles = files.filter(f => path.extname(f) === this.PROFILE_PLUGIN).map(f => path.normalize(directory + '/' + f));
+        Array.prototype.push.apply(dependencies, pluginFiles);
+
+        callback();
+      });
+    };
+
     // Note: we need a serialized queue here to ensure that the order of the files
     // passed is stable. Otherwise the hash will not be stable
     d3.queue(1)
       .defer(addLuaFiles, this.PROFILES_PATH)
       .defer(addLuaFiles, this.PROFILES_PATH + '/lib')
+      .defer(addPluginFiles, this.PROFILE_PLUGINS_PATH)
       .awaitAll(hash.hashOfFiles.bind(hash, dependencies, callback));
   };
 
@@ -47,14 +47,19 @@ module.exports = function () {
     this.HOST = `http://${this.OSRM_IP}:${this.OSRM_PORT}`;
 
     this.OSRM_PROFILE = process.env.OSRM_PROFILE;
+    // use the compiled profile plugins of the build directory instead of Lua profiles if they exist
+    this.OSRM_PROFILE_PLUGINS = process.env.OSRM_PROFILE_PLUGINS;
 
     if (this.PLATFORM_WINDOWS) {
       this.TERMSIGNAL = 9;
       this.EXE = '.exe';
+      this.PROFILE_PLUGIN = '.dll';
     } else {
       this.TERMSIGNAL = 'SIGTERM';
       this.EXE = '';
+      this.PROFILE_PLUGIN = '.so';
     }
+    this.PROFILE_PLUGINS_PATH = path.resolve(this.BIN_PATH, 'profiles');
 
     // heuristically detect .so/.a/.dll/.lib suffix
     this.LIB = ['lib%s.a', 'lib%s.so', '%s.dll', '%s.lib'].find((format) => {
@@ -96,6 +101,15 @@ module.exports = function () {
     return path.resolve(this.PROFILES_PATH, profile + '.lua');
   };
 
+  // the compiled plugin of the profile if OSRM_PROFILE_PLUGINS is set and it exists
+  this.getProfileFile = (profile) => {
+    if (this.OSRM_PROFILE_PLUGINS) {
+      const plugin = path.join(this.PROFILE_PLUGINS_PATH, profile + this.PROFILE_PLUGIN);
+      if (fs.existsSync(plugin)) return plugin;
+    }
+    return path.join(this.PROFILES_PATH, profile + '.lua');
+  };
+
   this.verifyOSRMIsNotRunning = (callback) => {
     tryConnect(this.OSRM_IP, this.OSRM_PORT, (err) => {
       if (!err) return callback(new Error('*** osrm-routed is already running.'));
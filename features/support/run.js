@@ -13,6 +13,7 @@ module.exports = function () {
       '{osm_file}': this.inputCacheFile,
       '{processed_file}': this.processedCacheFile,
       '{profile_file}': this.profileFile,
+      '{bin_path}': this.BIN_PATH,
       '{rastersource_file}': this.rasterCacheFile,
       '{speeds_file}': this.speedsCacheFile,
       '{penalties_file}': this.penaltiesCacheFile,
@@ -39,8 +39,9 @@ namespace osrm::contractor
 struct ContractorConfig final : storage::IOConfig
 {
     ContractorConfig()
-        : IOConfig(
-              {".osrm.ebg", ".osrm.ebg_nodes", ".osrm.properties"}, {}, {".osrm.hsgr", ".osrm.enw"})
+        : IOConfig({".osrm.ebg", ".osrm.ebg_nodes", ".osrm.properties"},
+                   {".osrm.partition"},
+                   {".osrm.hsgr", ".osrm.enw", ".osrm.cch"})
     {
     }
 
@@ -56,6 +57,9 @@ struct ContractorConfig final : storage::IOConfig
     updater::UpdaterConfig updater_config;
 
     unsigned requested_num_threads = 0;
+
+    // Use the contraction order of the partition and only compute the shortcut weights
+    bool customizable = false;
 };
 } // namespace osrm::contractor
 
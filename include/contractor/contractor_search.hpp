@@ -16,6 +16,7 @@ void search(ContractorHeap &heap,
             const std::vector<bool> &contractable,
             const unsigned number_of_targets,
             const int node_limit,
+            const short hop_limit,
             const EdgeWeight weight_limit,
             const NodeID forbidden_node);
 
@@ -0,0 +1,38 @@
+#ifndef OSRM_CONTRACTOR_CUSTOMIZABLE_CONTRACTION_HPP
+#define OSRM_CONTRACTOR_CUSTOMIZABLE_CONTRACTION_HPP
+
+#include "contractor/contract_excludable_graph.hpp"
+#include "contractor/customizable_graph.hpp"
+#include "contractor/query_edge.hpp"
+
+#include "extractor/edge_based_edge.hpp"
+
+#include "partitioner/multi_level_partition.hpp"
+
+#include <vector>
+
+namespace osrm::contractor
+{
+
+// Computes the contraction order and the shortcut topology of a customizable contraction
+// hierarchy. The order is derived from the recursive bisection of the partition: nodes on the cut
+// between cells of a higher level are contracted later, nodes on the same level are ordered by
+// their degree in the graph with the shortcuts added so far.
+CustomizableGraph makeCustomizableGraph(const partitioner::MultiLevelPartition &partition,
+                                        const NodeID number_of_nodes,
+                                        const std::vector<extractor::EdgeBasedEdge> &edges);
+
+// Computes the weights of all arcs for the given edges, ignoring the nodes that are not allowed by
+// the filter. The result uses node ids and can be used like the edges of a contracted graph.
+std::vector<QueryEdge> customizeGraph(const CustomizableGraph &graph,
+                                      const std::vector<extractor::EdgeBasedEdge> &edges,
+                                      const std::vector<bool> &node_filter);
+
+// Customizes the graph for every exclude filter, see contractExcludableGraph
+GraphAndFilter customizeExcludableGraph(const CustomizableGraph &graph,
+                                        const std::vector<extractor::EdgeBasedEdge> &edges,
+                                        const std::vector<std::vector<bool>> &filters);
+
+} // namespace osrm::contractor
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef OSRM_CONTRACTOR_CUSTOMIZABLE_GRAPH_HPP
+#define OSRM_CONTRACTOR_CUSTOMIZABLE_GRAPH_HPP
+
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace osrm::contractor
+{
+
+// Metric independent shortcut topology of a customizable contraction hierarchy.
+//
+// The nodes are numbered by their rank in the contraction order. A node has an arc to every
+// neighbour of higher rank in the graph that remains after contracting all nodes of lower rank.
+// This contains every shortcut any metric could need, so new weights only require to recompute
+// the weights of the arcs, see customizeGraph.
+struct CustomizableGraph
+{
+    NodeID GetNumberOfNodes() const { return static_cast<NodeID>(order.size()); }
+    EdgeID GetNumberOfArcs() const { return static_cast<EdgeID>(heads.size()); }
+
+    // Returns the arc between two ranks, the first one has to be the lower one
+    EdgeID FindArc(const NodeID lower_rank, const NodeID upper_rank) const
+    {
+        BOOST_ASSERT(lower_rank < upper_rank);
+        const auto begin = heads.begin() + first_arc[lower_rank];
+        const auto end = heads.begin() + first_arc[lower_rank + 1];
+        const auto iter = std::lower_bound(begin, end, upper_rank);
+        if (iter == end || *iter != upper_rank)
+        {
+            return SPECIAL_EDGEID;
+        }
+        return static_cast<EdgeID>(iter - heads.begin());
+    }
+
+    // node id of each rank
+    std::vector<NodeID> order;
+    // rank of each node id
+    std::vector<NodeID> ranks;
+    // the arcs of rank r are [first_arc[r], first_arc[r + 1])
+    std::vector<EdgeID> first_arc;
+    // rank of the upper node of each arc, sorted ascending for each lower node
+    std::vector<NodeID> heads;
+};
+} // namespace osrm::contractor
+
+#endif
@@ -2,6 +2,7 @@
 #define OSRM_CONTRACTOR_SERIALIZATION_HPP
 
 #include "contractor/contracted_metric.hpp"
+#include "contractor/customizable_graph.hpp"
 
 #include "util/serialization.hpp"
 
@@ -42,6 +43,24 @@ void read(storage::tar::FileReader &reader,
                                      metric.edge_filter[index]);
     }
 }
+
+inline void
+write(storage::tar::FileWriter &writer, const std::string &name, const CustomizableGraph &graph)
+{
+    storage::serialization::write(writer, name + "/order", graph.order);
+    storage::serialization::write(writer, name + "/ranks", graph.ranks);
+    storage::serialization::write(writer, name + "/first_arc", graph.first_arc);
+    storage::serialization::write(writer, name + "/heads", graph.heads);
+}
+
+inline void
+read(storage::tar::FileReader &reader, const std::string &name, CustomizableGraph &graph)
+{
+    storage::serialization::read(reader, name + "/order", graph.order);
+    storage::serialization::read(reader, name + "/ranks", graph.ranks);
+    storage::serialization::read(reader, name + "/first_arc", graph.first_arc);
+    storage::serialization::read(reader, name + "/heads", graph.heads);
+}
 } // namespace osrm::contractor::serialization
 
 #endif
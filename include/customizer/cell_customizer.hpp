@@ -8,7 +8,15 @@
 #include <tbb/enumerable_thread_specific.h>
 #include <tbb/parallel_for.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <tuple>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace osrm::customizer
 {
@@ -23,12 +31,51 @@ class CellCustomizer
         EdgeDistance distance;
     };
 
+    struct MatrixArc
+    {
+        std::uint32_t target;
+        EdgeWeight::value_type weight;
+        EdgeDuration::value_type duration;
+        EdgeDistance::value_type distance;
+    };
+
   public:
     using Heap =
         util::QueryHeap<NodeID, NodeID, EdgeWeight, HeapData, util::ArrayStorage<NodeID, int>>;
     using HeapPtr = tbb::enumerable_thread_specific<Heap>;
 
-    CellCustomizer(const partitioner::MultiLevelPartition &partition) : partition(partition) {}
+    // Buffers of the search from all sources of a cell at once, see CustomizeMatrix.
+    // Each row of the label matrices holds the values from all sources to one node of the cell.
+    class MatrixData
+    {
+        friend class CellCustomizer;
+
+        std::unordered_map<NodeID, std::uint32_t> local_ids;
+        std::vector<NodeID> nodes;
+        std::vector<std::uint32_t> arc_offsets;
+        std::vector<std::uint32_t> clique_offsets;
+        std::vector<MatrixArc> arcs;
+        std::vector<EdgeWeight::value_type> weights;
+        std::vector<EdgeDuration::value_type> durations;
+        std::vector<EdgeDistance::value_type> distances;
+        std::vector<std::pair<EdgeWeight::value_type, std::uint32_t>> queue;
+        std::vector<EdgeWeight::value_type> queued_weights;
+    };
+    using MatrixDataPtr = tbb::enumerable_thread_specific<MatrixData>;
+
+    // Cells above level 1 with at least this many sources are customized with CustomizeMatrix.
+    // It is disabled by default: it breaks ties between paths of equal weight differently than
+    // Dijkstra, so durations and distances of the cells may differ.
+    static constexpr std::size_t DEFAULT_MATRIX_MIN_SOURCES =
+        std::numeric_limits<std::size_t>::max();
+    // Number of sources searched at once by CustomizeMatrix
+    static constexpr std::size_t MATRIX_BLOCK_SIZE = 32;
+
+    CellCustomizer(const partitioner::MultiLevelPartition &partition,
+                   const std::size_t matrix_min_sources = DEFAULT_MATRIX_MIN_SOURCES)
+        : partition(partition), matrix_min_sources(matrix_min_sources)
+    {
+    }
 
     template <typename GraphT>
     void Customize(const GraphT &graph,
@@ -110,6 +157,109 @@ class CellCustomizer
         }
     }
 
+    // Customizes a cell above level 1 with one search from all sources at once.
+    // The search runs on the overlay of the sub-cell cliques and the edges between the sub-cells.
+    // Every node has a row of labels with one entry per source, relaxing an arc updates the
+    // whole row in a loop over contiguous int32 and float values that the compiler vectorizes.
+    // Like the from_clique flag of the Dijkstra search, every node has two rows: one for the
+    // paths that enter the node from another sub-cell and one for the paths that use a clique
+    // arc to reach it. Only the first one relaxes clique arcs.
+    template <typename GraphT>
+    void CustomizeMatrix(const GraphT &graph,
+                         MatrixData &data,
+                         const partitioner::CellStorage &cells,
+                         const std::vector<bool> &allowed_nodes,
+                         CellMetric &metric,
+                         LevelID level,
+                         CellID id) const
+    {
+        BOOST_ASSERT(level > 1);
+
+        auto cell = cells.GetCell(metric, level, id);
+        const auto sources = cell.GetSourceNodes();
+        const auto num_sources = static_cast<std::size_t>(sources.size());
+
+        data.local_ids.clear();
+        data.nodes.clear();
+        data.arc_offsets.clear();
+        data.clique_offsets.clear();
+        data.arcs.clear();
+
+        const auto add_node = [&data](const NodeID node)
+        {
+            const auto [iter, inserted] =
+                data.local_ids.emplace(node, static_cast<std::uint32_t>(data.nodes.size()));
+            if (inserted)
+            {
+                data.nodes.push_back(node);
+            }
+            return iter->second;
+        };
+
+        for (const auto source : sources)
+        {
+            if (allowed_nodes[source])
+            {
+                add_node(source);
+            }
+        }
+
+        // Collect all nodes reachable from the sources and their arcs. The i-th node has the
+        // edges to other sub-cells in [arc_offsets[i], clique_offsets[i]) followed by the clique
+        // arcs in [clique_offsets[i], arc_offsets[i + 1]).
+        for (std::size_t index = 0; index < data.nodes.size(); ++index)
+        {
+            const auto node = data.nodes[index];
+            const auto subcell_id = partition.GetCell(level - 1, node);
+            data.arc_offsets.push_back(data.arcs.size());
+
+            for (auto edge : graph.GetInternalEdgeRange(level, node))
+            {
+                const NodeID to = graph.GetTarget(edge);
+                const auto &edge_data = graph.GetEdgeData(edge);
+                if (allowed_nodes[to] && edge_data.forward &&
+                    subcell_id != partition.GetCell(level - 1, to))
+                {
+                    data.arcs.push_back(
+                        {EntryRow(add_node(to)),
+                         from_alias<EdgeWeight::value_type>(edge_data.weight),
+                         static_cast<EdgeDuration::value_type>(edge_data.duration),
+                         from_alias<EdgeDistance::value_type>(edge_data.distance)});
+                }
+            }
+            data.clique_offsets.push_back(data.arcs.size());
+
+            auto subcell = cells.GetCell(metric, level - 1, subcell_id);
+            auto subcell_destination = subcell.GetDestinationNodes().begin();
+            auto subcell_duration = subcell.GetOutDuration(node).begin();
+            auto subcell_distance = subcell.GetOutDistance(node).begin();
+            for (auto subcell_weight : subcell.GetOutWeight(node))
+            {
+                const NodeID to = *subcell_destination;
+                if (subcell_weight != INVALID_EDGE_WEIGHT && allowed_nodes[to] && to != node)
+                {
+                    data.arcs.push_back({CliqueRow(add_node(to)),
+                                         from_alias<EdgeWeight::value_type>(subcell_weight),
+                                         from_alias<EdgeDuration::value_type>(*subcell_duration),
+                                         from_alias<EdgeDistance::value_type>(*subcell_distance)});
+                }
+
+                ++subcell_destination;
+                ++subcell_duration;
+                ++subcell_distance;
+            }
+        }
+        data.arc_offsets.push_back(data.arcs.size());
+
+        // The sources are searched in blocks of columns, so the rows of a block stay in the cache
+        for (std::size_t first_column = 0; first_column < num_sources;
+             first_column += MATRIX_BLOCK_SIZE)
+        {
+            const auto num_columns = std::min(MATRIX_BLOCK_SIZE, num_sources - first_column);
+            CustomizeMatrixBlock(data, cell, allowed_nodes, first_column, num_columns);
+        }
+    }
+
     template <typename GraphT>
     void Customize(const GraphT &graph,
                    const partitioner::CellStorage &cells,
@@ -118,23 +268,324 @@ class CellCustomizer
     {
         Heap heap_exemplar(graph.GetNumberOfNodes());
         HeapPtr heaps(heap_exemplar);
+        MatrixDataPtr matrices;
 
         for (std::size_t level = 1; level < partition.GetNumberOfLevels(); ++level)
         {
             tbb::parallel_for(tbb::blocked_range<std::size_t>(0, partition.GetNumberOfCells(level)),
                               [&](const tbb::blocked_range<std::size_t> &range)
                               {
-                                  auto &heap = heaps.local();
                                   for (auto id = range.begin(), end = range.end(); id != end; ++id)
                                   {
-                                      Customize(
-                                          graph, heap, cells, allowed_nodes, metric, level, id);
+                                      CustomizeCell(graph,
+                                                    heaps,
+                                                    matrices,
+                                                    cells,
+                                                    allowed_nodes,
+                                                    metric,
+                                                    level,
+                                                    id);
                                   }
                               });
         }
     }
 
+    // Recomputes only the cells marked in `dirty_cells`, indexed by level and cell id.
+    // All other cells keep the values they already have in `metric`.
+    template <typename GraphT>
+    void Customize(const GraphT &graph,
+                   const partitioner::CellStorage &cells,
+                   const std::vector<bool> &allowed_nodes,
+                   CellMetric &metric,
+                   const std::vector<std::vector<bool>> &dirty_cells) const
+    {
+        BOOST_ASSERT(dirty_cells.size() == partition.GetNumberOfLevels());
+
+        Heap heap_exemplar(graph.GetNumberOfNodes());
+        HeapPtr heaps(heap_exemplar);
+        MatrixDataPtr matrices;
+
+        for (std::size_t level = 1; level < partition.GetNumberOfLevels(); ++level)
+        {
+            std::vector<CellID> level_cells;
+            for (CellID id = 0; id < partition.GetNumberOfCells(level); ++id)
+            {
+                if (dirty_cells[level][id])
+                {
+                    level_cells.push_back(id);
+                }
+            }
+
+            tbb::parallel_for(tbb::blocked_range<std::size_t>(0, level_cells.size()),
+                              [&](const tbb::blocked_range<std::size_t> &range)
+                              {
+                                  for (auto index = range.begin(), end = range.end(); index != end;
+                                       ++index)
+                                  {
+                                      CustomizeCell(graph,
+                                                    heaps,
+                                                    matrices,
+                                                    cells,
+                                                    allowed_nodes,
+                                                    metric,
+                                                    level,
+                                                    level_cells[index]);
+                                  }
+                              });
+        }
+    }
+
+    // Returns the cells that have to be customized again if the outgoing edges of
+    // `updated_nodes` changed. An edge is only used by the cells that contain both of its nodes,
+    // so these cells and all their parents are marked.
+    template <typename GraphT>
+    std::vector<std::vector<bool>> GetDirtyCells(const GraphT &graph,
+                                                 const std::vector<NodeID> &updated_nodes) const
+    {
+        std::vector<std::vector<bool>> dirty_cells(partition.GetNumberOfLevels());
+        for (std::size_t level = 1; level < partition.GetNumberOfLevels(); ++level)
+        {
+            dirty_cells[level].resize(partition.GetNumberOfCells(level), false);
+        }
+
+        for (const auto node : updated_nodes)
+        {
+            BOOST_ASSERT(node < graph.GetNumberOfNodes());
+            for (const auto edge : graph.GetAdjacentEdgeRange(node))
+            {
+                if (!graph.GetEdgeData(edge).forward)
+                {
+                    continue;
+                }
+
+                const auto first_common_level =
+                    partition.GetHighestDifferentLevel(node, graph.GetTarget(edge)) + 1;
+                for (auto level = std::max<std::size_t>(first_common_level, 1);
+                     level < partition.GetNumberOfLevels();
+                     ++level)
+                {
+                    dirty_cells[level][partition.GetCell(level, node)] = true;
+                }
+            }
+        }
+
+        return dirty_cells;
+    }
+
   private:
+    // Cells on higher levels with many sources are dense, so one search from all sources is
+    // faster than a Dijkstra search per source
+    template <typename GraphT>
+    void CustomizeCell(const GraphT &graph,
+                       HeapPtr &heaps,
+                       MatrixDataPtr &matrices,
+                       const partitioner::CellStorage &cells,
+                       const std::vector<bool> &allowed_nodes,
+                       CellMetric &metric,
+                       LevelID level,
+                       CellID id) const
+    {
+        const auto num_sources = cells.GetCell(metric, level, id).GetSourceNodes().size();
+        if (level > 1 && static_cast<std::size_t>(num_sources) >= matrix_min_sources)
+        {
+            CustomizeMatrix(graph, matrices.local(), cells, allowed_nodes, metric, level, id);
+        }
+        else
+        {
+            Customize(graph, heaps.local(), cells, allowed_nodes, metric, level, id);
+        }
+    }
+
+    // Searches from the sources [first_column, first_column + num_columns) of the cell
+    template <typename CellT>
+    static void CustomizeMatrixBlock(MatrixData &data,
+                                     CellT &cell,
+                                     const std::vector<bool> &allowed_nodes,
+                                     const std::size_t first_column,
+                                     const std::size_t num_columns)
+    {
+        const auto sources = cell.GetSourceNodes();
+        const auto num_rows = 2 * data.nodes.size();
+        const auto INF_WEIGHT = from_alias<EdgeWeight::value_type>(INVALID_EDGE_WEIGHT);
+        data.weights.assign(num_rows * num_columns, INF_WEIGHT);
+        data.durations.assign(num_rows * num_columns,
+                              from_alias<EdgeDuration::value_type>(MAXIMAL_EDGE_DURATION));
+        data.distances.assign(num_rows * num_columns,
+                              from_alias<EdgeDistance::value_type>(INVALID_EDGE_DISTANCE));
+        data.queued_weights.assign(num_rows, INF_WEIGHT);
+        data.queue.clear();
+
+        // Rows are processed by the smallest weight that changed since they were queued, so
+        // most labels are final when a row is processed like in Dijkstra's algorithm. A row is
+        // queued again when one of its labels changes later.
+        const auto push = [&data](const std::uint32_t row, const EdgeWeight::value_type weight)
+        {
+            if (weight < data.queued_weights[row])
+            {
+                data.queued_weights[row] = weight;
+                data.queue.emplace_back(weight, row);
+                std::push_heap(data.queue.begin(), data.queue.end(), std::greater<>());
+            }
+        };
+
+        for (std::size_t column = 0; column < num_columns; ++column)
+        {
+            const auto source = sources[first_column + column];
+            if (allowed_nodes[source])
+            {
+                const auto row = EntryRow(data.local_ids.at(source));
+                data.weights[row * num_columns + column] = 0;
+                data.durations[row * num_columns + column] = 0;
+                data.distances[row * num_columns + column] = 0;
+                push(row, 0);
+            }
+        }
+
+        while (!data.queue.empty())
+        {
+            std::pop_heap(data.queue.begin(), data.queue.end(), std::greater<>());
+            const auto [weight, row] = data.queue.back();
+            data.queue.pop_back();
+            if (weight != data.queued_weights[row])
+            {
+                continue;
+            }
+            data.queued_weights[row] = INF_WEIGHT;
+
+            const auto local_id = row / 2;
+            const auto arcs_end = row == EntryRow(local_id) ? data.arc_offsets[local_id + 1]
+                                                            : data.clique_offsets[local_id];
+            for (auto arc_index = data.arc_offsets[local_id]; arc_index < arcs_end; ++arc_index)
+            {
+                const auto &arc = data.arcs[arc_index];
+                push(arc.target, RelaxRow(data, num_columns, row, arc));
+            }
+        }
+
+        // The label of a destination is the better one of its two rows
+        const auto label = [&](const std::uint32_t row, const std::size_t column)
+        {
+            const auto index = row * num_columns + column;
+            return std::make_tuple(
+                data.weights[index], data.durations[index], data.distances[index]);
+        };
+        for (std::size_t column = 0; column < num_columns; ++column)
+        {
+            const auto source = sources[first_column + column];
+            if (!allowed_nodes[source])
+            {
+                continue;
+            }
+
+            auto weights = cell.GetOutWeight(source);
+            auto durations = cell.GetOutDuration(source);
+            auto distances = cell.GetOutDistance(source);
+            for (const auto destination : cell.GetDestinationNodes())
+            {
+                BOOST_ASSERT(!weights.empty());
+                BOOST_ASSERT(!durations.empty());
+                BOOST_ASSERT(!distances.empty());
+
+                const auto iter = data.local_ids.find(destination);
+                if (iter == data.local_ids.end())
+                {
+                    weights.front() = INVALID_EDGE_WEIGHT;
+                    durations.front() = MAXIMAL_EDGE_DURATION;
+                    distances.front() = INVALID_EDGE_DISTANCE;
+                }
+                else
+                {
+                    const auto [weight, duration, distance] =
+                        std::min(label(EntryRow(iter->second), column),
+                                 label(CliqueRow(iter->second), column));
+                    const bool reached = weight != INF_WEIGHT;
+                    weights.front() = reached ? EdgeWeight{weight} : INVALID_EDGE_WEIGHT;
+                    durations.front() = reached ? EdgeDuration{duration} : MAXIMAL_EDGE_DURATION;
+                    distances.front() = reached ? EdgeDistance{distance} : INVALID_EDGE_DISTANCE;
+                }
+
+                weights.advance(1);
+                durations.advance(1);
+                distances.advance(1);
+            }
+            BOOST_ASSERT(weights.empty());
+            BOOST_ASSERT(durations.empty());
+            BOOST_ASSERT(distances.empty());
+        }
+    }
+
+    static std::uint32_t EntryRow(const std::uint32_t local_id) { return 2 * local_id; }
+    static std::uint32_t CliqueRow(const std::uint32_t local_id) { return 2 * local_id + 1; }
+
+    // Relaxes the arc for all sources, returns the smallest changed weight of the target or
+    // INVALID_EDGE_WEIGHT if no label changed
+    static EdgeWeight::value_type RelaxRow(MatrixData &data,
+                                           const std::size_t num_sources,
+                                           const std::uint32_t row,
+                                           const MatrixArc &arc)
+    {
+        // Arcs never lead back to their own row, so the rows do not overlap
+        BOOST_ASSERT(arc.target != row);
+        return RelaxColumns(data.weights.data() + row * num_sources,
+                            data.durations.data() + row * num_sources,
+                            data.distances.data() + row * num_sources,
+                            data.weights.data() + arc.target * num_sources,
+                            data.durations.data() + arc.target * num_sources,
+                            data.distances.data() + arc.target * num_sources,
+                            num_sources,
+                            arc);
+    }
+
+    // The rows are passed as __restrict parameters, otherwise GCC only vectorizes the loop with
+    // AVX2 and falls back to a branchy scalar loop on SSE2.
+    static EdgeWeight::value_type
+    RelaxColumns(const EdgeWeight::value_type *__restrict from_weights,
+                 const EdgeDuration::value_type *__restrict from_durations,
+                 const EdgeDistance::value_type *__restrict from_distances,
+                 EdgeWeight::value_type *__restrict to_weights,
+                 EdgeDuration::value_type *__restrict to_durations,
+                 EdgeDistance::value_type *__restrict to_distances,
+                 const std::size_t num_sources,
+                 const MatrixArc &arc)
+    {
+        const auto INF_WEIGHT = from_alias<EdgeWeight::value_type>(INVALID_EDGE_WEIGHT);
+
+        const auto arc_weight = static_cast<std::uint32_t>(arc.weight);
+        const auto arc_duration = static_cast<std::uint32_t>(arc.duration);
+        const auto arc_distance = arc.distance;
+
+        // Branch free, so the loop can be vectorized. The sums are computed on unsigned values
+        // because the labels of unreached nodes would overflow.
+        auto min_changed_weight = INF_WEIGHT;
+        for (std::size_t column = 0; column < num_sources; ++column)
+        {
+            const auto weight = static_cast<EdgeWeight::value_type>(
+                static_cast<std::uint32_t>(from_weights[column]) + arc_weight);
+            const auto duration = static_cast<EdgeDuration::value_type>(
+                static_cast<std::uint32_t>(from_durations[column]) + arc_duration);
+            const auto distance = from_distances[column] + arc_distance;
+
+            const auto old_weight = to_weights[column];
+            const auto old_duration = to_durations[column];
+            const auto old_distance = to_distances[column];
+            const bool better =
+                (from_weights[column] != INF_WEIGHT) &
+                ((weight < old_weight) |
+                 ((weight == old_weight) &
+                  ((duration < old_duration) |
+                   ((duration == old_duration) & (distance < old_distance)))));
+
+            to_weights[column] = better ? weight : old_weight;
+            to_durations[column] = better ? duration : old_duration;
+            to_distances[column] = better ? distance : old_distance;
+            // a select would not be vectorized as part of the reduction
+            const auto mask = -static_cast<EdgeWeight::value_type>(better);
+            min_changed_weight =
+                std::min(min_changed_weight, (weight & mask) | (INF_WEIGHT & ~mask));
+        }
+        return min_changed_weight;
+    }
+
     template <typename GraphT>
     void RelaxNode(const GraphT &graph,
                    const partitioner::CellStorage &cells,
@@ -233,6 +684,7 @@ class CellCustomizer
     }
 
     const partitioner::MultiLevelPartition &partition;
+    const std::size_t matrix_min_sources;
 };
 } // namespace osrm::customizer
 
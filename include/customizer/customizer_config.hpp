@@ -1,7 +1,9 @@
 #ifndef OSRM_CUSTOMIZE_CUSTOMIZER_CONFIG_HPP
 #define OSRM_CUSTOMIZE_CUSTOMIZER_CONFIG_HPP
 
+#include <cstddef>
 #include <filesystem>
+#include <limits>
 
 #include "storage/io_config.hpp"
 #include "updater/updater_config.hpp"
@@ -19,8 +21,9 @@ struct CustomizationConfig final : storage::IOConfig
                     ".osrm.properties",
                     ".osrm.enw"},
                    {},
-                   {".osrm.cell_metrics", ".osrm.mldgr"}),
-          requested_num_threads(0)
+                   {".osrm.cell_metrics", ".osrm.mldgr", ".osrm.updated_nodes"}),
+          requested_num_threads(0), incremental(false),
+          matrix_min_sources(std::numeric_limits<std::size_t>::max())
     {
     }
 
@@ -31,6 +34,11 @@ struct CustomizationConfig final : storage::IOConfig
     }
 
     unsigned requested_num_threads;
+    // Only recompute the cells that changed since the last customization
+    bool incremental;
+    // Customize cells above level 1 with at least this many sources with one search from all
+    // sources at once, disabled by default
+    std::size_t matrix_min_sources;
 
     updater::UpdaterConfig updater_config;
 };
@@ -102,6 +102,29 @@ inline void writeGraph(const std::filesystem::path &path,
     writer.WriteFrom("/mld/connectivity_checksum", connectivity_checksum);
     serialization::write(writer, "/mld/multilevelgraph", graph);
 }
+
+// reads .osrm.updated_nodes file
+inline void readUpdatedNodes(const std::filesystem::path &path,
+                             std::vector<NodeID> &updated_nodes,
+                             std::uint32_t &connectivity_checksum)
+{
+    storage::tar::FileReader reader{path, storage::tar::FileReader::VerifyFingerprint};
+
+    reader.ReadInto("/mld/connectivity_checksum", connectivity_checksum);
+    storage::serialization::read(reader, "/mld/updated_nodes", updated_nodes);
+}
+
+// writes .osrm.updated_nodes file
+inline void writeUpdatedNodes(const std::filesystem::path &path,
+                              const std::vector<NodeID> &updated_nodes,
+                              const std::uint32_t connectivity_checksum)
+{
+    storage::tar::FileWriter writer{path, storage::tar::FileWriter::GenerateFingerprint};
+
+    writer.WriteElementCount64("/mld/connectivity_checksum", 1);
+    writer.WriteFrom("/mld/connectivity_checksum", connectivity_checksum);
+    storage::serialization::write(writer, "/mld/updated_nodes", updated_nodes);
+}
 } // namespace osrm::customizer::files
 
 #endif
@@ -4,6 +4,7 @@
 #include "engine/datafacade/contiguous_internalmem_datafacade.hpp"
 #include "engine/datafacade/shared_memory_allocator.hpp"
 #include "engine/datafacade_factory.hpp"
+#include "engine/traffic_update_watcher.hpp"
 
 #include "storage/shared_datatype.hpp"
 #include "storage/shared_memory.hpp"
@@ -14,6 +15,7 @@
 #include <boost/thread/locks.hpp>
 #include <boost/thread/shared_mutex.hpp>
 
+#include <filesystem>
 #include <memory>
 #include <thread>
 
@@ -34,7 +36,9 @@ class DataWatchdogImpl<AlgorithmT, datafacade::ContiguousInternalMemoryDataFacad
     using Facade = datafacade::ContiguousInternalMemoryDataFacade<AlgorithmT>;
 
   public:
-    DataWatchdogImpl(const std::string &dataset_name) : dataset_name(dataset_name), active(true)
+    DataWatchdogImpl(const std::string &dataset_name,
+                     const std::filesystem::path &traffic_update_directory = {})
+        : dataset_name(dataset_name), active(true)
     {
         // create the initial facade before launching the watchdog thread
         {
@@ -54,14 +58,16 @@ class DataWatchdogImpl<AlgorithmT, datafacade::ContiguousInternalMemoryDataFacad
             static_region = *static_shared_region;
             updatable_region = *updatable_shared_region;
 
-            {
-                boost::unique_lock<boost::shared_mutex> swap_lock(factory_mutex);
-                facade_factory =
-                    DataFacadeFactory<datafacade::ContiguousInternalMemoryDataFacade, AlgorithmT>(
-                        std::make_shared<datafacade::SharedMemoryAllocator>(
-                            std::vector<storage::SharedRegionRegister::ShmKey>{
-                                static_region.shm_key, updatable_region.shm_key}));
-            }
+            SwapRegions();
+        }
+
+        if (!traffic_update_directory.empty())
+        {
+            traffic_updates = std::make_unique<TrafficUpdateWatcher>(
+                traffic_update_directory,
+                [this](const auto &base, auto generation)
+                { return PublishGeneration(base, std::move(generation)); });
+            traffic_updates->Reset(allocator);
         }
 
         watcher = std::thread(&DataWatchdogImpl::Run, this);
@@ -72,6 +78,8 @@ class DataWatchdogImpl<AlgorithmT, datafacade::ContiguousInternalMemoryDataFacad
         active = false;
         barrier.notify_all();
         watcher.join();
+        // can still publish a generation
+        traffic_updates.reset();
     }
 
     std::shared_ptr<const Facade> Get(const api::BaseParameters &params) const
@@ -116,19 +124,46 @@ class DataWatchdogImpl<AlgorithmT, datafacade::ContiguousInternalMemoryDataFacad
                         << (int)updatable_region.shm_key << " with timestamps "
                         << static_region.timestamp << " and " << updatable_region.timestamp;
 
-            {
-                boost::unique_lock<boost::shared_mutex> swap_lock(factory_mutex);
-                facade_factory =
-                    DataFacadeFactory<datafacade::ContiguousInternalMemoryDataFacade, AlgorithmT>(
-                        std::make_shared<datafacade::SharedMemoryAllocator>(
-                            std::vector<storage::SharedRegionRegister::ShmKey>{
-                                static_region.shm_key, updatable_region.shm_key}));
-            }
+            SwapRegions();
         }
 
         util::Log() << "DataWatchdog thread stopped";
     }
 
+    void SwapRegions()
+    {
+        auto new_allocator = std::make_shared<datafacade::SharedMemoryAllocator>(
+            std::vector<storage::SharedRegionRegister::ShmKey>{static_region.shm_key,
+                                                               updatable_region.shm_key});
+
+        boost::unique_lock<boost::shared_mutex> swap_lock(factory_mutex);
+        facade_factory =
+            DataFacadeFactory<datafacade::ContiguousInternalMemoryDataFacade, AlgorithmT>(
+                new_allocator);
+        allocator = new_allocator;
+
+        // Updates of the previous regions are superseded by the new ones
+        if (traffic_updates)
+        {
+            traffic_updates->Reset(std::move(new_allocator));
+        }
+    }
+
+    // Swaps in a generation of the current regions with applied traffic updates
+    bool PublishGeneration(const TrafficUpdateWatcher::Allocator &base,
+                           TrafficUpdateWatcher::Allocator generation)
+    {
+        boost::unique_lock<boost::shared_mutex> swap_lock(factory_mutex);
+        if (base != allocator)
+        {
+            return false;
+        }
+        facade_factory =
+            DataFacadeFactory<datafacade::ContiguousInternalMemoryDataFacade, AlgorithmT>(
+                std::move(generation));
+        return true;
+    }
+
     mutable boost::shared_mutex factory_mutex;
     const std::string dataset_name;
     storage::SharedMonitor<storage::SharedRegionRegister> barrier;
@@ -139,6 +174,9 @@ class DataWatchdogImpl<AlgorithmT, datafacade::ContiguousInternalMemoryDataFacad
     storage::SharedRegion *static_shared_region;
     storage::SharedRegion *updatable_shared_region;
     DataFacadeFactory<datafacade::ContiguousInternalMemoryDataFacade, AlgorithmT> facade_factory;
+    // allocator of the current regions without traffic updates
+    TrafficUpdateWatcher::Allocator allocator;
+    std::unique_ptr<TrafficUpdateWatcher> traffic_updates;
 };
 } // namespace detail
 
@@ -404,6 +404,34 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
             input_coordinate, approach, max_distance, bearing, use_all_edges);
     }
 
+    std::vector<std::vector<PhantomNodeWithDistance>>
+    NearestPhantomNodesInRange(const std::vector<SnappingQuery> &queries,
+                               const bool use_all_edges) const override final
+    {
+        BOOST_ASSERT(m_geospatial_query.get());
+
+        return m_geospatial_query->NearestPhantomNodesInRange(queries, use_all_edges);
+    }
+
+    std::vector<std::vector<PhantomNodeWithDistance>>
+    NearestPhantomNodes(const std::vector<SnappingQuery> &queries,
+                        const size_t max_results) const override final
+    {
+        BOOST_ASSERT(m_geospatial_query.get());
+
+        return m_geospatial_query->NearestPhantomNodes(queries, max_results);
+    }
+
+    std::vector<PhantomCandidateAlternatives>
+    NearestCandidatesWithAlternativeFromBigComponent(const std::vector<SnappingQuery> &queries,
+                                                     const bool use_all_edges) const override final
+    {
+        BOOST_ASSERT(m_geospatial_query.get());
+
+        return m_geospatial_query->NearestCandidatesWithAlternativeFromBigComponent(queries,
+                                                                                    use_all_edges);
+    }
+
     std::uint32_t GetCheckSum() const override final { return m_check_sum; }
 
     std::string GetTimestamp() const override final
@@ -454,31 +482,31 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         return edge_based_node_data.GetNameID(edge_based_node_id);
     }
 
-    std::string_view GetNameForID(const NameID id) const override final
+    extractor::NameString GetNameForID(const NameID id) const override final
     {
         CHECK_DATASET_DISABLED(m_name_table, DATASET_NAME_DATA);
         return m_name_table->GetNameForID(id);
     }
 
-    std::string_view GetRefForID(const NameID id) const override final
+    extractor::NameString GetRefForID(const NameID id) const override final
     {
         CHECK_DATASET_DISABLED(m_name_table, DATASET_NAME_DATA);
         return m_name_table->GetRefForID(id);
     }
 
-    std::string_view GetPronunciationForID(const NameID id) const override final
+    extractor::NameString GetPronunciationForID(const NameID id) const override final
     {
         CHECK_DATASET_DISABLED(m_name_table, DATASET_NAME_DATA);
         return m_name_table->GetPronunciationForID(id);
     }
 
-    std::string_view GetDestinationsForID(const NameID id) const override final
+    extractor::NameString GetDestinationsForID(const NameID id) const override final
     {
         CHECK_DATASET_DISABLED(m_name_table, DATASET_NAME_DATA);
         return m_name_table->GetDestinationsForID(id);
     }
 
-    std::string_view GetExitsForID(const NameID id) const override final
+    extractor::NameString GetExitsForID(const NameID id) const override final
     {
         CHECK_DATASET_DISABLED(m_name_table, DATASET_NAME_DATA);
         return m_name_table->GetExitsForID(id);
@@ -5,12 +5,14 @@
 
 #include "engine/approach.hpp"
 #include "engine/phantom_node.hpp"
+#include "engine/snapping_query.hpp"
 
 #include "contractor/query_edge.hpp"
 
 #include "extractor/class_data.hpp"
 #include "extractor/edge_based_node_segment.hpp"
 #include "extractor/maneuver_override.hpp"
+#include "extractor/name_table.hpp"
 #include "extractor/query_node.hpp"
 #include "extractor/segment_data_container.hpp"
 #include "extractor/travel_mode.hpp"
@@ -46,8 +48,7 @@ class BaseDataFacade
   public:
     using RTreeLeaf = extractor::EdgeBasedNodeSegment;
 
-    using NodeForwardRange =
-        std::ranges::subrange<extractor::SegmentDataView::SegmentNodeVector::const_iterator>;
+    using NodeForwardRange = extractor::SegmentNodeRange;
     using NodeReverseRange = std::ranges::reverse_view<NodeForwardRange>;
 
     using WeightForwardRange =
@@ -143,6 +144,19 @@ class BaseDataFacade
                                                      const Approach approach,
                                                      const bool use_all_edges) const = 0;
 
+    // Batch versions of the queries above, one result per query in the same order
+    virtual std::vector<std::vector<PhantomNodeWithDistance>>
+    NearestPhantomNodesInRange(const std::vector<SnappingQuery> &queries,
+                               const bool use_all_edges) const = 0;
+
+    virtual std::vector<std::vector<PhantomNodeWithDistance>>
+    NearestPhantomNodes(const std::vector<SnappingQuery> &queries,
+                        const size_t max_results) const = 0;
+
+    virtual std::vector<PhantomCandidateAlternatives>
+    NearestCandidatesWithAlternativeFromBigComponent(const std::vector<SnappingQuery> &queries,
+                                                     const bool use_all_edges) const = 0;
+
     virtual bool HasLaneData(const EdgeID edge_based_edge_id) const = 0;
     virtual util::guidance::LaneTupleIdPair GetLaneData(const EdgeID edge_based_edge_id) const = 0;
     virtual extractor::TurnLaneDescription
@@ -150,15 +164,15 @@ class BaseDataFacade
 
     virtual NameID GetNameIndex(const NodeID edge_based_node_id) const = 0;
 
-    virtual std::string_view GetNameForID(const NameID id) const = 0;
+    virtual extractor::NameString GetNameForID(const NameID id) const = 0;
 
-    virtual std::string_view GetRefForID(const NameID id) const = 0;
+    virtual extractor::NameString GetRefForID(const NameID id) const = 0;
 
-    virtual std::string_view GetPronunciationForID(const NameID id) const = 0;
+    virtual extractor::NameString GetPronunciationForID(const NameID id) const = 0;
 
-    virtual std::string_view GetDestinationsForID(const NameID id) const = 0;
+    virtual extractor::NameString GetDestinationsForID(const NameID id) const = 0;
 
-    virtual std::string_view GetExitsForID(const NameID id) const = 0;
+    virtual extractor::NameString GetExitsForID(const NameID id) const = 0;
 
     virtual bool GetContinueStraightDefault() const = 0;
 
@@ -0,0 +1,40 @@
+#ifndef OSRM_ENGINE_DATAFACADE_SHADOW_MEMORY_ALLOCATOR_HPP_
+#define OSRM_ENGINE_DATAFACADE_SHADOW_MEMORY_ALLOCATOR_HPP_
+
+#include "engine/datafacade/contiguous_block_allocator.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace osrm::engine::datafacade
+{
+
+/**
+ * This allocator shadows some blocks of another allocator with process-local copies
+ * that can be modified without affecting the datafacades of the other allocator.
+ * All other blocks are shared with the other allocator, which is kept alive
+ * as long as this allocator exists.
+ */
+class ShadowMemoryAllocator final : public ContiguousBlockAllocator
+{
+  public:
+    // Copies the blocks in `block_names` from `source`, which is usually
+    // the index of `base` or of an earlier shadow of it.
+    ShadowMemoryAllocator(std::shared_ptr<ContiguousBlockAllocator> base,
+                          const storage::SharedDataIndex &source,
+                          const std::vector<std::string> &block_names);
+    ~ShadowMemoryAllocator() override final;
+
+    // interface to give access to the datafacades
+    const storage::SharedDataIndex &GetIndex() override final;
+
+  private:
+    std::shared_ptr<ContiguousBlockAllocator> base;
+    storage::SharedDataIndex index;
+    std::unique_ptr<char[]> internal_memory;
+};
+
+} // namespace osrm::engine::datafacade
+
+#endif // OSRM_ENGINE_DATAFACADE_SHADOW_MEMORY_ALLOCATOR_HPP_
@@ -80,7 +80,11 @@ class WatchingProvider : public DataFacadeProvider<AlgorithmT, FacadeT>
   public:
     using Facade = typename DataFacadeProvider<AlgorithmT, FacadeT>::Facade;
 
-    WatchingProvider(const std::string &dataset_name) : watchdog(dataset_name) {}
+    WatchingProvider(const std::string &dataset_name,
+                     const std::filesystem::path &traffic_update_directory = {})
+        : watchdog(dataset_name, traffic_update_directory)
+    {
+    }
 
     std::shared_ptr<const Facade> Get(const api::TileParameters &params) const override final
     {
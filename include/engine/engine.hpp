@@ -58,7 +58,8 @@ template <typename Algorithm> class Engine final : public EngineInterface
         {
             util::Log(logDEBUG) << "Using shared memory with name \"" << config.dataset_name
                                 << "\" with algorithm " << routing_algorithms::name<Algorithm>();
-            facade_provider = std::make_unique<WatchingProvider<Algorithm>>(config.dataset_name);
+            facade_provider = std::make_unique<WatchingProvider<Algorithm>>(
+                config.dataset_name, config.traffic_update_directory);
         }
         else if (!config.memory_file.empty() || config.use_mmap)
         {
@@ -51,6 +51,8 @@ namespace osrm::engine
  *  - Nearest
  *
  * In addition, shared memory can be used for datasets loaded with osrm-datastore.
+ * Segment speed files put into the traffic update directory are applied to a MLD dataset in
+ * shared memory while it is in use.
  *
  * You can chose between two algorithms:
  *  - Algorithm::CH
@@ -87,6 +89,7 @@ struct EngineConfig final
     std::vector<storage::FeatureDataset> disable_feature_dataset;
     std::string verbosity;
     std::string dataset_name;
+    std::filesystem::path traffic_update_directory;
 };
 } // namespace osrm::engine
 
@@ -4,19 +4,26 @@
 #include "engine/approach.hpp"
 #include "engine/bearing.hpp"
 #include "engine/phantom_node.hpp"
+#include "engine/snapping_query.hpp"
 #include "util/bearing.hpp"
 #include "util/coordinate_calculation.hpp"
+#include "util/hilbert_value.hpp"
 #include "util/rectangle.hpp"
 #include "util/typedefs.hpp"
 #include "util/web_mercator.hpp"
 
 #include "osrm/coordinate.hpp"
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <optional>
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <iterator>
+#include <utility>
 #include <vector>
 
 namespace osrm::engine
@@ -211,7 +218,98 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
         return MakeAlternativeBigCandidates(input_coordinate, nearest_coord, results);
     }
 
+    // Batch versions of the queries above, one result per query in the same order.
+    std::vector<std::vector<PhantomNodeWithDistance>>
+    NearestPhantomNodesInRange(const std::vector<SnappingQuery> &queries,
+                               const bool use_all_edges) const
+    {
+        return RunInHilbertOrder<std::vector<PhantomNodeWithDistance>>(
+            queries,
+            [this, use_all_edges](const SnappingQuery &query)
+            {
+                BOOST_ASSERT(query.max_distance);
+                return NearestPhantomNodes(query.input_coordinate,
+                                           query.approach,
+                                           *query.max_distance,
+                                           query.bearing,
+                                           use_all_edges);
+            });
+    }
+
+    std::vector<std::vector<PhantomNodeWithDistance>>
+    NearestPhantomNodes(const std::vector<SnappingQuery> &queries, const size_t max_results) const
+    {
+        return RunInHilbertOrder<std::vector<PhantomNodeWithDistance>>(
+            queries,
+            [this, max_results](const SnappingQuery &query)
+            {
+                return NearestPhantomNodes(query.input_coordinate,
+                                           query.approach,
+                                           max_results,
+                                           query.max_distance,
+                                           query.bearing,
+                                           std::nullopt);
+            });
+    }
+
+    std::vector<PhantomCandidateAlternatives>
+    NearestCandidatesWithAlternativeFromBigComponent(const std::vector<SnappingQuery> &queries,
+                                                     const bool use_all_edges) const
+    {
+        return RunInHilbertOrder<PhantomCandidateAlternatives>(
+            queries,
+            [this, use_all_edges](const SnappingQuery &query)
+            {
+                return NearestCandidatesWithAlternativeFromBigComponent(query.input_coordinate,
+                                                                        query.approach,
+                                                                        query.max_distance,
+                                                                        query.bearing,
+                                                                        use_all_edges);
+            });
+    }
+
   private:
+    // Batches with at least this many queries are split into ranges that run in parallel
+    static constexpr std::size_t PARALLEL_BATCH_SIZE = 256;
+    static constexpr std::size_t PARALLEL_GRAIN_SIZE = 64;
+
+    // Runs the queries sorted by the Hilbert value of their input coordinates, projected the same
+    // way as the leaves of the r-tree. Consecutive searches then mostly descend into the same
+    // subtrees and find the inner nodes and leaves still in the cache instead of reading them
+    // from memory (or from disk if the r-tree is memory mapped) again.
+    template <typename ResultT, typename QueryFn>
+    std::vector<ResultT> RunInHilbertOrder(const std::vector<SnappingQuery> &queries,
+                                           QueryFn query_fn) const
+    {
+        std::vector<std::pair<std::uint64_t, std::size_t>> order(queries.size());
+        for (std::size_t index = 0; index < queries.size(); ++index)
+        {
+            auto projected = queries[index].input_coordinate;
+            projected.lat = FixedLatitude{static_cast<std::int32_t>(
+                COORDINATE_PRECISION * util::web_mercator::latToY(toFloating(projected.lat)))};
+            order[index] = {util::GetHilbertCode(projected), index};
+        }
+        std::sort(order.begin(), order.end());
+
+        std::vector<ResultT> results(queries.size());
+        const auto run = [&](const tbb::blocked_range<std::size_t> &range)
+        {
+            for (auto position = range.begin(); position != range.end(); ++position)
+            {
+                const auto index = order[position].second;
+                results[index] = query_fn(queries[index]);
+            }
+        };
+
+        const tbb::blocked_range<std::size_t> all_queries(0, order.size(), PARALLEL_GRAIN_SIZE);
+        if (queries.size() < PARALLEL_BATCH_SIZE)
+            run(all_queries);
+        else
+            tbb::parallel_for(all_queries, run);
+
+        return results;
+    }
+
     PhantomCandidateAlternatives
     MakeAlternativeBigCandidates(const util::Coordinate input_coordinate,
                                  const Coordinate nearest_coord,
@@ -136,11 +136,11 @@ inline std::vector<RouteStep> assembleSteps(const datafacade::BaseDataFacade &fa
                 steps.push_back(RouteStep{path_point.from_edge_based_node,
                                           step_name_id,
                                           is_segregated,
-                                          std::string(name),
-                                          std::string(ref),
-                                          std::string(pronunciation),
-                                          std::string(destinations),
-                                          std::string(exits),
+                                          std::string(name.get()),
+                                          std::string(ref.get()),
+                                          std::string(pronunciation.get()),
+                                          std::string(destinations.get()),
+                                          std::string(exits.get()),
                                           NO_ROTARY_NAME,
                                           NO_ROTARY_NAME,
                                           from_alias<double>(segment_duration) / 10.,
@@ -237,11 +237,11 @@ inline std::vector<RouteStep> assembleSteps(const datafacade::BaseDataFacade &fa
         steps.push_back(RouteStep{leg_data[leg_data.size() - 1].from_edge_based_node,
                                   step_name_id,
                                   is_segregated,
-                                  std::string(facade.GetNameForID(step_name_id)),
-                                  std::string(facade.GetRefForID(step_name_id)),
-                                  std::string(facade.GetPronunciationForID(step_name_id)),
-                                  std::string(facade.GetDestinationsForID(step_name_id)),
-                                  std::string(facade.GetExitsForID(step_name_id)),
+                                  std::string(facade.GetNameForID(step_name_id).get()),
+                                  std::string(facade.GetRefForID(step_name_id).get()),
+                                  std::string(facade.GetPronunciationForID(step_name_id).get()),
+                                  std::string(facade.GetDestinationsForID(step_name_id).get()),
+                                  std::string(facade.GetExitsForID(step_name_id).get()),
                                   NO_ROTARY_NAME,
                                   NO_ROTARY_NAME,
                                   from_alias<double>(duration) / 10.,
@@ -283,11 +283,11 @@ inline std::vector<RouteStep> assembleSteps(const datafacade::BaseDataFacade &fa
         steps.push_back(RouteStep{source_node_id,
                                   source_name_id,
                                   is_segregated,
-                                  std::string(facade.GetNameForID(source_name_id)),
-                                  std::string(facade.GetRefForID(source_name_id)),
-                                  std::string(facade.GetPronunciationForID(source_name_id)),
-                                  std::string(facade.GetDestinationsForID(source_name_id)),
-                                  std::string(facade.GetExitsForID(source_name_id)),
+                                  std::string(facade.GetNameForID(source_name_id).get()),
+                                  std::string(facade.GetRefForID(source_name_id).get()),
+                                  std::string(facade.GetPronunciationForID(source_name_id).get()),
+                                  std::string(facade.GetDestinationsForID(source_name_id).get()),
+                                  std::string(facade.GetExitsForID(source_name_id).get()),
                                   NO_ROTARY_NAME,
                                   NO_ROTARY_NAME,
                                   from_alias<double>(duration) / 10.,
@@ -326,11 +326,11 @@ inline std::vector<RouteStep> assembleSteps(const datafacade::BaseDataFacade &fa
     steps.push_back(RouteStep{target_node_id,
                               target_name_id,
                               facade.IsSegregated(target_node_id),
-                              std::string(facade.GetNameForID(target_name_id)),
-                              std::string(facade.GetRefForID(target_name_id)),
-                              std::string(facade.GetPronunciationForID(target_name_id)),
-                              std::string(facade.GetDestinationsForID(target_name_id)),
-                              std::string(facade.GetExitsForID(target_name_id)),
+                              std::string(facade.GetNameForID(target_name_id).get()),
+                              std::string(facade.GetRefForID(target_name_id).get()),
+                              std::string(facade.GetPronunciationForID(target_name_id).get()),
+                              std::string(facade.GetDestinationsForID(target_name_id).get()),
+                              std::string(facade.GetExitsForID(target_name_id).get()),
                               NO_ROTARY_NAME,
                               NO_ROTARY_NAME,
                               ZERO_DURATION,
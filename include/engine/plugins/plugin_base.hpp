@@ -7,6 +7,7 @@
 #include "engine/datafacade/datafacade_base.hpp"
 #include "engine/phantom_node.hpp"
 #include "engine/routing_algorithms.hpp"
+#include "engine/snapping_query.hpp"
 #include "engine/status.hpp"
 
 #include "util/coordinate.hpp"
@@ -178,32 +179,33 @@ class BasePlugin
             parameters.coordinates.size());
         BOOST_ASSERT(radiuses.size() == parameters.coordinates.size());
 
-        const bool use_hints = !parameters.hints.empty();
         const bool use_bearings = !parameters.bearings.empty();
         const bool use_approaches = !parameters.approaches.empty();
 
+        std::vector<std::size_t> query_indices;
+        std::vector<SnappingQuery> queries;
         for (const auto i : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
         {
-            if (use_hints && parameters.hints[i] && !parameters.hints[i]->segment_hints.empty() &&
-                parameters.hints[i]->IsValid(parameters.coordinates[i], facade))
+            if (UseHint(facade, parameters, i))
             {
-                for (const auto &seg_hint : parameters.hints[i]->segment_hints)
-                {
-                    phantom_nodes[i].push_back(PhantomNodeWithDistance{
-                        seg_hint.phantom,
-                        util::coordinate_calculation::greatCircleDistance(
-                            parameters.coordinates[i], seg_hint.phantom.location)});
-                }
+                phantom_nodes[i] = MakePhantomNodesFromHint(parameters, i);
                 continue;
             }
 
-            phantom_nodes[i] = facade.NearestPhantomNodesInRange(
+            query_indices.push_back(i);
+            queries.push_back(SnappingQuery{
                 parameters.coordinates[i],
                 radiuses[i],
                 use_bearings ? parameters.bearings[i] : std::nullopt,
                 use_approaches && parameters.approaches[i] ? parameters.approaches[i].value()
-                                                           : engine::Approach::UNRESTRICTED,
-                use_all_edges);
+                                                           : engine::Approach::UNRESTRICTED});
+        }
+
+        auto results = facade.NearestPhantomNodesInRange(queries, use_all_edges);
+        BOOST_ASSERT(results.size() == queries.size());
+        for (const auto query : util::irange<std::size_t>(0UL, queries.size()))
+        {
+            phantom_nodes[query_indices[query]] = std::move(results[query]);
         }
 
         return phantom_nodes;
@@ -217,38 +219,35 @@ class BasePlugin
         std::vector<std::vector<PhantomNodeWithDistance>> phantom_nodes(
             parameters.coordinates.size());
 
-        const bool use_hints = !parameters.hints.empty();
-        const bool use_bearings = !parameters.bearings.empty();
-        const bool use_radiuses = !parameters.radiuses.empty();
-        const bool use_approaches = !parameters.approaches.empty();
-
         BOOST_ASSERT(parameters.IsValid());
+        std::vector<std::size_t> query_indices;
+        std::vector<SnappingQuery> queries;
         for (const auto i : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
         {
-            if (use_hints && parameters.hints[i] && !parameters.hints[i]->segment_hints.empty() &&
-                parameters.hints[i]->IsValid(parameters.coordinates[i], facade))
+            if (UseHint(facade, parameters, i))
             {
-                for (const auto &seg_hint : parameters.hints[i]->segment_hints)
-                {
-                    phantom_nodes[i].push_back(PhantomNodeWithDistance{
-                        seg_hint.phantom,
-                        util::coordinate_calculation::greatCircleDistance(
-                            parameters.coordinates[i], seg_hint.phantom.location)});
-                }
+                phantom_nodes[i] = MakePhantomNodesFromHint(parameters, i);
                 continue;
             }
 
-            phantom_nodes[i] = facade.NearestPhantomNodes(
-                parameters.coordinates[i],
-                number_of_results,
-                use_radiuses ? parameters.radiuses[i] : default_radius,
-                use_bearings ? parameters.bearings[i] : std::nullopt,
-                use_approaches && parameters.approaches[i] ? parameters.approaches[i].value()
-                                                           : engine::Approach::UNRESTRICTED);
+            query_indices.push_back(i);
+            queries.push_back(MakeSnappingQuery(parameters, i));
+        }
+
+        auto results = facade.NearestPhantomNodes(queries, number_of_results);
+        BOOST_ASSERT(results.size() == queries.size());
+        for (const auto query : util::irange<std::size_t>(0UL, queries.size()))
+        {
+            const auto i = query_indices[query];
+            phantom_nodes[i] = std::move(results[query]);
 
             // we didn't find a fitting node, return error
             if (phantom_nodes[i].empty())
             {
+                // Only keep the results up to the first coordinate without a result
+                std::for_each(phantom_nodes.begin() + i + 1,
+                              phantom_nodes.end(),
+                              [](auto &candidates) { candidates.clear(); });
                 break;
             }
         }
@@ -261,17 +260,14 @@ class BasePlugin
     {
         std::vector<PhantomCandidateAlternatives> alternatives(parameters.coordinates.size());
 
-        const bool use_hints = !parameters.hints.empty();
-        const bool use_bearings = !parameters.bearings.empty();
-        const bool use_radiuses = !parameters.radiuses.empty();
-        const bool use_approaches = !parameters.approaches.empty();
         const bool use_all_edges = parameters.snapping == api::BaseParameters::SnappingType::Any;
 
         BOOST_ASSERT(parameters.IsValid());
+        std::vector<std::size_t> query_indices;
+        std::vector<SnappingQuery> queries;
         for (const auto i : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
         {
-            if (use_hints && parameters.hints[i] && !parameters.hints[i]->segment_hints.empty() &&
-                parameters.hints[i]->IsValid(parameters.coordinates[i], facade))
+            if (UseHint(facade, parameters, i))
             {
                 std::transform(parameters.hints[i]->segment_hints.begin(),
                                parameters.hints[i]->segment_hints.end(),
@@ -281,20 +277,24 @@ class BasePlugin
                 continue;
             }
 
-            alternatives[i] = facade.NearestCandidatesWithAlternativeFromBigComponent(
-                parameters.coordinates[i],
-                use_radiuses ? parameters.radiuses[i] : default_radius,
-                use_bearings ? parameters.bearings[i] : std::nullopt,
-                use_approaches && parameters.approaches[i] ? parameters.approaches[i].value()
-                                                           : engine::Approach::UNRESTRICTED,
-                use_all_edges);
+            query_indices.push_back(i);
+            queries.push_back(MakeSnappingQuery(parameters, i));
+        }
+
+        auto results =
+            facade.NearestCandidatesWithAlternativeFromBigComponent(queries, use_all_edges);
+        BOOST_ASSERT(results.size() == queries.size());
+        for (const auto query : util::irange<std::size_t>(0UL, queries.size()))
+        {
+            const auto i = query_indices[query];
+            alternatives[i] = std::move(results[query]);
 
             // we didn't find a fitting node, return error
             if (alternatives[i].first.empty())
             {
                 // This ensures the list of phantom nodes only consists of valid nodes.
                 // We can use this on the call-site to detect an error.
-                alternatives.pop_back();
+                alternatives.resize(i);
                 break;
             }
 
@@ -325,6 +325,45 @@ class BasePlugin
                std::to_string(missing_index);
     }
 
+    bool UseHint(const datafacade::BaseDataFacade &facade,
+                 const api::BaseParameters &parameters,
+                 const std::size_t i) const
+    {
+        return !parameters.hints.empty() && parameters.hints[i] &&
+               !parameters.hints[i]->segment_hints.empty() &&
+               parameters.hints[i]->IsValid(parameters.coordinates[i], facade);
+    }
+
+    std::vector<PhantomNodeWithDistance>
+    MakePhantomNodesFromHint(const api::BaseParameters &parameters, const std::size_t i) const
+    {
+        std::vector<PhantomNodeWithDistance> phantom_nodes;
+        for (const auto &seg_hint : parameters.hints[i]->segment_hints)
+        {
+            phantom_nodes.push_back(PhantomNodeWithDistance{
+                seg_hint.phantom,
+                util::coordinate_calculation::greatCircleDistance(parameters.coordinates[i],
+                                                                  seg_hint.phantom.location)});
+        }
+        return phantom_nodes;
+    }
+
+    // Falls back to default_radius for non-set radii
+    SnappingQuery MakeSnappingQuery(const api::BaseParameters &parameters,
+                                    const std::size_t i) const
+    {
+        const bool use_bearings = !parameters.bearings.empty();
+        const bool use_radiuses = !parameters.radiuses.empty();
+        const bool use_approaches = !parameters.approaches.empty();
+
+        return SnappingQuery{
+            parameters.coordinates[i],
+            use_radiuses ? parameters.radiuses[i] : default_radius,
+            use_bearings ? parameters.bearings[i] : std::nullopt,
+            use_approaches && parameters.approaches[i] ? parameters.approaches[i].value()
+                                                       : engine::Approach::UNRESTRICTED};
+    }
+
     const std::optional<double> default_radius;
 };
 } // namespace osrm::engine::plugins
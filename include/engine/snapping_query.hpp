@@ -0,0 +1,24 @@
+#ifndef OSRM_ENGINE_SNAPPING_QUERY_HPP
+#define OSRM_ENGINE_SNAPPING_QUERY_HPP
+
+#include "engine/approach.hpp"
+#include "engine/bearing.hpp"
+
+#include "util/coordinate.hpp"
+
+#include <optional>
+
+namespace osrm::engine
+{
+
+// Parameters to snap one input coordinate of a request to the road network
+struct SnappingQuery
+{
+    util::Coordinate input_coordinate;
+    std::optional<double> max_distance;
+    std::optional<Bearing> bearing;
+    Approach approach;
+};
+} // namespace osrm::engine
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef OSRM_ENGINE_TRAFFIC_UPDATE_WATCHER_HPP
+#define OSRM_ENGINE_TRAFFIC_UPDATE_WATCHER_HPP
+
+#include "engine/datafacade/contiguous_block_allocator.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace osrm::engine
+{
+
+/**
+ * Watches a directory for segment speed files and applies them to a MLD data set that is
+ * already in use, without running osrm-customize and osrm-datastore.
+ *
+ * Files are picked up in the order of their names, later files take precedence. They can be CSV
+ * files or binary traffic files (see osrm-traffic-convert). Files should be written under a name
+ * starting with a dot and renamed when they are complete. Applied files are removed, files that
+ * can't be applied are renamed to end in ".failed".
+ *
+ * Every batch of files is applied to copies of the changed blocks and only the cells that contain
+ * updated nodes are customized again. The result is published as a new generation that shares all
+ * other blocks with the data set, so queries running on older generations are not affected.
+ *
+ * Only segment speeds are supported. All updates are discarded when a new data set is loaded.
+ */
+class TrafficUpdateWatcher
+{
+  public:
+    using Allocator = std::shared_ptr<datafacade::ContiguousBlockAllocator>;
+    // Publishes `generation` that was derived from the data set of `base`.
+    // Returns false if `base` is not the current data set anymore.
+    using PublishCallback = std::function<bool(const Allocator &base, Allocator generation)>;
+
+    TrafficUpdateWatcher(std::filesystem::path directory,
+                         PublishCallback publish,
+                         std::chrono::milliseconds poll_interval = std::chrono::seconds(1));
+    ~TrafficUpdateWatcher();
+
+    // Discards all updates and applies the following ones to the data set of `base`
+    void Reset(Allocator base);
+
+  private:
+    struct Customization;
+
+    void Run();
+    void ApplyUpdates(const std::vector<std::filesystem::path> &files);
+
+    const std::filesystem::path directory;
+    const PublishCallback publish;
+    const std::chrono::milliseconds poll_interval;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool active;
+    Allocator next_base;
+
+    // only used by the watcher thread
+    Allocator base;
+    Allocator current;
+    std::unique_ptr<Customization> customization;
+
+    std::thread watcher;
+};
+} // namespace osrm::engine
+
+#endif
@@ -44,6 +44,9 @@ class CompressedEdgeContainer
                              const EdgeWeight weight,
                              const EdgeDuration duration);
 
+    // Moves all geometries of a container that holds a disjoint set of edges into this one
+    void Merge(CompressedEdgeContainer &&other);
+
     void InitializeBothwayVector();
     unsigned ZipEdges(const unsigned f_edge_pos, const unsigned r_edge_pos);
 
@@ -0,0 +1,159 @@
+#ifndef OSRM_EXTRACTOR_COMPRESSED_SEGMENT_NODES_HPP_
+#define OSRM_EXTRACTOR_COMPRESSED_SEGMENT_NODES_HPP_
+
+#include "util/typedefs.hpp"
+#include "util/vector_view.hpp"
+
+#include "storage/shared_memory_ownership.hpp"
+#include "storage/tar_fwd.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+namespace osrm::extractor
+{
+namespace detail
+{
+template <storage::Ownership Ownership> class CompressedSegmentNodesImpl;
+} // namespace detail
+
+namespace serialization
+{
+template <storage::Ownership Ownership>
+inline void read(storage::tar::FileReader &reader,
+                 const std::string &name,
+                 detail::CompressedSegmentNodesImpl<Ownership> &compressed_nodes);
+template <storage::Ownership Ownership>
+inline void write(storage::tar::FileWriter &writer,
+                  const std::string &name,
+                  const detail::CompressedSegmentNodesImpl<Ownership> &compressed_nodes);
+} // namespace serialization
+
+namespace detail
+{
+// Block-compressed storage for the node lists of the compressed geometries.
+//
+// Geometries are grouped into blocks of BLOCK_SIZE. Inside a block every node is stored as the
+// zig-zag encoded difference to the previous node, written as a varint. Nodes along a way have
+// mostly consecutive ids, so the majority of nodes take a single byte instead of four.
+// To decode a geometry only its block has to be scanned, which is found through block_offsets.
+// The number of nodes per geometry is not stored, it is taken from the segment data index.
+template <storage::Ownership Ownership> class CompressedSegmentNodesImpl
+{
+    template <typename T> using Vector = util::ViewOrVector<T, Ownership>;
+
+  public:
+    static constexpr std::uint32_t BLOCK_SIZE = 64;
+
+    CompressedSegmentNodesImpl() = default;
+
+    CompressedSegmentNodesImpl(Vector<std::uint64_t> block_offsets_, Vector<std::uint8_t> data_)
+        : block_offsets(std::move(block_offsets_)), data(std::move(data_))
+    {
+    }
+
+    template <typename IndexT, typename NodesT>
+    CompressedSegmentNodesImpl(const IndexT &index, const NodesT &nodes)
+    {
+        static_assert(Ownership != storage::Ownership::View, "Views can not be encoded.");
+        BOOST_ASSERT(!index.empty());
+
+        const std::uint32_t number_of_geometries = index.size() - 1;
+        for (std::uint32_t first = 0; first < number_of_geometries; first += BLOCK_SIZE)
+        {
+            block_offsets.push_back(data.size());
+
+            const auto last = std::min(first + BLOCK_SIZE, number_of_geometries);
+            NodeID previous = 0;
+            for (auto offset = index[first]; offset < index[last]; ++offset)
+            {
+                encodeValue(static_cast<std::int64_t>(nodes[offset]) - previous);
+                previous = nodes[offset];
+            }
+        }
+        block_offsets.push_back(data.size());
+    }
+
+    bool empty() const { return block_offsets.empty(); }
+
+    // Writes the nodes of geometry `id` to `out`
+    template <typename IndexT, typename OutIter>
+    void Decode(const IndexT &index, const std::uint32_t id, OutIter out) const
+    {
+        BOOST_ASSERT(id + 1 < index.size());
+        const auto block = id / BLOCK_SIZE;
+        BOOST_ASSERT(block + 1 < block_offsets.size());
+
+        const auto *position = data.data() + block_offsets[block];
+        NodeID current = 0;
+
+        // Skip all geometries in front of `id`, we still need their values to
+        // reconstruct the absolute node ids.
+        for (auto offset = index[block * BLOCK_SIZE]; offset < index[id]; ++offset)
+        {
+            current += decodeValue(position);
+        }
+
+        for (auto offset = index[id]; offset < index[id + 1]; ++offset)
+        {
+            current += decodeValue(position);
+            *out++ = current;
+        }
+    }
+
+    std::size_t GetSizeInBytes() const
+    {
+        return block_offsets.size() * sizeof(std::uint64_t) + data.size();
+    }
+
+    friend void serialization::read<Ownership>(
+        storage::tar::FileReader &reader,
+        const std::string &name,
+        detail::CompressedSegmentNodesImpl<Ownership> &compressed_nodes);
+    friend void serialization::write<Ownership>(
+        storage::tar::FileWriter &writer,
+        const std::string &name,
+        const detail::CompressedSegmentNodesImpl<Ownership> &compressed_nodes);
+
+  private:
+    void encodeValue(const std::int64_t delta)
+    {
+        // zig-zag maps small negative and positive deltas to small unsigned values
+        auto value =
+            (static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63);
+        while (value >= 0x80)
+        {
+            data.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        data.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    // Returns the decoded delta, as unsigned value it can be added with wrap-around
+    static NodeID decodeValue(const std::uint8_t *&position)
+    {
+        std::uint64_t value = 0;
+        unsigned shift = 0;
+        while (*position & 0x80)
+        {
+            value |= static_cast<std::uint64_t>(*position++ & 0x7f) << shift;
+            shift += 7;
+        }
+        value |= static_cast<std::uint64_t>(*position++) << shift;
+
+        return static_cast<NodeID>((value >> 1) ^ (~(value & 1) + 1));
+    }
+
+    Vector<std::uint64_t> block_offsets;
+    Vector<std::uint8_t> data;
+};
+} // namespace detail
+
+using CompressedSegmentNodesView = detail::CompressedSegmentNodesImpl<storage::Ownership::View>;
+using CompressedSegmentNodes = detail::CompressedSegmentNodesImpl<storage::Ownership::Container>;
+} // namespace osrm::extractor
+
+#endif
@@ -9,6 +9,9 @@
 
 #include "storage/tar_fwd.hpp"
 
+#include "util/external_vector.hpp"
+
+#include <filesystem>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -20,6 +23,10 @@ namespace osrm::extractor
  * is collected by the extractor callbacks.
  *
  * The data is the filtered, aggregated and finally written to disk.
+ *
+ * The node and edge lists are the largest of these containers. With a memory budget they are
+ * spilled to disk and sorted with an external merge sort, all passes over them are merge joins
+ * that visit them in order.
  */
 class ExtractionContainers
 {
@@ -35,12 +42,17 @@ class ExtractionContainers
     void PrepareRestrictions(const ReferencedWays &restriction_ways);
     void PrepareEdges(ScriptingEnvironment &scripting_environment);
 
-    void WriteCharData(const std::string &file_name);
+    void WriteCharData(const std::string &file_name, const bool compress_names);
+
+    // spill settings of the node and edge lists, also used for intermediate edge lists
+    std::filesystem::path spill_directory;
+    std::size_t memory_budget;
 
   public:
     using NodeIDVector = std::vector<OSMNodeID>;
     using NodeVector = std::vector<QueryNode>;
-    using EdgeVector = std::vector<InternalExtractorEdge>;
+    using ExternalNodeVector = util::ExternalVector<QueryNode>;
+    using ExternalEdgeVector = util::ExternalVector<InternalExtractorEdge>;
     using AnnotationDataVector = std::vector<NodeBasedEdgeAnnotation>;
     using NameCharData = std::vector<unsigned char>;
     using NameOffsets = std::vector<size_t>;
@@ -48,8 +60,8 @@ class ExtractionContainers
     using WayNodeIDOffsets = std::vector<size_t>;
 
     NodeIDVector used_node_id_list;
-    NodeVector all_nodes_list;
-    EdgeVector all_edges_list;
+    ExternalNodeVector all_nodes_list;
+    ExternalEdgeVector all_edges_list;
     AnnotationDataVector all_edges_annotation_data_list;
     NameCharData name_char_data;
     NameOffsets name_offsets;
@@ -72,10 +84,14 @@ class ExtractionContainers
     std::vector<UnresolvedManeuverOverride> internal_maneuver_overrides;
     NodeVector used_nodes;
 
-    ExtractionContainers();
+    // The node and edge lists share `memory_budget` bytes of memory and keep everything else in
+    // files in `spill_directory`, a budget of 0 keeps them in memory
+    explicit ExtractionContainers(const std::filesystem::path &spill_directory = {},
+                                  const std::size_t memory_budget = 0);
 
     void PrepareData(ScriptingEnvironment &scripting_environment,
-                     const std::string &names_data_path);
+                     const std::string &names_data_path,
+                     const bool compress_names);
 };
 } // namespace osrm::extractor
 
@@ -75,6 +75,17 @@ class Extractor
     ParsedOSMData ParseOSMData(ScriptingEnvironment &scripting_environment,
                                const unsigned number_of_threads);
 
+    // checkpoint of the parse stage, the obstacles are kept in the scripting environment
+    void WriteParsedOSMData(const ParsedOSMData &parsed_osm_data,
+                            const ScriptingEnvironment &scripting_environment) const;
+    ParsedOSMData ReadParsedOSMData(ScriptingEnvironment &scripting_environment) const;
+
+    // Runs the expansion stage and writes its outputs. Returns the input of the r-tree stage:
+    // the edge-based node segments and the node coordinates.
+    std::vector<EdgeBasedNodeSegment> ExpandGraph(ScriptingEnvironment &scripting_environment,
+                                                  ParsedOSMData parsed_osm_data,
+                                                  std::vector<util::Coordinate> &coordinates);
+
     EdgeID BuildEdgeExpandedGraph(
         // input data
         const util::NodeBasedDynamicGraph &node_based_graph,
@@ -100,6 +111,14 @@ class Extractor
                         const util::DeallocatingVector<EdgeBasedEdge> &input_edge_list,
                         const std::vector<EdgeBasedNodeSegment> &input_node_segments,
                         EdgeBasedNodeDataContainer &nodes_container) const;
+    std::vector<NodeID> MatchPreviousNodeIDs(const EdgeID number_of_edge_based_nodes) const;
+    void RenumberEdgeBasedNodes(const std::vector<std::uint32_t> &permutation,
+                                EdgeBasedNodeDataContainer &edge_based_nodes_container,
+                                std::vector<EdgeBasedNodeSegment> &edge_based_node_segments,
+                                std::vector<EdgeWeight> &edge_based_node_weights,
+                                std::vector<EdgeDuration> &edge_based_node_durations,
+                                std::vector<EdgeDistance> &edge_based_node_distances,
+                                util::DeallocatingVector<EdgeBasedEdge> &edge_based_edge_list);
     void BuildRTree(std::vector<EdgeBasedNodeSegment> edge_based_node_segments,
                     const std::vector<util::Coordinate> &coordinates);
 
@@ -38,6 +38,19 @@ namespace osrm::extractor
 
 struct ExtractorConfig final : storage::IOConfig
 {
+    // Stages of the extraction in the order they run. Every stage but the first one can be started
+    // from the checkpoint that the previous stage writes if `write_checkpoints` is set.
+    enum class Stage
+    {
+        // parses the OSM file, checkpoint: .osrm.parsed
+        Parse,
+        // builds and compresses the node-based graph, expands it into the edge-based graph and
+        // annotates the turns, checkpoint: .osrm.ebg_segments
+        Expansion,
+        // builds the r-tree
+        RTree
+    };
+
     ExtractorConfig() noexcept
         : IOConfig(
               {
@@ -65,7 +78,9 @@ struct ExtractorConfig final : storage::IOConfig
                ".osrm.icd",
                ".osrm.cnbg",
                ".osrm.cnbg_to_ebg",
-               ".osrm.maneuver_overrides"})
+               ".osrm.maneuver_overrides",
+               ".osrm.parsed",
+               ".osrm.ebg_segments"})
     {
     }
 
@@ -76,16 +91,33 @@ struct ExtractorConfig final : storage::IOConfig
 
     std::filesystem::path input_path;
     std::filesystem::path profile_path;
+    // OSM change files (.osc) that are applied to the input while it is parsed
+    std::vector<std::filesystem::path> change_paths;
     std::vector<std::filesystem::path> location_dependent_data_paths;
+    // .osrm file of a previous extraction whose edge-based node ids are kept where possible
+    std::filesystem::path previous_dataset_path;
+    // file for a dense node location index, keeps the index in memory if empty
+    std::filesystem::path location_index_path;
     std::string data_version;
 
+    Stage start_stage = Stage::Parse;
+    bool write_checkpoints = false;
+
     unsigned requested_num_threads = 0;
     unsigned small_component_size = 1000;
 
+    // memory for the node and edge lists during extraction in bytes, 0 for no limit
+    std::size_t memory_budget = 0;
+    // directory for the parts of these lists that do not fit, defaults to the output directory
+    std::filesystem::path spill_directory;
+
     bool use_metadata = false;
     bool parse_conditionals = false;
     bool use_locations_cache = true;
     bool dump_nbg_graph = false;
+    bool use_locality_renumbering = false;
+    bool compress_geometry = false;
+    bool compress_names = false;
 };
 } // namespace osrm::extractor
 
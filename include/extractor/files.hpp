@@ -2,7 +2,11 @@
 #define OSRM_EXTRACTOR_FILES_HPP
 
 #include "extractor/edge_based_edge.hpp"
+#include "extractor/edge_based_node_segment.hpp"
+#include "extractor/maneuver_override.hpp"
+#include "extractor/node_based_edge.hpp"
 #include "extractor/node_data_container.hpp"
+#include "extractor/obstacles.hpp"
 #include "extractor/profile_properties.hpp"
 #include "extractor/query_node.hpp"
 #include "extractor/serialization.hpp"
@@ -569,6 +573,80 @@ void readCompressedNodeBasedGraph(const std::filesystem::path &path, EdgeListT &
 
     storage::serialization::read(reader, "/extractor/cnbg", edge_list);
 }
+
+// writes the .osrm.parsed checkpoint with the result of parsing the OSM data
+template <typename PackedOSMIDsT>
+void writeParsedData(const std::filesystem::path &path,
+                     const LaneDescriptionMap &turn_lane_map,
+                     const std::vector<TurnRestriction> &turn_restrictions,
+                     const std::vector<UnresolvedManeuverOverride> &maneuver_overrides,
+                     const std::vector<util::Coordinate> &coordinates,
+                     const PackedOSMIDsT &osm_node_ids,
+                     const std::vector<NodeBasedEdge> &edges,
+                     const std::vector<NodeBasedEdgeAnnotation> &annotations,
+                     const ObstacleMap &obstacle_map)
+{
+    static_assert(std::is_same<typename PackedOSMIDsT::value_type, OSMNodeID>::value, "");
+
+    const auto fingerprint = storage::tar::FileWriter::GenerateFingerprint;
+    storage::tar::FileWriter writer{path, fingerprint};
+
+    serialization::write(writer, "/extractor/turn_lanes", turn_lane_map);
+    serialization::write(writer, "/extractor/turn_restrictions", turn_restrictions);
+    serialization::write(writer, "/extractor/maneuver_overrides", maneuver_overrides);
+    storage::serialization::write(writer, "/extractor/nodes/coordinates", coordinates);
+    util::serialization::write(writer, "/extractor/nodes/osm_node_ids", osm_node_ids);
+    storage::serialization::write(writer, "/extractor/edges", edges);
+    storage::serialization::write(writer, "/extractor/annotations", annotations);
+    serialization::write(writer, "/extractor/obstacles", obstacle_map);
+}
+
+// reads the .osrm.parsed checkpoint
+template <typename PackedOSMIDsT>
+void readParsedData(const std::filesystem::path &path,
+                    LaneDescriptionMap &turn_lane_map,
+                    std::vector<TurnRestriction> &turn_restrictions,
+                    std::vector<UnresolvedManeuverOverride> &maneuver_overrides,
+                    std::vector<util::Coordinate> &coordinates,
+                    PackedOSMIDsT &osm_node_ids,
+                    std::vector<NodeBasedEdge> &edges,
+                    std::vector<NodeBasedEdgeAnnotation> &annotations,
+                    ObstacleMap &obstacle_map)
+{
+    static_assert(std::is_same<typename PackedOSMIDsT::value_type, OSMNodeID>::value, "");
+
+    const auto fingerprint = storage::tar::FileReader::VerifyFingerprint;
+    storage::tar::FileReader reader{path, fingerprint};
+
+    serialization::read(reader, "/extractor/turn_lanes", turn_lane_map);
+    serialization::read(reader, "/extractor/turn_restrictions", turn_restrictions);
+    serialization::read(reader, "/extractor/maneuver_overrides", maneuver_overrides);
+    storage::serialization::read(reader, "/extractor/nodes/coordinates", coordinates);
+    util::serialization::read(reader, "/extractor/nodes/osm_node_ids", osm_node_ids);
+    storage::serialization::read(reader, "/extractor/edges", edges);
+    storage::serialization::read(reader, "/extractor/annotations", annotations);
+    serialization::read(reader, "/extractor/obstacles", obstacle_map);
+}
+
+// writes the .osrm.ebg_segments checkpoint with the input of the r-tree
+inline void writeEdgeBasedNodeSegments(const std::filesystem::path &path,
+                                       const std::vector<EdgeBasedNodeSegment> &segments)
+{
+    const auto fingerprint = storage::tar::FileWriter::GenerateFingerprint;
+    storage::tar::FileWriter writer{path, fingerprint};
+
+    storage::serialization::write(writer, "/extractor/edge_based_node_segments", segments);
+}
+
+// reads the .osrm.ebg_segments checkpoint
+inline void readEdgeBasedNodeSegments(const std::filesystem::path &path,
+                                      std::vector<EdgeBasedNodeSegment> &segments)
+{
+    const auto fingerprint = storage::tar::FileReader::VerifyFingerprint;
+    storage::tar::FileReader reader{path, fingerprint};
+
+    storage::serialization::read(reader, "/extractor/edge_based_node_segments", segments);
+}
 } // namespace osrm::extractor::files
 
 #endif
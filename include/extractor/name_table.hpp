@@ -2,10 +2,16 @@
 #define OSRM_EXTRACTOR_NAME_TABLE_HPP
 
 #include "util/indexed_data.hpp"
+#include "util/string_symbol_table.hpp"
 #include "util/typedefs.hpp"
 
+#include <compare>
+#include <cstdint>
+#include <iterator>
+#include <ostream>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace osrm::extractor
 {
@@ -28,6 +34,46 @@ inline void write(storage::tar::FileWriter &writer,
                   const detail::NameTableImpl<Ownership> &index_data);
 } // namespace serialization
 
+// Result of a name table lookup. For plain tables it refers to the stored string, for compressed
+// tables it owns the decoded string. The std::string_view of get() and of the explicit conversion
+// is only valid as long as the NameString lives.
+class NameString
+{
+  public:
+    NameString() = default;
+    explicit NameString(std::string_view view_) : view(view_) {}
+    explicit NameString(std::string decoded_) : decoded(std::move(decoded_)), is_decoded(true) {}
+
+    std::string_view get() const { return is_decoded ? std::string_view{decoded} : view; }
+    explicit operator std::string_view() const { return get(); }
+
+    bool empty() const { return get().empty(); }
+    std::size_t size() const { return get().size(); }
+    const char *data() const { return get().data(); }
+
+    friend bool operator==(const NameString &lhs, const NameString &rhs)
+    {
+        return lhs.get() == rhs.get();
+    }
+    friend auto operator<=>(const NameString &lhs, const NameString &rhs)
+    {
+        return lhs.get() <=> rhs.get();
+    }
+    friend bool operator==(const NameString &lhs, const std::string_view rhs)
+    {
+        return lhs.get() == rhs;
+    }
+    friend std::ostream &operator<<(std::ostream &out, const NameString &name)
+    {
+        return out << name.get();
+    }
+
+  private:
+    std::string_view view;
+    std::string decoded;
+    bool is_decoded = false;
+};
+
 namespace detail
 {
 // This class provides a limited view over all the string data we serialize out.
@@ -44,6 +90,9 @@ namespace detail
 //
 // Offset 0 is name, 1 is destination, 2 is pronunciation, 3 is ref, 4 is exits
 // See datafacades and extractor callbacks for details.
+//
+// If the table has a symbol table all strings are stored compressed by it and are decoded on
+// every lookup, see util::StringSymbolTable.
 template <storage::Ownership Ownership> class NameTableImpl
 {
   public:
@@ -51,51 +100,95 @@ template <storage::Ownership Ownership> class NameTableImpl
         util::detail::IndexedDataImpl<util::VariableGroupBlock<16, std::string_view>, Ownership>;
     using ResultType = typename IndexedData::ResultType;
     using ValueType = typename IndexedData::ValueType;
+    using SymbolTable = util::detail::StringSymbolTableImpl<Ownership>;
 
     NameTableImpl() {}
 
-    NameTableImpl(IndexedData indexed_data_) : indexed_data{std::move(indexed_data_)} {}
+    NameTableImpl(IndexedData indexed_data_, SymbolTable symbol_table_ = {})
+        : indexed_data{std::move(indexed_data_)}, symbol_table{std::move(symbol_table_)}
+    {
+    }
+
+    // Builds a table with all strings compressed by a symbol table trained on them.
+    // Without any symbols every byte would be escaped, so the strings are stored plain then.
+    template <typename OffsetIterator, typename DataIterator>
+    static NameTableImpl
+    MakeCompressed(OffsetIterator first, OffsetIterator last, DataIterator data)
+    {
+        static_assert(Ownership != storage::Ownership::View, "Views can not be compressed.");
+
+        SymbolTable symbol_table(first, last, data);
+        if (symbol_table.empty())
+            return NameTableImpl(IndexedData(first, last, data));
+
+        const typename SymbolTable::Encoder encoder(symbol_table);
+
+        std::vector<std::uint64_t> offsets;
+        std::vector<char> encoded;
+        offsets.reserve(std::distance(first, last));
+        offsets.push_back(0);
+        for (auto current = first; std::next(current) != last; ++current)
+        {
+            const std::string_view value(reinterpret_cast<const char *>(&*(data + *current)),
+                                         *std::next(current) - *current);
+            encoder.Encode(value, std::back_inserter(encoded));
+            offsets.push_back(encoded.size());
+        }
+
+        return NameTableImpl(IndexedData(offsets.begin(), offsets.end(), encoded.begin()),
+                             std::move(symbol_table));
+    }
+
+    bool IsCompressed() const { return !symbol_table.empty(); }
 
-    std::string_view GetNameForID(const NameID id) const
+    // All valid name ids are below this bound
+    NameID GetNameIDUpperBound() const { return indexed_data.capacity(); }
+
+    std::size_t GetSizeInBytes() const
+    {
+        return indexed_data.GetSizeInBytes() + symbol_table.GetSizeInBytes();
+    }
+
+    NameString GetNameForID(const NameID id) const
     {
         if (id == INVALID_NAMEID)
             return {};
 
-        return indexed_data.at(id + 0);
+        return lookup(id + 0);
     }
 
-    std::string_view GetDestinationsForID(const NameID id) const
+    NameString GetDestinationsForID(const NameID id) const
     {
         if (id == INVALID_NAMEID)
             return {};
 
-        return indexed_data.at(id + 1);
+        return lookup(id + 1);
     }
 
-    std::string_view GetExitsForID(const NameID id) const
+    NameString GetExitsForID(const NameID id) const
     {
         if (id == INVALID_NAMEID)
             return {};
 
-        return indexed_data.at(id + 4);
+        return lookup(id + 4);
     }
 
-    std::string_view GetRefForID(const NameID id) const
+    NameString GetRefForID(const NameID id) const
     {
         if (id == INVALID_NAMEID)
             return {};
 
         const constexpr auto OFFSET_REF = 3u;
-        return indexed_data.at(id + OFFSET_REF);
+        return lookup(id + OFFSET_REF);
     }
 
-    std::string_view GetPronunciationForID(const NameID id) const
+    NameString GetPronunciationForID(const NameID id) const
     {
         if (id == INVALID_NAMEID)
             return {};
 
         const constexpr auto OFFSET_PRONUNCIATION = 2u;
-        return indexed_data.at(id + OFFSET_PRONUNCIATION);
+        return lookup(id + OFFSET_PRONUNCIATION);
     }
 
     friend void serialization::read<Ownership>(storage::tar::FileReader &reader,
@@ -107,7 +200,19 @@ template <storage::Ownership Ownership> class NameTableImpl
                                                 const NameTableImpl &index_data);
 
   private:
+    NameString lookup(const std::uint32_t index) const
+    {
+        const auto value = indexed_data.at(index);
+        if (symbol_table.empty() || value.empty())
+            return NameString{value};
+
+        std::string decoded;
+        symbol_table.Decode(value, decoded);
+        return NameString{std::move(decoded)};
+    }
+
     IndexedData indexed_data;
+    SymbolTable symbol_table;
 };
 } // namespace detail
 
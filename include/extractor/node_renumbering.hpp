@@ -0,0 +1,63 @@
+#ifndef OSRM_EXTRACTOR_NODE_RENUMBERING_HPP
+#define OSRM_EXTRACTOR_NODE_RENUMBERING_HPP
+
+#include "extractor/edge_based_edge.hpp"
+#include "extractor/edge_based_node_segment.hpp"
+#include "extractor/maneuver_override.hpp"
+#include "extractor/nbg_to_ebg.hpp"
+#include "extractor/packed_osm_ids.hpp"
+
+#include "util/coordinate.hpp"
+#include "util/deallocating_vector.hpp"
+#include "util/typedefs.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace osrm::extractor
+{
+
+// Computes a permutation (old id -> new id) of the edge-based nodes that orders them along the
+// Hilbert curve of their first segment. Forward and reverse nodes of the same compressed edge share
+// that segment and end up next to each other. Nodes without any segment (e.g. duplicated via-way
+// nodes) keep their relative order and are moved to the end.
+std::vector<std::uint32_t>
+makeHilbertPermutation(const std::uint32_t number_of_edge_based_nodes,
+                       const std::vector<EdgeBasedNodeSegment> &segments,
+                       const std::vector<util::Coordinate> &coordinates);
+
+// Finds for every edge-based node the id that the node between the same pair of OSM nodes had in
+// a previous dataset, or SPECIAL_NODEID. Pairs that are not unique in one of the datasets, e.g.
+// parallel ways between the same intersections, are not matched.
+std::vector<NodeID> matchPreviousNodeIDs(const std::uint32_t number_of_edge_based_nodes,
+                                         const std::vector<NBGToEBG> &mapping,
+                                         const PackedOSMIDs &osm_node_ids,
+                                         const std::vector<NBGToEBG> &previous_mapping,
+                                         const PackedOSMIDs &previous_osm_node_ids);
+
+// Computes a permutation (old id -> new id) that keeps the previous id of every matched node that
+// is still in range. All other nodes fill the remaining ids in the order given by `permutation`.
+std::vector<std::uint32_t> makeStablePermutation(const std::vector<NodeID> &previous_ids,
+                                                 const std::vector<std::uint32_t> &permutation);
+
+void renumber(std::vector<EdgeBasedNodeSegment> &segments,
+              const std::vector<std::uint32_t> &permutation);
+
+void renumber(util::DeallocatingVector<EdgeBasedEdge> &edges,
+              const std::vector<std::uint32_t> &permutation);
+
+void renumber(std::vector<NBGToEBG> &mapping, const std::vector<std::uint32_t> &permutation);
+
+// Moves the weight, duration and distance of every node to its new id
+void renumber(std::vector<EdgeWeight> &weights,
+              std::vector<EdgeDuration> &durations,
+              std::vector<EdgeDistance> &distances,
+              const std::vector<std::uint32_t> &permutation);
+
+void renumber(std::vector<StorageManeuverOverride> &maneuver_overrides,
+              std::vector<NodeID> &node_sequences,
+              const std::vector<std::uint32_t> &permutation);
+
+} // namespace osrm::extractor
+
+#endif
@@ -28,6 +28,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef OSRM_EXTRACTOR_OBSTACLES_DATA_HPP_
 #define OSRM_EXTRACTOR_OBSTACLES_DATA_HPP_
 
+#include "storage/tar_fwd.hpp"
 #include "util/typedefs.hpp"
 
 #include <osmium/osm/node.hpp>
@@ -105,6 +106,16 @@ struct Obstacle
     float weight{0};   // unit: profile.weight_multiplier
 };
 
+class ObstacleMap;
+
+namespace serialization
+{
+inline void
+read(storage::tar::FileReader &reader, const std::string &name, ObstacleMap &obstacle_map);
+inline void
+write(storage::tar::FileWriter &writer, const std::string &name, const ObstacleMap &obstacle_map);
+} // namespace serialization
+
 // A class that holds all known nodes with obstacles.
 //
 // This class holds all obstacles, bidirectional and unidirectional ones.  For
@@ -198,6 +209,17 @@ class ObstacleMap
     // compression with the leading node of the leading node.
     void compress(NodeID from, NodeID delendus, NodeID to);
 
+    // One half of compress(): replace the leading node 'delendus' of the obstacles at 'last'
+    // with 'first'. Calls for different nodes 'last' can run concurrently.
+    void compressLeadingNode(NodeID first, NodeID delendus, NodeID last);
+
+    friend void serialization::read(storage::tar::FileReader &reader,
+                                    const std::string &name,
+                                    ObstacleMap &obstacle_map);
+    friend void serialization::write(storage::tar::FileWriter &writer,
+                                     const std::string &name,
+                                     const ObstacleMap &obstacle_map);
+
   private:
     // obstacles according to external id
     tbb::concurrent_vector<OsmFromToObstacle> osm_obstacles;
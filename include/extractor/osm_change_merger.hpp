@@ -0,0 +1,74 @@
+#ifndef OSRM_EXTRACTOR_OSM_CHANGE_MERGER_HPP
+#define OSRM_EXTRACTOR_OSM_CHANGE_MERGER_HPP
+
+#include <osmium/memory/buffer.hpp>
+#include <osmium/osm/entity_bits.hpp>
+#include <osmium/osm/object.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <tuple>
+#include <vector>
+
+namespace osmium::io
+{
+class Reader;
+} // namespace osmium::io
+
+namespace osrm::extractor
+{
+
+// Applies OSM change files (.osc) to the buffers of an input file while it is read, so that
+// osrm-extract sees the updated data without writing an updated copy of the input first.
+//
+// Only the newest version of each changed object is kept, deleted objects are dropped. The input
+// has to be sorted by type and ID like all planet files and extracts are.
+class OSMChangeMerger
+{
+  public:
+    OSMChangeMerger() = default;
+    explicit OSMChangeMerger(const std::vector<std::filesystem::path> &change_paths);
+    explicit OSMChangeMerger(std::vector<osmium::memory::Buffer> change_buffers);
+
+    // Starts a new pass over the input that contains the given entities
+    void Rewind(osmium::osm_entity_bits::type entities);
+
+    // Returns the buffer with changed objects replaced and new objects inserted. Must be called
+    // for all buffers of a pass in input order.
+    osmium::memory::Buffer Merge(osmium::memory::Buffer input);
+
+    // Returns the changed objects that follow the last object of the input, or an invalid buffer
+    // if there are none left
+    osmium::memory::Buffer Tail();
+
+    // Reads the next buffer of a pass from the reader and merges it, followed by the tail once
+    // the input is exhausted. Returns an invalid buffer when the pass is done.
+    osmium::memory::Buffer Read(osmium::io::Reader &reader);
+
+    std::size_t GetNumberOfChanges() const { return changes.size(); }
+
+  private:
+    // order of objects in sorted OSM files: type, then zero and negative before positive IDs
+    using ObjectKey = std::tuple<osmium::item_type, bool, osmium::unsigned_object_id_type>;
+    static ObjectKey Key(const osmium::OSMObject &object)
+    {
+        return {object.type(), object.id() > 0, object.positive_id()};
+    }
+
+    void Init();
+    void Append(osmium::memory::Buffer &output, const osmium::OSMObject &change) const;
+
+    std::vector<osmium::memory::Buffer> change_buffers;
+    // newest version of every changed object in input order
+    std::vector<const osmium::OSMObject *> changes;
+
+    osmium::osm_entity_bits::type entities = osmium::osm_entity_bits::object;
+    std::size_t next_change = 0;
+    // the reader must not be read again after it returned its last buffer
+    bool input_exhausted = false;
+    ObjectKey last_input{osmium::item_type::undefined, false, 0};
+};
+
+} // namespace osrm::extractor
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef OSRM_EXTRACTOR_PROFILE_PLUGIN_HPP
+#define OSRM_EXTRACTOR_PROFILE_PLUGIN_HPP
+
+#include "extractor/extraction_node.hpp"
+#include "extractor/extraction_relation.hpp"
+#include "extractor/extraction_segment.hpp"
+#include "extractor/extraction_turn.hpp"
+#include "extractor/extraction_way.hpp"
+#include "extractor/obstacles.hpp"
+#include "extractor/profile_properties.hpp"
+
+#include <osmium/osm/node.hpp>
+#include <osmium/osm/way.hpp>
+
+#include <string>
+#include <vector>
+
+// Bumped whenever this interface or one of the structures passed through it changes.
+// A plugin has to be compiled against the headers of the osrm-extract that loads it.
+#define OSRM_PROFILE_PLUGIN_ABI_VERSION 1
+
+#if defined(_WIN32)
+#define OSRM_PROFILE_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#define OSRM_PROFILE_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+namespace osrm::extractor
+{
+
+/**
+ * Interface of profiles that are compiled into a shared library instead of being written in Lua.
+ *
+ * The functions mirror the functions of a Lua profile: the constructor takes the place of setup()
+ * and the process functions are called with the same objects as their Lua counterparts. They are
+ * called concurrently from all extraction threads on a single plugin instance and therefore must
+ * not modify the plugin. Obstacles are added to the obstacle map passed to the constructor, which
+ * is thread-safe.
+ *
+ * A plugin library exports its profile with OSRM_PROFILE_PLUGIN(Type), where Type has a
+ * constructor taking an ObstacleMap &.
+ */
+class ProfilePlugin
+{
+  public:
+    virtual ~ProfilePlugin() = default;
+
+    virtual const ProfileProperties &GetProfileProperties() const = 0;
+
+    virtual std::vector<std::vector<std::string>> GetExcludableClasses() const { return {}; }
+    virtual std::vector<std::string> GetClassNames() const { return {}; }
+    virtual std::vector<std::string> GetNameSuffixList() const { return {}; }
+    virtual std::vector<std::string> GetRestrictions() const { return {}; }
+    virtual std::vector<std::string> GetRelations() const { return {}; }
+
+    virtual void ProcessNode(const osmium::Node &,
+                             ExtractionNode &,
+                             const ExtractionRelationContainer &) const
+    {
+    }
+    virtual void
+    ProcessWay(const osmium::Way &, ExtractionWay &, const ExtractionRelationContainer &) const = 0;
+    virtual void ProcessTurn(ExtractionTurn &) const {}
+    virtual void ProcessSegment(ExtractionSegment &) const {}
+};
+
+} // namespace osrm::extractor
+
+#define OSRM_PROFILE_PLUGIN(Type)                                                                  \
+    extern "C" OSRM_PROFILE_PLUGIN_EXPORT unsigned osrm_profile_plugin_abi_version()               \
+    {                                                                                              \
+        return OSRM_PROFILE_PLUGIN_ABI_VERSION;                                                    \
+    }                                                                                              \
+    extern "C" OSRM_PROFILE_PLUGIN_EXPORT osrm::extractor::ProfilePlugin *                         \
+    osrm_create_profile_plugin(osrm::extractor::ObstacleMap &obstacle_map)                         \
+    {                                                                                              \
+        return new Type(obstacle_map);                                                             \
+    }
+
+#endif // OSRM_EXTRACTOR_PROFILE_PLUGIN_HPP
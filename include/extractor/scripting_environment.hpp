@@ -60,6 +60,8 @@ class ScriptingEnvironment
     virtual std::vector<std::string> GetRestrictions() = 0;
     virtual std::vector<std::string> GetRelations() = 0;
     virtual void ProcessTurn(ExtractionTurn &turn) = 0;
+    // Same as ProcessTurn for all turns of a block of intersections at once
+    virtual void ProcessTurns(std::vector<ExtractionTurn> &turns) = 0;
     virtual void ProcessSegment(ExtractionSegment &segment) = 0;
 
     virtual void
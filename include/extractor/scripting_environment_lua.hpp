@@ -11,6 +11,10 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <sol/sol.hpp>
 
@@ -32,6 +36,16 @@ struct LuaScriptingContext final
                     ExtractionWay &result,
                     const ExtractionRelationContainer &relations);
 
+    // Calls process_nodes and process_ways of api_version 5 once for all elements of a buffer
+    void ProcessNodes(const std::vector<std::pair<const osmium::Node *, ExtractionNode *>> &nodes,
+                      const ExtractionRelationContainer &relations);
+    void ProcessWays(const std::vector<std::pair<const osmium::Way *, ExtractionWay *>> &ways,
+                     const ExtractionRelationContainer &relations);
+
+    void ProcessTurn(ExtractionTurn &turn);
+    // Calls process_turns of api_version 5 once for all turns, falls back to process_turn
+    void ProcessTurns(std::vector<ExtractionTurn> &turns);
+
     ProfileProperties properties;
     RasterContainer raster_sources;
     sol::state state;
@@ -40,11 +54,21 @@ struct LuaScriptingContext final
     bool has_node_function = false;
     bool has_way_function = false;
     bool has_segment_function = false;
+    bool has_nodes_function = false;
+    bool has_ways_function = false;
+    bool has_turns_function = false;
 
     sol::protected_function turn_function;
     sol::protected_function way_function;
     sol::protected_function node_function;
     sol::protected_function segment_function;
+    sol::protected_function ways_function;
+    sol::protected_function nodes_function;
+    sol::protected_function turns_function;
+
+    // tags that are passed as columns to the batch functions, the views point into the keys
+    std::vector<std::string> batch_tag_keys;
+    std::unordered_map<std::string_view, std::size_t> batch_tag_columns;
 
     int api_version = 4;
     sol::table profile_table;
@@ -53,6 +77,13 @@ struct LuaScriptingContext final
     const LocationDependentData &location_dependent_data;
     LocationDependentData::point_t last_location_point;
     std::vector<std::size_t> last_location_indexes;
+
+  private:
+    template <typename Object, typename Result>
+    void ProcessBatch(sol::protected_function &function,
+                      const char *objects_name,
+                      const std::vector<std::pair<const Object *, Result *>> &batch,
+                      const ExtractionRelationContainer &relations);
 };
 
 /**
@@ -66,7 +97,7 @@ class Sol2ScriptingEnvironment final : public ScriptingEnvironment
 {
   public:
     static const constexpr int SUPPORTED_MIN_API_VERSION = 0;
-    static const constexpr int SUPPORTED_MAX_API_VERSION = 4;
+    static const constexpr int SUPPORTED_MAX_API_VERSION = 5;
 
     explicit Sol2ScriptingEnvironment(
         const std::string &file_name,
@@ -81,6 +112,7 @@ class Sol2ScriptingEnvironment final : public ScriptingEnvironment
     std::vector<std::string> GetRestrictions() override;
     std::vector<std::string> GetRelations() override;
     void ProcessTurn(ExtractionTurn &turn) override;
+    void ProcessTurns(std::vector<ExtractionTurn> &turns) override;
     void ProcessSegment(ExtractionSegment &segment) override;
 
     void
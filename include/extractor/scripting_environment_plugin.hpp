@@ -0,0 +1,66 @@
+#ifndef SCRIPTING_ENVIRONMENT_PLUGIN_HPP
+#define SCRIPTING_ENVIRONMENT_PLUGIN_HPP
+
+#include "extractor/profile_plugin.hpp"
+#include "extractor/scripting_environment.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace boost::dll
+{
+class shared_library;
+} // namespace boost::dll
+
+namespace osrm::extractor
+{
+
+/**
+ * Runs a profile compiled into a shared library, see ProfilePlugin.
+ *
+ * Location-dependent data is not supported: compiled profiles have no access to the
+ * --location-dependent-data polygons.
+ */
+class PluginScriptingEnvironment final : public ScriptingEnvironment
+{
+  public:
+    explicit PluginScriptingEnvironment(const std::filesystem::path &plugin_path);
+    ~PluginScriptingEnvironment() override;
+
+    // Returns true if `profile_path` names a shared library rather than a Lua file
+    static bool IsPlugin(const std::filesystem::path &profile_path);
+
+    const ProfileProperties &GetProfileProperties() override;
+
+    std::vector<std::vector<std::string>> GetExcludableClasses() override;
+    std::vector<std::string> GetClassNames() override;
+    std::vector<std::string> GetNameSuffixList() override;
+    std::vector<std::string> GetRestrictions() override;
+    std::vector<std::string> GetRelations() override;
+    void ProcessTurn(ExtractionTurn &turn) override;
+    void ProcessTurns(std::vector<ExtractionTurn> &turns) override;
+    void ProcessSegment(ExtractionSegment &segment) override;
+
+    void
+    ProcessElements(const osmium::memory::Buffer &buffer,
+                    const RestrictionParser &restriction_parser,
+                    const ManeuverOverrideRelationParser &maneuver_override_parser,
+                    const ExtractionRelationContainer &relations,
+                    std::vector<std::pair<const osmium::Node &, ExtractionNode>> &resulting_nodes,
+                    std::vector<std::pair<const osmium::Way &, ExtractionWay>> &resulting_ways,
+                    std::vector<InputTurnRestriction> &resulting_restrictions,
+                    std::vector<InputManeuverOverride> &resulting_maneuver_overrides) override;
+
+    bool HasLocationDependentData() const override { return false; }
+
+  private:
+    // the plugin is destroyed before its library is unloaded
+    std::unique_ptr<boost::dll::shared_library> library;
+    std::unique_ptr<ProfilePlugin> plugin;
+};
+
+} // namespace osrm::extractor
+
+#endif /* SCRIPTING_ENVIRONMENT_PLUGIN_HPP */
@@ -1,6 +1,8 @@
 #ifndef OSRM_EXTRACTOR_SEGMENT_DATA_CONTAINER_HPP_
 #define OSRM_EXTRACTOR_SEGMENT_DATA_CONTAINER_HPP_
 
+#include "extractor/compressed_segment_nodes.hpp"
+
 #include "util/packed_vector.hpp"
 #include "util/typedefs.hpp"
 #include "util/vector_view.hpp"
@@ -8,8 +10,14 @@
 #include "storage/shared_memory_ownership.hpp"
 #include "storage/tar_fwd.hpp"
 
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
 #include <ranges>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace osrm::extractor
 {
@@ -33,6 +41,95 @@ inline void write(storage::tar::FileWriter &writer,
                   const detail::SegmentDataContainerImpl<Ownership> &segment_data);
 } // namespace serialization
 
+namespace detail
+{
+// Node list of a decoded geometry. Unused buffers are kept in a per-thread pool, so decoding a
+// geometry reuses the memory of an earlier geometry instead of allocating.
+class DecodedNodesBuffer
+{
+  public:
+    static DecodedNodesBuffer *Acquire()
+    {
+        auto &pool = Pool();
+        if (pool.empty())
+            return new DecodedNodesBuffer;
+
+        auto *buffer = pool.back().release();
+        pool.pop_back();
+        buffer->nodes.clear();
+        buffer->references.store(1, std::memory_order_relaxed);
+        return buffer;
+    }
+
+    void Retain() { references.fetch_add(1, std::memory_order_relaxed); }
+
+    void Release()
+    {
+        if (references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            Pool().emplace_back(this);
+    }
+
+    std::vector<NodeID> nodes;
+
+  private:
+    DecodedNodesBuffer() = default;
+
+    static std::vector<std::unique_ptr<DecodedNodesBuffer>> &Pool()
+    {
+        thread_local std::vector<std::unique_ptr<DecodedNodesBuffer>> pool;
+        return pool;
+    }
+
+    std::atomic<std::uint32_t> references{1};
+};
+} // namespace detail
+
+// Nodes of one geometry. Points into the node list of the segment data or, if the node lists are
+// block-compressed, into a decode buffer that is shared by all copies of the range.
+class SegmentNodeRange : public std::ranges::view_interface<SegmentNodeRange>
+{
+  public:
+    SegmentNodeRange() = default;
+    SegmentNodeRange(const NodeID *first_, const NodeID *last_) : first(first_), last(last_) {}
+    // Takes over the reference to the buffer
+    explicit SegmentNodeRange(detail::DecodedNodesBuffer *buffer_)
+        : first(buffer_->nodes.data()), last(buffer_->nodes.data() + buffer_->nodes.size()),
+          buffer(buffer_)
+    {
+    }
+
+    SegmentNodeRange(const SegmentNodeRange &other)
+        : first(other.first), last(other.last), buffer(other.buffer)
+    {
+        if (buffer)
+            buffer->Retain();
+    }
+    SegmentNodeRange(SegmentNodeRange &&other) noexcept
+        : first(other.first), last(other.last), buffer(std::exchange(other.buffer, nullptr))
+    {
+    }
+    SegmentNodeRange &operator=(SegmentNodeRange other) noexcept
+    {
+        std::swap(first, other.first);
+        std::swap(last, other.last);
+        std::swap(buffer, other.buffer);
+        return *this;
+    }
+    ~SegmentNodeRange()
+    {
+        if (buffer)
+            buffer->Release();
+    }
+
+    const NodeID *begin() const { return first; }
+    const NodeID *end() const { return last; }
+
+  private:
+    const NodeID *first = nullptr;
+    const NodeID *last = nullptr;
+    detail::DecodedNodesBuffer *buffer = nullptr;
+};
+
 namespace detail
 {
 template <storage::Ownership Ownership> class SegmentDataContainerImpl
@@ -51,6 +148,7 @@ template <storage::Ownership Ownership> class SegmentDataContainerImpl
     using SegmentWeightVector = PackedVector<SegmentWeight, SEGMENT_WEIGHT_BITS>;
     using SegmentDurationVector = PackedVector<SegmentDuration, SEGMENT_DURATION_BITS>;
     using SegmentDatasourceVector = Vector<DatasourceID>;
+    using CompressedNodes = CompressedSegmentNodesImpl<Ownership>;
 
     SegmentDataContainerImpl() = default;
 
@@ -61,27 +159,16 @@ template <storage::Ownership Ownership> class SegmentDataContainerImpl
                              SegmentDurationVector fwd_durations_,
                              SegmentDurationVector rev_durations_,
                              SegmentDatasourceVector fwd_datasources_,
-                             SegmentDatasourceVector rev_datasources_)
+                             SegmentDatasourceVector rev_datasources_,
+                             CompressedNodes compressed_nodes_ = {})
         : index(std::move(index_)), nodes(std::move(nodes_)), fwd_weights(std::move(fwd_weights_)),
           rev_weights(std::move(rev_weights_)), fwd_durations(std::move(fwd_durations_)),
           rev_durations(std::move(rev_durations_)), fwd_datasources(std::move(fwd_datasources_)),
-          rev_datasources(std::move(rev_datasources_))
+          rev_datasources(std::move(rev_datasources_)),
+          compressed_nodes(std::move(compressed_nodes_))
     {
     }
 
-    auto GetForwardGeometry(const DirectionalGeometryID id)
-    {
-        const auto begin = nodes.begin() + index[id];
-        const auto end = nodes.begin() + index[id + 1];
-
-        return std::ranges::subrange(begin, end);
-    }
-
-    auto GetReverseGeometry(const DirectionalGeometryID id)
-    {
-        return GetForwardGeometry(id) | std::views::reverse;
-    }
-
     auto GetForwardDurations(const DirectionalGeometryID id)
     {
         const auto begin = fwd_durations.begin() + index[id] + 1;
@@ -130,12 +217,17 @@ template <storage::Ownership Ownership> class SegmentDataContainerImpl
         return std::ranges::subrange(begin, end) | std::views::reverse;
     }
 
-    auto GetForwardGeometry(const DirectionalGeometryID id) const
+    SegmentNodeRange GetForwardGeometry(const DirectionalGeometryID id) const
     {
-        const auto begin = nodes.cbegin() + index[id];
-        const auto end = nodes.cbegin() + index[id + 1];
-
-        return std::ranges::subrange(begin, end);
+        if (!compressed_nodes.empty())
+        {
+            auto *buffer = DecodedNodesBuffer::Acquire();
+            buffer->nodes.reserve(index[id + 1] - index[id]);
+            compressed_nodes.Decode(index, id, std::back_inserter(buffer->nodes));
+            return SegmentNodeRange(buffer);
+        }
+
+        return SegmentNodeRange(nodes.data() + index[id], nodes.data() + index[id + 1]);
     }
 
     auto GetReverseGeometry(const DirectionalGeometryID id) const
@@ -194,6 +286,25 @@ template <storage::Ownership Ownership> class SegmentDataContainerImpl
     auto GetNumberOfGeometries() const { return index.size() - 1; }
     auto GetNumberOfSegments() const { return fwd_weights.size(); }
 
+    bool HasCompressedNodes() const { return !compressed_nodes.empty(); }
+
+    std::size_t GetNodesSizeInBytes() const
+    {
+        return nodes.size() * sizeof(NodeID) + compressed_nodes.GetSizeInBytes();
+    }
+
+    // Replaces the plain node lists by the block-compressed representation
+    void CompressNodes()
+    {
+        static_assert(Ownership != storage::Ownership::View, "Views can not be compressed.");
+        if (!compressed_nodes.empty())
+            return;
+
+        compressed_nodes = CompressedNodes(index, nodes);
+        nodes.clear();
+        nodes.shrink_to_fit();
+    }
+
     friend void
     serialization::read<Ownership>(storage::tar::FileReader &reader,
                                    const std::string &name,
@@ -212,6 +323,7 @@ template <storage::Ownership Ownership> class SegmentDataContainerImpl
     SegmentDurationVector rev_durations;
     SegmentDatasourceVector fwd_datasources;
     SegmentDatasourceVector rev_datasources;
+    CompressedNodes compressed_nodes;
 };
 } // namespace detail
 
@@ -8,9 +8,11 @@
 #include "extractor/name_table.hpp"
 #include "extractor/nbg_to_ebg.hpp"
 #include "extractor/node_data_container.hpp"
+#include "extractor/obstacles.hpp"
 #include "extractor/profile_properties.hpp"
 #include "extractor/restriction.hpp"
 #include "extractor/segment_data_container.hpp"
+#include "extractor/turn_lane_types.hpp"
 
 #include "storage/io.hpp"
 #include "storage/serialization.hpp"
@@ -71,6 +73,24 @@ inline void write(storage::tar::FileWriter &writer, const std::string &name, Dat
 }
 
 // read/write for segment data file
+template <storage::Ownership Ownership>
+inline void read(storage::tar::FileReader &reader,
+                 const std::string &name,
+                 detail::CompressedSegmentNodesImpl<Ownership> &compressed_nodes)
+{
+    storage::serialization::read(reader, name + "/block_offsets", compressed_nodes.block_offsets);
+    storage::serialization::read(reader, name + "/data", compressed_nodes.data);
+}
+
+template <storage::Ownership Ownership>
+inline void write(storage::tar::FileWriter &writer,
+                  const std::string &name,
+                  const detail::CompressedSegmentNodesImpl<Ownership> &compressed_nodes)
+{
+    storage::serialization::write(writer, name + "/block_offsets", compressed_nodes.block_offsets);
+    storage::serialization::write(writer, name + "/data", compressed_nodes.data);
+}
+
 template <storage::Ownership Ownership>
 inline void read(storage::tar::FileReader &reader,
                  const std::string &name,
@@ -86,6 +106,7 @@ inline void read(storage::tar::FileReader &reader,
         reader, name + "/forward_data_sources", segment_data.fwd_datasources);
     storage::serialization::read(
         reader, name + "/reverse_data_sources", segment_data.rev_datasources);
+    serialization::read(reader, name + "/compressed_nodes", segment_data.compressed_nodes);
 }
 
 template <storage::Ownership Ownership>
@@ -103,6 +124,7 @@ inline void write(storage::tar::FileWriter &writer,
         writer, name + "/forward_data_sources", segment_data.fwd_datasources);
     storage::serialization::write(
         writer, name + "/reverse_data_sources", segment_data.rev_datasources);
+    serialization::write(writer, name + "/compressed_nodes", segment_data.compressed_nodes);
 }
 
 template <storage::Ownership Ownership>
@@ -126,14 +148,11 @@ inline void write(storage::tar::FileWriter &writer,
         writer, name + "/annotations", node_data_container.annotation_data);
 }
 
-inline void read(storage::io::BufferReader &reader, ConditionalTurnPenalty &turn_penalty)
+inline void read(storage::io::BufferReader &reader, std::vector<util::OpeningHours> &conditions)
 {
-    reader.ReadInto(turn_penalty.turn_offset);
-    reader.ReadInto(turn_penalty.location.lat);
-    reader.ReadInto(turn_penalty.location.lon);
     auto const num_conditions = reader.ReadElementCount64();
-    turn_penalty.conditions.resize(num_conditions);
-    for (auto &condition : turn_penalty.conditions)
+    conditions.resize(num_conditions);
+    for (auto &condition : conditions)
     {
         reader.ReadInto(condition.modifier);
         storage::serialization::read(reader, condition.times);
@@ -142,13 +161,11 @@ inline void read(storage::io::BufferReader &reader, ConditionalTurnPenalty &turn
     }
 }
 
-inline void write(storage::io::BufferWriter &writer, const ConditionalTurnPenalty &turn_penalty)
+inline void write(storage::io::BufferWriter &writer,
+                  const std::vector<util::OpeningHours> &conditions)
 {
-    writer.WriteFrom(turn_penalty.turn_offset);
-    writer.WriteFrom(static_cast<util::FixedLatitude::value_type>(turn_penalty.location.lat));
-    writer.WriteFrom(static_cast<util::FixedLongitude::value_type>(turn_penalty.location.lon));
-    writer.WriteElementCount64(turn_penalty.conditions.size());
-    for (const auto &c : turn_penalty.conditions)
+    writer.WriteElementCount64(conditions.size());
+    for (const auto &c : conditions)
     {
         writer.WriteFrom(c.modifier);
         storage::serialization::write(writer, c.times);
@@ -157,6 +174,22 @@ inline void write(storage::io::BufferWriter &writer, const ConditionalTurnPenalt
     }
 }
 
+inline void read(storage::io::BufferReader &reader, ConditionalTurnPenalty &turn_penalty)
+{
+    reader.ReadInto(turn_penalty.turn_offset);
+    reader.ReadInto(turn_penalty.location.lat);
+    reader.ReadInto(turn_penalty.location.lon);
+    read(reader, turn_penalty.conditions);
+}
+
+inline void write(storage::io::BufferWriter &writer, const ConditionalTurnPenalty &turn_penalty)
+{
+    writer.WriteFrom(turn_penalty.turn_offset);
+    writer.WriteFrom(static_cast<util::FixedLatitude::value_type>(turn_penalty.location.lat));
+    writer.WriteFrom(static_cast<util::FixedLongitude::value_type>(turn_penalty.location.lon));
+    write(writer, turn_penalty.conditions);
+}
+
 inline void write(storage::io::BufferWriter &writer,
                   const std::vector<ConditionalTurnPenalty> &conditional_penalties)
 {
@@ -206,6 +239,7 @@ inline void write(storage::tar::FileWriter &writer,
 {
     storage::io::BufferWriter buffer_writer;
     util::serialization::write(writer, name, name_table.indexed_data);
+    util::serialization::write(writer, name + "/symbol_table", name_table.symbol_table);
 }
 
 template <storage::Ownership Ownership>
@@ -214,6 +248,204 @@ inline void read(storage::tar::FileReader &reader,
                  detail::NameTableImpl<Ownership> &name_table)
 {
     util::serialization::read(reader, name, name_table.indexed_data);
+    util::serialization::read(reader, name + "/symbol_table", name_table.symbol_table);
+}
+
+// read/write for the intermediate data of the osrm-extract checkpoints
+inline void read(storage::io::BufferReader &reader, TurnPath &turn_path)
+{
+    std::uint8_t type;
+    reader.ReadInto(type);
+    if (type == TurnPathType::VIA_WAY_TURN_PATH)
+    {
+        ViaWayPath path;
+        reader.ReadInto(path.from);
+        storage::serialization::read(reader, path.via);
+        reader.ReadInto(path.to);
+        turn_path.node_or_way = std::move(path);
+    }
+    else
+    {
+        ViaNodePath path;
+        reader.ReadInto(path.from);
+        reader.ReadInto(path.via);
+        reader.ReadInto(path.to);
+        turn_path.node_or_way = path;
+    }
+}
+
+inline void write(storage::io::BufferWriter &writer, const TurnPath &turn_path)
+{
+    writer.WriteFrom(static_cast<std::uint8_t>(turn_path.Type()));
+    if (turn_path.Type() == TurnPathType::VIA_WAY_TURN_PATH)
+    {
+        const auto &path = turn_path.AsViaWayPath();
+        writer.WriteFrom(path.from);
+        storage::serialization::write(writer, path.via);
+        writer.WriteFrom(path.to);
+    }
+    else
+    {
+        const auto &path = turn_path.AsViaNodePath();
+        writer.WriteFrom(path.from);
+        writer.WriteFrom(path.via);
+        writer.WriteFrom(path.to);
+    }
+}
+
+inline void read(storage::io::BufferReader &reader, TurnRestriction &restriction)
+{
+    read(reader, restriction.turn_path);
+    reader.ReadInto(restriction.is_only);
+    read(reader, restriction.condition);
+}
+
+inline void write(storage::io::BufferWriter &writer, const TurnRestriction &restriction)
+{
+    write(writer, restriction.turn_path);
+    writer.WriteFrom(restriction.is_only);
+    write(writer, restriction.condition);
+}
+
+inline void read(storage::io::BufferReader &reader, UnresolvedManeuverOverride &maneuver_override)
+{
+    read(reader, maneuver_override.turn_path);
+    reader.ReadInto(maneuver_override.instruction_node);
+    reader.ReadInto(maneuver_override.override_type);
+    reader.ReadInto(maneuver_override.direction);
+}
+
+inline void write(storage::io::BufferWriter &writer,
+                  const UnresolvedManeuverOverride &maneuver_override)
+{
+    write(writer, maneuver_override.turn_path);
+    writer.WriteFrom(maneuver_override.instruction_node);
+    writer.WriteFrom(maneuver_override.override_type);
+    writer.WriteFrom(maneuver_override.direction);
+}
+
+// vectors of elements with variable size are stored in a single buffer
+template <typename T>
+inline void
+readBuffered(storage::tar::FileReader &reader, const std::string &name, std::vector<T> &elements)
+{
+    std::string buffer;
+    storage::serialization::read(reader, name, buffer);
+
+    storage::io::BufferReader buffer_reader{buffer};
+    elements.resize(buffer_reader.ReadElementCount64());
+    for (auto &element : elements)
+    {
+        read(buffer_reader, element);
+    }
+}
+
+template <typename T>
+inline void writeBuffered(storage::tar::FileWriter &writer,
+                          const std::string &name,
+                          const std::vector<T> &elements)
+{
+    storage::io::BufferWriter buffer_writer;
+    buffer_writer.WriteElementCount64(elements.size());
+    for (const auto &element : elements)
+    {
+        write(buffer_writer, element);
+    }
+
+    storage::serialization::write(writer, name, buffer_writer.GetBuffer());
+}
+
+inline void read(storage::tar::FileReader &reader,
+                 const std::string &name,
+                 std::vector<TurnRestriction> &restrictions)
+{
+    readBuffered(reader, name, restrictions);
+}
+
+inline void write(storage::tar::FileWriter &writer,
+                  const std::string &name,
+                  const std::vector<TurnRestriction> &restrictions)
+{
+    writeBuffered(writer, name, restrictions);
+}
+
+inline void read(storage::tar::FileReader &reader,
+                 const std::string &name,
+                 std::vector<UnresolvedManeuverOverride> &maneuver_overrides)
+{
+    readBuffered(reader, name, maneuver_overrides);
+}
+
+inline void write(storage::tar::FileWriter &writer,
+                  const std::string &name,
+                  const std::vector<UnresolvedManeuverOverride> &maneuver_overrides)
+{
+    writeBuffered(writer, name, maneuver_overrides);
+}
+
+// the descriptions are stored in the order of their IDs, so the IDs survive a round trip
+inline void
+read(storage::tar::FileReader &reader, const std::string &name, LaneDescriptionMap &turn_lane_map)
+{
+    std::vector<std::uint32_t> offsets;
+    std::vector<TurnLaneType::Mask> masks;
+    storage::serialization::read(reader, name + "/offsets", offsets);
+    storage::serialization::read(reader, name + "/masks", masks);
+
+    turn_lane_map.data.clear();
+    for (std::size_t id = 0; id + 1 < offsets.size(); ++id)
+    {
+        turn_lane_map.data.emplace(
+            TurnLaneDescription(masks.begin() + offsets[id], masks.begin() + offsets[id + 1]),
+            static_cast<LaneDescriptionID>(id));
+    }
+}
+
+inline void write(storage::tar::FileWriter &writer,
+                  const std::string &name,
+                  const LaneDescriptionMap &turn_lane_map)
+{
+    const auto [offsets, masks] = transformTurnLaneMapIntoArrays(turn_lane_map);
+    storage::serialization::write(writer, name + "/offsets", offsets);
+    storage::serialization::write(writer, name + "/masks", masks);
+}
+
+// only the obstacles with internal node IDs are stored, i.e. after ObstacleMap::fixupNodes
+inline void
+read(storage::tar::FileReader &reader, const std::string &name, ObstacleMap &obstacle_map)
+{
+    std::string buffer;
+    storage::serialization::read(reader, name, buffer);
+
+    storage::io::BufferReader buffer_reader{buffer};
+    obstacle_map.obstacles.clear();
+    const auto count = buffer_reader.ReadElementCount64();
+    for (std::uint64_t index = 0; index < count; ++index)
+    {
+        NodeID from;
+        NodeID to;
+        Obstacle obstacle{Obstacle::Type::None};
+        buffer_reader.ReadInto(from);
+        buffer_reader.ReadInto(to);
+        buffer_reader.ReadInto(obstacle);
+        obstacle_map.emplace(from, to, obstacle);
+    }
+}
+
+inline void
+write(storage::tar::FileWriter &writer, const std::string &name, const ObstacleMap &obstacle_map)
+{
+    storage::io::BufferWriter buffer_writer;
+    buffer_writer.WriteElementCount64(obstacle_map.obstacles.size());
+    for (const auto &[key, value] : obstacle_map.obstacles)
+    {
+        const auto &[from, to, obstacle] = value;
+        buffer_writer.WriteFrom(from);
+        buffer_writer.WriteFrom(to);
+        buffer_writer.WriteFrom(obstacle);
+    }
+
+    storage::serialization::write(writer, name, buffer_writer.GetBuffer());
 }
 } // namespace osrm::extractor::serialization
 
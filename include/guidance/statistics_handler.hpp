@@ -7,11 +7,13 @@
 
 #include "util/log.hpp"
 
+#include <tbb/enumerable_thread_specific.h>
+
 #include <algorithm>
 #include <iomanip>
 #include <iterator>
 #include <map>
-#include <mutex>
+#include <numeric>
 
 #include <cstdint>
 
@@ -46,6 +48,18 @@ class StatisticsHandler final : public IntersectionHandler
 
     ~StatisticsHandler() override final
     {
+        // Merge the histograms of all threads
+        std::map<TurnType::Enum, std::uint64_t> type_hist;
+        std::map<DirectionModifier::Enum, std::uint64_t> modifier_hist;
+        histograms.combine_each(
+            [&](const Histograms &thread_histograms)
+            {
+                for (const auto &[type, count] : thread_histograms.type_hist)
+                    type_hist[type] += count;
+                for (const auto &[modifier, count] : thread_histograms.modifier_hist)
+                    modifier_hist[modifier] += count;
+            });
+
         const auto add_second = [](const auto acc, const auto &kv) { return acc + kv.second; };
 
         const auto num_types =
@@ -78,8 +92,8 @@ class StatisticsHandler final : public IntersectionHandler
     Intersection
     operator()(const NodeID, const EdgeID, Intersection intersection) const override final
     {
-        // Lock histograms updates on a per-intersection basis.
-        std::lock_guard<std::mutex> defer{lock};
+        // Every thread has its own histograms, so no locking is needed
+        auto &[type_hist, modifier_hist] = histograms.local();
 
         // Generate histograms for all roads; this way we will get duplicates
         // which we would not get doing it after EBF generation. But we want
@@ -100,9 +114,12 @@ class StatisticsHandler final : public IntersectionHandler
     }
 
   private:
-    mutable std::mutex lock;
-    mutable std::map<TurnType::Enum, std::uint64_t> type_hist;
-    mutable std::map<DirectionModifier::Enum, std::uint64_t> modifier_hist;
+    struct Histograms
+    {
+        std::map<TurnType::Enum, std::uint64_t> type_hist;
+        std::map<DirectionModifier::Enum, std::uint64_t> modifier_hist;
+    };
+    mutable tbb::enumerable_thread_specific<Histograms> histograms;
 };
 
 } // namespace osrm::guidance
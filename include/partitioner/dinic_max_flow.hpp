@@ -3,7 +3,9 @@
 
 #include "partitioner/bisection_graph_view.hpp"
 
+#include <atomic>
 #include <cstdint>
+#include <optional>
 #include <set>
 #include <unordered_set>
 #include <vector>
@@ -27,10 +29,24 @@ class DinicMaxFlow
     // input parameter storing the set o
     using SourceSinkNodes = std::unordered_set<NodeID>;
 
+    // largest flow value the caller is still interested in, it can be lowered concurrently (e.g.
+    // when several cuts are computed in parallel and only the best one is used)
+    using FlowBound = std::atomic<std::size_t>;
+
+    // frontiers of the level graph BFS with at least this many nodes are relaxed in parallel
+    static constexpr std::size_t PARALLEL_FRONTIER_SIZE = 4096;
+
     MinCut operator()(const BisectionGraphView &view,
                       const SourceSinkNodes &source_nodes,
                       const SourceSinkNodes &sink_nodes) const;
 
+    // Same as above but gives up as soon as the flow exceeds the bound. Since the flow value
+    // equals the number of cut edges, no cut within the bound exists in that case.
+    std::optional<MinCut> operator()(const BisectionGraphView &view,
+                                     const SourceSinkNodes &source_nodes,
+                                     const SourceSinkNodes &sink_nodes,
+                                     const FlowBound &bound) const;
+
     // validates the inpiut parameters to the flow algorithm (e.g. not intersecting)
     bool Validate(const BisectionGraphView &view,
                   const SourceSinkNodes &source_nodes,
@@ -53,6 +69,8 @@ class DinicMaxFlow
     //  \   /
     //    b
     // would assign s = 0, a,b = 1, t=2
+    // The BFS is level synchronous, large frontiers are relaxed in parallel. Since the levels are
+    // hop distances, the result does not depend on the order in which nodes are visited.
     LevelGraph ComputeLevelGraph(const BisectionGraphView &view,
                                  const std::vector<NodeID> &border_source_nodes,
                                  const SourceSinkNodes &source_nodes,
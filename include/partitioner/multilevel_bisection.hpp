@@ -0,0 +1,25 @@
+#ifndef OSRM_PARTITIONER_MULTILEVEL_BISECTION_HPP_
+#define OSRM_PARTITIONER_MULTILEVEL_BISECTION_HPP_
+
+#include "partitioner/bisection_graph_view.hpp"
+#include "partitioner/dinic_max_flow.hpp"
+
+#include <cstddef>
+
+namespace osrm::partitioner
+{
+
+// Alternative to the inertial flow cut. The graph is coarsened by repeatedly contracting a heavy
+// edge matching, the coarsest graph is bisected `num_initial_cuts` times by growing regions from
+// spatially extreme nodes and the best of these cuts is refined with Fiduccia-Mattheyses [1]
+// moves on every level while it is projected back to the input graph.
+// The result uses the same conventions as the inertial flow cut.
+//
+// [1] Fiduccia and Mattheyses, A Linear-Time Heuristic for Improving Network Partitions, 1982
+DinicMaxFlow::MinCut computeMultilevelCut(const BisectionGraphView &view,
+                                          const std::size_t num_initial_cuts,
+                                          const double balance);
+
+} // namespace osrm::partitioner
+
+#endif // OSRM_PARTITIONER_MULTILEVEL_BISECTION_HPP_
@@ -0,0 +1,32 @@
+#ifndef OSRM_PARTITIONER_PARTITION_REPORT_HPP
+#define OSRM_PARTITIONER_PARTITION_REPORT_HPP
+
+#include "partitioner/cell_storage.hpp"
+#include "partitioner/edge_based_graph.hpp"
+#include "partitioner/multi_level_partition.hpp"
+
+#include "util/json_container.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace osrm::partitioner
+{
+
+// Summarizes the quality of a partition to compare the results of different parameters:
+//  - per level the distributions of boundary nodes and clique arcs per cell and the size of the
+//    level in .osrm.cell_metrics, which is what customization has to compute,
+//  - the number of nodes a forward MLD search on the overlay settles for `num_queries` random
+//    queries, which is what queries have to pay. Clique weights are computed on demand for the
+//    cells these searches touch.
+// `num_metrics` is the number of metrics osrm-customize computes (one per exclude class).
+util::json::Object makePartitionReport(const MultiLevelPartition &partition,
+                                       const CellStorage &storage,
+                                       const DynamicEdgeBasedGraph &graph,
+                                       const std::size_t num_metrics,
+                                       const std::size_t num_queries,
+                                       const std::uint32_t seed = 42);
+
+} // namespace osrm::partitioner
+
+#endif
@@ -10,9 +10,16 @@ namespace osrm::partitioner
 
 struct PartitionerConfig final : storage::IOConfig
 {
+    // algorithm for the single bisections of the recursive bisection
+    enum class BisectionAlgorithm
+    {
+        InertialFlow,
+        Multilevel
+    };
+
     PartitionerConfig()
         : IOConfig({".osrm.fileIndex", ".osrm.ebg_nodes", ".osrm.enw"},
-                   {".osrm.hsgr", ".osrm.cnbg"},
+                   {".osrm.hsgr", ".osrm.cnbg", ".osrm.properties"},
                    {".osrm.ebg",
                     ".osrm.cnbg",
                     ".osrm.cnbg_to_ebg",
@@ -21,8 +28,9 @@ struct PartitionerConfig final : storage::IOConfig
                     ".osrm.cells",
                     ".osrm.maneuver_overrides"}),
           requested_num_threads(0), balance(1.2), boundary_factor(0.25), num_optimizing_cuts(10),
-          small_component_size(1000),
-          max_cell_sizes({128, 128 * 32, 128 * 32 * 16, 128 * 32 * 16 * 32})
+          small_component_size(1000), bisection_algorithm(BisectionAlgorithm::InertialFlow),
+          max_cell_sizes({128, 128 * 32, 128 * 32 * 16, 128 * 32 * 16 * 32}),
+          num_report_queries(1000)
     {
     }
 
@@ -37,7 +45,13 @@ struct PartitionerConfig final : storage::IOConfig
     double boundary_factor;
     std::size_t num_optimizing_cuts;
     std::size_t small_component_size;
+    BisectionAlgorithm bisection_algorithm;
     std::vector<std::size_t> max_cell_sizes;
+
+    // a JSON report about the quality of the partition is written to this file if it is set
+    std::filesystem::path report_path;
+    // number of random queries the report uses to estimate the query cost
+    std::size_t num_report_queries;
 };
 } // namespace osrm::partitioner
 
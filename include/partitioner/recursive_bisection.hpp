@@ -2,6 +2,7 @@
 #define OSRM_PARTITIONER_RECURSIVE_BISECTION_HPP_
 
 #include "partitioner/bisection_graph.hpp"
+#include "partitioner/partitioner_config.hpp"
 #include "partitioner/recursive_bisection_state.hpp"
 #include "util/typedefs.hpp"
 
@@ -19,7 +20,9 @@ class RecursiveBisection
                        const double balance,
                        const double boundary_factor,
                        const std::size_t num_optimizing_cuts,
-                       const std::size_t small_component_size);
+                       const std::size_t small_component_size,
+                       const PartitionerConfig::BisectionAlgorithm algorithm =
+                           PartitionerConfig::BisectionAlgorithm::InertialFlow);
 
     const std::vector<BisectionID> &BisectionIDs() const;
 
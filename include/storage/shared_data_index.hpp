@@ -5,6 +5,9 @@
 
 #include <boost/iterator/function_output_iterator.hpp>
 
+#include <algorithm>
+#include <memory>
+#include <set>
 #include <type_traits>
 #include <unordered_map>
 
@@ -19,7 +22,7 @@ class SharedDataIndex
     struct AllocatedRegion
     {
         void *memory_ptr;
-        std::unique_ptr<BaseDataLayout> layout;
+        std::shared_ptr<const BaseDataLayout> layout;
     };
 
     SharedDataIndex() = default;
@@ -35,12 +38,24 @@ class SharedDataIndex
         }
     }
 
+    // Returns a new index that shares all regions of this index and adds `region`.
+    // Blocks of the added region take precedence over blocks with the same name.
+    SharedDataIndex Overlay(AllocatedRegion region) const
+    {
+        auto overlay_regions = regions;
+        overlay_regions.push_back(std::move(region));
+        return SharedDataIndex{std::move(overlay_regions)};
+    }
+
     template <typename OutIter> void List(const std::string &name_prefix, OutIter out) const
     {
+        // Overlaid regions contain blocks with the same names
+        std::set<std::string> names;
         for (const auto &region : regions)
         {
-            region.layout->List(name_prefix, out);
+            region.layout->List(name_prefix, std::inserter(names, names.end()));
         }
+        std::copy(names.begin(), names.end(), out);
     }
 
     template <typename T> auto GetBlockPtr(const std::string &name) const
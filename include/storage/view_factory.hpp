@@ -72,8 +72,14 @@ inline auto make_name_table_view(const SharedDataIndex &index, const std::string
     auto values =
         make_vector_view<extractor::NameTableView::IndexedData::ValueType>(index, name + "/values");
 
+    auto symbols = make_vector_view<std::uint64_t>(index, name + "/symbol_table/symbols");
+    auto symbol_lengths =
+        make_vector_view<std::uint8_t>(index, name + "/symbol_table/symbol_lengths");
+
     extractor::NameTableView::IndexedData index_data_view{blocks, values};
-    return extractor::NameTableView{index_data_view};
+    extractor::NameTableView::SymbolTable symbol_table_view{std::move(symbols),
+                                                            std::move(symbol_lengths)};
+    return extractor::NameTableView{index_data_view, std::move(symbol_table_view)};
 }
 
 inline auto make_lane_data_view(const SharedDataIndex &index, const std::string &name)
@@ -123,7 +129,13 @@ inline auto make_segment_data_view(const SharedDataIndex &index, const std::stri
 
     auto node_list = make_vector_view<NodeID>(index, name + "/nodes");
 
-    auto num_entries = index.GetBlockEntries(name + "/nodes");
+    extractor::CompressedSegmentNodesView compressed_node_list(
+        make_vector_view<std::uint64_t>(index, name + "/compressed_nodes/block_offsets"),
+        make_vector_view<std::uint8_t>(index, name + "/compressed_nodes/data"));
+
+    // The node list is empty if it is stored compressed, the data sources always have one entry
+    // per node.
+    auto num_entries = index.GetBlockEntries(name + "/forward_data_sources");
 
     extractor::SegmentDataView::SegmentWeightVector fwd_weight_list(
         make_vector_view<extractor::SegmentDataView::SegmentWeightVector::block_type>(
@@ -158,7 +170,8 @@ inline auto make_segment_data_view(const SharedDataIndex &index, const std::stri
                                       fwd_duration_list,
                                       rev_duration_list,
                                       fwd_datasources_list,
-                                      rev_datasources_list};
+                                      rev_datasources_list,
+                                      compressed_node_list};
 }
 
 inline auto make_coordinates_view(const SharedDataIndex &index, const std::string &name)
@@ -191,9 +204,13 @@ inline auto make_turn_duration_view(const SharedDataIndex &index, const std::str
 inline auto make_search_tree_view(const SharedDataIndex &index, const std::string &name)
 {
     using RTreeLeaf = extractor::EdgeBasedNodeSegment;
-    using RTreeNode = util::StaticRTree<RTreeLeaf, storage::Ownership::View>::TreeNode;
+    using RTreeSearchTree = util::StaticRTree<RTreeLeaf, storage::Ownership::View>::SearchTree;
 
-    const auto search_tree = make_vector_view<RTreeNode>(index, name + "/search_tree");
+    RTreeSearchTree search_tree{
+        make_vector_view<std::int32_t>(index, name + "/search_tree/min_lons"),
+        make_vector_view<std::int32_t>(index, name + "/search_tree/max_lons"),
+        make_vector_view<std::int32_t>(index, name + "/search_tree/min_lats"),
+        make_vector_view<std::int32_t>(index, name + "/search_tree/max_lats")};
 
     const auto rtree_level_starts =
         make_vector_view<std::uint64_t>(index, name + "/search_tree_level_starts");
@@ -209,7 +226,7 @@ inline auto make_search_tree_view(const SharedDataIndex &index, const std::strin
     }
 
     return util::StaticRTree<RTreeLeaf, storage::Ownership::View>{
-        search_tree, rtree_level_starts, path, coordinates};
+        std::move(search_tree), rtree_level_starts, path, coordinates};
 }
 
 inline auto make_intersection_bearings_view(const SharedDataIndex &index, const std::string &name)
@@ -1,39 +1,125 @@
 #ifndef OSRM_UPDATER_CSV_FILE_PARSER_HPP
 #define OSRM_UPDATER_CSV_FILE_PARSER_HPP
 
+#include "updater/files.hpp"
 #include "updater/source.hpp"
 
 #include "util/exception.hpp"
 #include "util/exception_utils.hpp"
+#include "util/integer_range.hpp"
 #include "util/log.hpp"
 
+#include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
 #include <tbb/parallel_sort.h>
-#include <tbb/spin_mutex.h>
 
 #include <boost/exception/diagnostic_information.hpp>
+#include <boost/format.hpp>
 #include <boost/iostreams/device/mapped_file.hpp>
-#include <boost/phoenix.hpp>
-#include <boost/spirit/include/qi.hpp>
 
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
 #include <filesystem>
+#include <functional>
+#include <numeric>
 #include <vector>
 
 namespace osrm::updater
 {
 
+// Cursor over a single line of a CSV file. Every field parser either consumes a complete field
+// and returns true or leaves the cursor untouched and returns false.
+struct CSVLineParser
+{
+    const char *first;
+    const char *last;
+
+    bool AtEnd() const { return first == last; }
+
+    bool Separator()
+    {
+        if (first == last || *first != ',')
+            return false;
+        ++first;
+        return true;
+    }
+
+    bool UnsignedInteger(std::uint64_t &value)
+    {
+        const auto [ptr, error] = std::from_chars(first, last, value);
+        if (error != std::errc())
+            return false;
+        first = ptr;
+        return true;
+    }
+
+    // Real number without a sign
+    bool UnsignedReal(double &value)
+    {
+        if (first == last || *first == '-' || *first == '+')
+            return false;
+        return Number(first, value);
+    }
+
+    // Real number with an optional sign
+    bool Real(double &value)
+    {
+        // from_chars does not accept an explicit plus sign
+        if (first != last && *first == '+')
+        {
+            const char *number = first + 1;
+            if (number == last || *number == '-' || !Number(number, value))
+                return false;
+            first = number;
+            return true;
+        }
+        return Number(first, value);
+    }
+
+  private:
+    bool Number(const char *&begin, double &value) const
+    {
+#if defined(__cpp_lib_to_chars)
+        const auto [ptr, error] = std::from_chars(begin, last, value);
+        if (error != std::errc())
+            return false;
+        begin = ptr;
+        return true;
+#else
+        // Standard libraries without floating point from_chars: strtod needs a terminated string
+        char buffer[64];
+        const auto length = std::min<std::size_t>(last - begin, sizeof(buffer) - 1);
+        std::memcpy(buffer, begin, length);
+        buffer[length] = '\0';
+        char *end = nullptr;
+        const auto parsed = std::strtod(buffer, &end);
+        if (end == buffer || *buffer == ' ' || *buffer == '\t')
+            return false;
+        value = parsed;
+        begin += end - buffer;
+        return true;
+#endif
+    }
+};
+
 // Functor to parse a list of CSV files using "key,value,comment" grammar.
-// Key and Value structures must be a model of Random Access Sequence.
+// The key and value parsers consume the fields of their structure from a line.
+// Binary traffic files (see updater/files.hpp) are accepted in place of CSV files.
 // Also the Value structure must have source member that will be filled
 // with the corresponding file index in the CSV filenames vector.
 template <typename Key, typename Value> struct CSVFilesParser
 {
-    using Iterator = boost::iostreams::mapped_file_source::iterator;
-    using KeyRule = boost::spirit::qi::rule<Iterator, Key()>;
-    using ValueRule = boost::spirit::qi::rule<Iterator, Value()>;
+    using KeyParser = std::function<bool(CSVLineParser &, Key &)>;
+    using ValueParser = std::function<bool(CSVLineParser &, Value &)>;
+
+    // Files are split at line boundaries into chunks of about this size that are parsed in parallel
+    static constexpr std::size_t CHUNK_SIZE = 1024 * 1024;
 
-    CSVFilesParser(std::size_t start_index, const KeyRule &key_rule, const ValueRule &value_rule)
-        : start_index(start_index), key_rule(key_rule), value_rule(value_rule)
+    CSVFilesParser(std::size_t start_index, KeyParser key_parser, ValueParser value_parser)
+        : start_index(start_index), key_parser(std::move(key_parser)),
+          value_parser(std::move(value_parser))
     {
     }
 
@@ -42,32 +128,52 @@ template <typename Key, typename Value> struct CSVFilesParser
     {
         try
         {
-            tbb::spin_mutex mutex;
-            std::vector<std::pair<Key, Value>> lookup;
+            std::vector<std::vector<Chunk>> file_chunks(csv_filenames.size());
             tbb::parallel_for(std::size_t{0},
                               csv_filenames.size(),
+                              [&](const std::size_t idx) {
+                                  file_chunks[idx] =
+                                      ParseCSVFile(csv_filenames[idx], start_index + idx);
+                              });
+
+            // Move the values of all chunks into one flat vector
+            std::vector<Chunk *> chunks;
+            for (auto &file : file_chunks)
+            {
+                for (auto &chunk : file)
+                    chunks.push_back(&chunk);
+            }
+            std::vector<std::size_t> offsets(chunks.size() + 1, 0);
+            std::transform_inclusive_scan(chunks.begin(),
+                                          chunks.end(),
+                                          offsets.begin() + 1,
+                                          std::plus<>(),
+                                          [](const auto chunk) { return chunk->size(); });
+            std::vector<std::pair<Key, Value>> lookup(offsets.back());
+            tbb::parallel_for(std::size_t{0},
+                              chunks.size(),
                               [&](const std::size_t idx)
                               {
-                                  auto local = ParseCSVFile(csv_filenames[idx], start_index + idx);
-
-                                  { // Merge local CSV results into a flat global vector
-                                      tbb::spin_mutex::scoped_lock _{mutex};
-                                      lookup.insert(end(lookup),
-                                                    std::make_move_iterator(begin(local)),
-                                                    std::make_move_iterator(end(local)));
-                                  }
+                                  std::move(chunks[idx]->begin(),
+                                            chunks[idx]->end(),
+                                            lookup.begin() + offsets[idx]);
+                                  *chunks[idx] = {};
                               });
 
             // With flattened map-ish view of all the files, make a stable sort on key and source
             // and unique them on key to keep only the value with the largest file index
             // and the largest line number in a file.
             // The operands order is swapped to make descending ordering on (key, source)
-            tbb::parallel_sort(begin(lookup),
-                               end(lookup),
-                               [](const auto &lhs, const auto &rhs) {
-                                   return std::tie(rhs.first, rhs.second.source) <
-                                          std::tie(lhs.first, lhs.second.source);
-                               });
+            // A single binary file is already in this order.
+            const auto descending = [](const auto &lhs, const auto &rhs)
+            {
+                return std::tie(rhs.first, rhs.second.source) <
+                       std::tie(lhs.first, lhs.second.source);
+            };
+            if (!std::is_sorted(begin(lookup), end(lookup), descending))
+            {
+                tbb::parallel_sort(begin(lookup), end(lookup), descending);
+            }
 
             // Unique only on key to take the source precedence into account and remove duplicates.
             const auto it = std::unique(begin(lookup),
@@ -90,40 +196,140 @@ template <typename Key, typename Value> struct CSVFilesParser
     }
 
   private:
-    // Parse a single CSV file and return result as a vector<Key, Value>
-    auto ParseCSVFile(const std::string &filename, std::size_t file_id) const
+    using Chunk = std::vector<std::pair<Key, Value>>;
+
+    // Parses the lines in [first, last) and appends them to result. Returns the start of the first
+    // malformed line or last if all lines are valid.
+    const char *ParseLines(const char *first,
+                           const char *last,
+                           const std::uint8_t file_id,
+                           Chunk &result) const
+    {
+        while (first != last)
+        {
+            const auto end_of_line =
+                static_cast<const char *>(std::memchr(first, '\n', last - first));
+            const auto next_line = end_of_line ? end_of_line + 1 : last;
+            auto line_end = end_of_line ? end_of_line : last;
+            if (line_end != first && *(line_end - 1) == '\r')
+                --line_end;
+
+            // empty lines are skipped
+            if (line_end != first)
+            {
+                CSVLineParser line{first, line_end};
+                Key key;
+                Value value;
+                // The comment after the value is optional and can be anything
+                if (!key_parser(line, key) || !line.Separator() || !value_parser(line, value) ||
+                    !(line.AtEnd() || line.Separator()))
+                {
+                    return first;
+                }
+                value.source = file_id;
+                result.emplace_back(std::move(key), std::move(value));
+            }
+            first = next_line;
+        }
+        return last;
+    }
+
+    // Read the records of a binary file, they are converted without parsing
+    std::vector<Chunk> ReadBinaryFile(const std::string &filename, std::size_t file_id) const
     {
-        namespace qi = boost::spirit::qi;
+        using Record = decltype(toRecord(std::declval<Key>(), std::declval<Value>()));
 
-        std::vector<std::pair<Key, Value>> result;
+        boost::iostreams::mapped_file_source region;
+        const auto records = files::mmapTrafficFile<Record>(filename, region);
+
+        // The records are sorted ascending but the lookup descending
+        std::vector<Chunk> result(1);
+        auto &values = result.front();
+        values.resize(records.size());
+        tbb::parallel_for(tbb::blocked_range<std::size_t>(0, records.size()),
+                          [&](const tbb::blocked_range<std::size_t> &range)
+                          {
+                              for (auto index = range.begin(); index < range.end(); ++index)
+                              {
+                                  auto &value = values[records.size() - 1 - index];
+                                  value = fromRecord(records[index]);
+                                  value.second.source = file_id;
+                              }
+                          });
+
+        util::Log() << "Loaded " << filename << " with " << values.size() << " values";
+
+        return result;
+    }
+
+    // Parse a single CSV file and return the values of each chunk in the order of the lines
+    std::vector<Chunk> ParseCSVFile(const std::string &filename, std::size_t file_id) const
+    {
+        std::vector<Chunk> result;
         try
         {
             if (std::filesystem::file_size(filename) == 0)
                 return result;
 
+            if (files::isTrafficFile(filename))
+                return ReadBinaryFile(filename, file_id);
+
             boost::iostreams::mapped_file_source mmap(filename);
-            auto first = mmap.begin(), last = mmap.end();
+            const char *first = mmap.data();
+            const char *last = first + mmap.size();
+
+            // Split the file into chunks that end after a newline
+            std::vector<const char *> boundaries{first};
+            const auto number_of_chunks = std::max<std::size_t>(1, mmap.size() / CHUNK_SIZE);
+            for (std::size_t chunk = 1; chunk < number_of_chunks; ++chunk)
+            {
+                const auto split = std::max(first + chunk * mmap.size() / number_of_chunks,
+                                            boundaries.back());
+                const auto newline =
+                    static_cast<const char *>(std::memchr(split, '\n', last - split));
+                if (newline == nullptr)
+                    break;
+                boundaries.push_back(newline + 1);
+            }
+            boundaries.push_back(last);
 
             BOOST_ASSERT(file_id <= std::numeric_limits<std::uint8_t>::max());
-            ValueRule value_source =
-                value_rule[qi::_val = qi::_1, bind(&Value::source, qi::_val) = file_id];
-            qi::rule<Iterator, std::pair<Key, Value>()> csv_line =
-                (key_rule >> ',' >> value_source) >> -(',' >> *(qi::char_ - qi::eol));
-            const auto ok = qi::parse(first, last, -(csv_line % qi::eol) >> *qi::eol, result);
+            const auto chunks = boundaries.size() - 1;
+            result.resize(chunks);
+            std::vector<const char *> malformed(chunks);
+            tbb::parallel_for(tbb::blocked_range<std::size_t>(0, chunks, 1),
+                              [&](const tbb::blocked_range<std::size_t> &range)
+                              {
+                                  for (auto chunk = range.begin(); chunk < range.end(); ++chunk)
+                                  {
+                                      malformed[chunk] =
+                                          ParseLines(boundaries[chunk],
+                                                     boundaries[chunk + 1],
+                                                     static_cast<std::uint8_t>(file_id),
+                                                     result[chunk]);
+                                  }
+                              });
 
-            if (!ok || first != last)
+            for (const auto chunk : util::irange<std::size_t>(0, chunks))
             {
-                auto begin_of_line = first - 1;
-                while (begin_of_line >= mmap.begin() && *begin_of_line != '\n')
-                    --begin_of_line;
-                auto line_number = std::count(mmap.begin(), first, '\n') + 1;
-                const auto message = boost::format("CSV file %1% malformed on line %2%:\n %3%\n") %
-                                     filename % std::to_string(line_number) %
-                                     std::string(begin_of_line + 1, std::find(first, last, '\n'));
-                throw util::exception(message.str() + SOURCE_REF);
+                const auto line = malformed[chunk];
+                if (line != boundaries[chunk + 1])
+                {
+                    const auto line_number = std::count(first, line, '\n') + 1;
+                    const auto message =
+                        boost::format("CSV file %1% malformed on line %2%:\n %3%\n") % filename %
+                        std::to_string(line_number) %
+                        std::string(line, std::find(line, last, '\n'));
+                    throw util::exception(message.str() + SOURCE_REF);
+                }
             }
 
-            util::Log() << "Loaded " << filename << " with " << result.size() << "values";
+            const auto values = std::accumulate(result.begin(),
+                                                result.end(),
+                                                std::size_t{0},
+                                                [](const auto sum, const auto &chunk)
+                                                { return sum + chunk.size(); });
+            util::Log() << "Loaded " << filename << " with " << values << " values";
 
             return result;
         }
@@ -136,8 +342,8 @@ template <typename Key, typename Value> struct CSVFilesParser
     }
 
     const std::size_t start_index;
-    const KeyRule key_rule;
-    const ValueRule value_rule;
+    const KeyParser key_parser;
+    const ValueParser value_parser;
 };
 } // namespace osrm::updater
 
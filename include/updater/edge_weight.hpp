@@ -0,0 +1,61 @@
+#ifndef OSRM_UPDATER_EDGE_WEIGHT_HPP
+#define OSRM_UPDATER_EDGE_WEIGHT_HPP
+
+#include "util/typedefs.hpp"
+
+#include <tuple>
+
+namespace osrm::updater
+{
+
+// Sums the segment weights and durations of an edge-based node. The node weight is invalid if
+// one of its segments is blocked.
+template <typename WeightsT, typename DurationsT>
+inline std::tuple<EdgeWeight, EdgeDuration> sumSegments(const WeightsT &weights,
+                                                        const DurationsT &durations)
+{
+    EdgeWeight weight = {0};
+    for (const SegmentWeight segment_weight : weights)
+    {
+        if (segment_weight == INVALID_SEGMENT_WEIGHT)
+        {
+            weight = INVALID_EDGE_WEIGHT;
+            break;
+        }
+        weight += alias_cast<EdgeWeight>(segment_weight);
+    }
+    EdgeDuration duration = {0};
+    for (const SegmentDuration segment_duration : durations)
+    {
+        duration += alias_cast<EdgeDuration>(segment_duration);
+    }
+    return std::make_tuple(weight, duration);
+}
+
+// Computes the weight of an edge-based edge from the weight of its source node and the turn
+// penalty. The edge weight has to be at least `weight_min_value`, the number of nodes of the
+// source geometry: a too negative turn penalty is raised in place, otherwise the node weight is.
+inline EdgeWeight computeEdgeWeight(const EdgeWeight node_weight,
+                                    TurnPenalty &turn_weight_penalty,
+                                    const EdgeWeight weight_min_value)
+{
+    if (node_weight == INVALID_EDGE_WEIGHT)
+        return INVALID_EDGE_WEIGHT;
+
+    auto weight = node_weight;
+    if (alias_cast<EdgeWeight>(turn_weight_penalty) + node_weight < weight_min_value)
+    {
+        if (turn_weight_penalty < TurnPenalty{0})
+        {
+            turn_weight_penalty = alias_cast<TurnPenalty>(weight_min_value - node_weight);
+        }
+        else
+        {
+            weight = weight_min_value;
+        }
+    }
+    return weight + alias_cast<EdgeWeight>(turn_weight_penalty);
+}
+} // namespace osrm::updater
+
+#endif
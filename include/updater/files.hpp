@@ -0,0 +1,74 @@
+#ifndef OSRM_UPDATER_FILES_HPP
+#define OSRM_UPDATER_FILES_HPP
+
+#include "updater/source.hpp"
+
+#include "storage/serialization.hpp"
+#include "storage/tar.hpp"
+
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/mmap_tar.hpp"
+#include "util/vector_view.hpp"
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace osrm::updater::files
+{
+
+// Returns true if the file is a binary traffic file and not a CSV file. The binary files are tar
+// files that start with the fingerprint, which is no valid CSV line.
+inline bool isTrafficFile(const std::filesystem::path &path)
+{
+    constexpr std::string_view fingerprint_name = "osrm_fingerprint.meta";
+    char name[fingerprint_name.size() + 1] = {};
+    std::ifstream in(path, std::ios::binary);
+    in.read(name, sizeof(name));
+    return in && std::string_view(name, fingerprint_name.size()) == fingerprint_name &&
+           name[fingerprint_name.size()] == '\0';
+}
+
+// writes a binary segment speed or turn penalty file, the records need to be sorted by key
+template <typename RecordT>
+inline void writeTrafficFile(const std::filesystem::path &path, const std::vector<RecordT> &records)
+{
+    static_assert(std::is_same<SegmentSpeedRecord, RecordT>::value ||
+                      std::is_same<TurnPenaltyRecord, RecordT>::value,
+                  "");
+
+    const auto fingerprint = storage::tar::FileWriter::GenerateFingerprint;
+    storage::tar::FileWriter writer{path, fingerprint};
+
+    storage::serialization::write(writer, RecordT::NAME, records);
+}
+
+// maps the records of a binary segment speed or turn penalty file into memory
+template <typename RecordT>
+inline util::vector_view<const RecordT> mmapTrafficFile(const std::filesystem::path &path,
+                                                       boost::iostreams::mapped_file_source &region)
+{
+    static_assert(std::is_same<SegmentSpeedRecord, RecordT>::value ||
+                      std::is_same<TurnPenaltyRecord, RecordT>::value,
+                  "");
+
+    auto map = util::mmapTarFile(path, region);
+    const auto entry = map.find(RecordT::NAME);
+    if (entry == map.end() ||
+        (entry->second.second - entry->second.first) % sizeof(RecordT) != 0)
+    {
+        throw util::exception(path.string() + " contains no " + RecordT::NAME + SOURCE_REF);
+    }
+
+    const auto [begin, end] = entry->second;
+    return util::vector_view<const RecordT>(reinterpret_cast<const RecordT *>(begin),
+                                            (end - begin) / sizeof(RecordT));
+}
+} // namespace osrm::updater::files
+
+#endif
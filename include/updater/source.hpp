@@ -3,6 +3,8 @@
 
 #include "util/typedefs.hpp"
 
+#include <algorithm>
+#include <limits>
 #include <optional>
 #include <tuple>
 #include <vector>
@@ -85,6 +87,71 @@ struct PenaltySource final
     std::uint8_t source;
 };
 
+// Fixed width records of the binary traffic files, see updater/files.hpp.
+// The records of a file are sorted ascending by their key.
+struct SegmentSpeedRecord final
+{
+    static constexpr auto NAME = "/updater/segment_speeds";
+
+    std::uint64_t from;
+    std::uint64_t to;
+    double speed;
+    // only used if has_rate is set, NaN keeps the existing weight
+    double rate;
+    std::uint8_t has_rate;
+};
+
+struct TurnPenaltyRecord final
+{
+    static constexpr auto NAME = "/updater/turn_penalties";
+
+    std::uint64_t from;
+    std::uint64_t via;
+    std::uint64_t to;
+    double duration;
+    // NaN if the weight is not set
+    double weight;
+};
+
+inline SegmentSpeedRecord toRecord(const Segment &segment, const SpeedSource &source)
+{
+    SegmentSpeedRecord record{};
+    record.from = segment.from;
+    record.to = segment.to;
+    record.speed = source.speed;
+    record.rate = source.rate.value_or(std::numeric_limits<double>::quiet_NaN());
+    record.has_rate = source.rate.has_value();
+    return record;
+}
+
+inline std::pair<Segment, SpeedSource> fromRecord(const SegmentSpeedRecord &record)
+{
+    SpeedSource source;
+    source.speed = record.speed;
+    if (record.has_rate)
+        source.rate = record.rate;
+    return {Segment{record.from, record.to}, source};
+}
+
+inline TurnPenaltyRecord toRecord(const Turn &turn, const PenaltySource &source)
+{
+    TurnPenaltyRecord record{};
+    record.from = turn.from;
+    record.via = turn.via;
+    record.to = turn.to;
+    record.duration = source.duration;
+    record.weight = source.weight;
+    return record;
+}
+
+inline std::pair<Turn, PenaltySource> fromRecord(const TurnPenaltyRecord &record)
+{
+    PenaltySource source;
+    source.duration = record.duration;
+    source.weight = record.weight;
+    return {Turn{record.from, record.via, record.to}, source};
+}
+
 using SegmentLookupTable = LookupTable<Segment, SpeedSource>;
 using TurnLookupTable = LookupTable<Turn, PenaltySource>;
 } // namespace osrm::updater
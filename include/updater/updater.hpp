@@ -31,6 +31,14 @@ class Updater
         std::vector<EdgeDistance> &node_distances, // TODO: remove when optional
         std::uint32_t &connectivity_checksum) const;
 
+    // Also returns the sorted edge-based nodes whose outgoing edges got new weights
+    EdgeID LoadAndUpdateEdgeExpandedGraph(
+        std::vector<extractor::EdgeBasedEdge> &edge_based_edge_list,
+        std::vector<EdgeWeight> &node_weights,
+        std::vector<EdgeDuration> &node_durations, // TODO: remove when optional
+        std::vector<NodeID> &updated_nodes,
+        std::uint32_t &connectivity_checksum) const;
+
   private:
     UpdaterConfig config;
 };
@@ -0,0 +1,218 @@
+#ifndef OSRM_UTIL_BOUNDING_BOX_KERNELS_HPP
+#define OSRM_UTIL_BOUNDING_BOX_KERNELS_HPP
+
+#include "util/coordinate.hpp"
+#include "util/rectangle.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+// Tests of one point or rectangle against many bounding boxes at once.
+//
+// The boxes are given as structure of arrays, each array holds `count` fixed point coordinates.
+// With AVX2 or NEON enabled at compile time eight or four boxes are tested per instruction,
+// otherwise the scalar loops are used. All variants give the same results as
+// RectangleInt2D::GetMinSquaredDist and RectangleInt2D::Intersects.
+namespace osrm::util::bounding_box_kernels
+{
+
+namespace detail
+{
+inline void minSquaredDistancesScalar(const std::int32_t *min_lons,
+                                      const std::int32_t *max_lons,
+                                      const std::int32_t *min_lats,
+                                      const std::int32_t *max_lats,
+                                      const std::size_t count,
+                                      const std::int32_t lon,
+                                      const std::int32_t lat,
+                                      std::uint64_t *distances)
+{
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        // The distance on each axis is zero if the coordinate lies inside the box on that axis
+        const std::int64_t d_lon =
+            std::max(std::max(min_lons[index] - lon, lon - max_lons[index]), 0);
+        const std::int64_t d_lat =
+            std::max(std::max(min_lats[index] - lat, lat - max_lats[index]), 0);
+        distances[index] = static_cast<std::uint64_t>(d_lon * d_lon + d_lat * d_lat);
+    }
+}
+
+inline std::uint64_t intersectingBoxesScalar(const std::int32_t *min_lons,
+                                             const std::int32_t *max_lons,
+                                             const std::int32_t *min_lats,
+                                             const std::int32_t *max_lats,
+                                             const std::size_t count,
+                                             const RectangleInt2D &box)
+{
+    const auto box_min_lon = static_cast<std::int32_t>(box.min_lon);
+    const auto box_max_lon = static_cast<std::int32_t>(box.max_lon);
+    const auto box_min_lat = static_cast<std::int32_t>(box.min_lat);
+    const auto box_max_lat = static_cast<std::int32_t>(box.max_lat);
+
+    std::uint64_t mask = 0;
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        const bool intersects = !(max_lons[index] < box_min_lon || min_lons[index] > box_max_lon ||
+                                  max_lats[index] < box_min_lat || min_lats[index] > box_max_lat);
+        mask |= static_cast<std::uint64_t>(intersects) << index;
+    }
+    return mask;
+}
+} // namespace detail
+
+// Writes the squared euclidean distance from `location` to each box into `distances`.
+// This assumes projected coordinates, see RectangleInt2D::GetMinSquaredDist.
+inline void minSquaredDistances(const std::int32_t *min_lons,
+                                const std::int32_t *max_lons,
+                                const std::int32_t *min_lats,
+                                const std::int32_t *max_lats,
+                                const std::size_t count,
+                                const Coordinate location,
+                                std::uint64_t *distances)
+{
+    const auto lon = static_cast<std::int32_t>(location.lon);
+    const auto lat = static_cast<std::int32_t>(location.lat);
+    std::size_t index = 0;
+
+#if defined(__AVX2__)
+    const auto lons = _mm256_set1_epi32(lon);
+    const auto lats = _mm256_set1_epi32(lat);
+    const auto zero = _mm256_setzero_si256();
+    for (; index + 8 <= count; index += 8)
+    {
+        const auto load = [index](const std::int32_t *values)
+        { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + index)); };
+
+        const auto d_lon = _mm256_max_epi32(
+            _mm256_max_epi32(_mm256_sub_epi32(load(min_lons), lons),
+                             _mm256_sub_epi32(lons, load(max_lons))),
+            zero);
+        const auto d_lat = _mm256_max_epi32(
+            _mm256_max_epi32(_mm256_sub_epi32(load(min_lats), lats),
+                             _mm256_sub_epi32(lats, load(max_lats))),
+            zero);
+
+        // _mm256_mul_epu32 multiplies the even 32 bit lanes into 64 bit results,
+        // the differences are non-negative so the unsigned multiplication is exact.
+        const auto even = _mm256_add_epi64(_mm256_mul_epu32(d_lon, d_lon),
+                                           _mm256_mul_epu32(d_lat, d_lat));
+        const auto d_lon_odd = _mm256_srli_epi64(d_lon, 32);
+        const auto d_lat_odd = _mm256_srli_epi64(d_lat, 32);
+        const auto odd = _mm256_add_epi64(_mm256_mul_epu32(d_lon_odd, d_lon_odd),
+                                          _mm256_mul_epu32(d_lat_odd, d_lat_odd));
+
+        // even holds the boxes 0 2 | 4 6 and odd 1 3 | 5 7, restore the order 0 1 2 3 | 4 5 6 7
+        const auto low = _mm256_unpacklo_epi64(even, odd);
+        const auto high = _mm256_unpackhi_epi64(even, odd);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(distances + index),
+                            _mm256_permute2x128_si256(low, high, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(distances + index + 4),
+                            _mm256_permute2x128_si256(low, high, 0x31));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const auto lons = vdupq_n_s32(lon);
+    const auto lats = vdupq_n_s32(lat);
+    const auto zero = vdupq_n_s32(0);
+    for (; index + 4 <= count; index += 4)
+    {
+        const auto d_lon = vmaxq_s32(vmaxq_s32(vsubq_s32(vld1q_s32(min_lons + index), lons),
+                                               vsubq_s32(lons, vld1q_s32(max_lons + index))),
+                                     zero);
+        const auto d_lat = vmaxq_s32(vmaxq_s32(vsubq_s32(vld1q_s32(min_lats + index), lats),
+                                               vsubq_s32(lats, vld1q_s32(max_lats + index))),
+                                     zero);
+
+        const auto low = vmlal_s32(vmull_s32(vget_low_s32(d_lon), vget_low_s32(d_lon)),
+                                   vget_low_s32(d_lat),
+                                   vget_low_s32(d_lat));
+        const auto high = vmlal_high_s32(vmull_high_s32(d_lon, d_lon), d_lat, d_lat);
+        vst1q_u64(distances + index, vreinterpretq_u64_s64(low));
+        vst1q_u64(distances + index + 2, vreinterpretq_u64_s64(high));
+    }
+#endif
+
+    detail::minSquaredDistancesScalar(min_lons + index,
+                                      max_lons + index,
+                                      min_lats + index,
+                                      max_lats + index,
+                                      count - index,
+                                      lon,
+                                      lat,
+                                      distances + index);
+}
+
+// Returns a bit mask with bit i set if box i intersects `box`, at most 64 boxes can be tested.
+inline std::uint64_t intersectingBoxes(const std::int32_t *min_lons,
+                                       const std::int32_t *max_lons,
+                                       const std::int32_t *min_lats,
+                                       const std::int32_t *max_lats,
+                                       const std::size_t count,
+                                       const RectangleInt2D &box)
+{
+    BOOST_ASSERT(count <= 64);
+    std::uint64_t mask = 0;
+    std::size_t index = 0;
+
+#if defined(__AVX2__)
+    const auto box_min_lon = _mm256_set1_epi32(static_cast<std::int32_t>(box.min_lon));
+    const auto box_max_lon = _mm256_set1_epi32(static_cast<std::int32_t>(box.max_lon));
+    const auto box_min_lat = _mm256_set1_epi32(static_cast<std::int32_t>(box.min_lat));
+    const auto box_max_lat = _mm256_set1_epi32(static_cast<std::int32_t>(box.max_lat));
+    for (; index + 8 <= count; index += 8)
+    {
+        const auto load = [index](const std::int32_t *values)
+        { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + index)); };
+
+        const auto disjoint =
+            _mm256_or_si256(_mm256_or_si256(_mm256_cmpgt_epi32(box_min_lon, load(max_lons)),
+                                            _mm256_cmpgt_epi32(load(min_lons), box_max_lon)),
+                            _mm256_or_si256(_mm256_cmpgt_epi32(box_min_lat, load(max_lats)),
+                                            _mm256_cmpgt_epi32(load(min_lats), box_max_lat)));
+        const auto disjoint_bits =
+            static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(disjoint)));
+        mask |= static_cast<std::uint64_t>(~disjoint_bits & 0xff) << index;
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const auto box_min_lon = vdupq_n_s32(static_cast<std::int32_t>(box.min_lon));
+    const auto box_max_lon = vdupq_n_s32(static_cast<std::int32_t>(box.max_lon));
+    const auto box_min_lat = vdupq_n_s32(static_cast<std::int32_t>(box.min_lat));
+    const auto box_max_lat = vdupq_n_s32(static_cast<std::int32_t>(box.max_lat));
+    const std::uint32_t lane_bits[4] = {1, 2, 4, 8};
+    const auto bits = vld1q_u32(lane_bits);
+    for (; index + 4 <= count; index += 4)
+    {
+        const auto disjoint =
+            vorrq_u32(vorrq_u32(vcltq_s32(vld1q_s32(max_lons + index), box_min_lon),
+                                vcgtq_s32(vld1q_s32(min_lons + index), box_max_lon)),
+                      vorrq_u32(vcltq_s32(vld1q_s32(max_lats + index), box_min_lat),
+                                vcgtq_s32(vld1q_s32(min_lats + index), box_max_lat)));
+        const auto intersect_bits = vaddvq_u32(vbicq_u32(bits, disjoint));
+        mask |= static_cast<std::uint64_t>(intersect_bits) << index;
+    }
+#endif
+
+    if (index < count)
+    {
+        mask |= detail::intersectingBoxesScalar(min_lons + index,
+                                                max_lons + index,
+                                                min_lats + index,
+                                                max_lats + index,
+                                                count - index,
+                                                box)
+                << index;
+    }
+    return mask;
+}
+} // namespace osrm::util::bounding_box_kernels
+
+#endif
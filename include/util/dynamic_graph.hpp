@@ -10,11 +10,15 @@
 
 #include <boost/assert.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <cstdint>
 
 #include <algorithm>
 #include <atomic>
 #include <limits>
+#include <numeric>
 #include <tuple>
 #include <vector>
 
@@ -319,6 +323,90 @@ template <typename EdgeDataT> class DynamicGraph
         return EdgeIterator(node.first_edge + node.edges);
     }
 
+    // adds edges sorted by their source node, the edges of different source nodes are written in
+    // parallel. Invalidates edge iterators for all source nodes
+    template <typename EdgeContainerT> void InsertEdges(const EdgeContainerT &edges)
+    {
+        std::vector<std::size_t> first_source_edge;
+        for (const auto index : irange<std::size_t>(0, edges.size()))
+        {
+            BOOST_ASSERT(index == 0 || edges[index - 1].source <= edges[index].source);
+            if (index == 0 || edges[index - 1].source != edges[index].source)
+            {
+                first_source_edge.push_back(index);
+            }
+        }
+        first_source_edge.push_back(edges.size());
+        const auto number_of_sources = first_source_edge.size() - 1;
+
+        // Nodes without enough free space after their edges are moved to the end of the edge list.
+        // The free space after the edges of a node can only be used by this node, if the node has
+        // no edges it might be the space of a different node.
+        std::vector<EdgeIterator> moved_offsets(number_of_sources + 1, 0);
+        tbb::parallel_for(
+            tbb::blocked_range<std::size_t>(0, number_of_sources),
+            [&](const auto &range)
+            {
+                for (auto source_index = range.begin(); source_index < range.end(); ++source_index)
+                {
+                    const auto &node = node_array[edges[first_source_edge[source_index]].source];
+                    const auto number_of_new_edges = first_source_edge[source_index + 1] -
+                                                     first_source_edge[source_index];
+                    bool fits = node.edges > 0;
+                    for (std::size_t offset = 0; fits && offset < number_of_new_edges; ++offset)
+                    {
+                        const std::size_t edge = node.first_edge + node.edges + offset;
+                        fits = edge < edge_list.size() && isDummy(edge);
+                    }
+                    moved_offsets[source_index + 1] =
+                        fits ? 0 : (node.edges + number_of_new_edges) * 1.1 + 2;
+                }
+            });
+        std::partial_sum(moved_offsets.begin(), moved_offsets.end(), moved_offsets.begin());
+
+        const EdgeIterator first_moved_edge = edge_list.size();
+        edge_list.resize(edge_list.size() + moved_offsets.back());
+
+        tbb::parallel_for(
+            tbb::blocked_range<std::size_t>(0, number_of_sources),
+            [&](const auto &range)
+            {
+                for (auto source_index = range.begin(); source_index < range.end(); ++source_index)
+                {
+                    const auto begin = first_source_edge[source_index];
+                    const auto end = first_source_edge[source_index + 1];
+                    Node &node = node_array[edges[begin].source];
+
+                    const auto moved_size =
+                        moved_offsets[source_index + 1] - moved_offsets[source_index];
+                    if (moved_size > 0)
+                    {
+                        const EdgeIterator new_first_edge =
+                            first_moved_edge + moved_offsets[source_index];
+                        for (const auto i : irange(0u, node.edges))
+                        {
+                            edge_list[new_first_edge + i] = edge_list[node.first_edge + i];
+                            makeDummy(node.first_edge + i);
+                        }
+                        for (const auto i : irange<EdgeIterator>(node.edges + (end - begin),
+                                                                 moved_size))
+                        {
+                            makeDummy(new_first_edge + i);
+                        }
+                        node.first_edge = new_first_edge;
+                    }
+
+                    for (const auto index : irange(begin, end))
+                    {
+                        Edge &edge = edge_list[node.first_edge + node.edges++];
+                        edge.target = edges[index].target;
+                        edge.data = edges[index].data;
+                    }
+                }
+            });
+        number_of_edges += edges.size();
+    }
+
     // removes an edge. Invalidates edge iterators for the source node
     void DeleteEdge(const NodeIterator source, const EdgeIterator e)
     {
@@ -7,9 +7,10 @@
 namespace osrm::util
 {
 
+template <typename NodeDataT>
 inline std::vector<std::vector<bool>>
 excludeFlagsToNodeFilter(const NodeID number_of_nodes,
-                         const extractor::EdgeBasedNodeDataContainer &node_data,
+                         const NodeDataT &node_data,
                          const extractor::ProfileProperties &properties)
 {
     std::vector<std::vector<bool>> filters;
@@ -0,0 +1,184 @@
+#ifndef OSRM_UTIL_EXTERNAL_VECTOR_HPP
+#define OSRM_UTIL_EXTERNAL_VECTOR_HPP
+
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/integer_range.hpp"
+#include "util/mmap_file.hpp"
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <queue>
+#include <random>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace osrm::util
+{
+
+// Append-only sequence of trivially copyable records that are sorted and then visited in order.
+//
+// Without a memory budget this is a plain std::vector. With a budget all records beyond it are
+// spilled to chunk files in `spill_directory`: sorting sorts every chunk in place through a memory
+// mapping (the runs of an external merge sort) and merges the runs with a k-way merge into new
+// chunks, visiting maps one chunk at a time. Only one chunk worth of records is kept on the heap.
+template <typename T> class ExternalVector
+{
+    static_assert(std::is_trivially_copyable_v<T>, "records are written to disk as raw bytes");
+
+  public:
+    ExternalVector() = default;
+
+    // A `memory_budget` of 0 keeps all records in memory
+    ExternalVector(std::filesystem::path spill_directory_, const std::size_t memory_budget)
+        : spill_directory(std::move(spill_directory_)),
+          chunk_size(memory_budget == 0 ? 0 : std::max<std::size_t>(1, memory_budget / sizeof(T)))
+    {
+    }
+
+    ExternalVector(const ExternalVector &) = delete;
+    ExternalVector &operator=(const ExternalVector &) = delete;
+
+    ~ExternalVector() { RemoveChunks(); }
+
+    void push_back(const T &value)
+    {
+        buffer.push_back(value);
+        if (chunk_size != 0 && buffer.size() >= chunk_size)
+            Spill();
+    }
+
+    std::size_t size() const { return num_spilled + buffer.size(); }
+    bool empty() const { return size() == 0; }
+
+    // Returns true if records have been written to disk
+    bool spilled() const { return !chunks.empty(); }
+
+    void clear()
+    {
+        RemoveChunks();
+        buffer.clear();
+        buffer.shrink_to_fit();
+    }
+
+    template <typename Compare> void sort(const Compare &compare)
+    {
+        if (chunks.empty())
+        {
+            tbb::parallel_sort(buffer.begin(), buffer.end(), compare);
+            return;
+        }
+
+        if (!buffer.empty())
+            Spill();
+
+        // run generation: every chunk is sorted in place
+        for (const auto &chunk : chunks)
+        {
+            boost::iostreams::mapped_file region;
+            auto records = util::mmapFile<T>(chunk, region);
+            tbb::parallel_sort(records.begin(), records.end(), compare);
+        }
+
+        auto runs = std::move(chunks);
+        chunks.clear();
+        num_spilled = 0;
+
+        // k-way merge of the runs into new chunks
+        {
+            struct Cursor
+            {
+                const T *current;
+                const T *end;
+            };
+            const auto greater = [&compare](const Cursor &lhs, const Cursor &rhs)
+            { return compare(*rhs.current, *lhs.current); };
+            std::priority_queue<Cursor, std::vector<Cursor>, decltype(greater)> queue(greater);
+
+            std::vector<boost::iostreams::mapped_file_source> regions(runs.size());
+            for (const auto index : util::irange<std::size_t>(0, runs.size()))
+            {
+                const auto records = util::mmapFile<T>(runs[index], regions[index]);
+                if (!records.empty())
+                    queue.push({records.data(), records.data() + records.size()});
+            }
+
+            while (!queue.empty())
+            {
+                auto cursor = queue.top();
+                queue.pop();
+                push_back(*cursor.current);
+                if (++cursor.current != cursor.end)
+                    queue.push(cursor);
+            }
+        }
+
+        for (const auto &run : runs)
+        {
+            std::error_code error;
+            std::filesystem::remove(run, error);
+        }
+    }
+
+    // Calls `callback` with a mutable reference to every record in order, changes are kept
+    template <typename Callback> void for_each(Callback &&callback)
+    {
+        for (const auto &chunk : chunks)
+        {
+            boost::iostreams::mapped_file region;
+            for (auto &record : util::mmapFile<T>(chunk, region))
+                callback(record);
+        }
+        for (auto &record : buffer)
+            callback(record);
+    }
+
+  private:
+    void Spill()
+    {
+        if (spill_prefix.empty())
+            spill_prefix = "osrm-spill-" + std::to_string(std::random_device{}()) + "-";
+
+        auto path = spill_directory / (spill_prefix + std::to_string(next_chunk++));
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char *>(buffer.data()), buffer.size() * sizeof(T));
+        if (!out)
+        {
+            throw util::exception("Writing " + path.string() + " failed" + SOURCE_REF);
+        }
+        num_spilled += buffer.size();
+        chunks.push_back(std::move(path));
+        buffer.clear();
+    }
+
+    void RemoveChunks()
+    {
+        for (const auto &chunk : chunks)
+        {
+            std::error_code error;
+            std::filesystem::remove(chunk, error);
+        }
+        chunks.clear();
+        num_spilled = 0;
+    }
+
+    std::filesystem::path spill_directory;
+    std::string spill_prefix;
+    std::size_t chunk_size = 0;
+    std::size_t next_chunk = 0;
+    std::size_t num_spilled = 0;
+    std::vector<std::filesystem::path> chunks;
+    std::vector<T> buffer;
+};
+
+} // namespace osrm::util
+
+#endif // OSRM_UTIL_EXTERNAL_VECTOR_HPP
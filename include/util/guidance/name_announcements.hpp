@@ -220,17 +220,19 @@ inline bool requiresNameAnnounced(const NameID from_name_id,
     if (from_name_id == to_name_id)
         return false;
     else
-        return requiresNameAnnounced(name_table.GetNameForID(from_name_id),
-                                     name_table.GetRefForID(from_name_id),
-                                     name_table.GetPronunciationForID(from_name_id),
-                                     name_table.GetExitsForID(from_name_id),
-                                     //
-                                     name_table.GetNameForID(to_name_id),
-                                     name_table.GetRefForID(to_name_id),
-                                     name_table.GetPronunciationForID(to_name_id),
-                                     name_table.GetExitsForID(to_name_id),
-                                     //
-                                     suffix_table);
+        // The names may be decoded on lookup, they live until the end of the call
+        return requiresNameAnnounced(
+            std::string_view(name_table.GetNameForID(from_name_id)),
+            std::string_view(name_table.GetRefForID(from_name_id)),
+            std::string_view(name_table.GetPronunciationForID(from_name_id)),
+            std::string_view(name_table.GetExitsForID(from_name_id)),
+            //
+            std::string_view(name_table.GetNameForID(to_name_id)),
+            std::string_view(name_table.GetRefForID(to_name_id)),
+            std::string_view(name_table.GetPronunciationForID(to_name_id)),
+            std::string_view(name_table.GetExitsForID(to_name_id)),
+            //
+            suffix_table);
 }
 
 } // namespace osrm::util::guidance
@@ -276,6 +276,14 @@ template <typename GroupBlockPolicy, storage::Ownership Ownership> struct Indexe
 
     bool empty() const { return blocks.empty(); }
 
+    // Number of addressable values, the last block may hold fewer values
+    std::size_t capacity() const { return blocks.size() * (BLOCK_SIZE + 1); }
+
+    std::size_t GetSizeInBytes() const
+    {
+        return blocks.size() * sizeof(BlockReference) + values.size() * sizeof(ValueType);
+    }
+
     template <typename OffsetIterator, typename DataIterator>
     IndexedDataImpl(OffsetIterator first, OffsetIterator last, DataIterator data)
     {
@@ -7,6 +7,7 @@
 #include "util/range_table.hpp"
 #include "util/static_graph.hpp"
 #include "util/static_rtree.hpp"
+#include "util/string_symbol_table.hpp"
 
 #include "storage/io.hpp"
 #include "storage/serialization.hpp"
@@ -114,6 +115,24 @@ inline void write(storage::tar::FileWriter &writer,
     storage::serialization::write(writer, name + "/values", index_data.values);
 }
 
+template <storage::Ownership Ownership>
+inline void read(storage::tar::FileReader &reader,
+                 const std::string &name,
+                 detail::StringSymbolTableImpl<Ownership> &symbol_table)
+{
+    storage::serialization::read(reader, name + "/symbols", symbol_table.symbols);
+    storage::serialization::read(reader, name + "/symbol_lengths", symbol_table.symbol_lengths);
+}
+
+template <storage::Ownership Ownership>
+inline void write(storage::tar::FileWriter &writer,
+                  const std::string &name,
+                  const detail::StringSymbolTableImpl<Ownership> &symbol_table)
+{
+    storage::serialization::write(writer, name + "/symbols", symbol_table.symbols);
+    storage::serialization::write(writer, name + "/symbol_lengths", symbol_table.symbol_lengths);
+}
+
 template <class EdgeDataT,
           storage::Ownership Ownership,
           std::uint32_t BRANCHING_FACTOR,
@@ -122,7 +141,14 @@ void read(storage::tar::FileReader &reader,
           const std::string &name,
           util::StaticRTree<EdgeDataT, Ownership, BRANCHING_FACTOR, LEAF_PAGE_SIZE> &rtree)
 {
-    storage::serialization::read(reader, name + "/search_tree", rtree.m_search_tree);
+    storage::serialization::read(
+        reader, name + "/search_tree/min_lons", rtree.m_search_tree.min_lons);
+    storage::serialization::read(
+        reader, name + "/search_tree/max_lons", rtree.m_search_tree.max_lons);
+    storage::serialization::read(
+        reader, name + "/search_tree/min_lats", rtree.m_search_tree.min_lats);
+    storage::serialization::read(
+        reader, name + "/search_tree/max_lats", rtree.m_search_tree.max_lats);
     storage::serialization::read(
         reader, name + "/search_tree_level_starts", rtree.m_tree_level_starts);
 }
@@ -135,7 +161,14 @@ void write(storage::tar::FileWriter &writer,
            const std::string &name,
            const util::StaticRTree<EdgeDataT, Ownership, BRANCHING_FACTOR, LEAF_PAGE_SIZE> &rtree)
 {
-    storage::serialization::write(writer, name + "/search_tree", rtree.m_search_tree);
+    storage::serialization::write(
+        writer, name + "/search_tree/min_lons", rtree.m_search_tree.min_lons);
+    storage::serialization::write(
+        writer, name + "/search_tree/max_lons", rtree.m_search_tree.max_lons);
+    storage::serialization::write(
+        writer, name + "/search_tree/min_lats", rtree.m_search_tree.min_lats);
+    storage::serialization::write(
+        writer, name + "/search_tree/max_lats", rtree.m_search_tree.max_lats);
     storage::serialization::write(
         writer, name + "/search_tree_level_starts", rtree.m_tree_level_starts);
 }
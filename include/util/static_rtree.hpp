@@ -5,6 +5,7 @@
 #include "osrm/coordinate.hpp"
 #include "util/bearing.hpp"
 #include "util/binary_heap.hpp"
+#include "util/bounding_box_kernels.hpp"
 #include "util/coordinate_calculation.hpp"
 #include "util/deallocating_vector.hpp"
 #include "util/exception.hpp"
@@ -17,6 +18,7 @@
 #include "util/vector_view.hpp"
 #include "util/web_mercator.hpp"
 
+#include "storage/io.hpp"
 #include "storage/shared_memory_ownership.hpp"
 
 #include <boost/assert.hpp>
@@ -24,13 +26,18 @@
 
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
+#include <tbb/parallel_pipeline.h>
 #include <tbb/parallel_sort.h>
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <filesystem>
 #include <limits>
+#include <memory>
 #include <queue>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace osrm::util
@@ -152,6 +159,7 @@ class StaticRTree
 
     static_assert(LEAF_PAGE_SIZE >= sizeof(EdgeDataT), "page size is too small");
     static_assert(((LEAF_PAGE_SIZE - 1) & LEAF_PAGE_SIZE) == 0, "page size is not a power of 2");
+    static_assert(BRANCHING_FACTOR <= 64, "children are tested with a 64 bit mask");
     static constexpr std::uint32_t LEAF_NODE_SIZE = (LEAF_PAGE_SIZE / sizeof(EdgeDataT));
 
     struct CandidateSegment
@@ -163,7 +171,7 @@ class StaticRTree
     /**
      * Represents a node position somewhere in our tree.  This is purely a navigation
      * class used to find children of each node - the actual data for each node
-     * is in the m_search_tree vector of TreeNode objects.
+     * is in m_search_tree.
      */
     struct TreeIndex
     {
@@ -184,6 +192,21 @@ class StaticRTree
         Rectangle minimum_bounding_rectangle;
     };
 
+    /**
+     * The bounding boxes of all TreeNodes, stored as structure of arrays in the same
+     * order. The children of a node are consecutive in every array, so their boxes are
+     * tested together (see bounding_box_kernels.hpp).
+     */
+    struct SearchTree
+    {
+        Vector<std::int32_t> min_lons;
+        Vector<std::int32_t> max_lons;
+        Vector<std::int32_t> min_lats;
+        Vector<std::int32_t> max_lats;
+
+        std::size_t size() const { return min_lons.size(); }
+    };
+
   private:
     /**
      * A lightweight wrapper for the Hilbert Code for each EdgeDataT object
@@ -248,7 +271,7 @@ class StaticRTree
     };
 
     // Representation of the in-memory search tree
-    Vector<TreeNode> m_search_tree;
+    SearchTree m_search_tree;
     // Reference to the actual lon/lat data we need for doing math
     util::vector_view<const Coordinate> m_coordinate_list;
     // Holds the start indexes of each level in m_search_tree
@@ -272,6 +295,7 @@ class StaticRTree
         : m_coordinate_list(coordinate_list.data(), coordinate_list.size())
     {
         const auto element_count = input_data_vector.size();
+        std::vector<TreeNode> search_tree;
         std::vector<WrappedInputElement> input_wrapper_vector(element_count);
 
         // Step 1 - create a vector of Hilbert Code/original position pairs
@@ -306,73 +330,127 @@ class StaticRTree
         // sort the hilbert-value representatives
         tbb::parallel_sort(input_wrapper_vector.begin(), input_wrapper_vector.end());
         {
-            boost::iostreams::mapped_file out_objects_region;
-            auto out_objects = mmapFile<EdgeDataT>(on_disk_file_name,
-                                                   out_objects_region,
-                                                   input_data_vector.size() * sizeof(EdgeDataT));
-
-            // Note, we can't just write everything in one go, because the input_data_vector
-            // is not sorted by hilbert code, only the input_wrapper_vector is in the correct
-            // order.  Instead, we iterate over input_wrapper_vector, copy the hilbert-indexed
-            // entries from input_data_vector into a temporary contiguous array, then write
-            // that array to disk.
-
-            // Create the first level of TreeNodes - each bounding LEAF_NODE_COUNT EdgeDataT
-            // objects.
-            std::size_t wrapped_element_index = 0;
-            auto objects_iter = out_objects.begin();
-
-            while (wrapped_element_index < element_count)
+            // Create the first level of TreeNodes - each bounding LEAF_NODE_SIZE EdgeDataT
+            // objects. Blocks of leaves are built in parallel and their objects are copied
+            // into a contiguous buffer in hilbert order, which is written to disk as soon as
+            // all preceding blocks have been written.
+            storage::io::FileWriter out_objects(on_disk_file_name,
+                                                storage::io::FileWriter::HasNoFingerprint);
+
+            struct LeafBlock
             {
-                TreeNode current_node;
-
-                // Loop over the next block of EdgeDataT, calculate the bounding box
-                // for the block, and save the data to write to disk in the correct
-                // order.
-                for (std::uint32_t object_index = 0;
-                     object_index < LEAF_NODE_SIZE && wrapped_element_index < element_count;
-                     ++object_index, ++wrapped_element_index)
+                std::vector<EdgeDataT> objects;
+                std::vector<TreeNode> leaves;
+            };
+            using LeafBlockPtr = std::shared_ptr<LeafBlock>;
+
+            const std::size_t leaf_count = (element_count + LEAF_NODE_SIZE - 1) / LEAF_NODE_SIZE;
+            search_tree.reserve(leaf_count);
+
+            const constexpr std::size_t GRAINSIZE = 64;
+            std::size_t current_leaf = 0;
+            tbb::filter<void, tbb::blocked_range<std::size_t>> generator_stage(
+                tbb::filter_mode::serial_in_order,
+                [&](tbb::flow_control &fc)
                 {
-                    const std::uint32_t input_object_index =
-                        input_wrapper_vector[wrapped_element_index].m_original_index;
-                    const EdgeDataT &object = input_data_vector[input_object_index];
-
-                    *objects_iter++ = object;
-
-                    Coordinate projected_u{
-                        web_mercator::fromWGS84(Coordinate{m_coordinate_list[object.u]})};
-                    Coordinate projected_v{
-                        web_mercator::fromWGS84(Coordinate{m_coordinate_list[object.v]})};
-
-                    BOOST_ASSERT(std::abs(toFloating(projected_u.lon).operator double()) <= 180.);
-                    BOOST_ASSERT(std::abs(toFloating(projected_u.lat).operator double()) <= 180.);
-                    BOOST_ASSERT(std::abs(toFloating(projected_v.lon).operator double()) <= 180.);
-                    BOOST_ASSERT(std::abs(toFloating(projected_v.lat).operator double()) <= 180.);
-
-                    Rectangle rectangle;
-                    rectangle.min_lon =
-                        std::min(rectangle.min_lon, std::min(projected_u.lon, projected_v.lon));
-                    rectangle.max_lon =
-                        std::max(rectangle.max_lon, std::max(projected_u.lon, projected_v.lon));
-
-                    rectangle.min_lat =
-                        std::min(rectangle.min_lat, std::min(projected_u.lat, projected_v.lat));
-                    rectangle.max_lat =
-                        std::max(rectangle.max_lat, std::max(projected_u.lat, projected_v.lat));
-
-                    BOOST_ASSERT(rectangle.IsValid());
-                    current_node.minimum_bounding_rectangle.MergeBoundingBoxes(rectangle);
-                }
+                    if (current_leaf < leaf_count)
+                    {
+                        auto next_leaf = std::min(current_leaf + GRAINSIZE, leaf_count);
+                        auto result = tbb::blocked_range<std::size_t>(current_leaf, next_leaf);
+                        current_leaf = next_leaf;
+                        return result;
+                    }
+                    else
+                    {
+                        fc.stop();
+                        return tbb::blocked_range<std::size_t>(leaf_count, leaf_count);
+                    }
+                });
 
-                m_search_tree.emplace_back(current_node);
-            }
+            tbb::filter<tbb::blocked_range<std::size_t>, LeafBlockPtr> leaf_stage(
+                tbb::filter_mode::parallel,
+                [&](const tbb::blocked_range<std::size_t> &leaf_range)
+                {
+                    auto block = std::make_shared<LeafBlock>();
+                    const auto first_element = leaf_range.begin() * LEAF_NODE_SIZE;
+                    const auto last_element =
+                        std::min<std::size_t>(leaf_range.end() * LEAF_NODE_SIZE, element_count);
+                    block->objects.reserve(last_element - first_element);
+                    block->leaves.reserve(leaf_range.size());
+
+                    for (auto leaf_first_element = first_element;
+                         leaf_first_element < last_element;
+                         leaf_first_element += LEAF_NODE_SIZE)
+                    {
+                        TreeNode current_node;
+
+                        // Loop over the next block of EdgeDataT, calculate the bounding box
+                        // for the block, and save the data to write to disk in the correct
+                        // order.
+                        const auto leaf_last_element =
+                            std::min<std::size_t>(leaf_first_element + LEAF_NODE_SIZE,
+                                                  last_element);
+                        for (auto wrapped_element_index :
+                             irange<std::size_t>(leaf_first_element, leaf_last_element))
+                        {
+                            const std::uint32_t input_object_index =
+                                input_wrapper_vector[wrapped_element_index].m_original_index;
+                            const EdgeDataT &object = input_data_vector[input_object_index];
+
+                            block->objects.push_back(object);
+
+                            Coordinate projected_u{
+                                web_mercator::fromWGS84(Coordinate{m_coordinate_list[object.u]})};
+                            Coordinate projected_v{
+                                web_mercator::fromWGS84(Coordinate{m_coordinate_list[object.v]})};
+
+                            BOOST_ASSERT(std::abs(toFloating(projected_u.lon).operator double()) <=
+                                         180.);
+                            BOOST_ASSERT(std::abs(toFloating(projected_u.lat).operator double()) <=
+                                         180.);
+                            BOOST_ASSERT(std::abs(toFloating(projected_v.lon).operator double()) <=
+                                         180.);
+                            BOOST_ASSERT(std::abs(toFloating(projected_v.lat).operator double()) <=
+                                         180.);
+
+                            Rectangle rectangle;
+                            rectangle.min_lon =
+                                std::min({rectangle.min_lon, projected_u.lon, projected_v.lon});
+                            rectangle.max_lon =
+                                std::max({rectangle.max_lon, projected_u.lon, projected_v.lon});
+
+                            rectangle.min_lat =
+                                std::min({rectangle.min_lat, projected_u.lat, projected_v.lat});
+                            rectangle.max_lat =
+                                std::max({rectangle.max_lat, projected_u.lat, projected_v.lat});
+
+                            BOOST_ASSERT(rectangle.IsValid());
+                            current_node.minimum_bounding_rectangle.MergeBoundingBoxes(rectangle);
+                        }
+
+                        block->leaves.emplace_back(current_node);
+                    }
+                    return block;
+                });
+
+            tbb::filter<LeafBlockPtr, void> output_stage(
+                tbb::filter_mode::serial_in_order,
+                [&](auto block)
+                {
+                    out_objects.WriteFrom(block->objects);
+                    search_tree.insert(
+                        search_tree.end(), block->leaves.begin(), block->leaves.end());
+                });
+
+            tbb::parallel_pipeline(std::thread::hardware_concurrency() * 5,
+                                   generator_stage & leaf_stage & output_stage);
         }
         // mmap as read-only now
         m_objects = mmapFile<EdgeDataT>(on_disk_file_name, m_objects_region);
 
         // Should hold the number of nodes at the lowest level of the graph (closest
         // to the data)
-        std::uint32_t nodes_in_previous_level = m_search_tree.size();
+        std::uint32_t nodes_in_previous_level = search_tree.size();
 
         // Holds the number of TreeNodes in each level.
         // We always start with the root node, so
@@ -384,7 +462,7 @@ class StaticRTree
         // nodes from the previous level.
         while (nodes_in_previous_level > 1)
         {
-            auto previous_level_start_pos = m_search_tree.size() - nodes_in_previous_level;
+            auto previous_level_start_pos = search_tree.size() - nodes_in_previous_level;
 
             // We can calculate how many nodes will be in this level, we divide by
             // BRANCHING_FACTOR
@@ -392,26 +470,36 @@ class StaticRTree
             std::uint32_t nodes_in_current_level =
                 std::ceil(static_cast<double>(nodes_in_previous_level) / BRANCHING_FACTOR);
 
-            for (auto current_node_idx : irange<std::size_t>(0, nodes_in_current_level))
-            {
-                TreeNode parent_node;
-                auto first_child_index =
-                    current_node_idx * BRANCHING_FACTOR + previous_level_start_pos;
-                auto last_child_index =
-                    first_child_index +
-                    std::min<std::size_t>(BRANCHING_FACTOR,
-                                          nodes_in_previous_level -
-                                              current_node_idx * BRANCHING_FACTOR);
-
-                // Calculate the bounding box for BRANCHING_FACTOR nodes in the previous
-                // level, then save that box as a new TreeNode in the new level.
-                for (auto child_node_idx : irange<std::size_t>(first_child_index, last_child_index))
+            // The parents of a level only depend on the previous level, so they are
+            // calculated in parallel.
+            const auto current_level_start_pos = search_tree.size();
+            search_tree.resize(current_level_start_pos + nodes_in_current_level);
+            tbb::parallel_for(
+                tbb::blocked_range<std::size_t>(0, nodes_in_current_level),
+                [&](const tbb::blocked_range<std::size_t> &range)
                 {
-                    parent_node.minimum_bounding_rectangle.MergeBoundingBoxes(
-                        m_search_tree[child_node_idx].minimum_bounding_rectangle);
-                }
-                m_search_tree.emplace_back(parent_node);
-            }
+                    for (auto current_node_idx : irange(range.begin(), range.end()))
+                    {
+                        TreeNode &parent_node =
+                            search_tree[current_level_start_pos + current_node_idx];
+                        auto first_child_index =
+                            current_node_idx * BRANCHING_FACTOR + previous_level_start_pos;
+                        auto last_child_index =
+                            first_child_index +
+                            std::min<std::size_t>(BRANCHING_FACTOR,
+                                                  nodes_in_previous_level -
+                                                      current_node_idx * BRANCHING_FACTOR);
+
+                        // Calculate the bounding box for BRANCHING_FACTOR nodes in the previous
+                        // level, then save that box as a new TreeNode in the new level.
+                        for (auto child_node_idx :
+                             irange<std::size_t>(first_child_index, last_child_index))
+                        {
+                            parent_node.minimum_bounding_rectangle.MergeBoundingBoxes(
+                                search_tree[child_node_idx].minimum_bounding_rectangle);
+                        }
+                    }
+                });
             nodes_in_previous_level = nodes_in_current_level;
             tree_level_sizes.push_back(nodes_in_previous_level);
         }
@@ -421,7 +509,7 @@ class StaticRTree
 
         // Flip the tree so that the root node is at 0.
         // This just makes our math during search a bit more intuitive
-        std::reverse(m_search_tree.begin(), m_search_tree.end());
+        std::reverse(search_tree.begin(), search_tree.end());
 
         // Same for the level sizes - root node / base level is at 0
         std::reverse(tree_level_sizes.begin(), tree_level_sizes.end());
@@ -446,9 +534,32 @@ class StaticRTree
         // searches
         for (auto i : irange<std::size_t>(0, tree_level_sizes.size()))
         {
-            std::reverse(m_search_tree.begin() + m_tree_level_starts[i],
-                         m_search_tree.begin() + m_tree_level_starts[i] + tree_level_sizes[i]);
+            std::reverse(search_tree.begin() + m_tree_level_starts[i],
+                         search_tree.begin() + m_tree_level_starts[i] + tree_level_sizes[i]);
         }
+
+        // Split the boxes into the arrays used for searching
+        m_search_tree.min_lons.resize(search_tree.size());
+        m_search_tree.max_lons.resize(search_tree.size());
+        m_search_tree.min_lats.resize(search_tree.size());
+        m_search_tree.max_lats.resize(search_tree.size());
+        tbb::parallel_for(tbb::blocked_range<std::size_t>(0, search_tree.size()),
+                          [&](const tbb::blocked_range<std::size_t> &range)
+                          {
+                              for (auto index : irange(range.begin(), range.end()))
+                              {
+                                  const auto &rectangle =
+                                      search_tree[index].minimum_bounding_rectangle;
+                                  m_search_tree.min_lons[index] =
+                                      static_cast<std::int32_t>(rectangle.min_lon);
+                                  m_search_tree.max_lons[index] =
+                                      static_cast<std::int32_t>(rectangle.max_lon);
+                                  m_search_tree.min_lats[index] =
+                                      static_cast<std::int32_t>(rectangle.min_lat);
+                                  m_search_tree.max_lats[index] =
+                                      static_cast<std::int32_t>(rectangle.max_lat);
+                              }
+                          });
     }
 
     /**
@@ -468,7 +579,7 @@ class StaticRTree
      * These memory blocks basically just contain the files read into RAM,
      * excep the .fileIndex file always stays on disk, and we mmap() it as usual
      */
-    explicit StaticRTree(Vector<TreeNode> search_tree_,
+    explicit StaticRTree(SearchTree search_tree_,
                          Vector<std::uint64_t> tree_level_starts,
                          const std::filesystem::path &on_disk_file_name,
                          const Vector<Coordinate> &coordinate_list)
@@ -662,17 +773,22 @@ class StaticRTree
             {
                 BOOST_ASSERT(current_tree_index.level + 1 < m_tree_level_starts.size());
 
-                for (const auto child_index : child_indexes(current_tree_index))
+                const auto children = child_indexes(current_tree_index);
+                const auto first_child_index = children.front();
+                auto intersecting = bounding_box_kernels::intersectingBoxes(
+                    m_search_tree.min_lons.data() + first_child_index,
+                    m_search_tree.max_lons.data() + first_child_index,
+                    m_search_tree.min_lats.data() + first_child_index,
+                    m_search_tree.max_lats.data() + first_child_index,
+                    children.size(),
+                    projected_rectangle);
+
+                for (; intersecting != 0; intersecting &= intersecting - 1)
                 {
-                    const auto &child_rectangle =
-                        m_search_tree[child_index].minimum_bounding_rectangle;
-
-                    if (child_rectangle.Intersects(projected_rectangle))
-                    {
-                        traversal_queue.push(TreeIndex(
-                            current_tree_index.level + 1,
-                            child_index - m_tree_level_starts[current_tree_index.level + 1]));
-                    }
+                    const auto child_index = first_child_index + std::countr_zero(intersecting);
+                    traversal_queue.push(TreeIndex(
+                        current_tree_index.level + 1,
+                        child_index - m_tree_level_starts[current_tree_index.level + 1]));
                 }
             }
         }
@@ -735,16 +851,23 @@ class StaticRTree
         // Check that we're actually looking at the bottom level of the tree
         BOOST_ASSERT(!is_leaf(parent));
 
-        for (const auto child_index : child_indexes(parent))
-        {
-            const auto &child = m_search_tree[child_index];
+        const auto children = child_indexes(parent);
+        const auto first_child_index = children.front();
 
-            const auto squared_lower_bound_to_element =
-                child.minimum_bounding_rectangle.GetMinSquaredDist(
-                    fixed_projected_input_coordinate);
+        std::array<std::uint64_t, BRANCHING_FACTOR> squared_lower_bounds;
+        bounding_box_kernels::minSquaredDistances(
+            m_search_tree.min_lons.data() + first_child_index,
+            m_search_tree.max_lons.data() + first_child_index,
+            m_search_tree.min_lats.data() + first_child_index,
+            m_search_tree.max_lats.data() + first_child_index,
+            children.size(),
+            fixed_projected_input_coordinate,
+            squared_lower_bounds.data());
 
+        for (const auto child_index : children)
+        {
             traversal_queue.emplace(QueryCandidate{
-                squared_lower_bound_to_element,
+                squared_lower_bounds[child_index - first_child_index],
                 TreeIndex(parent.level + 1, child_index - m_tree_level_starts[parent.level + 1])});
         }
     }
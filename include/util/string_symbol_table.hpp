@@ -0,0 +1,281 @@
+#ifndef OSRM_UTIL_STRING_SYMBOL_TABLE_HPP
+#define OSRM_UTIL_STRING_SYMBOL_TABLE_HPP
+
+#include "storage/shared_memory_ownership.hpp"
+#include "storage/tar_fwd.hpp"
+
+#include "util/vector_view.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace osrm::util
+{
+namespace detail
+{
+template <storage::Ownership Ownership> class StringSymbolTableImpl;
+} // namespace detail
+
+namespace serialization
+{
+template <storage::Ownership Ownership>
+inline void read(storage::tar::FileReader &reader,
+                 const std::string &name,
+                 detail::StringSymbolTableImpl<Ownership> &symbol_table);
+
+template <storage::Ownership Ownership>
+inline void write(storage::tar::FileWriter &writer,
+                  const std::string &name,
+                  const detail::StringSymbolTableImpl<Ownership> &symbol_table);
+} // namespace serialization
+
+namespace detail
+{
+// Static symbol table compression for short strings, following the idea of FSST.
+//
+// Up to 255 frequent substrings of 1 to 8 bytes are replaced by a single byte code. Bytes that are
+// not covered by any symbol are written as the escape code followed by the byte itself.
+// Every string is encoded on its own, so it can be decoded without touching other strings.
+// Decoding is a table lookup and an 8 byte copy per code.
+template <storage::Ownership Ownership> class StringSymbolTableImpl
+{
+    template <typename T> using Vector = util::ViewOrVector<T, Ownership>;
+
+  public:
+    static constexpr std::uint32_t MAX_SYMBOL_LENGTH = 8;
+    static constexpr std::uint32_t MAX_SYMBOLS = 255;
+    static constexpr std::uint8_t ESCAPE_CODE = 255;
+    // Symbols are selected on a sample of the input strings of at most this many bytes
+    static constexpr std::size_t SAMPLE_SIZE = 1 << 20;
+    static constexpr std::uint32_t TRAINING_ROUNDS = 5;
+
+    StringSymbolTableImpl() = default;
+
+    StringSymbolTableImpl(Vector<std::uint64_t> symbols_, Vector<std::uint8_t> symbol_lengths_)
+        : symbols(std::move(symbols_)), symbol_lengths(std::move(symbol_lengths_))
+    {
+        BOOST_ASSERT(symbols.size() == symbol_lengths.size());
+    }
+
+    // Builds a symbol table for the strings [data + *first, data + *(first + 1)) ...
+    template <typename OffsetIterator, typename DataIterator>
+    StringSymbolTableImpl(OffsetIterator first, OffsetIterator last, DataIterator data)
+    {
+        static_assert(Ownership != storage::Ownership::View, "Views can not be trained.");
+
+        std::vector<std::string_view> sample;
+        const std::size_t number_of_strings = std::distance(first, last) - 1;
+        BOOST_ASSERT(first != last);
+
+        // Take every n-th string on average to cover the whole input with a bounded sample.
+        // Strings are picked by a hash of their index: a fixed stride would only ever hit the same
+        // member of groups of strings that are stored interleaved, like the five per name.
+        const std::size_t total_size = *std::prev(last) - *first;
+        const std::size_t stride = std::max<std::size_t>(1, total_size / SAMPLE_SIZE);
+        for (std::size_t index = 0; index < number_of_strings; ++index)
+        {
+            if (mix(index) % stride != 0)
+                continue;
+
+            const auto begin = first[index];
+            const auto end = first[index + 1];
+            if (begin != end)
+                sample.emplace_back(reinterpret_cast<const char *>(&*(data + begin)), end - begin);
+        }
+
+        std::vector<std::string> candidates;
+        for (std::uint32_t round = 0; round < TRAINING_ROUNDS; ++round)
+        {
+            candidates = selectSymbols(Encoder(candidates), sample);
+        }
+
+        for (const auto &candidate : candidates)
+        {
+            std::uint64_t symbol = 0;
+            std::memcpy(&symbol, candidate.data(), candidate.size());
+            symbols.push_back(symbol);
+            symbol_lengths.push_back(candidate.size());
+        }
+    }
+
+    bool empty() const { return symbols.empty(); }
+
+    std::size_t GetSizeInBytes() const
+    {
+        return symbols.size() * sizeof(std::uint64_t) + symbol_lengths.size();
+    }
+
+    void Decode(const std::string_view encoded, std::string &out) const
+    {
+        // Every code expands to at most 8 bytes. Symbols are always copied with all 8 bytes and the
+        // output is shrunk to the actual size afterwards.
+        out.resize(encoded.size() * MAX_SYMBOL_LENGTH);
+        auto *output = out.data();
+
+        for (auto position = encoded.begin(); position != encoded.end(); ++position)
+        {
+            const auto code = static_cast<std::uint8_t>(*position);
+            if (code == ESCAPE_CODE)
+            {
+                BOOST_ASSERT(std::next(position) != encoded.end());
+                *output++ = *++position;
+            }
+            else
+            {
+                BOOST_ASSERT(code < symbols.size());
+                std::memcpy(output, &symbols[code], MAX_SYMBOL_LENGTH);
+                output += symbol_lengths[code];
+            }
+        }
+
+        out.resize(output - out.data());
+    }
+
+    // Encodes strings with the greedy longest match of the symbols.
+    // Symbols are found through one hash table per length.
+    class Encoder
+    {
+      public:
+        explicit Encoder(const StringSymbolTableImpl &table)
+        {
+            for (std::uint32_t code = 0; code < table.symbols.size(); ++code)
+            {
+                lookup[table.symbol_lengths[code] - 1].emplace(table.symbols[code], code);
+            }
+        }
+
+        explicit Encoder(const std::vector<std::string> &candidates)
+        {
+            for (std::uint32_t code = 0; code < candidates.size(); ++code)
+            {
+                const auto &candidate = candidates[code];
+                lookup[candidate.size() - 1].emplace(load(candidate.data(), candidate.size()),
+                                                     code);
+            }
+        }
+
+        // Returns the code and length of the longest symbol at the front of `value`.
+        // If there is none the result is the escape code with length 1.
+        std::tuple<std::uint8_t, std::uint32_t> Match(const std::string_view value) const
+        {
+            const auto max_length = std::min<std::size_t>(MAX_SYMBOL_LENGTH, value.size());
+            for (auto length = max_length; length > 0; --length)
+            {
+                const auto &symbols_of_length = lookup[length - 1];
+                if (symbols_of_length.empty())
+                    continue;
+
+                const auto iter = symbols_of_length.find(load(value.data(), length));
+                if (iter != symbols_of_length.end())
+                    return {iter->second, length};
+            }
+            return {ESCAPE_CODE, 1};
+        }
+
+        // Writes the codes of `value` to `out`
+        template <typename OutIter> OutIter Encode(std::string_view value, OutIter out) const
+        {
+            while (!value.empty())
+            {
+                const auto [code, length] = Match(value);
+                *out++ = static_cast<char>(code);
+                if (code == ESCAPE_CODE)
+                    *out++ = value.front();
+                value.remove_prefix(length);
+            }
+            return out;
+        }
+
+      private:
+        static std::uint64_t load(const char *data, const std::size_t length)
+        {
+            std::uint64_t symbol = 0;
+            std::memcpy(&symbol, data, length);
+            return symbol;
+        }
+
+        std::array<std::unordered_map<std::uint64_t, std::uint8_t>, MAX_SYMBOL_LENGTH> lookup;
+    };
+
+    friend void serialization::read<Ownership>(storage::tar::FileReader &reader,
+                                               const std::string &name,
+                                               StringSymbolTableImpl &symbol_table);
+
+    friend void serialization::write<Ownership>(storage::tar::FileWriter &writer,
+                                                const std::string &name,
+                                                const StringSymbolTableImpl &symbol_table);
+
+  private:
+    // Finalizer of splitmix64
+    static std::uint64_t mix(std::uint64_t value)
+    {
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+        return value ^ (value >> 31);
+    }
+
+    // Encodes the sample with the current symbols and picks the new symbols from the used symbols,
+    // the escaped bytes and the concatenations of two consecutive symbols.
+    // Candidates are ranked by the number of bytes they cover in the sample.
+    static std::vector<std::string> selectSymbols(const Encoder &encoder,
+                                                  const std::vector<std::string_view> &sample)
+    {
+        std::unordered_map<std::string, std::uint64_t> gains;
+        for (auto value : sample)
+        {
+            std::string_view previous;
+            while (!value.empty())
+            {
+                const auto length = std::get<1>(encoder.Match(value));
+                const auto current = value.substr(0, length);
+
+                gains[std::string(current)] += current.size();
+                if (!previous.empty() && previous.size() + current.size() <= MAX_SYMBOL_LENGTH)
+                {
+                    // previous and current are adjacent in the sample
+                    const std::string_view combined(previous.data(),
+                                                    previous.size() + current.size());
+                    gains[std::string(combined)] += combined.size();
+                }
+
+                previous = current;
+                value.remove_prefix(length);
+            }
+        }
+
+        std::vector<std::pair<std::string, std::uint64_t>> ranked(gains.begin(), gains.end());
+        const auto by_gain = [](const auto &lhs, const auto &rhs)
+        { return std::tie(rhs.second, lhs.first) < std::tie(lhs.second, rhs.first); };
+        const auto number_of_symbols = std::min<std::size_t>(MAX_SYMBOLS, ranked.size());
+        std::partial_sort(
+            ranked.begin(), ranked.begin() + number_of_symbols, ranked.end(), by_gain);
+
+        std::vector<std::string> candidates;
+        candidates.reserve(number_of_symbols);
+        std::transform(ranked.begin(),
+                       ranked.begin() + number_of_symbols,
+                       std::back_inserter(candidates),
+                       [](auto &entry) { return std::move(entry.first); });
+        return candidates;
+    }
+
+    Vector<std::uint64_t> symbols;
+    Vector<std::uint8_t> symbol_lengths;
+};
+} // namespace detail
+
+using StringSymbolTable = detail::StringSymbolTableImpl<storage::Ownership::Container>;
+using StringSymbolTableView = detail::StringSymbolTableImpl<storage::Ownership::View>;
+} // namespace osrm::util
+
+#endif // OSRM_UTIL_STRING_SYMBOL_TABLE_HPP
@@ -0,0 +1,1170 @@
+// Car profile compiled into a profile plugin
+//
+// A port of car.lua and the parts of lib/ it uses, see "Compiled profiles" in docs/profiles.md.
+// Changes to car.lua have to be ported here as well. Location-dependent data is not available to
+// plugins, so maxheight and driving_side fall back to their defaults where car.lua would query
+// location tags.
+
+#include "extractor/profile_plugin.hpp"
+
+#include "extractor/extraction_helper_functions.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <initializer_list>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace
+{
+
+using namespace osrm;
+using namespace osrm::extractor;
+
+using Set = std::unordered_set<std::string_view>;
+template <typename T> using Table = std::unordered_map<std::string_view, T>;
+template <std::size_t N> using Sequence = std::array<std::string_view, N>;
+
+// tag values are nullptr if a tag is not set, like nil in Lua
+using Value = const char *;
+
+Value get(const osmium::OSMObject &object, const char *key)
+{
+    return object.get_value_by_key(key);
+}
+
+Value get(const osmium::OSMObject &object, const std::string_view prefix, const char *suffix)
+{
+    return object.get_value_by_key((std::string(prefix) + suffix).c_str());
+}
+
+bool equals(const Value value, const std::string_view other)
+{
+    return value != nullptr && value == other;
+}
+
+bool contains(const Set &set, const Value value) { return value != nullptr && set.contains(value); }
+
+template <typename T> std::optional<T> lookup(const Table<T> &table, const Value value)
+{
+    if (value == nullptr)
+        return {};
+    const auto entry = table.find(value);
+    if (entry == table.end())
+        return {};
+    return entry->second;
+}
+
+bool isDigit(const char character) { return std::isdigit(static_cast<unsigned char>(character)); }
+bool isAlpha(const char character) { return std::isalpha(static_cast<unsigned char>(character)); }
+
+// tonumber(value)
+std::optional<double> toNumber(const Value value)
+{
+    if (value == nullptr || *value == '\0')
+        return {};
+    char *end = nullptr;
+    const auto number = std::strtod(value, &end);
+    if (*end != '\0')
+        return {};
+    return number;
+}
+
+// tonumber(value:match("%d*")), the digits at the start of value
+std::optional<double> leadingNumber(const std::string_view value)
+{
+    const auto end = std::find_if_not(value.begin(), value.end(), isDigit);
+    if (end == value.begin())
+        return {};
+    return std::stod(std::string(value.begin(), end));
+}
+
+// tonumber(value:gsub(",", "."):match("%d+%.?%d*")), the first decimal number in value
+std::optional<double> firstNumber(const std::string_view value)
+{
+    const auto begin = std::find_if(value.begin(), value.end(), isDigit);
+    if (begin == value.end())
+        return {};
+    auto end = std::find_if_not(begin, value.end(), isDigit);
+    std::string number(begin, end);
+    if (end != value.end() && (*end == '.' || *end == ','))
+    {
+        const auto fraction_end = std::find_if_not(end + 1, value.end(), isDigit);
+        number += '.';
+        number.append(end + 1, fraction_end);
+    }
+    return std::stod(number);
+}
+
+// lib/measure.lua
+
+std::optional<double> parseValueSpeed(const std::string_view value)
+{
+    auto speed = leadingNumber(value);
+    if (speed && (value.find("mph") != value.npos || value.find("mp/h") != value.npos))
+        *speed *= 1.609;
+    return speed;
+}
+
+std::optional<double> parseValueMeters(const std::string_view value)
+{
+    auto meters = firstNumber(value);
+    const auto inches = value.find('\'');
+    if (meters && inches != value.npos)
+    {
+        // imperial feet'inches
+        *meters *= 12;
+        if (const auto number = leadingNumber(value.substr(
+                std::find_if(value.begin() + inches, value.end(), isDigit) - value.begin())))
+            *meters += *number;
+        *meters *= 0.0254;
+    }
+    return meters;
+}
+
+std::optional<double> parseValueKilograms(const std::string_view value)
+{
+    auto kilograms = firstNumber(value);
+    if (kilograms)
+    {
+        if (value.find("lbs") != value.npos)
+            *kilograms *= 0.45359237;
+        else if (value.find("kg") == value.npos)
+            *kilograms *= 1000; // metric tons
+    }
+    return kilograms;
+}
+
+std::optional<double> getMaxHeight(const Value value)
+{
+    // https://wiki.openstreetmap.org/wiki/Key:maxheight#Non-numerical_values
+    static const Set non_numerical_values = {"default", "none", "no-sign", "unsigned"};
+    if (value == nullptr)
+        return {};
+    if (non_numerical_values.contains(value))
+        return 4.5;
+    return parseValueMeters(value);
+}
+
+std::optional<double> getMaxMeters(const Value value)
+{
+    if (value == nullptr)
+        return {};
+    return parseValueMeters(value);
+}
+
+std::optional<double> getMaxWeight(const Value value)
+{
+    if (value == nullptr)
+        return {};
+    return parseValueKilograms(value);
+}
+
+// intermediate values of process_way
+struct WayData
+{
+    Value highway;
+    Value bridge;
+    Value route;
+    Value forward_access = nullptr;
+    Value backward_access = nullptr;
+    Value oneway = nullptr;
+    bool is_forward_oneway = false;
+    bool is_reverse_oneway = false;
+};
+
+// lib/tags.lua
+
+std::pair<Value, Value>
+getForwardBackwardByKey(const osmium::Way &way, const WayData &data, const std::string_view key)
+{
+    auto forward = get(way, key, ":forward");
+    auto backward = get(way, key, ":backward");
+    if (forward == nullptr || backward == nullptr)
+    {
+        const auto common = get(way, key, "");
+        if (data.is_forward_oneway)
+        {
+            forward = forward ? forward : common;
+        }
+        else if (data.is_reverse_oneway)
+        {
+            backward = backward ? backward : common;
+        }
+        else
+        {
+            forward = forward ? forward : common;
+            backward = backward ? backward : common;
+        }
+    }
+    return {forward, backward};
+}
+
+template <typename Keys>
+std::pair<Value, Value> getForwardBackwardBySet(const osmium::Way &way, const Keys &keys)
+{
+    Value forward = nullptr;
+    Value backward = nullptr;
+    for (const auto key : keys)
+    {
+        if (forward == nullptr)
+            forward = get(way, key, ":forward");
+        if (backward == nullptr)
+            backward = get(way, key, ":backward");
+        if (forward == nullptr || backward == nullptr)
+        {
+            const auto common = get(way, key, "");
+            forward = forward ? forward : common;
+            backward = backward ? backward : common;
+        }
+        if (forward != nullptr && backward != nullptr)
+            break;
+    }
+    return {forward, backward};
+}
+
+std::pair<Value, Value> getForwardBackwardBySet(const osmium::Way &way,
+                                                const std::initializer_list<std::string_view> keys)
+{
+    return getForwardBackwardBySet<std::initializer_list<std::string_view>>(way, keys);
+}
+
+class CarProfile final : public ProfilePlugin
+{
+  public:
+    explicit CarProfile(ObstacleMap &obstacle_map) : obstacle_map(obstacle_map)
+    {
+        properties.SetMaxSpeedForMapMatching(180 / 3.6);
+        // For routing based on duration, but weighted for preferring certain roads
+        properties.SetWeightName("routability");
+        properties.call_tagless_node_function = false;
+        properties.SetUturnPenalty(20);
+        properties.continue_straight_at_waypoint = true;
+        properties.use_turn_restrictions = true;
+        properties.left_hand_driving = false;
+    }
+
+    const ProfileProperties &GetProfileProperties() const override { return properties; }
+
+    std::vector<std::vector<std::string>> GetExcludableClasses() const override
+    {
+        return {{"toll"}, {"motorway"}, {"ferry"}};
+    }
+
+    std::vector<std::string> GetClassNames() const override
+    {
+        return {"toll", "motorway", "ferry", "restricted", "tunnel"};
+    }
+
+    std::vector<std::string> GetNameSuffixList() const override
+    {
+        return {"N", "NE", "E", "SE", "S", "SW", "W", "NW",
+                "North", "South", "West", "East", "Nor", "Sou", "We", "Ea"};
+    }
+
+    std::vector<std::string> GetRestrictions() const override
+    {
+        return {restrictions.begin(), restrictions.end()};
+    }
+
+    std::vector<std::string> GetRelations() const override { return {"route"}; }
+
+    void ProcessNode(const osmium::Node &node,
+                     ExtractionNode &,
+                     const ExtractionRelationContainer &) const override
+    {
+        // parse access and barrier tags
+        Value access = nullptr;
+        for (const auto key : access_tags_hierarchy)
+        {
+            if ((access = get(node, key, "")))
+                break;
+        }
+
+        if (access != nullptr)
+        {
+            if (access_tag_blacklist.contains(access) &&
+                !restricted_access_tag_list.contains(access))
+                AddObstacle(node, Obstacle{Obstacle::Type::Barrier});
+        }
+        else if (const auto barrier = get(node, "barrier"))
+        {
+            // check height restriction barriers
+            bool restricted_by_height = false;
+            if (equals(barrier, "height_restrictor"))
+            {
+                const auto maxheight = getMaxHeight(get(node, "maxheight"));
+                restricted_by_height = maxheight && *maxheight < vehicle_height;
+            }
+
+            // make an exception for rising bollard barriers
+            const auto rising_bollard = equals(get(node, "bollard"), "rising");
+
+            // make an exception for lowered/flat barrier=kerb
+            // and incorrect tagging of highway crossing kerb as highway barrier
+            const auto kerb = get(node, "kerb");
+            const auto flat_kerb = equals(kerb, "lowered") || equals(kerb, "flush");
+            const auto highway_crossing_kerb =
+                equals(barrier, "kerb") && equals(get(node, "highway"), "crossing");
+
+            if ((!barrier_whitelist.contains(barrier) && !rising_bollard && !flat_kerb &&
+                 !highway_crossing_kerb) ||
+                restricted_by_height)
+                AddObstacle(node, Obstacle{Obstacle::Type::Barrier});
+        }
+
+        ProcessObstacles(node);
+    }
+
+    void ProcessWay(const osmium::Way &way,
+                    ExtractionWay &result,
+                    const ExtractionRelationContainer &) const override
+    {
+        WayData data{get(way, "highway"), get(way, "bridge"), get(way, "route")};
+
+        // perform a quick initial check and abort if the way is obviously not routable
+        if ((data.highway == nullptr || *data.highway == '\0') &&
+            (data.route == nullptr || *data.route == '\0'))
+            return;
+
+        // the handlers of car.lua in the same order, a false result aborts
+        result.forward_travel_mode = TRAVEL_MODE_DRIVING;
+        result.backward_travel_mode = TRAVEL_MODE_DRIVING;
+
+        if (!BlockedWays(way, data) || contains(avoid, data.highway))
+            return;
+        HandleHeight(way, result);
+        HandleWidth(way, result);
+        HandleLength(way, result);
+        HandleWeight(way, result);
+        if (!Access(way, result, data))
+            return;
+        Oneway(way, result, data);
+        Destinations(way, result, data);
+        Ferries(way, result, data);
+        Movables(way, result, data);
+        if (contains(service_tag_forbidden, get(way, "service")))
+        {
+            result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+            result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+            return;
+        }
+        Hov(way, result, data);
+        if (!Speed(result, data))
+            return;
+        Maxspeed(way, result);
+        Surface(way, result);
+        Penalties(way, result, data);
+        Classes(way, result, data);
+        TurnLanes(way, result, data);
+        Classification(way, result, data);
+        Roundabouts(way, result);
+        Startpoint(result, data);
+        DrivingSide(way, result);
+        Names(way, result);
+        // weights: only the distance weight sets rates here
+        // way_classification_for_turn: the turn classification tables of car.lua are empty
+    }
+
+    void ProcessTurn(ExtractionTurn &turn) const override
+    {
+        // Use a sigmoid function to return a penalty that maxes out at turn_penalty
+        // over the space of 0-180 degrees.  Values here were chosen by fitting
+        // the function to some turn penalty samples from real driving.
+        const auto bias = turn.is_left_hand_driving ? 1. / turn_bias : turn_bias;
+
+        for (const auto &obstacle : obstacle_map.get(turn.from, turn.via))
+        {
+            // disregard a minor stop if entering by the major road
+            if (obstacle.type == Obstacle::Type::StopMinor && !EnteringByMinorRoad(turn))
+                continue;
+            // heuristic to infer the direction of a stop without an explicit direction tag
+            if (turn.number_of_roads == 2 && obstacle.type == Obstacle::Type::Stop &&
+                obstacle.direction == Obstacle::Direction::None &&
+                turn.source_road.distance < 20 && turn.target_road.distance > 20)
+                continue;
+            turn.duration += obstacle.duration;
+        }
+
+        if (turn.number_of_roads > 2 || turn.source_mode != turn.target_mode || turn.is_u_turn)
+        {
+            if (turn.angle >= 0)
+                turn.duration += turn_penalty / (1 + std::exp(-((13 / bias) * turn.angle / 180 -
+                                                                 6.5 * bias)));
+            else
+                turn.duration += turn_penalty / (1 + std::exp(-((13 * bias) * -turn.angle / 180 -
+                                                                 6.5 / bias)));
+
+            if (turn.is_u_turn)
+                turn.duration += properties.GetUturnPenalty();
+        }
+
+        turn.weight = turn.duration;
+
+        // penalize turns from non-local access only segments onto local access only tags
+        if (!turn.source_restricted && turn.target_restricted)
+            turn.weight = std::numeric_limits<TurnPenalty::value_type>::max();
+    }
+
+  private:
+    void AddObstacle(const osmium::Node &node, const Obstacle &obstacle) const
+    {
+        obstacle_map.emplace(to_alias<OSMNodeID>(node.id()), obstacle);
+    }
+
+    // lib/obstacles.lua
+    void ProcessObstacles(const osmium::Node &node) const
+    {
+        static const Table<Obstacle::Type> types = {
+            {"traffic_signals", Obstacle::Type::TrafficSignals},
+            {"stop", Obstacle::Type::Stop},
+            {"stop_minor", Obstacle::Type::StopMinor},
+            {"give_way", Obstacle::Type::GiveWay},
+            {"crossing", Obstacle::Type::Crossing},
+            {"traffic_calming", Obstacle::Type::TrafficCalming},
+            {"mini_roundabout", Obstacle::Type::MiniRoundabout},
+            {"turning_loop", Obstacle::Type::TurningLoop},
+            {"turning_circle", Obstacle::Type::TurningCircle}};
+        static const Table<Obstacle::Direction> directions = {
+            {"none", Obstacle::Direction::None},
+            {"forward", Obstacle::Direction::Forward},
+            {"backward", Obstacle::Direction::Backward},
+            {"both", Obstacle::Direction::Both}};
+
+        auto type = lookup(types, get(node, "highway"));
+        if (!type)
+            return;
+
+        auto direction = get(node, "direction");
+        float duration = 0;
+        if (*type == Obstacle::Type::TrafficSignals)
+        {
+            // traffic_signals:direction trumps direction
+            if (const auto signals_direction = get(node, "traffic_signals:direction"))
+                direction = signals_direction;
+            duration = 2;
+        }
+        if (*type == Obstacle::Type::Stop)
+        {
+            if (equals(get(node, "stop"), "minor"))
+                type = Obstacle::Type::StopMinor;
+            duration = 2;
+        }
+        if (*type == Obstacle::Type::GiveWay)
+            duration = 1;
+
+        AddObstacle(node,
+                    Obstacle{*type,
+                             lookup(directions, direction).value_or(Obstacle::Direction::None),
+                             duration,
+                             0});
+    }
+
+    // true if the source road of this turn is a minor road at the intersection
+    static bool EnteringByMinorRoad(const ExtractionTurn &turn)
+    {
+        // implementation: comparing road speeds
+        auto max_speed = turn.target_speed;
+        for (const auto &leg : turn.roads_on_the_right)
+            max_speed = std::max(max_speed, leg.speed);
+        for (const auto &leg : turn.roads_on_the_left)
+            max_speed = std::max(max_speed, leg.speed);
+        return max_speed > turn.source_speed;
+    }
+
+    // lib/way_handlers.lua
+
+    bool BlockedWays(const osmium::Way &way, const WayData &data) const
+    {
+        if (equals(get(way, "area"), "yes"))
+            return false;
+        if (equals(data.highway, "steps"))
+            return false;
+        if (equals(data.highway, "construction") || equals(get(way, "railway"), "construction"))
+            return false;
+        const auto construction = get(way, "construction");
+        if (construction != nullptr && !construction_whitelist.contains(construction))
+            return false;
+        if (get(way, "proposed") != nullptr)
+            return false;
+        // reversible oneways change direction with low frequency
+        if (equals(get(way, "oneway"), "reversible"))
+            return false;
+        if (equals(get(way, "impassable"), "yes") || equals(get(way, "status"), "impassable"))
+            return false;
+        return true;
+    }
+
+    void HandleHeight(const osmium::Way &way, ExtractionWay &result) const
+    {
+        const auto [forward, backward] =
+            getForwardBackwardBySet(way, {"maxheight:physical", "maxheight"});
+        if (const auto height = getMaxHeight(forward); height && *height < vehicle_height)
+            result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        if (const auto height = getMaxHeight(backward); height && *height < vehicle_height)
+            result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+    }
+
+    void HandleWidth(const osmium::Way &way, ExtractionWay &result) const
+    {
+        const auto [forward, backward] =
+            getForwardBackwardBySet(way, {"maxwidth:physical", "maxwidth", "width", "est_width"});
+        const auto narrow = equals(get(way, "narrow"), "yes");
+        const auto inaccessible = [&](const Value width)
+        {
+            if ((equals(width, "narrow") || narrow) && vehicle_width > 2.2)
+                return true;
+            const auto meters = getMaxMeters(width);
+            return meters && *meters <= vehicle_width;
+        };
+        if (inaccessible(forward))
+            result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        if (inaccessible(backward))
+            result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+    }
+
+    void HandleLength(const osmium::Way &way, ExtractionWay &result) const
+    {
+        const auto [forward, backward] = getForwardBackwardBySet(way, {"maxlength"});
+        if (const auto length = getMaxMeters(forward); length && *length < vehicle_length)
+            result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        if (const auto length = getMaxMeters(backward); length && *length < vehicle_length)
+            result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+    }
+
+    void HandleWeight(const osmium::Way &way, ExtractionWay &result) const
+    {
+        const auto [forward, backward] = getForwardBackwardBySet(way, {"maxweight"});
+        if (const auto weight = getMaxWeight(forward); weight && *weight < vehicle_weight)
+            result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        if (const auto weight = getMaxWeight(backward); weight && *weight < vehicle_weight)
+            result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+    }
+
+    bool Access(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        std::tie(data.forward_access, data.backward_access) =
+            getForwardBackwardBySet(way, access_tags_hierarchy);
+
+        // only allow a subset of roads to be treated as restricted
+        if (contains(restricted_highway_whitelist, data.highway))
+        {
+            if (contains(restricted_access_tag_list, data.forward_access))
+                result.forward_restricted = true;
+            if (contains(restricted_access_tag_list, data.backward_access))
+                result.backward_restricted = true;
+        }
+
+        // blacklist access tags that aren't marked as restricted
+        if (contains(access_tag_blacklist, data.forward_access) && !result.forward_restricted)
+            result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        if (contains(access_tag_blacklist, data.backward_access) && !result.backward_restricted)
+            result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+
+        return result.forward_travel_mode != TRAVEL_MODE_INACCESSIBLE ||
+               result.backward_travel_mode != TRAVEL_MODE_INACCESSIBLE;
+    }
+
+    void Oneway(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        Value oneway = nullptr;
+        for (const auto restriction : restrictions)
+        {
+            if ((oneway = get(way, "oneway:", restriction.data())))
+                break;
+        }
+        if (oneway == nullptr)
+            oneway = get(way, "oneway");
+        data.oneway = oneway;
+
+        if (equals(oneway, "-1"))
+        {
+            data.is_reverse_oneway = true;
+            result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        }
+        else if (equals(oneway, "yes") || equals(oneway, "1") || equals(oneway, "true"))
+        {
+            data.is_forward_oneway = true;
+            result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        }
+        else
+        {
+            const auto junction = get(way, "junction");
+            if ((equals(data.highway, "motorway") || equals(junction, "roundabout") ||
+                 equals(junction, "circular")) &&
+                !equals(oneway, "no"))
+            {
+                // implied oneway
+                data.is_forward_oneway = true;
+                result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+            }
+        }
+    }
+
+    // lib/destination.lua
+    static void Destinations(const osmium::Way &way, ExtractionWay &result, const WayData &data)
+    {
+        if (!data.is_forward_oneway && !data.is_reverse_oneway)
+            return;
+
+        const auto directional_tag = [&](const std::string_view tag) -> std::optional<std::string>
+        {
+            auto value = get(way, tag, data.is_forward_oneway ? ":forward" : ":backward");
+            if (value == nullptr)
+                value = get(way, tag, "");
+            if (value == nullptr)
+                return {};
+            std::string result;
+            for (const auto *character = value; *character != '\0'; ++character)
+            {
+                if (*character == ';')
+                    result += ", ";
+                else
+                    result += *character;
+            }
+            return result;
+        };
+
+        // Assemble destination as: "A59: Düsseldorf, Köln"
+        const auto ref = directional_tag("destination:ref");
+        const auto destination = directional_tag("destination");
+        const auto street = directional_tag("destination:street");
+        std::string value;
+        if (ref && destination)
+            value = *ref + ": " + *destination;
+        else
+            value = ref ? *ref : destination ? *destination : street ? *street : "";
+        result.destinations = canonicalizeStringList(std::move(value), ",");
+    }
+
+    void Ferries(const osmium::Way &way, ExtractionWay &result, const WayData &data) const
+    {
+        const auto route_speed = lookup(route_speeds, data.route);
+        if (!route_speed || *route_speed <= 0)
+            return;
+
+        const auto duration = get(way, "duration");
+        if (duration != nullptr && durationIsValid(duration))
+            result.duration = std::max<double>(parseDuration(duration), 1);
+        result.forward_travel_mode = TRAVEL_MODE_FERRY;
+        result.backward_travel_mode = TRAVEL_MODE_FERRY;
+        result.forward_speed = *route_speed;
+        result.backward_speed = *route_speed;
+    }
+
+    void Movables(const osmium::Way &way, ExtractionWay &result, const WayData &data) const
+    {
+        const auto bridge_speed = lookup(bridge_speeds, data.bridge);
+        if (!bridge_speed || *bridge_speed <= 0)
+            return;
+
+        // car.lua compares the capacity:car string to the number 0, which never matches
+        result.forward_travel_mode = TRAVEL_MODE_DRIVING;
+        result.backward_travel_mode = TRAVEL_MODE_DRIVING;
+        const auto duration = get(way, "duration");
+        if (duration != nullptr && durationIsValid(duration))
+        {
+            result.duration = std::max<double>(parseDuration(duration), 1);
+        }
+        else
+        {
+            result.forward_speed = *bridge_speed;
+            result.backward_speed = *bridge_speed;
+        }
+    }
+
+    // all lanes restricted to hov vehicles?
+    static bool HasAllDesignatedHovLanes(const Value lanes)
+    {
+        if (lanes == nullptr)
+            return false;
+        std::string_view remaining = lanes;
+        while (true)
+        {
+            const auto separator = remaining.find('|');
+            if (remaining.substr(0, separator) != "designated")
+                return false;
+            if (separator == remaining.npos)
+                return true;
+            remaining.remove_prefix(separator + 1);
+        }
+    }
+
+    static void Hov(const osmium::Way &way, ExtractionWay &result, const WayData &data)
+    {
+        if (equals(get(way, "hov"), "designated"))
+        {
+            result.forward_restricted = true;
+            result.backward_restricted = true;
+        }
+
+        // with the routability weight turn penalties are used instead of filtering out
+        const auto [forward, backward] = getForwardBackwardByKey(way, data, "hov:lanes");
+        if (HasAllDesignatedHovLanes(forward))
+            result.forward_restricted = true;
+        if (HasAllDesignatedHovLanes(backward))
+            result.backward_restricted = true;
+    }
+
+    bool Speed(ExtractionWay &result, const WayData &data) const
+    {
+        // abort if already set, eg. by a route
+        if (result.forward_speed != -1)
+            return true;
+
+        if (const auto speed = lookup(highway_speeds, data.highway))
+        {
+            // set speed by way type
+            result.forward_speed = *speed;
+            result.backward_speed = *speed;
+        }
+        else
+        {
+            // set the avg speed on ways that are marked accessible
+            const auto default_speed_for = [&](const Value access, const Value other_access,
+                                               double &speed, TravelMode &mode)
+            {
+                if (contains(access_tag_whitelist, access))
+                    speed = default_speed;
+                else if (access != nullptr && !access_tag_blacklist.contains(access))
+                    speed = default_speed;
+                else if (access == nullptr && other_access != nullptr)
+                    mode = TRAVEL_MODE_INACCESSIBLE;
+            };
+            TravelMode forward_mode = result.forward_travel_mode;
+            TravelMode backward_mode = result.backward_travel_mode;
+            default_speed_for(
+                data.forward_access, data.backward_access, result.forward_speed, forward_mode);
+            default_speed_for(
+                data.backward_access, data.forward_access, result.backward_speed, backward_mode);
+            result.forward_travel_mode = forward_mode;
+            result.backward_travel_mode = backward_mode;
+        }
+
+        return result.forward_speed != -1 || result.backward_speed != -1 || result.duration > 0;
+    }
+
+    double ParseMaxspeed(const Value value) const
+    {
+        if (value == nullptr)
+            return 0;
+        if (const auto speed = parseValueSpeed(value))
+            return *speed;
+
+        // parse maxspeed like FR:urban
+        std::string source(value);
+        std::transform(source.begin(),
+                       source.end(),
+                       source.begin(),
+                       [](const unsigned char character) { return std::tolower(character); });
+        if (const auto speed = lookup(maxspeed_table, source.c_str()))
+            return *speed;
+
+        // %a%a:(%a+)
+        for (std::size_t index = 0; index + 3 < source.size(); ++index)
+        {
+            if (isAlpha(source[index]) && isAlpha(source[index + 1]) && source[index + 2] == ':' &&
+                isAlpha(source[index + 3]))
+            {
+                const auto begin = source.begin() + index + 3;
+                const auto highway_type =
+                    std::string(begin, std::find_if_not(begin, source.end(), isAlpha));
+                return lookup(maxspeed_table_default, highway_type.c_str()).value_or(0);
+            }
+        }
+        return 0;
+    }
+
+    void Maxspeed(const osmium::Way &way, ExtractionWay &result) const
+    {
+        const auto [forward, backward] = getForwardBackwardBySet(
+            way, {"maxspeed:advisory", "maxspeed", "source:maxspeed", "maxspeed:type"});
+        if (const auto speed = ParseMaxspeed(forward); speed > 0)
+            result.forward_speed = speed * speed_reduction;
+        if (const auto speed = ParseMaxspeed(backward); speed > 0)
+            result.backward_speed = speed * speed_reduction;
+    }
+
+    void Surface(const osmium::Way &way, ExtractionWay &result) const
+    {
+        // reduce speed on bad surfaces
+        for (const auto &[key, speeds] : {std::make_pair("surface", &surface_speeds),
+                                          std::make_pair("tracktype", &tracktype_speeds),
+                                          std::make_pair("smoothness", &smoothness_speeds)})
+        {
+            if (const auto speed = lookup(*speeds, get(way, key)))
+            {
+                result.forward_speed = std::min(*speed, result.forward_speed);
+                result.backward_speed = std::min(*speed, result.backward_speed);
+            }
+        }
+    }
+
+    void Penalties(const osmium::Way &way, ExtractionWay &result, const WayData &data) const
+    {
+        const auto service_penalty = lookup(service_penalties, get(way, "service")).value_or(1.);
+
+        const auto number_or_infinity = [](const Value value)
+        {
+            return value == nullptr ? std::numeric_limits<double>::infinity()
+                                    : leadingNumber(value).value_or(
+                                          std::numeric_limits<double>::infinity());
+        };
+        const auto width = number_or_infinity(get(way, "width"));
+        const auto lanes = number_or_infinity(get(way, "lanes"));
+        const auto is_bidirectional = result.forward_travel_mode != TRAVEL_MODE_INACCESSIBLE &&
+                                      result.backward_travel_mode != TRAVEL_MODE_INACCESSIBLE;
+        const auto width_penalty = width <= 3 || (lanes <= 1 && is_bidirectional) ? 0.5 : 1.;
+
+        // high frequency reversible oneways, e.g. controlled by traffic signals
+        const auto alternating_penalty = equals(data.oneway, "alternating") ? 0.4 : 1.;
+
+        const auto side_road = get(way, "side_road");
+        const auto sideroad_penalty =
+            equals(side_road, "yes") || equals(side_road, "rotary") ? side_road_multiplier : 1.;
+
+        const auto penalty =
+            std::min({service_penalty, width_penalty, alternating_penalty, sideroad_penalty});
+
+        if (result.forward_speed > 0)
+            result.forward_rate = (result.forward_speed * penalty) / 3.6;
+        if (result.backward_speed > 0)
+            result.backward_rate = (result.backward_speed * penalty) / 3.6;
+        if (result.duration > 0)
+            result.weight = result.duration / penalty;
+    }
+
+    static void Classes(const osmium::Way &way, ExtractionWay &result, const WayData &data)
+    {
+        const auto [forward_toll, backward_toll] = getForwardBackwardByKey(way, data, "toll");
+        const auto [forward_route, backward_route] = getForwardBackwardByKey(way, data, "route");
+        const auto tunnel = get(way, "tunnel");
+
+        if (tunnel != nullptr && !equals(tunnel, "no"))
+        {
+            result.forward_classes["tunnel"] = true;
+            result.backward_classes["tunnel"] = true;
+        }
+        if (equals(forward_toll, "yes"))
+            result.forward_classes["toll"] = true;
+        if (equals(backward_toll, "yes"))
+            result.backward_classes["toll"] = true;
+        if (equals(forward_route, "ferry"))
+            result.forward_classes["ferry"] = true;
+        if (equals(backward_route, "ferry"))
+            result.backward_classes["ferry"] = true;
+        if (result.forward_restricted)
+            result.forward_classes["restricted"] = true;
+        if (result.backward_restricted)
+            result.backward_classes["restricted"] = true;
+        if (equals(data.highway, "motorway") || equals(data.highway, "motorway_link"))
+        {
+            result.forward_classes["motorway"] = true;
+            result.backward_classes["motorway"] = true;
+        }
+    }
+
+    // lib/guidance.lua
+    static void TurnLanes(const osmium::Way &way, ExtractionWay &result, const WayData &data)
+    {
+        const auto [psv_forward, psv_backward] = getForwardBackwardByKey(way, data, "lanes:psv");
+        const auto psv_forward_count = static_cast<std::int32_t>(toNumber(psv_forward).value_or(0));
+        const auto psv_backward_count =
+            static_cast<std::int32_t>(toNumber(psv_backward).value_or(0));
+        const auto [turn_forward, turn_backward] = getForwardBackwardByKey(way, data, "turn:lanes");
+        const auto [vehicle_forward, vehicle_backward] =
+            getForwardBackwardByKey(way, data, "vehicle:lanes");
+
+        // trims lane string with regard to supported lanes
+        const auto process_lanes = [](const Value turn_lanes,
+                                      const Value vehicle_lanes,
+                                      const std::int32_t first_count,
+                                      const std::int32_t second_count) -> std::string
+        {
+            if (vehicle_lanes != nullptr)
+                return applyAccessTokens(turn_lanes, vehicle_lanes);
+            if (first_count != 0 || second_count != 0)
+                return trimLaneString(turn_lanes, first_count, second_count);
+            return turn_lanes;
+        };
+
+        // note: backward lanes swap psv_backward and psv_forward
+        if (turn_forward != nullptr)
+            result.turn_lanes_forward =
+                process_lanes(turn_forward, vehicle_forward, psv_backward_count, psv_forward_count);
+        if (turn_backward != nullptr)
+            result.turn_lanes_backward = process_lanes(
+                turn_backward, vehicle_backward, psv_forward_count, psv_backward_count);
+    }
+
+    static void Classification(const osmium::Way &way, ExtractionWay &result, const WayData &data)
+    {
+        static const Table<RoadPriorityClass::Enum> highway_classes = {
+            {"motorway", RoadPriorityClass::MOTORWAY},
+            {"motorway_link", RoadPriorityClass::MOTORWAY_LINK},
+            {"trunk", RoadPriorityClass::TRUNK},
+            {"trunk_link", RoadPriorityClass::TRUNK_LINK},
+            {"primary", RoadPriorityClass::PRIMARY},
+            {"primary_link", RoadPriorityClass::PRIMARY_LINK},
+            {"secondary", RoadPriorityClass::SECONDARY},
+            {"secondary_link", RoadPriorityClass::SECONDARY_LINK},
+            {"tertiary", RoadPriorityClass::TERTIARY},
+            {"tertiary_link", RoadPriorityClass::TERTIARY_LINK},
+            {"unclassified", RoadPriorityClass::UNCLASSIFIED},
+            {"residential", RoadPriorityClass::MAIN_RESIDENTIAL},
+            // all service roads are recognised as alley
+            {"service", RoadPriorityClass::ALLEY},
+            {"living_street", RoadPriorityClass::SIDE_RESIDENTIAL},
+            {"track", RoadPriorityClass::BIKE_PATH},
+            {"path", RoadPriorityClass::BIKE_PATH},
+            {"footway", RoadPriorityClass::FOOT_PATH},
+            {"pedestrian", RoadPriorityClass::FOOT_PATH},
+            {"steps", RoadPriorityClass::FOOT_PATH}};
+        static const Set motorway_types = {"motorway", "motorway_link", "trunk", "trunk_link"};
+        static const Set link_types = {
+            "motorway_link", "trunk_link", "primary_link", "secondary_link", "tertiary_link"};
+        static const Set road_types = {"motorway",
+                                       "motorway_link",
+                                       "trunk",
+                                       "trunk_link",
+                                       "primary",
+                                       "primary_link",
+                                       "secondary",
+                                       "secondary_link",
+                                       "tertiary",
+                                       "tertiary_link",
+                                       "unclassified",
+                                       "residential",
+                                       "living_street"};
+
+        auto &classification = result.road_classification;
+        if (contains(motorway_types, data.highway))
+            classification.SetMotorwayFlag(true);
+        if (contains(link_types, data.highway))
+            classification.SetLinkClass(true);
+        classification.SetClass(
+            lookup(highway_classes, data.highway).value_or(RoadPriorityClass::CONNECTIVITY));
+        classification.SetLowPriorityFlag(!contains(road_types, data.highway));
+
+        const auto set_lanes = [&](const double lanes)
+        {
+            classification.SetNumberOfLanes(static_cast<std::uint8_t>(std::clamp(lanes, 0., 255.)));
+        };
+        if (const auto lanes = get(way, "lanes"))
+        {
+            if (const auto count = toNumber(lanes))
+                set_lanes(*count);
+        }
+        else
+        {
+            const auto total = toNumber(get(way, "lanes:forward")).value_or(0) +
+                               toNumber(get(way, "lanes:backward")).value_or(0);
+            if (total != 0)
+                set_lanes(total);
+        }
+    }
+
+    static void Roundabouts(const osmium::Way &way, ExtractionWay &result)
+    {
+        const auto junction = get(way, "junction");
+        if (equals(junction, "roundabout"))
+            result.roundabout = true;
+        // roundabout-shaped ways not following roundabout rules, see Issue 3361
+        if (equals(junction, "circular"))
+            result.circular = true;
+    }
+
+    void Startpoint(ExtractionWay &result, const WayData &data) const
+    {
+        result.is_startpoint = result.forward_travel_mode == TRAVEL_MODE_DRIVING ||
+                               result.backward_travel_mode == TRAVEL_MODE_DRIVING;
+        if (equals(data.highway, "service") &&
+            contains(service_access_tag_blacklist, data.forward_access))
+            result.is_startpoint = false;
+    }
+
+    void DrivingSide(const osmium::Way &way, ExtractionWay &result) const
+    {
+        const auto driving_side = get(way, "driving_side");
+        if (equals(driving_side, "left"))
+            result.is_left_hand_driving = true;
+        else if (equals(driving_side, "right"))
+            result.is_left_hand_driving = false;
+        else
+            result.is_left_hand_driving = properties.left_hand_driving;
+    }
+
+    static void Names(const osmium::Way &way, ExtractionWay &result)
+    {
+        if (const auto name = get(way, "name"))
+            result.name = name;
+        if (const auto ref = get(way, "ref"))
+        {
+            result.forward_ref = canonicalizeStringList(ref, ";");
+            result.backward_ref = result.forward_ref;
+        }
+        if (const auto pronunciation = get(way, "name:pronunciation"))
+            result.pronunciation = pronunciation;
+        if (const auto exits = get(way, "junction:ref"))
+            result.exits = canonicalizeStringList(exits, ";");
+    }
+
+    ObstacleMap &obstacle_map;
+    ProfileProperties properties;
+
+    const double default_speed = 10;
+    const double side_road_multiplier = 0.8;
+    const double turn_penalty = 7.5;
+    const double speed_reduction = 0.8;
+    const double turn_bias = 1.075;
+
+    // size of the vehicle, limited by physical restrictions of the way
+    const double vehicle_height = 2.0;
+    const double vehicle_width = 1.9;
+    // size of the vehicle, limited mostly by legal restrictions of the way
+    const double vehicle_length = 4.8;
+    const double vehicle_weight = 2000;
+
+    const Set barrier_whitelist = {"cattle_grid",
+                                   "border_control",
+                                   "toll_booth",
+                                   "sally_port",
+                                   "gate",
+                                   "lift_gate",
+                                   "no",
+                                   "entrance",
+                                   "height_restrictor",
+                                   "arch"};
+    const Set access_tag_whitelist = {
+        "yes", "motorcar", "motor_vehicle", "vehicle", "permissive", "designated", "hov"};
+    const Set access_tag_blacklist = {"no",
+                                      "agricultural",
+                                      "forestry",
+                                      "emergency",
+                                      "psv",
+                                      "customers",
+                                      "private",
+                                      "delivery",
+                                      "destination"};
+    // tags disallow access to in combination with highway=service
+    const Set service_access_tag_blacklist = {"private"};
+    const Set restricted_access_tag_list = {"private", "delivery", "destination", "customers"};
+    const Sequence<4> access_tags_hierarchy = {"motorcar", "motor_vehicle", "vehicle", "access"};
+    const Set service_tag_forbidden = {"emergency_access"};
+    const Sequence<3> restrictions = {"motorcar", "motor_vehicle", "vehicle"};
+    const Set avoid = {
+        "area", "reversible", "impassable", "hov_lanes", "steps", "construction", "proposed"};
+    const Table<double> highway_speeds = {{"motorway", 90},
+                                          {"motorway_link", 45},
+                                          {"trunk", 85},
+                                          {"trunk_link", 40},
+                                          {"primary", 65},
+                                          {"primary_link", 30},
+                                          {"secondary", 55},
+                                          {"secondary_link", 25},
+                                          {"tertiary", 40},
+                                          {"tertiary_link", 20},
+                                          {"unclassified", 25},
+                                          {"residential", 25},
+                                          {"living_street", 10},
+                                          {"service", 15}};
+    const Table<double> service_penalties = {{"alley", 0.5},
+                                             {"parking", 0.5},
+                                             {"parking_aisle", 0.5},
+                                             {"driveway", 0.5},
+                                             {"drive-through", 0.5},
+                                             {"drive-thru", 0.5}};
+    const Set restricted_highway_whitelist = {"motorway",
+                                              "motorway_link",
+                                              "trunk",
+                                              "trunk_link",
+                                              "primary",
+                                              "primary_link",
+                                              "secondary",
+                                              "secondary_link",
+                                              "tertiary",
+                                              "tertiary_link",
+                                              "residential",
+                                              "living_street",
+                                              "unclassified",
+                                              "service"};
+    const Set construction_whitelist = {"no", "widening", "minor"};
+    const Table<double> route_speeds = {{"ferry", 5}, {"shuttle_train", 10}};
+    const Table<double> bridge_speeds = {{"movable", 5}};
+    // max speed for surfaces, tracktypes and smoothnesses
+    const Table<double> surface_speeds = {
+        {"cement", 80},      {"compacted", 80}, {"fine_gravel", 80}, {"paving_stones", 60},
+        {"metal", 60},       {"bricks", 60},    {"grass", 40},       {"wood", 40},
+        {"sett", 40},        {"grass_paver", 40}, {"gravel", 40},    {"unpaved", 40},
+        {"ground", 40},      {"dirt", 40},      {"pebblestone", 40}, {"tartan", 40},
+        {"cobblestone", 30}, {"clay", 30},      {"earth", 20},       {"stone", 20},
+        {"rocky", 20},       {"sand", 20},      {"mud", 10}};
+    const Table<double> tracktype_speeds = {
+        {"grade1", 60}, {"grade2", 40}, {"grade3", 30}, {"grade4", 25}, {"grade5", 20}};
+    const Table<double> smoothness_speeds = {{"intermediate", 80},
+                                             {"bad", 40},
+                                             {"very_bad", 20},
+                                             {"horrible", 10},
+                                             {"very_horrible", 5},
+                                             {"impassable", 0}};
+    // http://wiki.openstreetmap.org/wiki/Speed_limits
+    const Table<double> maxspeed_table_default = {
+        {"urban", 50}, {"rural", 90}, {"trunk", 110}, {"motorway", 130}};
+    // list only exceptions
+    const Table<double> maxspeed_table = {{"at:rural", 100},
+                                          {"at:trunk", 100},
+                                          {"be:motorway", 120},
+                                          {"be-bru:rural", 70},
+                                          {"be-bru:urban", 30},
+                                          {"be-vlg:rural", 70},
+                                          {"bg:motorway", 140},
+                                          {"by:urban", 60},
+                                          {"by:motorway", 110},
+                                          {"ca-on:rural", 80},
+                                          {"ch:rural", 80},
+                                          {"ch:trunk", 100},
+                                          {"ch:motorway", 120},
+                                          {"cz:trunk", 0},
+                                          {"cz:motorway", 0},
+                                          {"de:living_street", 7},
+                                          {"de:rural", 100},
+                                          {"de:motorway", 0},
+                                          {"dk:rural", 80},
+                                          {"es:trunk", 90},
+                                          {"fr:rural", 80},
+                                          {"gb:nsl_single", (60 * 1609) / 1000.},
+                                          {"gb:nsl_dual", (70 * 1609) / 1000.},
+                                          {"gb:motorway", (70 * 1609) / 1000.},
+                                          {"nl:rural", 80},
+                                          {"nl:trunk", 100},
+                                          {"no:rural", 80},
+                                          {"no:motorway", 110},
+                                          {"ph:urban", 40},
+                                          {"ph:rural", 80},
+                                          {"ph:motorway", 100},
+                                          {"pl:rural", 100},
+                                          {"pl:expressway", 120},
+                                          {"pl:motorway", 140},
+                                          {"ro:trunk", 100},
+                                          {"ru:living_street", 20},
+                                          {"ru:urban", 60},
+                                          {"ru:motorway", 110},
+                                          {"uk:nsl_single", (60 * 1609) / 1000.},
+                                          {"uk:nsl_dual", (70 * 1609) / 1000.},
+                                          {"uk:motorway", (70 * 1609) / 1000.},
+                                          {"za:urban", 60},
+                                          {"za:rural", 100},
+                                          {"none", 140}};
+};
+
+} // namespace
+
+OSRM_PROFILE_PLUGIN(CarProfile)
@@ -16,3 +16,8 @@ do
     { set +x; } 2>/dev/null
   done
 done
+
+# The compiled car profile gets no location-dependent data
+set -x
+OSRM_PROFILE_PLUGINS=1 node ./node_modules/cucumber/bin/cucumber.js features/car/ -p mld -m mmap --tags ~@location_dependent_data
+{ set +x; } 2>/dev/null
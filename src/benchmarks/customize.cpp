@@ -0,0 +1,127 @@
+#include "customizer/cell_customizer.hpp"
+#include "customizer/edge_based_graph.hpp"
+
+#include "extractor/files.hpp"
+
+#include "partitioner/cell_storage.hpp"
+#include "partitioner/edge_based_graph_reader.hpp"
+#include "partitioner/files.hpp"
+#include "partitioner/multi_level_partition.hpp"
+
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace osrm;
+
+// The matrix search is disabled by default in osrm-customize, compare it at this threshold
+constexpr std::size_t DEFAULT_MATRIX_MIN_SOURCES = 16;
+
+// Customizes all cells and returns the time in milliseconds
+double measure_customization(const customizer::CellCustomizer &customizer,
+                             const partitioner::MultiLevelEdgeBasedGraph &graph,
+                             const partitioner::CellStorage &storage,
+                             const std::vector<bool> &node_filter,
+                             customizer::CellMetric &metric)
+{
+    TIMER_START(customize);
+    customizer.Customize(graph, storage, node_filter, metric);
+    TIMER_STOP(customize);
+
+    return TIMER_MSEC(customize);
+}
+
+int main(int argc, char **argv)
+try
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    if (argc < 2)
+    {
+        std::cerr << "./customize-bench file.osrm [matrix min sources]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::filesystem::path base_path(argv[1]);
+    const auto matrix_min_sources =
+        argc > 2 ? std::stoul(argv[2]) : DEFAULT_MATRIX_MIN_SOURCES;
+    const auto path = [&base_path](const std::string &extension)
+    {
+        auto path = base_path;
+        path.replace_extension(extension);
+        return path;
+    };
+
+    partitioner::MultiLevelPartition mlp;
+    partitioner::files::readPartition(path(".osrm.partition"), mlp);
+
+    partitioner::CellStorage storage;
+    partitioner::files::readCells(path(".osrm.cells"), storage);
+
+    EdgeID num_nodes = 0;
+    std::vector<extractor::EdgeBasedEdge> edges;
+    std::uint32_t connectivity_checksum = 0;
+    extractor::files::readEdgeBasedGraph(
+        path(".osrm.ebg"), num_nodes, edges, connectivity_checksum);
+
+    auto directed = partitioner::splitBidirectionalEdges(edges);
+    auto tidied = partitioner::prepareEdgesForUsageInGraph<
+        typename partitioner::MultiLevelEdgeBasedGraph::InputEdge>(std::move(directed));
+    const partitioner::MultiLevelEdgeBasedGraph graph(mlp, num_nodes, tidied);
+    const std::vector<bool> node_filter(graph.GetNumberOfNodes(), true);
+
+    const customizer::CellCustomizer dijkstra_customizer(mlp,
+                                                         std::numeric_limits<std::size_t>::max());
+    const customizer::CellCustomizer matrix_customizer(mlp, matrix_min_sources);
+
+    auto dijkstra_metric = storage.MakeMetric();
+    const auto dijkstra_ms =
+        measure_customization(dijkstra_customizer, graph, storage, node_filter, dijkstra_metric);
+    auto matrix_metric = storage.MakeMetric();
+    const auto matrix_ms =
+        measure_customization(matrix_customizer, graph, storage, node_filter, matrix_metric);
+
+    // Both searches find shortest paths, only paths of equal weight may differ in duration and
+    // distance
+    std::size_t different_weights = 0;
+    std::size_t different_durations = 0;
+    std::size_t different_distances = 0;
+    for (std::size_t index = 0; index < dijkstra_metric.weights.size(); ++index)
+    {
+        different_weights += dijkstra_metric.weights[index] != matrix_metric.weights[index];
+        different_durations += dijkstra_metric.durations[index] != matrix_metric.durations[index];
+        different_distances += dijkstra_metric.distances[index] != matrix_metric.distances[index];
+    }
+
+    std::cout << "nodes: " << graph.GetNumberOfNodes() << " edges: " << graph.GetNumberOfEdges()
+              << "\n";
+    for (std::size_t level = 1; level < mlp.GetNumberOfLevels(); ++level)
+    {
+        std::size_t matrix_cells = 0;
+        for (CellID id = 0; id < mlp.GetNumberOfCells(level); ++id)
+        {
+            matrix_cells +=
+                level > 1 && static_cast<std::size_t>(storage.GetCell(dijkstra_metric, level, id)
+                                                          .GetSourceNodes()
+                                                          .size()) >= matrix_min_sources;
+        }
+        std::cout << "level " << level << ": " << mlp.GetNumberOfCells(level) << " cells, "
+                  << matrix_cells << " customized with the matrix search\n";
+    }
+    std::cout << "customization of all cells:\ndijkstra " << dijkstra_ms << " ms\nmatrix "
+              << matrix_ms << " ms (min " << matrix_min_sources << " sources)\n"
+              << "different weights: " << different_weights
+              << "\ndifferent durations: " << different_durations
+              << "\ndifferent distances: " << different_distances << std::endl;
+
+    return different_weights == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+catch (const std::exception &e)
+{
+    util::Log(logERROR) << "Error: " << e.what();
+    return EXIT_FAILURE;
+}
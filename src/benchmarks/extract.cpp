@@ -0,0 +1,54 @@
+#include "osrm/extractor.hpp"
+#include "osrm/extractor_config.hpp"
+
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+using namespace osrm;
+
+// Extracts the same file with every given profile, e.g. to compare profiles/car.lua with the
+// compiled profiles/car.so, and reports the wall time of each extraction
+int main(int argc, char **argv)
+try
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    if (argc < 3)
+    {
+        std::cerr << "./extract-bench file.osm.pbf profile [profile...]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // the output of all runs goes to the same temporary files
+    const auto output_base = std::filesystem::temp_directory_path() / "extract-bench.osrm";
+
+    for (int index = 2; index < argc; ++index)
+    {
+        extractor::ExtractorConfig config;
+        config.input_path = argv[1];
+        config.profile_path = argv[index];
+        config.requested_num_threads = std::thread::hardware_concurrency();
+        config.UseDefaultOutputNames(output_base);
+
+        util::LogPolicy::GetInstance().SetLevel(logWARNING);
+        TIMER_START(extract);
+        osrm::extract(config);
+        TIMER_STOP(extract);
+        util::LogPolicy::GetInstance().SetLevel(logINFO);
+
+        std::cout << config.profile_path.string() << ": " << std::fixed << std::setprecision(2)
+                  << TIMER_SEC(extract) << "s" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    util::Log(logERROR) << "Error: " << e.what();
+    return EXIT_FAILURE;
+}
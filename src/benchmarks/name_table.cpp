@@ -0,0 +1,107 @@
+#include "extractor/files.hpp"
+#include "extractor/name_table.hpp"
+
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string_view>
+#include <vector>
+
+using namespace osrm;
+
+#ifdef _WIN32
+#pragma optimize("", off)
+template <class T> void dont_optimize_away(T &&datum) { T local = datum; }
+#pragma optimize("", on)
+#else
+template <class T> void dont_optimize_away(T &&datum) { asm volatile("" : "+r"(datum)); }
+#endif
+
+// Looks up all strings of a name id like the step assembly does for every turn
+double measure_step_lookups(const extractor::NameTable &name_table,
+                            const std::vector<NameID> &name_ids)
+{
+    TIMER_START(lookup);
+    std::size_t sum = 0;
+    for (const auto id : name_ids)
+    {
+        const auto name = name_table.GetNameForID(id);
+        const auto ref = name_table.GetRefForID(id);
+        const auto pronunciation = name_table.GetPronunciationForID(id);
+        const auto destinations = name_table.GetDestinationsForID(id);
+        const auto exits = name_table.GetExitsForID(id);
+        sum += name.size() + ref.size() + pronunciation.size() + destinations.size() + exits.size();
+        dont_optimize_away(sum);
+    }
+    TIMER_STOP(lookup);
+
+    return TIMER_MSEC(lookup);
+}
+
+int main(int argc, char **argv)
+try
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    if (argc < 2)
+    {
+        std::cerr << "./name-table-bench file.osrm.names" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::filesystem::path path(argv[1]);
+    extractor::NameTable input;
+    extractor::files::readNames(path, input);
+
+    // Every name id has five strings: name, destinations, pronunciation, ref and exits
+    std::vector<NameID> name_ids;
+    std::vector<std::size_t> offsets = {0};
+    std::vector<char> data;
+    for (NameID id = 0; id < input.GetNameIDUpperBound(); id += 5)
+    {
+        name_ids.push_back(id);
+        for (const auto &value : {input.GetNameForID(id),
+                                  input.GetDestinationsForID(id),
+                                  input.GetPronunciationForID(id),
+                                  input.GetRefForID(id),
+                                  input.GetExitsForID(id)})
+        {
+            const std::string_view view = value.get();
+            data.insert(data.end(), view.begin(), view.end());
+            offsets.push_back(data.size());
+        }
+    }
+    std::mt19937 g(1337);
+    std::shuffle(name_ids.begin(), name_ids.end(), g);
+
+    const extractor::NameTable plain{
+        extractor::NameTable::IndexedData(offsets.begin(), offsets.end(), data.begin())};
+
+    TIMER_START(compress);
+    const auto compressed =
+        extractor::NameTable::MakeCompressed(offsets.begin(), offsets.end(), data.begin());
+    TIMER_STOP(compress);
+
+    const auto plain_ms = measure_step_lookups(plain, name_ids);
+    const auto compressed_ms = measure_step_lookups(compressed, name_ids);
+    const auto lookups = 5. * name_ids.size();
+
+    std::cout << "name ids: " << name_ids.size() << "\n"
+              << "size:\nplain " << plain.GetSizeInBytes() / 1024 << " KiB\ncompressed "
+              << compressed.GetSizeInBytes() / 1024 << " KiB (" << TIMER_MSEC(compress)
+              << " ms to encode)\n"
+              << "lookups of all strings of a name id in random order:\nplain " << plain_ms
+              << " ms (" << plain_ms * 1e6 / lookups << " ns/lookup)\ncompressed " << compressed_ms
+              << " ms (" << compressed_ms * 1e6 / lookups << " ns/lookup)" << std::endl;
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    util::Log(logERROR) << "Error: " << e.what();
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,90 @@
+#include "extractor/files.hpp"
+#include "extractor/segment_data_container.hpp"
+
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace osrm;
+
+#ifdef _WIN32
+#pragma optimize("", off)
+template <class T> void dont_optimize_away(T &&datum) { T local = datum; }
+#pragma optimize("", on)
+#else
+template <class T> void dont_optimize_away(T &&datum) { asm volatile("" : "+r"(datum)); }
+#endif
+
+// Measures the time to access every geometry in random order
+double measure_random_access(const extractor::SegmentDataContainer &segment_data,
+                             const std::vector<std::uint32_t> &geometry_ids)
+{
+    TIMER_START(read);
+    NodeID sum = 0;
+    for (const auto id : geometry_ids)
+    {
+        for (const auto node : segment_data.GetForwardGeometry(id))
+            sum += node;
+        dont_optimize_away(sum);
+    }
+    TIMER_STOP(read);
+
+    return TIMER_MSEC(read);
+}
+
+int main(int argc, char **argv)
+try
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    if (argc < 2)
+    {
+        std::cerr << "./segment-geometry-bench file.osrm.geometry" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::filesystem::path path(argv[1]);
+    extractor::SegmentDataContainer segment_data;
+    extractor::files::readSegmentData(path, segment_data);
+    if (segment_data.HasCompressedNodes())
+    {
+        std::cerr << "Expected a dataset extracted without --compress-geometry" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::uint32_t> geometry_ids(segment_data.GetNumberOfGeometries());
+    std::iota(geometry_ids.begin(), geometry_ids.end(), 0);
+    std::mt19937 g(1337);
+    std::shuffle(geometry_ids.begin(), geometry_ids.end(), g);
+
+    const auto plain_bytes = segment_data.GetNodesSizeInBytes();
+    const auto plain_ms = measure_random_access(segment_data, geometry_ids);
+
+    TIMER_START(compress);
+    auto compressed_segment_data = segment_data;
+    compressed_segment_data.CompressNodes();
+    TIMER_STOP(compress);
+
+    const auto compressed_bytes = compressed_segment_data.GetNodesSizeInBytes();
+    const auto compressed_ms = measure_random_access(compressed_segment_data, geometry_ids);
+
+    std::cout << "geometries: " << geometry_ids.size() << "\n"
+              << "node lists:\nplain " << plain_bytes / 1024 / 1024 << " MiB\ncompressed "
+              << compressed_bytes / 1024 / 1024 << " MiB (" << TIMER_MSEC(compress)
+              << " ms to encode)\n"
+              << "random access of all geometries:\nplain " << plain_ms << " ms\ncompressed "
+              << compressed_ms << " ms\nslowdown: " << compressed_ms / plain_ms << std::endl;
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    util::Log(logERROR) << "Error: " << e.what();
+    return EXIT_FAILURE;
+}
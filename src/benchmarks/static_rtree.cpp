@@ -1,4 +1,5 @@
 #include "util/static_rtree.hpp"
+#include "util/bounding_box_kernels.hpp"
 #include "extractor/edge_based_node_segment.hpp"
 #include "extractor/files.hpp"
 #include "extractor/packed_osm_ids.hpp"
@@ -64,6 +65,102 @@ void benchmark(BenchStaticRTree &rtree, unsigned num_queries)
     benchmarkQuery(queries,
                    "10 results",
                    [&rtree](const util::Coordinate &q) { return rtree.Nearest(q, 10); });
+    benchmarkQuery(queries,
+                   "snapping within 1000m",
+                   [&rtree](const util::Coordinate &q)
+                   {
+                       return rtree.SearchInRange(
+                           q, 1000, [](const auto &) { return std::make_pair(true, true); });
+                   });
+}
+
+// Compares the bounding box tests of one tree node with all children against the scalar loops
+void benchmarkBoxKernels(unsigned num_nodes)
+{
+    constexpr std::size_t BRANCHING_FACTOR = 64;
+
+    std::mt19937 mt_rand(RANDOM_SEED);
+    std::uniform_int_distribution<> lat_udist(WORLD_MIN_LAT, WORLD_MAX_LAT);
+    std::uniform_int_distribution<> lon_udist(WORLD_MIN_LON, WORLD_MAX_LON);
+    std::vector<std::int32_t> min_lons, max_lons, min_lats, max_lats;
+    for (unsigned i = 0; i < num_nodes * BRANCHING_FACTOR; i++)
+    {
+        const auto lon = lon_udist(mt_rand) / 2;
+        const auto lat = lat_udist(mt_rand) / 2;
+        min_lons.push_back(lon);
+        max_lons.push_back(lon + COORDINATE_PRECISION);
+        min_lats.push_back(lat);
+        max_lats.push_back(lat + COORDINATE_PRECISION);
+    }
+    const util::Coordinate location{util::FixedLongitude{0}, util::FixedLatitude{0}};
+    const util::RectangleInt2D box{util::FloatLongitude{-10.},
+                                   util::FloatLongitude{10.},
+                                   util::FloatLatitude{-10.},
+                                   util::FloatLatitude{10.}};
+
+    std::uint64_t checksum = 0;
+    std::array<std::uint64_t, BRANCHING_FACTOR> distances;
+    const auto run = [&](const std::string &name, auto distance_kernel, auto intersection_kernel)
+    {
+        TIMER_START(distances);
+        for (std::size_t first = 0; first < min_lons.size(); first += BRANCHING_FACTOR)
+        {
+            distance_kernel(min_lons.data() + first,
+                            max_lons.data() + first,
+                            min_lats.data() + first,
+                            max_lats.data() + first,
+                            BRANCHING_FACTOR,
+                            location,
+                            distances.data());
+            checksum += distances[first % BRANCHING_FACTOR];
+        }
+        TIMER_STOP(distances);
+
+        TIMER_START(intersections);
+        for (std::size_t first = 0; first < min_lons.size(); first += BRANCHING_FACTOR)
+        {
+            checksum += intersection_kernel(min_lons.data() + first,
+                                            max_lons.data() + first,
+                                            min_lats.data() + first,
+                                            max_lats.data() + first,
+                                            BRANCHING_FACTOR,
+                                            box);
+        }
+        TIMER_STOP(intersections);
+
+        std::cout << name << ":\n"
+                  << TIMER_MSEC(distances) * 1e6 / num_nodes << " ns/node for min distances\n"
+                  << TIMER_MSEC(intersections) * 1e6 / num_nodes << " ns/node for intersections"
+                  << std::endl;
+    };
+
+    run(
+        "scalar box tests",
+        [](const std::int32_t *min_lons_,
+           const std::int32_t *max_lons_,
+           const std::int32_t *min_lats_,
+           const std::int32_t *max_lats_,
+           const std::size_t count,
+           const util::Coordinate location_,
+           std::uint64_t *distances_)
+        {
+            util::bounding_box_kernels::detail::minSquaredDistancesScalar(
+                min_lons_,
+                max_lons_,
+                min_lats_,
+                max_lats_,
+                count,
+                static_cast<std::int32_t>(location_.lon),
+                static_cast<std::int32_t>(location_.lat),
+                distances_);
+        },
+        [](auto... args)
+        { return util::bounding_box_kernels::detail::intersectingBoxesScalar(args...); });
+    run(
+        "vectorized box tests",
+        [](auto... args) { util::bounding_box_kernels::minSquaredDistances(args...); },
+        [](auto... args) { return util::bounding_box_kernels::intersectingBoxes(args...); });
+    std::cout << "checksum " << checksum << std::endl;
 }
 } // namespace osrm::benchmarks
 
@@ -87,6 +184,7 @@ int main(int argc, char **argv)
     osrm::extractor::files::readRamIndex(ram_path, rtree);
 
     osrm::benchmarks::benchmark(rtree, 10000);
+    osrm::benchmarks::benchmarkBoxKernels(100000);
 
     return 0;
 }
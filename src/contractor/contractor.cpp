@@ -1,6 +1,7 @@
 #include "contractor/contractor.hpp"
 #include "contractor/contract_excludable_graph.hpp"
 #include "contractor/contracted_edge_container.hpp"
+#include "contractor/customizable_contraction.hpp"
 #include "contractor/files.hpp"
 #include "contractor/graph_contractor.hpp"
 #include "contractor/graph_contractor_adaptors.hpp"
@@ -10,6 +11,9 @@
 #include "extractor/files.hpp"
 #include "extractor/node_based_edge.hpp"
 
+#include "partitioner/files.hpp"
+#include "partitioner/multi_level_partition.hpp"
+
 #include "storage/io.hpp"
 
 #include "updater/updater.hpp"
@@ -27,6 +31,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <filesystem>
 #include <iterator>
 #include <vector>
 
@@ -34,6 +39,45 @@
 
 namespace osrm::contractor
 {
+namespace
+{
+// The shortcut topology only depends on the partition and the connectivity of the graph and is
+// reused as long as both did not change.
+CustomizableGraph loadCustomizableGraph(const ContractorConfig &config,
+                                        const NodeID number_of_nodes,
+                                        const std::vector<extractor::EdgeBasedEdge> &edges,
+                                        const std::uint32_t connectivity_checksum)
+{
+    const auto partition_path = config.GetPath(".osrm.partition");
+    const auto graph_path = config.GetPath(".osrm.cch");
+    if (!std::filesystem::exists(partition_path))
+    {
+        throw util::exception("Customizable contraction requires " + partition_path.string() +
+                              ", run osrm-partition first" + SOURCE_REF);
+    }
+
+    CustomizableGraph graph;
+    if (std::filesystem::exists(graph_path) &&
+        std::filesystem::last_write_time(graph_path) >=
+            std::filesystem::last_write_time(partition_path))
+    {
+        std::uint32_t graph_checksum = 0;
+        files::readCustomizableGraph(graph_path, graph, graph_checksum);
+        if (graph_checksum == connectivity_checksum && graph.GetNumberOfNodes() == number_of_nodes)
+        {
+            util::Log() << "Loaded contraction order from " << graph_path;
+            return graph;
+        }
+    }
+
+    partitioner::MultiLevelPartition partition;
+    partitioner::files::readPartition(partition_path, partition);
+    graph = makeCustomizableGraph(partition, number_of_nodes, edges);
+    files::writeCustomizableGraph(graph_path, graph, connectivity_checksum);
+
+    return graph;
+}
+} // namespace
 
 int Contractor::Run()
 {
@@ -84,10 +128,20 @@ int Contractor::Run()
     QueryGraph query_graph;
     std::vector<std::vector<bool>> edge_filters;
     std::vector<std::vector<bool>> cores;
-    std::tie(query_graph, edge_filters) = contractExcludableGraph(
-        toContractorGraph(number_of_edge_based_nodes, std::move(edge_based_edge_list)),
-        std::move(node_weights),
-        node_filters);
+    if (config.customizable)
+    {
+        const auto customizable_graph = loadCustomizableGraph(
+            config, number_of_edge_based_nodes, edge_based_edge_list, connectivity_checksum);
+        std::tie(query_graph, edge_filters) =
+            customizeExcludableGraph(customizable_graph, edge_based_edge_list, node_filters);
+    }
+    else
+    {
+        std::tie(query_graph, edge_filters) = contractExcludableGraph(
+            toContractorGraph(number_of_edge_based_nodes, std::move(edge_based_edge_list)),
+            std::move(node_weights),
+            node_filters);
+    }
     TIMER_STOP(contraction);
     util::Log() << "Contracted graph has " << query_graph.GetNumberOfEdges() << " edges.";
     util::Log() << "Contraction took " << TIMER_SEC(contraction) << " sec";
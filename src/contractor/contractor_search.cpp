@@ -57,6 +57,7 @@ void search(ContractorHeap &heap,
             const std::vector<bool> &contractable,
             const unsigned number_of_targets,
             const int node_limit,
+            const short hop_limit,
             const EdgeWeight weight_limit,
             const NodeID forbidden_node)
 {
@@ -86,6 +87,12 @@ void search(ContractorHeap &heap,
             }
         }
 
+        // Paths with more hops are not considered as witnesses
+        if (heap.GetData(node).hop >= hop_limit)
+        {
+            continue;
+        }
+
         relaxNode(heap, graph, contractable, node, node_weight, forbidden_node);
     }
 }
@@ -0,0 +1,411 @@
+#include "contractor/customizable_contraction.hpp"
+#include "contractor/contracted_edge_container.hpp"
+
+#include "util/integer_range.hpp"
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+
+#include <boost/assert.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace osrm::contractor
+{
+namespace
+{
+struct ArcMetric
+{
+    EdgeWeight weight = INVALID_EDGE_WEIGHT;
+    EdgeDuration duration = MAXIMAL_EDGE_DURATION;
+    EdgeDistance distance = MAXIMAL_EDGE_DISTANCE;
+    // either the turn id of an original edge or the middle node of a shortcut
+    NodeID id = SPECIAL_NODEID;
+    bool shortcut = false;
+
+    bool IsValid() const { return weight != INVALID_EDGE_WEIGHT; }
+
+    bool operator<(const ArcMetric &other) const
+    {
+        return std::tie(weight, duration, distance) <
+               std::tie(other.weight, other.duration, other.distance);
+    }
+};
+
+// Two arcs that form a path of the weight of both, the middle node is the one they share
+inline void relax(ArcMetric &metric,
+                  const ArcMetric &first,
+                  const ArcMetric &second,
+                  const NodeID middle_node)
+{
+    if (!first.IsValid() || !second.IsValid())
+        return;
+
+    ArcMetric candidate{first.weight + second.weight,
+                        first.duration + second.duration,
+                        first.distance + second.distance,
+                        middle_node,
+                        true};
+    if (candidate < metric)
+        metric = candidate;
+}
+
+inline QueryEdge makeQueryEdge(const NodeID source,
+                               const NodeID target,
+                               const ArcMetric &metric,
+                               const bool forward,
+                               const bool backward)
+{
+    return QueryEdge{source,
+                     target,
+                     QueryEdge::EdgeData{metric.id,
+                                         metric.shortcut,
+                                         metric.weight,
+                                         metric.duration,
+                                         metric.distance,
+                                         forward,
+                                         backward}};
+}
+
+inline bool hasSameData(const ArcMetric &lhs, const ArcMetric &rhs)
+{
+    return std::tie(lhs.weight, lhs.duration, lhs.distance, lhs.id, lhs.shortcut) ==
+           std::tie(rhs.weight, rhs.duration, rhs.distance, rhs.id, rhs.shortcut);
+}
+} // namespace
+
+CustomizableGraph makeCustomizableGraph(const partitioner::MultiLevelPartition &partition,
+                                        const NodeID number_of_nodes,
+                                        const std::vector<extractor::EdgeBasedEdge> &edges)
+{
+    TIMER_START(order);
+
+    // Nodes are only contracted after all nodes of a lower key. Nodes that are connected to a
+    // different cell on level l have key l, so every cell is contracted before its border.
+    std::vector<LevelID> keys(number_of_nodes, 0);
+    std::vector<std::vector<NodeID>> adjacency(number_of_nodes);
+    for (const auto &edge : edges)
+    {
+        if (edge.source == edge.target)
+            continue;
+
+        const auto level = partition.GetHighestDifferentLevel(edge.source, edge.target);
+        keys[edge.source] = std::max(keys[edge.source], level);
+        keys[edge.target] = std::max(keys[edge.target], level);
+        adjacency[edge.source].push_back(edge.target);
+        adjacency[edge.target].push_back(edge.source);
+    }
+    tbb::parallel_for(tbb::blocked_range<NodeID>(0, number_of_nodes),
+                      [&](const auto &range)
+                      {
+                          for (auto node = range.begin(); node < range.end(); ++node)
+                          {
+                              auto &neighbours = adjacency[node];
+                              std::sort(neighbours.begin(), neighbours.end());
+                              neighbours.erase(std::unique(neighbours.begin(), neighbours.end()),
+                                               neighbours.end());
+                          }
+                      });
+
+    // Minimum degree ordering inside of the keys. The entries of the queue are invalidated lazily
+    // if the degree of a node changes.
+    using QueueEntry = std::tuple<LevelID, std::size_t, NodeID>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    for (const auto node : util::irange<NodeID>(0, number_of_nodes))
+    {
+        queue.emplace(keys[node], adjacency[node].size(), node);
+    }
+
+    CustomizableGraph graph;
+    graph.order.reserve(number_of_nodes);
+    graph.ranks.resize(number_of_nodes, SPECIAL_NODEID);
+    std::vector<std::vector<NodeID>> upward_neighbours(number_of_nodes);
+    std::vector<NodeID> merged;
+    while (!queue.empty())
+    {
+        const auto [key, degree, node] = queue.top();
+        queue.pop();
+        if (graph.ranks[node] != SPECIAL_NODEID || degree != adjacency[node].size())
+            continue;
+
+        graph.ranks[node] = static_cast<NodeID>(graph.order.size());
+        graph.order.push_back(node);
+
+        // All remaining neighbours form a clique after the node is contracted
+        const auto &neighbours = adjacency[node];
+        for (const auto neighbour : neighbours)
+        {
+            const auto &old_neighbours = adjacency[neighbour];
+            merged.clear();
+            std::set_union(old_neighbours.begin(),
+                           old_neighbours.end(),
+                           neighbours.begin(),
+                           neighbours.end(),
+                           std::back_inserter(merged));
+            merged.erase(std::remove_if(merged.begin(),
+                                        merged.end(),
+                                        [&](const NodeID other)
+                                        { return other == node || other == neighbour; }),
+                         merged.end());
+            if (merged.size() != old_neighbours.size())
+            {
+                queue.emplace(keys[neighbour], merged.size(), neighbour);
+            }
+            adjacency[neighbour].swap(merged);
+        }
+        upward_neighbours[node] = std::move(adjacency[node]);
+        adjacency[node].clear();
+    }
+    BOOST_ASSERT(graph.order.size() == number_of_nodes);
+
+    graph.first_arc.reserve(number_of_nodes + 1);
+    graph.first_arc.push_back(0);
+    for (const auto node : graph.order)
+    {
+        auto &neighbours = upward_neighbours[node];
+        const auto begin = graph.heads.size();
+        for (const auto neighbour : neighbours)
+        {
+            graph.heads.push_back(graph.ranks[neighbour]);
+        }
+        std::sort(graph.heads.begin() + begin, graph.heads.end());
+        graph.first_arc.push_back(static_cast<EdgeID>(graph.heads.size()));
+        std::vector<NodeID>().swap(neighbours);
+    }
+
+    TIMER_STOP(order);
+    util::Log() << "Computed contraction order with " << graph.GetNumberOfArcs() << " arcs in "
+                << TIMER_SEC(order) << " seconds";
+
+    return graph;
+}
+
+std::vector<QueryEdge> customizeGraph(const CustomizableGraph &graph,
+                                      const std::vector<extractor::EdgeBasedEdge> &edges,
+                                      const std::vector<bool> &node_filter)
+{
+    TIMER_START(customize);
+
+    const auto number_of_nodes = graph.GetNumberOfNodes();
+    const auto number_of_arcs = graph.GetNumberOfArcs();
+    BOOST_ASSERT(node_filter.size() == number_of_nodes);
+
+    // forward is the direction from the lower to the upper rank
+    std::vector<ArcMetric> forward_metrics(number_of_arcs);
+    std::vector<ArcMetric> backward_metrics(number_of_arcs);
+    for (const auto &edge : edges)
+    {
+        if (edge.source == edge.target || edge.data.weight == INVALID_EDGE_WEIGHT ||
+            !node_filter[edge.source] || !node_filter[edge.target])
+            continue;
+
+        const auto source_rank = graph.ranks[edge.source];
+        const auto target_rank = graph.ranks[edge.target];
+        const auto arc = graph.FindArc(std::min(source_rank, target_rank),
+                                       std::max(source_rank, target_rank));
+        BOOST_ASSERT_MSG(arc != SPECIAL_EDGEID, "edge is missing in the customizable graph");
+
+        const ArcMetric metric{std::max(edge.data.weight, {1}),
+                               to_alias<EdgeDuration>(edge.data.duration),
+                               edge.data.distance,
+                               edge.data.turn_id,
+                               false};
+        const bool is_upward = source_rank < target_rank;
+        if (edge.data.forward)
+        {
+            auto &current = is_upward ? forward_metrics[arc] : backward_metrics[arc];
+            current = std::min(current, metric);
+        }
+        if (edge.data.backward)
+        {
+            auto &current = is_upward ? backward_metrics[arc] : forward_metrics[arc];
+            current = std::min(current, metric);
+        }
+    }
+
+    // Arcs from lower ranks to each rank, the triangles of these arcs update the arcs of the rank
+    std::vector<EdgeID> first_downward_arc(number_of_nodes + 1, 0);
+    for (const auto head : graph.heads)
+    {
+        ++first_downward_arc[head + 1];
+    }
+    std::partial_sum(
+        first_downward_arc.begin(), first_downward_arc.end(), first_downward_arc.begin());
+    std::vector<std::pair<NodeID, EdgeID>> downward_arcs(number_of_arcs);
+    {
+        auto positions = first_downward_arc;
+        for (const auto rank : util::irange<NodeID>(0, number_of_nodes))
+        {
+            for (const auto arc : util::irange(graph.first_arc[rank], graph.first_arc[rank + 1]))
+            {
+                downward_arcs[positions[graph.heads[arc]]++] = {rank, arc};
+            }
+        }
+    }
+
+    // All ranks of a level only depend on ranks of lower levels and can be customized in parallel
+    std::vector<NodeID> levels(number_of_nodes, 0);
+    NodeID number_of_levels = 0;
+    for (const auto rank : util::irange<NodeID>(0, number_of_nodes))
+    {
+        number_of_levels = std::max(number_of_levels, levels[rank] + 1);
+        for (const auto arc : util::irange(graph.first_arc[rank], graph.first_arc[rank + 1]))
+        {
+            levels[graph.heads[arc]] = std::max(levels[graph.heads[arc]], levels[rank] + 1);
+        }
+    }
+    std::vector<NodeID> first_level_rank(number_of_levels + 1, 0);
+    for (const auto level : levels)
+    {
+        ++first_level_rank[level + 1];
+    }
+    std::partial_sum(first_level_rank.begin(), first_level_rank.end(), first_level_rank.begin());
+    std::vector<NodeID> level_ranks(number_of_nodes);
+    {
+        auto positions = first_level_rank;
+        for (const auto rank : util::irange<NodeID>(0, number_of_nodes))
+        {
+            level_ranks[positions[levels[rank]]++] = rank;
+        }
+    }
+
+    std::vector<ArcMetric> loop_metrics(number_of_nodes);
+    const auto customize_rank = [&](const NodeID rank)
+    {
+        const auto arcs_begin = graph.heads.begin() + graph.first_arc[rank];
+        const auto arcs_end = graph.heads.begin() + graph.first_arc[rank + 1];
+        for (const auto index :
+             util::irange(first_downward_arc[rank], first_downward_arc[rank + 1]))
+        {
+            const auto [lower_rank, lower_arc] = downward_arcs[index];
+            const auto middle_node = graph.order[lower_rank];
+            relax(loop_metrics[rank],
+                  backward_metrics[lower_arc],
+                  forward_metrics[lower_arc],
+                  middle_node);
+
+            // The upper neighbours of the lower rank are a subset of the upper neighbours of the
+            // rank, both are sorted
+            auto arc_iter = arcs_begin;
+            for (const auto other_arc :
+                 util::irange<EdgeID>(lower_arc + 1, graph.first_arc[lower_rank + 1]))
+            {
+                arc_iter = std::lower_bound(arc_iter, arcs_end, graph.heads[other_arc]);
+                BOOST_ASSERT(arc_iter != arcs_end && *arc_iter == graph.heads[other_arc]);
+                const auto arc = static_cast<EdgeID>(arc_iter - graph.heads.begin());
+                relax(forward_metrics[arc],
+                      backward_metrics[lower_arc],
+                      forward_metrics[other_arc],
+                      middle_node);
+                relax(backward_metrics[arc],
+                      backward_metrics[other_arc],
+                      forward_metrics[lower_arc],
+                      middle_node);
+            }
+        }
+    };
+    for (const auto level : util::irange<NodeID>(0, number_of_levels))
+    {
+        tbb::parallel_for(tbb::blocked_range<NodeID>(first_level_rank[level],
+                                                     first_level_rank[level + 1]),
+                          [&](const auto &range)
+                          {
+                              for (auto index = range.begin(); index < range.end(); ++index)
+                              {
+                                  customize_rank(level_ranks[index]);
+                              }
+                          });
+    }
+
+    // Edges are stored at the node with the lower rank, like in the contracted graph
+    std::vector<QueryEdge> query_edges;
+    for (const auto rank : util::irange<NodeID>(0, number_of_nodes))
+    {
+        const auto node = graph.order[rank];
+        if (loop_metrics[rank].IsValid())
+        {
+            query_edges.push_back(makeQueryEdge(node, node, loop_metrics[rank], true, true));
+        }
+        for (const auto arc : util::irange(graph.first_arc[rank], graph.first_arc[rank + 1]))
+        {
+            const auto target = graph.order[graph.heads[arc]];
+            const auto &forward = forward_metrics[arc];
+            const auto &backward = backward_metrics[arc];
+            if (forward.IsValid() && backward.IsValid() && hasSameData(forward, backward))
+            {
+                query_edges.push_back(makeQueryEdge(node, target, forward, true, true));
+                continue;
+            }
+            if (forward.IsValid())
+            {
+                query_edges.push_back(makeQueryEdge(node, target, forward, true, false));
+            }
+            if (backward.IsValid())
+            {
+                query_edges.push_back(makeQueryEdge(node, target, backward, false, true));
+            }
+        }
+    }
+    // Sorted by all properties, this is the order ContractedEdgeContainer::Merge expects
+    tbb::parallel_sort(query_edges.begin(),
+                       query_edges.end(),
+                       [](const QueryEdge &lhs, const QueryEdge &rhs)
+                       {
+                           return std::tie(lhs.source,
+                                           lhs.target,
+                                           lhs.data.shortcut,
+                                           lhs.data.turn_id,
+                                           lhs.data.weight,
+                                           lhs.data.duration,
+                                           lhs.data.forward,
+                                           lhs.data.backward) < std::tie(rhs.source,
+                                                                         rhs.target,
+                                                                         rhs.data.shortcut,
+                                                                         rhs.data.turn_id,
+                                                                         rhs.data.weight,
+                                                                         rhs.data.duration,
+                                                                         rhs.data.forward,
+                                                                         rhs.data.backward);
+                       });
+
+    TIMER_STOP(customize);
+    util::Log() << "Customized " << number_of_arcs << " arcs on " << number_of_levels
+                << " levels in " << TIMER_SEC(customize) << " seconds";
+
+    return query_edges;
+}
+
+GraphAndFilter customizeExcludableGraph(const CustomizableGraph &graph,
+                                        const std::vector<extractor::EdgeBasedEdge> &edges,
+                                        const std::vector<std::vector<bool>> &filters)
+{
+    const auto number_of_nodes = graph.GetNumberOfNodes();
+    if (filters.size() == 1 &&
+        std::all_of(filters.front().begin(), filters.front().end(), [](auto v) { return v; }))
+    {
+        auto query_edges = customizeGraph(graph, edges, filters.front());
+        std::vector<bool> edge_filter(query_edges.size(), true);
+        return GraphAndFilter{QueryGraph{number_of_nodes, query_edges}, {std::move(edge_filter)}};
+    }
+
+    ContractedEdgeContainer edge_container;
+    for (const auto &filter : filters)
+    {
+        edge_container.Merge(customizeGraph(graph, edges, filter));
+    }
+
+    return GraphAndFilter{QueryGraph{number_of_nodes, edge_container.edges},
+                          edge_container.MakeEdgeFilters()};
+}
+
+} // namespace osrm::contractor
@@ -16,9 +16,13 @@
 #include <tbb/enumerable_thread_specific.h>
 #include <tbb/parallel_for.h>
 #include <tbb/parallel_invoke.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/parallel_scan.h>
 #include <tbb/parallel_sort.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <limits>
 #include <memory>
 #include <vector>
@@ -46,7 +50,8 @@ struct ContractorNodeData
                        std::vector<bool> contractable_,
                        std::vector<EdgeWeight> weights_)
         : is_core(std::move(uncontracted_nodes_)), contractable(std::move(contractable_)),
-          priorities(number_of_nodes), weights(std::move(weights_)), depths(number_of_nodes, 0)
+          priorities(number_of_nodes), weights(std::move(weights_)), depths(number_of_nodes, 0),
+          outdated(number_of_nodes, false)
     {
         if (contractable.empty())
         {
@@ -65,7 +70,8 @@ struct ContractorNodeData
             [&] { util::inplacePermutation(weights.begin(), weights.end(), old_to_new); },
             [&] { util::inplacePermutation(is_core.begin(), is_core.end(), old_to_new); },
             [&] { util::inplacePermutation(contractable.begin(), contractable.end(), old_to_new); },
-            [&] { util::inplacePermutation(depths.begin(), depths.end(), old_to_new); });
+            [&] { util::inplacePermutation(depths.begin(), depths.end(), old_to_new); },
+            [&] { util::inplacePermutation(outdated.begin(), outdated.end(), old_to_new); });
     }
 
     std::vector<bool> is_core;
@@ -73,6 +79,27 @@ struct ContractorNodeData
     std::vector<NodePriority> priorities;
     std::vector<EdgeWeight> weights;
     std::vector<NodeDepth> depths;
+    // Priorities are only re-evaluated if a node is about to be contracted. This is written in
+    // parallel for the neighbours of the contracted nodes and can't be a std::vector<bool>.
+    std::vector<std::uint8_t> outdated;
+};
+
+// Limits of the witness searches. A search that stops early only adds more shortcuts, in the
+// sparse graph at the start of the contraction short searches find almost all witnesses.
+struct WitnessSearchLimits
+{
+    static constexpr int SIMULATION_SEARCH_SPACE_SIZE = 1000;
+    static constexpr int FULL_SEARCH_SPACE_SIZE = 2000;
+
+    explicit WitnessSearchLimits(const double average_degree)
+        : hops(average_degree < 3.3 ? 5
+               : average_degree < 5 ? 7
+               : average_degree < 10 ? 10
+                                     : std::numeric_limits<short>::max())
+    {
+    }
+
+    short hops;
 };
 
 struct ContractionStats
@@ -139,6 +166,7 @@ void ContractNode(ContractorThreadData *data,
                   const NodeID node,
                   std::vector<EdgeWeight> &node_weights,
                   const std::vector<bool> &contractable,
+                  const WitnessSearchLimits &limits,
                   ContractionStats *stats = nullptr)
 {
     auto &heap = data->heap;
@@ -245,23 +273,23 @@ void ContractNode(ContractorThreadData *data,
 
         if (RUNSIMULATION)
         {
-            const int constexpr SIMULATION_SEARCH_SPACE_SIZE = 1000;
             search(heap,
                    graph,
                    contractable,
                    number_of_targets,
-                   SIMULATION_SEARCH_SPACE_SIZE,
+                   WitnessSearchLimits::SIMULATION_SEARCH_SPACE_SIZE,
+                   limits.hops,
                    max_weight,
                    node);
         }
         else
         {
-            const int constexpr FULL_SEARCH_SPACE_SIZE = 2000;
             search(heap,
                    graph,
                    contractable,
                    number_of_targets,
-                   FULL_SEARCH_SPACE_SIZE,
+                   WitnessSearchLimits::FULL_SEARCH_SPACE_SIZE,
+                   limits.hops,
                    max_weight,
                    node);
         }
@@ -358,19 +386,21 @@ void ContractNode(ContractorThreadData *data,
                   const ContractorGraph &graph,
                   const NodeID node,
                   std::vector<EdgeWeight> &node_weights,
-                  const std::vector<bool> &contractable)
+                  const std::vector<bool> &contractable,
+                  const WitnessSearchLimits &limits)
 {
-    ContractNode<false>(data, graph, node, node_weights, contractable, nullptr);
+    ContractNode<false>(data, graph, node, node_weights, contractable, limits, nullptr);
 }
 
 ContractionStats SimulateNodeContraction(ContractorThreadData *data,
                                          const ContractorGraph &graph,
                                          const NodeID node,
                                          std::vector<EdgeWeight> &node_weights,
-                                         const std::vector<bool> &contractable)
+                                         const std::vector<bool> &contractable,
+                                         const WitnessSearchLimits &limits)
 {
     ContractionStats stats;
-    ContractNode<true>(data, graph, node, node_weights, contractable, &stats);
+    ContractNode<true>(data, graph, node, node_weights, contractable, limits, &stats);
     return stats;
 }
 
@@ -378,17 +408,21 @@ void RenumberGraph(ContractorGraph &graph, const std::vector<NodeID> &old_to_new
 {
     graph.Renumber(old_to_new);
     // Renumber all shortcut node IDs
-    for (const auto node : util::irange<NodeID>(0, graph.GetNumberOfNodes()))
-    {
-        for (const auto edge : graph.GetAdjacentEdgeRange(node))
-        {
-            auto &data = graph.GetEdgeData(edge);
-            if (data.shortcut)
-            {
-                data.id = old_to_new[data.id];
-            }
-        }
-    }
+    tbb::parallel_for(tbb::blocked_range<NodeID>(0, graph.GetNumberOfNodes()),
+                      [&](const auto &range)
+                      {
+                          for (auto node = range.begin(); node < range.end(); ++node)
+                          {
+                              for (const auto edge : graph.GetAdjacentEdgeRange(node))
+                              {
+                                  auto &data = graph.GetEdgeData(edge);
+                                  if (data.shortcut)
+                                  {
+                                      data.id = old_to_new[data.id];
+                                  }
+                              }
+                          }
+                      });
 }
 
 /* Reorder nodes for better locality during contraction */
@@ -397,33 +431,52 @@ void RenumberData(std::vector<RemainingNodeData> &remaining_nodes,
                   ContractorNodeData &node_data,
                   ContractorGraph &graph)
 {
-    std::vector<NodeID> current_to_new_node_id(graph.GetNumberOfNodes(), SPECIAL_NODEID);
+    const NodeID number_of_nodes = graph.GetNumberOfNodes();
+    std::vector<NodeID> current_to_new_node_id(number_of_nodes, SPECIAL_NODEID);
 
     // we need to make a copy here because we are going to modify it
     auto to_orig = new_to_old_node_id;
 
-    auto new_node_id = 0u;
-
     // All remaining nodes get the low IDs
-    for (auto &remaining : remaining_nodes)
-    {
-        auto id = new_node_id++;
-        current_to_new_node_id[remaining.id] = id;
-        new_to_old_node_id[id] = to_orig[remaining.id];
-        remaining.id = id;
-    }
-
-    // Already contracted nodes get the high IDs
-    for (const auto current_id : util::irange<std::size_t>(0, graph.GetNumberOfNodes()))
-    {
-        if (current_to_new_node_id[current_id] == SPECIAL_NODEID)
+    const NodeID number_of_remaining_nodes = remaining_nodes.size();
+    tbb::parallel_for(tbb::blocked_range<NodeID>(0, number_of_remaining_nodes),
+                      [&](const auto &range)
+                      {
+                          for (auto id = range.begin(); id < range.end(); ++id)
+                          {
+                              auto &remaining = remaining_nodes[id];
+                              current_to_new_node_id[remaining.id] = id;
+                              new_to_old_node_id[id] = to_orig[remaining.id];
+                              remaining.id = id;
+                          }
+                      });
+
+    // Already contracted nodes get the high IDs, in the order of their current IDs
+    const auto number_of_contracted_nodes = tbb::parallel_scan(
+        tbb::blocked_range<NodeID>(0, number_of_nodes),
+        NodeID{0},
+        [&](const auto &range, NodeID contracted_before, const bool is_final_scan)
         {
-            auto id = new_node_id++;
-            current_to_new_node_id[current_id] = id;
-            new_to_old_node_id[id] = to_orig[current_id];
-        }
-    }
-    BOOST_ASSERT(new_node_id == graph.GetNumberOfNodes());
+            for (auto current_id = range.begin(); current_id < range.end(); ++current_id)
+            {
+                if (current_to_new_node_id[current_id] != SPECIAL_NODEID &&
+                    current_to_new_node_id[current_id] < number_of_remaining_nodes)
+                {
+                    continue;
+                }
+                if (is_final_scan)
+                {
+                    const auto id = number_of_remaining_nodes + contracted_before;
+                    current_to_new_node_id[current_id] = id;
+                    new_to_old_node_id[id] = to_orig[current_id];
+                }
+                ++contracted_before;
+            }
+            return contracted_before;
+        },
+        std::plus<NodeID>());
+    BOOST_ASSERT(number_of_remaining_nodes + number_of_contracted_nodes == number_of_nodes);
+    (void)number_of_contracted_nodes;
 
     node_data.Renumber(current_to_new_node_id);
     RenumberGraph(graph, current_to_new_node_id);
@@ -473,15 +526,12 @@ void DeleteIncomingEdges(ContractorThreadData *data, ContractorGraph &graph, con
     }
 }
 
-bool UpdateNodeNeighbours(ContractorNodeData &node_data,
-                          ContractorThreadData *data,
+// The neighbours of independent nodes are disjoint, so this can run in parallel. Their priorities
+// are only re-evaluated once they are about to be contracted.
+void UpdateNodeNeighbours(ContractorNodeData &node_data,
                           const ContractorGraph &graph,
                           const NodeID node)
 {
-    std::vector<NodeID> &neighbours = data->neighbours;
-    neighbours.clear();
-
-    // find all neighbours
     for (auto e : graph.GetAdjacentEdgeRange(node))
     {
         const NodeID u = graph.GetTarget(e);
@@ -489,24 +539,150 @@ bool UpdateNodeNeighbours(ContractorNodeData &node_data,
         {
             continue;
         }
-        neighbours.push_back(u);
         node_data.depths[u] = std::max(node_data.depths[node] + 1, node_data.depths[u]);
+        node_data.outdated[u] = node_data.contractable[u];
     }
-    // eliminate duplicate entries ( forward + backward edges )
-    std::sort(neighbours.begin(), neighbours.end());
-    neighbours.resize(std::unique(neighbours.begin(), neighbours.end()) - neighbours.begin());
+}
 
-    // re-evaluate priorities of neighboring nodes
-    for (const NodeID u : neighbours)
+// Inserts the shortcuts of all threads into the graph. Shortcuts that duplicate an existing
+// shortcut only update its weight. The edges are sorted by source and all edges of a source are
+// handled by the same task.
+void InsertShortcuts(ContractorGraph &graph, ThreadDataContainer &thread_data_list)
+{
+    std::vector<ContractorThreadData *> thread_data;
+    std::vector<std::size_t> thread_offsets = {0};
+    for (auto &data : thread_data_list.data)
     {
-        if (node_data.contractable[u])
+        thread_data.push_back(data.get());
+        thread_offsets.push_back(thread_offsets.back() + data->inserted_edges.size());
+    }
+
+    std::vector<ContractorEdge> edges(thread_offsets.back());
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, thread_data.size(), 1),
+                      [&](const auto &range)
+                      {
+                          for (auto index = range.begin(); index < range.end(); ++index)
+                          {
+                              auto &inserted_edges = thread_data[index]->inserted_edges;
+                              std::copy(inserted_edges.begin(),
+                                        inserted_edges.end(),
+                                        edges.begin() + thread_offsets[index]);
+                              inserted_edges.clear();
+                          }
+                      });
+    tbb::parallel_sort(edges.begin(), edges.end());
+
+    std::vector<std::uint8_t> is_duplicate(edges.size(), false);
+    tbb::parallel_for(
+        tbb::blocked_range<std::size_t>(0, edges.size()),
+        [&](const auto &range)
         {
-            node_data.priorities[u] = EvaluateNodePriority(
-                SimulateNodeContraction(data, graph, u, node_data.weights, node_data.contractable),
-                node_data.depths[u]);
+            // move the bounds of the range to the first edge of a source
+            auto begin = range.begin();
+            while (begin > 0 && begin < edges.size() &&
+                   edges[begin - 1].source == edges[begin].source)
+            {
+                ++begin;
+            }
+            auto end = range.end();
+            while (end < edges.size() && edges[end - 1].source == edges[end].source)
+            {
+                ++end;
+            }
+
+            for (auto index = begin; index < end; ++index)
+            {
+                const auto &edge = edges[index];
+                const EdgeID current_edge_ID = graph.FindEdge(edge.source, edge.target);
+                if (current_edge_ID != SPECIAL_EDGEID)
+                {
+                    auto &current_data = graph.GetEdgeData(current_edge_ID);
+                    if (current_data.shortcut && edge.data.forward == current_data.forward &&
+                        edge.data.backward == current_data.backward)
+                    {
+                        // found a duplicate edge with smaller weight, update it.
+                        if (edge.data.weight < current_data.weight)
+                        {
+                            current_data = edge.data;
+                        }
+                        // don't insert duplicates
+                        is_duplicate[index] = true;
+                        continue;
+                    }
+                }
+
+                // duplicates of the new edges of the same contraction round
+                for (auto other = index; other > begin && edges[other - 1].source == edge.source &&
+                                         edges[other - 1].target == edge.target;
+                     --other)
+                {
+                    auto &other_edge = edges[other - 1];
+                    if (!is_duplicate[other - 1] && edge.data.forward == other_edge.data.forward &&
+                        edge.data.backward == other_edge.data.backward)
+                    {
+                        if (edge.data.weight < other_edge.data.weight)
+                        {
+                            other_edge.data = edge.data;
+                        }
+                        is_duplicate[index] = true;
+                        break;
+                    }
+                }
+            }
+        });
+
+    std::size_t number_of_new_edges = 0;
+    for (const auto index : util::irange<std::size_t>(0, edges.size()))
+    {
+        if (!is_duplicate[index])
+        {
+            edges[number_of_new_edges++] = edges[index];
         }
     }
-    return true;
+    edges.resize(number_of_new_edges);
+
+    graph.InsertEdges(edges);
+}
+
+std::size_t CountOutdatedPriorities(const ContractorNodeData &node_data,
+                                    const std::vector<RemainingNodeData> &remaining_nodes)
+{
+    return tbb::parallel_reduce(
+        tbb::blocked_range<std::size_t>(0, remaining_nodes.size()),
+        std::size_t{0},
+        [&](const auto &range, std::size_t sum)
+        {
+            for (auto index = range.begin(); index < range.end(); ++index)
+            {
+                sum += node_data.outdated[remaining_nodes[index].id];
+            }
+            return sum;
+        },
+        std::plus<std::size_t>());
+}
+
+// Average number of edges of the remaining nodes, this grows with the number of shortcuts
+double AverageDegree(const ContractorGraph &graph,
+                     const std::vector<RemainingNodeData> &remaining_nodes)
+{
+    if (remaining_nodes.empty())
+    {
+        return 0;
+    }
+
+    const auto number_of_edges = tbb::parallel_reduce(
+        tbb::blocked_range<std::size_t>(0, remaining_nodes.size()),
+        std::uint64_t{0},
+        [&](const auto &range, std::uint64_t sum)
+        {
+            for (auto index = range.begin(); index < range.end(); ++index)
+            {
+                sum += graph.GetOutDegree(remaining_nodes[index].id);
+            }
+            return sum;
+        },
+        std::plus<std::uint64_t>());
+    return static_cast<double>(number_of_edges) / remaining_nodes.size();
 }
 
 bool IsNodeIndependent(const util::XORFastHash<> &hash,
@@ -594,6 +770,8 @@ std::vector<bool> contractGraph(ContractorGraph &graph,
     const constexpr size_t ContractGrainSize = 1;
     const constexpr size_t NeighboursGrainSize = 1;
     const constexpr size_t DeleteGrainSize = 1;
+    // fraction of the remaining nodes with outdated priorities before all of them are updated
+    const constexpr double MAX_OUTDATED_PRIORITIES = 0.5;
 
     const NodeID number_of_nodes = graph.GetNumberOfNodes();
 
@@ -634,6 +812,7 @@ std::vector<bool> contractGraph(ContractorGraph &graph,
     {
         util::UnbufferedLog log;
         log << "initializing node priorities...";
+        const WitnessSearchLimits limits(AverageDegree(graph, remaining_nodes));
         tbb::parallel_for(
             tbb::blocked_range<std::size_t>(0, remaining_nodes.size(), PQGrainSize),
             [&](const auto &range)
@@ -645,7 +824,7 @@ std::vector<bool> contractGraph(ContractorGraph &graph,
                     BOOST_ASSERT(node_data.contractable[node]);
                     node_data.priorities[node] = EvaluateNodePriority(
                         SimulateNodeContraction(
-                            data, graph, node, node_data.weights, node_data.contractable),
+                            data, graph, node, node_data.weights, node_data.contractable, limits),
                         node_data.depths[node]);
                 }
             });
@@ -673,19 +852,74 @@ std::vector<bool> contractGraph(ContractorGraph &graph,
             next_renumbering = 0;
         }
 
-        tbb::parallel_for(
-            tbb::blocked_range<NodeID>(0, remaining_nodes.size(), IndependentGrainSize),
-            [&](const auto &range)
-            {
-                ContractorThreadData *data = thread_data_list.GetThreadData();
-                // determine independent node set
-                for (auto i = range.begin(), end = range.end(); i != end; ++i)
+        const WitnessSearchLimits limits(AverageDegree(graph, remaining_nodes));
+
+        // Re-evaluates the outdated priorities of the selected nodes and returns their number
+        const auto update_priorities = [&](const auto &is_selected)
+        {
+            std::atomic<std::size_t> number_of_updates = 0;
+            tbb::parallel_for(
+                tbb::blocked_range<NodeID>(0, remaining_nodes.size(), IndependentGrainSize),
+                [&](const auto &range)
                 {
-                    const NodeID node = remaining_nodes[i].id;
-                    remaining_nodes[i].is_independent = IsNodeIndependent(
-                        hash, node_data.priorities, new_to_old_node_id, graph, data, node);
-                }
-            });
+                    ContractorThreadData *data = thread_data_list.GetThreadData();
+                    for (auto i = range.begin(), end = range.end(); i != end; ++i)
+                    {
+                        const NodeID node = remaining_nodes[i].id;
+                        if (node_data.outdated[node] && is_selected(remaining_nodes[i]))
+                        {
+                            node_data.priorities[node] = EvaluateNodePriority(
+                                SimulateNodeContraction(data,
+                                                        graph,
+                                                        node,
+                                                        node_data.weights,
+                                                        node_data.contractable,
+                                                        limits),
+                                node_data.depths[node]);
+                            node_data.outdated[node] = false;
+                            ++number_of_updates;
+                        }
+                    }
+                });
+            return number_of_updates.load();
+        };
+
+        const auto select_independent_nodes = [&](const bool only_selected)
+        {
+            tbb::parallel_for(
+                tbb::blocked_range<NodeID>(0, remaining_nodes.size(), IndependentGrainSize),
+                [&](const auto &range)
+                {
+                    ContractorThreadData *data = thread_data_list.GetThreadData();
+                    // determine independent node set
+                    for (auto i = range.begin(), end = range.end(); i != end; ++i)
+                    {
+                        const NodeID node = remaining_nodes[i].id;
+                        if (only_selected && !remaining_nodes[i].is_independent)
+                        {
+                            continue;
+                        }
+                        remaining_nodes[i].is_independent = IsNodeIndependent(
+                            hash, node_data.priorities, new_to_old_node_id, graph, data, node);
+                    }
+                });
+        };
+
+        // Priorities that decreased are only found by re-evaluating all outdated priorities, this
+        // is done once too many of them are outdated.
+        if (CountOutdatedPriorities(node_data, remaining_nodes) >
+            MAX_OUTDATED_PRIORITIES * remaining_nodes.size())
+        {
+            update_priorities([](const auto &) { return true; });
+        }
+        select_independent_nodes(false);
+
+        // Lazily re-evaluate the outdated priorities of the independent nodes. A node with a
+        // higher priority might not be independent anymore, so all of them are checked again.
+        if (update_priorities([](const auto &remaining) { return remaining.is_independent; }) > 0)
+        {
+            select_independent_nodes(true);
+        }
 
         // sort all remaining nodes to the beginning of the sequence
         const auto begin_independent_nodes = std::stable_partition(
@@ -706,7 +940,8 @@ std::vector<bool> contractGraph(ContractorGraph &graph,
                 for (auto position = range.begin(), end = range.end(); position != end; ++position)
                 {
                     const NodeID node = remaining_nodes[position].id;
-                    ContractNode(data, graph, node, node_data.weights, node_data.contractable);
+                    ContractNode(
+                        data, graph, node, node_data.weights, node_data.contractable, limits);
                 }
             });
 
@@ -730,56 +965,22 @@ std::vector<bool> contractGraph(ContractorGraph &graph,
                 }
             });
 
-        // make sure we really sort each block
-        tbb::parallel_for(thread_data_list.data.range(),
-                          [&](const auto &range)
-                          {
-                              for (auto &data : range)
-                                  tbb::parallel_sort(data->inserted_edges.begin(),
-                                                     data->inserted_edges.end());
-                          });
-
-        // insert new edges
-        for (auto &data : thread_data_list.data)
-        {
-            for (const ContractorEdge &edge : data->inserted_edges)
-            {
-                const EdgeID current_edge_ID = graph.FindEdge(edge.source, edge.target);
-                if (current_edge_ID != SPECIAL_EDGEID)
-                {
-                    auto &current_data = graph.GetEdgeData(current_edge_ID);
-                    if (current_data.shortcut && edge.data.forward == current_data.forward &&
-                        edge.data.backward == current_data.backward)
-                    {
-                        // found a duplicate edge with smaller weight, update it.
-                        if (edge.data.weight < current_data.weight)
-                        {
-                            current_data = edge.data;
-                        }
-                        // don't insert duplicates
-                        continue;
-                    }
-                }
-                graph.InsertEdge(edge.source, edge.target, edge.data);
-            }
-            data->inserted_edges.clear();
-        }
+        InsertShortcuts(graph, thread_data_list);
 
         tbb::parallel_for(
             tbb::blocked_range<NodeID>(
                 begin_independent_nodes_idx, end_independent_nodes_idx, NeighboursGrainSize),
             [&](const auto &range)
             {
-                ContractorThreadData *data = thread_data_list.GetThreadData();
                 for (auto position = range.begin(), end = range.end(); position != end; ++position)
                 {
                     NodeID node = remaining_nodes[position].id;
-                    UpdateNodeNeighbours(node_data, data, graph, node);
+                    UpdateNodeNeighbours(node_data, graph, node);
                 }
             });
 
-        // remove contracted nodes from the pool
-        BOOST_ASSERT(end_independent_nodes_idx - begin_independent_nodes_idx > 0);
+        // remove contracted nodes from the pool, a round without independent nodes only updated
+        // outdated priorities
         number_of_contracted_nodes += end_independent_nodes_idx - begin_independent_nodes_idx;
         remaining_nodes.resize(begin_independent_nodes_idx);
 
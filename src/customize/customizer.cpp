@@ -23,6 +23,10 @@
 
 #include <tbb/global_control.h>
 
+#include <algorithm>
+#include <filesystem>
+#include <iterator>
+
 namespace osrm::customizer
 {
 
@@ -76,13 +80,17 @@ auto LoadAndUpdateEdgeExpandedGraph(const CustomizationConfig &config,
                                     std::vector<EdgeWeight> &node_weights,
                                     std::vector<EdgeDuration> &node_durations,
                                     std::vector<EdgeDistance> &node_distances,
+                                    std::vector<NodeID> &updated_nodes,
                                     std::uint32_t &connectivity_checksum)
 {
     updater::Updater updater(config.updater_config);
 
     std::vector<extractor::EdgeBasedEdge> edge_based_edge_list;
-    EdgeID num_nodes = updater.LoadAndUpdateEdgeExpandedGraph(
-        edge_based_edge_list, node_weights, node_durations, connectivity_checksum);
+    EdgeID num_nodes = updater.LoadAndUpdateEdgeExpandedGraph(edge_based_edge_list,
+                                                              node_weights,
+                                                              node_durations,
+                                                              updated_nodes,
+                                                              connectivity_checksum);
 
     extractor::files::readEdgeBasedNodeDistances(config.GetPath(".osrm.enw"), node_distances);
 
@@ -113,6 +121,76 @@ std::vector<CellMetric> customizeFilteredMetrics(const partitioner::MultiLevelEd
 
     return metrics;
 }
+
+// Loads the metrics of the last customization if they can be updated in place. The edges of
+// the nodes updated by the last customization got their original weights back, so these nodes
+// are added to `updated_nodes`.
+bool loadPreviousMetrics(const CustomizationConfig &config,
+                         const partitioner::CellStorage &storage,
+                         const std::string &metric_name,
+                         const std::size_t number_of_filters,
+                         const std::uint32_t connectivity_checksum,
+                         std::vector<NodeID> &updated_nodes,
+                         std::vector<CellMetric> &metrics)
+{
+    const auto metrics_path = config.GetPath(".osrm.cell_metrics");
+    const auto updated_nodes_path = config.GetPath(".osrm.updated_nodes");
+    if (!std::filesystem::exists(metrics_path) || !std::filesystem::exists(updated_nodes_path))
+    {
+        util::Log(logWARNING) << "No previous customization found, customizing all cells";
+        return false;
+    }
+
+    if (std::filesystem::last_write_time(config.GetPath(".osrm.cells")) >
+        std::filesystem::last_write_time(metrics_path))
+    {
+        util::Log(logWARNING) << "Cells changed since the previous customization, customizing "
+                                 "all cells";
+        return false;
+    }
+
+    std::vector<NodeID> previous_updated_nodes;
+    std::uint32_t previous_connectivity_checksum = 0;
+    files::readUpdatedNodes(
+        updated_nodes_path, previous_updated_nodes, previous_connectivity_checksum);
+    if (previous_connectivity_checksum != connectivity_checksum)
+    {
+        util::Log(logWARNING) << "Graph changed since the previous customization, customizing "
+                                 "all cells";
+        return false;
+    }
+
+    std::unordered_map<std::string, std::vector<CellMetric>> previous_metrics = {
+        {metric_name, {}}};
+    files::readCellMetrics(metrics_path, previous_metrics);
+    auto &metric_exclude_classes = previous_metrics[metric_name];
+
+    const auto metric_size = storage.MakeMetric().weights.size();
+    const auto has_metric_size = [metric_size](const auto &metric)
+    {
+        return metric.weights.size() == metric_size && metric.durations.size() == metric_size &&
+               metric.distances.size() == metric_size;
+    };
+    if (metric_exclude_classes.size() != number_of_filters ||
+        !std::all_of(
+            metric_exclude_classes.begin(), metric_exclude_classes.end(), has_metric_size))
+    {
+        util::Log(logWARNING) << "Previous metrics don't match the cells, customizing all cells";
+        return false;
+    }
+
+    std::vector<NodeID> merged_nodes;
+    merged_nodes.reserve(updated_nodes.size() + previous_updated_nodes.size());
+    std::set_union(updated_nodes.begin(),
+                   updated_nodes.end(),
+                   previous_updated_nodes.begin(),
+                   previous_updated_nodes.end(),
+                   std::back_inserter(merged_nodes));
+    updated_nodes = std::move(merged_nodes);
+    metrics = std::move(metric_exclude_classes);
+
+    return true;
+}
 } // namespace
 
 int Customizer::Run(const CustomizationConfig &config)
@@ -128,9 +206,15 @@ int Customizer::Run(const CustomizationConfig &config)
     std::vector<EdgeWeight> node_weights;
     std::vector<EdgeDuration> node_durations; // TODO: remove when durations are optional
     std::vector<EdgeDistance> node_distances; // TODO: remove when distances are optional
+    std::vector<NodeID> updated_nodes;
     std::uint32_t connectivity_checksum = 0;
-    auto graph = LoadAndUpdateEdgeExpandedGraph(
-        config, mlp, node_weights, node_durations, node_distances, connectivity_checksum);
+    auto graph = LoadAndUpdateEdgeExpandedGraph(config,
+                                                mlp,
+                                                node_weights,
+                                                node_durations,
+                                                node_distances,
+                                                updated_nodes,
+                                                connectivity_checksum);
     BOOST_ASSERT(graph.GetNumberOfNodes() == node_weights.size());
     std::for_each(
         node_weights.begin(), node_weights.end(), [](auto &w) { w &= EdgeWeight{0x7fffffff}; });
@@ -151,7 +235,39 @@ int Customizer::Run(const CustomizationConfig &config)
 
     TIMER_START(cell_customize);
     auto filter = util::excludeFlagsToNodeFilter(graph.GetNumberOfNodes(), node_data, properties);
-    auto metrics = customizeFilteredMetrics(graph, storage, CellCustomizer{mlp}, filter);
+    const CellCustomizer customizer{mlp, config.matrix_min_sources};
+    std::vector<CellMetric> metrics;
+    // the nodes updated by this run are needed by the next incremental run
+    std::vector<NodeID> changed_nodes = updated_nodes;
+    if (config.incremental && loadPreviousMetrics(config,
+                                                  storage,
+                                                  properties.GetWeightName(),
+                                                  filter.size(),
+                                                  connectivity_checksum,
+                                                  changed_nodes,
+                                                  metrics))
+    {
+        const auto dirty_cells = customizer.GetDirtyCells(graph, changed_nodes);
+        std::size_t num_dirty_cells = 0;
+        std::size_t num_cells = 0;
+        for (std::size_t level = 1; level < mlp.GetNumberOfLevels(); ++level)
+        {
+            num_dirty_cells +=
+                std::count(dirty_cells[level].begin(), dirty_cells[level].end(), true);
+            num_cells += dirty_cells[level].size();
+        }
+        util::Log() << "Customizing " << num_dirty_cells << " of " << num_cells
+                    << " cells changed by " << changed_nodes.size() << " nodes";
+
+        for (std::size_t index = 0; index < filter.size(); ++index)
+        {
+            customizer.Customize(graph, storage, filter[index], metrics[index], dirty_cells);
+        }
+    }
+    else
+    {
+        metrics = customizeFilteredMetrics(graph, storage, customizer, filter);
+    }
     TIMER_STOP(cell_customize);
     util::Log() << "Cells customization took " << TIMER_SEC(cell_customize) << " seconds";
 
@@ -166,6 +282,8 @@ int Customizer::Run(const CustomizationConfig &config)
         {properties.GetWeightName(), std::move(metrics)},
     };
     files::writeCellMetrics(config.GetPath(".osrm.cell_metrics"), metric_exclude_classes);
+    files::writeUpdatedNodes(
+        config.GetPath(".osrm.updated_nodes"), updated_nodes, connectivity_checksum);
     TIMER_STOP(writing_mld_data);
     util::Log() << "MLD customization writing took " << TIMER_SEC(writing_mld_data) << " seconds";
 
@@ -0,0 +1,41 @@
+#include "engine/datafacade/shadow_memory_allocator.hpp"
+
+#include "storage/block.hpp"
+
+#include "boost/assert.hpp"
+
+#include <cstring>
+
+namespace osrm::engine::datafacade
+{
+
+ShadowMemoryAllocator::ShadowMemoryAllocator(std::shared_ptr<ContiguousBlockAllocator> base_,
+                                             const storage::SharedDataIndex &source,
+                                             const std::vector<std::string> &block_names)
+    : base(std::move(base_))
+{
+    BOOST_ASSERT(base);
+
+    auto layout = std::make_shared<storage::ContiguousDataLayout>();
+    for (const auto &name : block_names)
+    {
+        layout->SetBlock(name,
+                         storage::Block{source.GetBlockEntries(name), source.GetBlockSize(name)});
+    }
+
+    internal_memory = std::make_unique<char[]>(layout->GetSizeOfLayout());
+    for (const auto &name : block_names)
+    {
+        std::memcpy(layout->GetBlockPtr(internal_memory.get(), name),
+                    source.GetBlockPtr<char>(name),
+                    source.GetBlockSize(name));
+    }
+
+    index = base->GetIndex().Overlay({internal_memory.get(), std::move(layout)});
+}
+
+ShadowMemoryAllocator::~ShadowMemoryAllocator() {}
+
+const storage::SharedDataIndex &ShadowMemoryAllocator::GetIndex() { return index; }
+
+} // namespace osrm::engine::datafacade
@@ -20,8 +20,12 @@ bool EngineConfig::IsValid() const
                               unlimited_or_more_than(max_results_nearest, 0) &&
                               unlimited_or_more_than(default_radius, 0) && max_alternatives >= 0;
 
+    // traffic updates are published through the shared memory data watchdog
+    const bool traffic_updates_valid = traffic_update_directory.empty() ||
+                                       (use_shared_memory && algorithm == Algorithm::MLD);
+
     return ((use_shared_memory && all_path_are_empty) || (use_mmap && storage_config.IsValid()) ||
             storage_config.IsValid()) &&
-           limits_valid;
+           limits_valid && traffic_updates_valid;
 }
 } // namespace osrm::engine
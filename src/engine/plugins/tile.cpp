@@ -518,7 +518,7 @@ void encodeVectorTile(const DataFacadeBase &facade,
                                 std::string(facade.GetDatasourceName(forward_datasource_idx)));
                             fbuilder.set_weight(from_alias<double>(forward_weight) / 10.0);
                             fbuilder.set_duration(from_alias<double>(forward_duration) / 10.0);
-                            fbuilder.set_name(name);
+                            fbuilder.set_name(name.get());
                             fbuilder.set_rate(forward_rate / 10.0);
                             fbuilder.set_is_startpoint(is_startpoint);
 
@@ -552,7 +552,7 @@ void encodeVectorTile(const DataFacadeBase &facade,
                                 std::string(facade.GetDatasourceName(reverse_datasource_idx)));
                             fbuilder.set_weight(from_alias<double>(reverse_weight) / 10.0);
                             fbuilder.set_duration(from_alias<double>(reverse_duration) / 10.0);
-                            fbuilder.set_name(name);
+                            fbuilder.set_name(name.get());
                             fbuilder.set_rate(reverse_rate / 10.0);
                             fbuilder.set_is_startpoint(is_startpoint);
 
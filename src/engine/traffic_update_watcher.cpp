@@ -0,0 +1,549 @@
+#include "engine/traffic_update_watcher.hpp"
+#include "engine/datafacade/shadow_memory_allocator.hpp"
+
+#include "customizer/cell_customizer.hpp"
+#include "customizer/cell_metric.hpp"
+#include "extractor/datasources.hpp"
+#include "extractor/profile_properties.hpp"
+#include "partitioner/cell_storage.hpp"
+#include "partitioner/multi_level_partition.hpp"
+#include "storage/view_factory.hpp"
+#include "updater/csv_source.hpp"
+#include "updater/edge_weight.hpp"
+#include "updater/speed_conversion.hpp"
+
+#include "util/coordinate_calculation.hpp"
+#include "util/exception.hpp"
+#include "util/exclude_flag.hpp"
+#include "util/for_each_pair.hpp"
+#include "util/integer_range.hpp"
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+
+#include <tbb/blocked_range.h>
+#include <tbb/concurrent_vector.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <ranges>
+#include <string>
+#include <tuple>
+
+namespace osrm::engine
+{
+
+namespace
+{
+const std::string SEGMENT_DATA = "/common/segment_data";
+const std::string GRAPH = "/mld/multilevelgraph";
+const std::string DATASOURCES = "/common/data_sources_names";
+const constexpr char *FAILED_EXTENSION = ".failed";
+// source ids of the lookup are 8 bit and start at 1
+const constexpr std::size_t MAX_FILES_PER_BATCH = 255;
+
+template <typename T>
+std::vector<T> copyBlock(const storage::SharedDataIndex &index, const std::string &name)
+{
+    const auto view = storage::make_vector_view<T>(index, name);
+    return std::vector<T>(view.begin(), view.end());
+}
+
+std::vector<std::string> metricBlocks(const std::string &metric_name, const std::size_t exclude)
+{
+    const auto prefix = "/mld/metrics/" + metric_name + "/exclude/" + std::to_string(exclude);
+    return {prefix + "/weights", prefix + "/durations", prefix + "/distances"};
+}
+
+template <typename T>
+void copyToBlock(const storage::SharedDataIndex &index,
+                 const std::string &name,
+                 const std::vector<T> &values)
+{
+    if (index.GetBlockSize(name) != values.size() * sizeof(T))
+    {
+        throw util::exception("size of " + name + " changed" + SOURCE_REF);
+    }
+    std::memcpy(index.GetBlockPtr<T>(name), values.data(), values.size() * sizeof(T));
+}
+
+std::vector<std::filesystem::path> listUpdateFiles(const std::filesystem::path &directory)
+{
+    std::vector<std::filesystem::path> files;
+    for (const auto &entry : std::filesystem::directory_iterator(directory))
+    {
+        const auto name = entry.path().filename().string();
+        // Incomplete files are hidden
+        if (entry.is_regular_file() && name.front() != '.' &&
+            entry.path().extension() != FAILED_EXTENSION)
+        {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    if (files.size() > MAX_FILES_PER_BATCH)
+    {
+        files.resize(MAX_FILES_PER_BATCH);
+    }
+    return files;
+}
+
+void markFailed(const std::filesystem::path &file)
+{
+    std::error_code error;
+    std::filesystem::rename(file, file.string() + FAILED_EXTENSION, error);
+    if (error)
+    {
+        util::Log(logERROR) << "Could not rename " << file << ": " << error.message();
+    }
+}
+
+// Views of the blocks needed to update a data set
+struct DataViews
+{
+    DataViews(const storage::SharedDataIndex &index)
+        : segment_data(storage::make_segment_data_view(index, SEGMENT_DATA)),
+          node_data(storage::make_ebn_data_view(index, "/common/ebg_node_data")),
+          coordinates(storage::make_coordinates_view(index, "/common/nbn_data/coordinates")),
+          osm_node_ids(storage::make_osm_ids_view(index, "/common/nbn_data/osm_node_ids")),
+          node_weights(storage::make_vector_view<EdgeWeight>(index, GRAPH + "/node_weights")),
+          node_durations(storage::make_vector_view<EdgeDuration>(index, GRAPH + "/node_durations")),
+          node_distances(storage::make_vector_view<EdgeDistance>(index, GRAPH + "/node_distances")),
+          turn_weights(storage::make_turn_weight_view(index, "/common/turn_penalty")),
+          turn_durations(storage::make_turn_duration_view(index, "/common/turn_penalty"))
+    {
+    }
+
+    extractor::SegmentDataView segment_data;
+    extractor::EdgeBasedNodeDataView node_data;
+    util::vector_view<util::Coordinate> coordinates;
+    extractor::PackedOSMIDsView osm_node_ids;
+    util::vector_view<EdgeWeight> node_weights;
+    util::vector_view<EdgeDuration> node_durations;
+    util::vector_view<EdgeDistance> node_distances;
+    util::vector_view<TurnPenalty> turn_weights;
+    util::vector_view<TurnPenalty> turn_durations;
+};
+
+// The edge-based edges of the data set only contain the turn id, the weights used by the
+// customization are computed from the node weights and the turn penalties like osrm-customize
+// does. `node` is the node whose weight the edge includes.
+partitioner::EdgeBasedGraphEdgeData makeEdgeData(const DataViews &data,
+                                                 const NodeID node,
+                                                 const NodeID turn_id,
+                                                 const bool forward,
+                                                 const bool backward)
+{
+    const auto geometry_id = data.node_data.GetGeometryID(node);
+    const auto weight_min_value =
+        to_alias<EdgeWeight>(data.segment_data.GetForwardGeometry(geometry_id.id).size());
+    auto turn_weight = data.turn_weights[turn_id];
+    const auto weight =
+        updater::computeEdgeWeight(data.node_weights[node], turn_weight, weight_min_value);
+    const auto duration =
+        data.node_durations[node] + alias_cast<EdgeDuration>(data.turn_durations[turn_id]);
+
+    return {turn_id, weight, data.node_distances[node], duration, forward, backward};
+}
+} // namespace
+
+// Copies of the data osrm-customize works on, they are kept in sync with the last generation
+struct TrafficUpdateWatcher::Customization
+{
+    Customization(const storage::SharedDataIndex &index, const std::string &source_name)
+        : partition(std::make_unique<partitioner::MultiLevelPartition::LevelData>(
+                        *index.GetBlockPtr<partitioner::MultiLevelPartition::LevelData>(
+                            "/mld/multilevelpartition/level_data")),
+                    copyBlock<PartitionID>(index, "/mld/multilevelpartition/partition"),
+                    copyBlock<CellID>(index, "/mld/multilevelpartition/cell_to_children")),
+          cells(copyBlock<NodeID>(index, "/mld/cellstorage/source_boundary"),
+                copyBlock<NodeID>(index, "/mld/cellstorage/destination_boundary"),
+                copyBlock<partitioner::CellStorage::CellData>(index, "/mld/cellstorage/cells"),
+                copyBlock<std::uint64_t>(index, "/mld/cellstorage/level_to_cell_offset")),
+          customizer(partition)
+    {
+        const auto &properties =
+            *index.GetBlockPtr<extractor::ProfileProperties>("/common/properties");
+        metric_name = properties.GetWeightName();
+        weight_multiplier = properties.GetWeightMultiplier();
+
+        const DataViews data(index);
+        const auto graph_view = storage::make_multi_level_graph_view(index, GRAPH);
+
+        std::vector<partitioner::MultiLevelEdgeBasedGraph::EdgeArrayEntry> edge_array(
+            index.GetBlockEntries(GRAPH + "/edge_array"));
+        tbb::parallel_for(tbb::blocked_range<NodeID>(0, graph_view.GetNumberOfNodes()),
+                          [&](const auto &range)
+                          {
+                              for (auto node = range.begin(); node < range.end(); ++node)
+                              {
+                                  for (const auto edge : graph_view.GetAdjacentEdgeRange(node))
+                                  {
+                                      const auto target = graph_view.GetTarget(edge);
+                                      const auto forward = graph_view.IsForwardEdge(edge);
+                                      edge_array[edge] = {
+                                          target,
+                                          makeEdgeData(data,
+                                                       forward ? node : target,
+                                                       graph_view.GetEdgeData(edge).turn_id,
+                                                       forward,
+                                                       graph_view.IsBackwardEdge(edge))};
+                                  }
+                              }
+                          });
+        graph = partitioner::MultiLevelEdgeBasedGraph(
+            copyBlock<partitioner::MultiLevelEdgeBasedGraph::NodeArrayEntry>(index,
+                                                                             GRAPH + "/node_array"),
+            std::move(edge_array),
+            copyBlock<partitioner::MultiLevelEdgeBasedGraph::EdgeOffset>(
+                index, GRAPH + "/node_to_edge_offset"));
+
+        filters =
+            util::excludeFlagsToNodeFilter(graph.GetNumberOfNodes(), data.node_data, properties);
+        for (const auto exclude : util::irange<std::size_t>(0, filters.size()))
+        {
+            const auto blocks = metricBlocks(metric_name, exclude);
+            metrics.push_back({copyBlock<EdgeWeight>(index, blocks[0]),
+                               copyBlock<EdgeDuration>(index, blocks[1]),
+                               copyBlock<EdgeDistance>(index, blocks[2])});
+        }
+
+        // Updated segments get their own data source, like the files used by osrm-customize
+        const auto &datasources = *index.GetBlockPtr<extractor::Datasources>(DATASOURCES);
+        const auto max_sources = std::numeric_limits<DatasourceID>::max();
+        source = max_sources - 1;
+        for (const auto id : util::irange<DatasourceID>(1, max_sources))
+        {
+            const auto name = datasources.GetSourceName(id);
+            if (name.empty() || name == source_name)
+            {
+                source = id;
+                break;
+            }
+        }
+    }
+
+    // Names of the blocks that each generation copies
+    std::vector<std::string> BlockNames() const
+    {
+        std::vector<std::string> names = {SEGMENT_DATA + "/forward_weights/packed",
+                                          SEGMENT_DATA + "/reverse_weights/packed",
+                                          SEGMENT_DATA + "/forward_durations/packed",
+                                          SEGMENT_DATA + "/reverse_durations/packed",
+                                          SEGMENT_DATA + "/forward_data_sources",
+                                          SEGMENT_DATA + "/reverse_data_sources",
+                                          GRAPH + "/node_weights",
+                                          GRAPH + "/node_durations",
+                                          DATASOURCES};
+        for (const auto exclude : util::irange<std::size_t>(0, metrics.size()))
+        {
+            const auto blocks = metricBlocks(metric_name, exclude);
+            names.insert(names.end(), blocks.begin(), blocks.end());
+        }
+        return names;
+    }
+
+    partitioner::MultiLevelPartition partition;
+    partitioner::CellStorage cells;
+    partitioner::MultiLevelEdgeBasedGraph graph;
+    std::vector<std::vector<bool>> filters;
+    std::vector<customizer::CellMetric> metrics;
+    const customizer::CellCustomizer customizer;
+    std::string metric_name;
+    double weight_multiplier;
+    DatasourceID source;
+};
+
+TrafficUpdateWatcher::TrafficUpdateWatcher(std::filesystem::path directory_,
+                                           PublishCallback publish_,
+                                           std::chrono::milliseconds poll_interval)
+    : directory(std::move(directory_)), publish(std::move(publish_)),
+      poll_interval(poll_interval), active(true)
+{
+    if (!std::filesystem::is_directory(directory))
+    {
+        throw util::exception("Traffic update directory " + directory.string() +
+                              " does not exist" + SOURCE_REF);
+    }
+    watcher = std::thread(&TrafficUpdateWatcher::Run, this);
+}
+
+TrafficUpdateWatcher::~TrafficUpdateWatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        active = false;
+    }
+    condition.notify_all();
+    watcher.join();
+}
+
+void TrafficUpdateWatcher::Reset(Allocator base_)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        next_base = std::move(base_);
+    }
+    condition.notify_all();
+}
+
+void TrafficUpdateWatcher::Run()
+{
+    util::Log() << "Watching " << directory << " for traffic updates";
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (active)
+    {
+        condition.wait_for(lock, poll_interval, [this] { return !active || next_base; });
+        if (!active)
+            break;
+
+        if (next_base)
+        {
+            base = std::move(next_base);
+            current = base;
+            customization.reset();
+        }
+        if (!base)
+            continue;
+
+        lock.unlock();
+        try
+        {
+            const auto files = listUpdateFiles(directory);
+            if (!files.empty())
+            {
+                ApplyUpdates(files);
+            }
+        }
+        catch (const std::exception &e)
+        {
+            util::Log(logERROR) << "Applying traffic updates failed: " << e.what();
+            customization.reset();
+        }
+        lock.lock();
+    }
+
+    util::Log() << "Traffic update watcher stopped";
+}
+
+void TrafficUpdateWatcher::ApplyUpdates(const std::vector<std::filesystem::path> &files)
+{
+    TIMER_START(apply_updates);
+
+    std::vector<std::string> file_names;
+    std::transform(files.begin(),
+                   files.end(),
+                   std::back_inserter(file_names),
+                   [](const auto &file) { return file.string(); });
+
+    updater::SegmentLookupTable lookup;
+    try
+    {
+        lookup = updater::csv::readSegmentValues(file_names);
+    }
+    catch (const util::exception &)
+    {
+        // Only set aside the malformed files, the others are applied in the next round
+        for (const auto &file : file_names)
+        {
+            try
+            {
+                updater::csv::readSegmentValues({file});
+            }
+            catch (const util::exception &e)
+            {
+                util::Log(logERROR) << "Invalid traffic update: " << e.what();
+                markFailed(file);
+            }
+        }
+        return;
+    }
+
+    try
+    {
+        if (!customization)
+        {
+            customization = std::make_unique<Customization>(current->GetIndex(),
+                                                            directory.filename().string());
+        }
+    }
+    catch (const std::exception &e)
+    {
+        util::Log(logERROR) << "Traffic updates need a MLD data set: " << e.what();
+        std::for_each(files.begin(), files.end(), markFailed);
+        return;
+    }
+
+    // All changes are made on copies that no query can see before they are published
+    auto generation = std::make_shared<datafacade::ShadowMemoryAllocator>(
+        base, current->GetIndex(), customization->BlockNames());
+    const auto &index = generation->GetIndex();
+    DataViews data(index);
+
+    auto &datasources = *index.GetBlockPtr<extractor::Datasources>(DATASOURCES);
+    datasources.SetSourceName(customization->source, directory.filename().string());
+
+    // Update the segments like osrm-customize does
+    tbb::concurrent_vector<GeometryID> updated_geometries;
+    const auto update_segments = [&](const auto &nodes,
+                                     const auto &segment_lengths,
+                                     auto &&weights,
+                                     auto &&durations,
+                                     auto &&datasources_range,
+                                     const bool forward)
+    {
+        bool updated = false;
+        for (const auto offset : util::irange<std::size_t>(0, weights.size()))
+        {
+            const auto u = data.osm_node_ids[nodes[offset]];
+            const auto v = data.osm_node_ids[nodes[offset + 1]];
+            // Self-loops are artifical segments (e.g. traffic light nodes)
+            if (u == v)
+                continue;
+
+            if (const auto value = forward ? lookup({u, v}) : lookup({v, u}))
+            {
+                const auto length = segment_lengths[offset];
+                weights[offset] = updater::convertToWeight(
+                    customization->weight_multiplier, weights[offset], *value, length);
+                durations[offset] = updater::convertToDuration(value->speed, length);
+                datasources_range[offset] = customization->source;
+                updated = true;
+            }
+        }
+        return updated;
+    };
+    using DirectionalGeometryID = extractor::SegmentDataView::DirectionalGeometryID;
+    tbb::parallel_for(
+        tbb::blocked_range<DirectionalGeometryID>(0, data.segment_data.GetNumberOfGeometries()),
+        [&](const auto &range)
+        {
+            std::vector<double> segment_lengths;
+            for (auto geometry_id = range.begin(); geometry_id < range.end(); ++geometry_id)
+            {
+                const auto nodes = data.segment_data.GetForwardGeometry(geometry_id);
+                segment_lengths.clear();
+                util::for_each_pair(nodes,
+                                    [&](const auto &u, const auto &v)
+                                    {
+                                        segment_lengths.push_back(
+                                            util::coordinate_calculation::greatCircleDistance(
+                                                data.coordinates[u], data.coordinates[v]));
+                                    });
+
+                if (update_segments(nodes,
+                                    segment_lengths,
+                                    data.segment_data.GetForwardWeights(geometry_id),
+                                    data.segment_data.GetForwardDurations(geometry_id),
+                                    data.segment_data.GetForwardDatasources(geometry_id),
+                                    true))
+                {
+                    updated_geometries.push_back(GeometryID{geometry_id, true});
+                }
+                // The reverse segments are oriented in forward direction
+                if (update_segments(
+                        nodes,
+                        segment_lengths,
+                        data.segment_data.GetReverseWeights(geometry_id) | std::views::reverse,
+                        data.segment_data.GetReverseDurations(geometry_id) | std::views::reverse,
+                        data.segment_data.GetReverseDatasources(geometry_id) | std::views::reverse,
+                        false))
+                {
+                    updated_geometries.push_back(GeometryID{geometry_id, false});
+                }
+            }
+        });
+
+    const auto by_id = [](const GeometryID lhs, const GeometryID rhs)
+    { return std::tie(lhs.id, lhs.forward) < std::tie(rhs.id, rhs.forward); };
+    tbb::parallel_sort(updated_geometries.begin(), updated_geometries.end(), by_id);
+
+    // Recompute the weights of the nodes and their outgoing edges
+    tbb::concurrent_vector<NodeID> updated_nodes;
+    auto &graph = customization->graph;
+    tbb::parallel_for(
+        tbb::blocked_range<NodeID>(0, graph.GetNumberOfNodes()),
+        [&](const auto &range)
+        {
+            for (auto node = range.begin(); node < range.end(); ++node)
+            {
+                const auto geometry_id = data.node_data.GetGeometryID(node);
+                if (!std::binary_search(
+                        updated_geometries.begin(), updated_geometries.end(), geometry_id, by_id))
+                {
+                    continue;
+                }
+
+                std::tie(data.node_weights[node], data.node_durations[node]) =
+                    geometry_id.forward
+                        ? updater::sumSegments(
+                              data.segment_data.GetForwardWeights(geometry_id.id),
+                              data.segment_data.GetForwardDurations(geometry_id.id))
+                        : updater::sumSegments(
+                              data.segment_data.GetReverseWeights(geometry_id.id),
+                              data.segment_data.GetReverseDurations(geometry_id.id));
+
+                // The customization only uses forward edges
+                for (const auto edge : graph.GetAdjacentEdgeRange(node))
+                {
+                    auto &edge_data = graph.GetEdgeData(edge);
+                    if (edge_data.forward)
+                    {
+                        edge_data = makeEdgeData(
+                            data, node, edge_data.turn_id, true, edge_data.backward);
+                    }
+                }
+                updated_nodes.push_back(node);
+            }
+        });
+
+    std::vector<NodeID> changed_nodes(updated_nodes.begin(), updated_nodes.end());
+    tbb::parallel_sort(changed_nodes.begin(), changed_nodes.end());
+
+    const auto dirty_cells = customization->customizer.GetDirtyCells(graph, changed_nodes);
+    for (const auto exclude : util::irange<std::size_t>(0, customization->metrics.size()))
+    {
+        auto &metric = customization->metrics[exclude];
+        customization->customizer.Customize(
+            graph, customization->cells, customization->filters[exclude], metric, dirty_cells);
+
+        const auto blocks = metricBlocks(customization->metric_name, exclude);
+        copyToBlock(index, blocks[0], metric.weights);
+        copyToBlock(index, blocks[1], metric.durations);
+        copyToBlock(index, blocks[2], metric.distances);
+    }
+
+    if (!publish(base, generation))
+    {
+        // A new data set arrived in the meantime, the files are applied to it in the next round
+        customization.reset();
+        return;
+    }
+    current = std::move(generation);
+
+    for (const auto &file : files)
+    {
+        std::error_code error;
+        std::filesystem::remove(file, error);
+        if (error)
+        {
+            util::Log(logWARNING) << "Could not remove " << file << ": " << error.message();
+        }
+    }
+
+    std::size_t num_dirty_cells = 0;
+    for (const auto &level : dirty_cells)
+    {
+        num_dirty_cells += std::count(level.begin(), level.end(), true);
+    }
+    TIMER_STOP(apply_updates);
+    util::Log() << "Applied " << lookup.lookup.size() << " segment speeds from " << files.size()
+                << " file(s) to " << changed_nodes.size() << " nodes and customized "
+                << num_dirty_cells << " cells in " << TIMER_MSEC(apply_updates) << "ms";
+}
+
+} // namespace osrm::engine
@@ -4,6 +4,7 @@
 #include <boost/assert.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 
+#include <algorithm>
 #include <filesystem>
 
 namespace osrm::extractor
@@ -245,6 +246,31 @@ void CompressedEdgeContainer::AddUncompressedEdge(const EdgeID edge_id,
     }
 }
 
+void CompressedEdgeContainer::Merge(CompressedEdgeContainer &&other)
+{
+    // insert in edge order, so the layout does not depend on the order of the hash map
+    std::vector<std::pair<EdgeID, unsigned>> entries(other.m_edge_id_to_list_index_map.begin(),
+                                                     other.m_edge_id_to_list_index_map.end());
+    std::sort(entries.begin(), entries.end());
+
+    for (const auto &[edge_id, other_index] : entries)
+    {
+        BOOST_ASSERT(!HasEntryForID(edge_id));
+        if (0 == m_free_list.size())
+        {
+            IncreaseFreeList();
+        }
+        const auto index = m_free_list.back();
+        m_free_list.pop_back();
+        m_edge_id_to_list_index_map[edge_id] = index;
+        m_compressed_oneway_geometries[index] =
+            std::move(other.m_compressed_oneway_geometries[other_index]);
+    }
+
+    clipped_weights += other.clipped_weights;
+    clipped_durations += other.clipped_durations;
+}
+
 void CompressedEdgeContainer::InitializeBothwayVector()
 {
     segment_data = std::make_unique<SegmentDataContainer>();
@@ -584,9 +584,11 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
 
         // connected_roads.begin()
         // turn
-        // Generate edges for either artificial nodes or the main graph
+        // Generate edges for either artificial nodes or the main graph. The turn is appended to
+        // `turns` and evaluated by the profile together with all other turns of the block, see
+        // apply_turn_penalties.
         const auto generate_edge =
-            [this, &scripting_environment, weight_multiplier](
+            [this, &scripting_environment](
                 // what nodes will be used? In most cases this will be the id
                 // stored in the edge_data. In case of duplicated nodes (e.g.
                 // due to via-way restrictions), one/both of these might
@@ -603,7 +605,8 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                 const ExtractionTurnLeg &outgoing_road_leg,
                 const std::vector<ExtractionTurnLeg> &road_legs_on_the_right,
                 const std::vector<ExtractionTurnLeg> &road_legs_on_the_left,
-                const intersection::IntersectionEdgeGeometries &edge_geometries) -> EdgeWithData
+                const intersection::IntersectionEdgeGeometries &edge_geometries,
+                std::vector<ExtractionTurn> &turns) -> EdgeWithData
         {
             const auto &edge_data1 = m_node_based_graph.GetEdgeData(node_based_edge_from);
             const auto &edge_data2 = m_node_based_graph.GetEdgeData(node_based_edge_to);
@@ -624,7 +627,7 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
             const bool is_uturn =
                 guidance::getTurnDirection(turn_angle) == guidance::DirectionModifier::UTurn;
 
-            ExtractionTurn extracted_turn{
+            turns.push_back(ExtractionTurn{
                 // general info
                 turn_angle,
                 static_cast<int>(road_legs_on_the_right.size() + road_legs_on_the_left.size() + 2 -
@@ -663,32 +666,19 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                 road_legs_on_the_left,
                 node_along_road_entering,
                 intersection_node,
-                node_along_road_exiting};
-
-            scripting_environment.ProcessTurn(extracted_turn);
-
-            // turn penalties are limited to [-2^15, 2^15) which roughly translates to 54 minutes
-            // and fits signed 16bit deci-seconds
-            auto weight_penalty = TurnPenalty{boost::numeric_cast<TurnPenalty::value_type>(
-                extracted_turn.weight * weight_multiplier)};
-            auto duration_penalty = TurnPenalty{
-                boost::numeric_cast<TurnPenalty::value_type>(extracted_turn.duration * 10.)};
+                node_along_road_exiting});
 
             BOOST_ASSERT(SPECIAL_NODEID != nbe_to_ebn_mapping[node_based_edge_from]);
             BOOST_ASSERT(SPECIAL_NODEID != nbe_to_ebn_mapping[node_based_edge_to]);
 
-            // auto turn_id = m_edge_based_edge_list.size();
-            auto weight = edge_data1.weight + alias_cast<EdgeWeight>(weight_penalty);
-            auto duration = edge_data1.duration + alias_cast<EdgeDuration>(duration_penalty);
-            auto distance = edge_data1.distance;
-
+            // the turn penalties are added by apply_turn_penalties
             EdgeBasedEdge edge_based_edge = {edge_based_node_from,
                                              edge_based_node_to,
                                              SPECIAL_NODEID, // This will be updated once the main
                                                              // loop completes!
-                                             weight,
-                                             duration,
-                                             distance,
+                                             edge_data1.weight,
+                                             edge_data1.duration,
+                                             edge_data1.distance,
                                              true,
                                              false};
 
@@ -713,8 +703,30 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
             lookup::TurnIndexBlock turn_index_block = {from_node, intersection_node, to_node};
 
             // insert data into the designated buffer
-            return EdgeWithData{
-                edge_based_edge, turn_index_block, weight_penalty, duration_penalty};
+            return EdgeWithData{edge_based_edge, turn_index_block, {}, {}};
+        };
+
+        // Writes the penalties of the evaluated turns into the edges generated with them
+        const auto apply_turn_penalties =
+            [weight_multiplier](std::vector<ExtractionTurn>::const_iterator turn,
+                                const std::vector<ExtractionTurn>::const_iterator turns_end,
+                                std::vector<EdgeWithData>::iterator edge_with_data)
+        {
+            for (; turn != turns_end; ++turn, ++edge_with_data)
+            {
+                // turn penalties are limited to [-2^15, 2^15) which roughly translates to 54
+                // minutes and fits signed 16bit deci-seconds
+                edge_with_data->turn_weight_penalty = TurnPenalty{
+                    boost::numeric_cast<TurnPenalty::value_type>(turn->weight * weight_multiplier)};
+                edge_with_data->turn_duration_penalty = TurnPenalty{
+                    boost::numeric_cast<TurnPenalty::value_type>(turn->duration * 10.)};
+
+                auto &data = edge_with_data->edge.data;
+                data.weight += alias_cast<EdgeWeight>(edge_with_data->turn_weight_penalty);
+                data.duration = from_alias<EdgeDuration::value_type>(
+                    to_alias<EdgeDuration>(data.duration) +
+                    alias_cast<EdgeDuration>(edge_with_data->turn_duration_penalty));
+            }
         };
 
         //
@@ -727,6 +739,11 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                 auto buffer = std::make_shared<EdgesPipelineBuffer>();
                 buffer->nodes_processed = intersection_node_range.size();
 
+                // the turns of continuous_data and delayed_data in the same order, the profile is
+                // called once for all of them after the whole block has been generated
+                std::vector<ExtractionTurn> turns;
+                std::vector<ExtractionTurn> delayed_turns;
+
                 for (NodeID intersection_node = intersection_node_range.begin(),
                             end = intersection_node_range.end();
                      intersection_node < end;
@@ -977,7 +994,8 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                                                   outgoing_road_leg,
                                                   road_legs_on_the_right,
                                                   road_legs_on_the_left,
-                                                  edge_geometries);
+                                                  edge_geometries,
+                                                  turns);
 
                                 buffer->continuous_data.push_back(edge_with_data);
 
@@ -1059,7 +1077,8 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                                                                             outgoing_road_leg,
                                                                             road_legs_on_the_right,
                                                                             road_legs_on_the_left,
-                                                                            edge_geometries);
+                                                                            edge_geometries,
+                                                                            delayed_turns);
 
                                         buffer->delayed_data.push_back(edge_with_data);
 
@@ -1112,7 +1131,8 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                                                                             outgoing_road_leg,
                                                                             road_legs_on_the_right,
                                                                             road_legs_on_the_left,
-                                                                            edge_geometries);
+                                                                            edge_geometries,
+                                                                            delayed_turns);
 
                                         buffer->delayed_data.push_back(edge_with_data);
 
@@ -1132,6 +1152,18 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                     }
                 }
 
+                // evaluate all turns of the block with a single call into the profile
+                BOOST_ASSERT(turns.size() == buffer->continuous_data.size());
+                BOOST_ASSERT(delayed_turns.size() == buffer->delayed_data.size());
+                std::move(delayed_turns.begin(), delayed_turns.end(), std::back_inserter(turns));
+                scripting_environment.ProcessTurns(turns);
+
+                const auto delayed_turns_begin = turns.cbegin() + buffer->continuous_data.size();
+                apply_turn_penalties(
+                    turns.cbegin(), delayed_turns_begin, buffer->continuous_data.begin());
+                apply_turn_penalties(
+                    delayed_turns_begin, turns.cend(), buffer->delayed_data.begin());
+
                 return buffer;
             });
 
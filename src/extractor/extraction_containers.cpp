@@ -379,7 +379,11 @@ get_via_node_path_from_OSM_ids(const std::string &turn_relation_type,
 namespace osrm::extractor
 {
 
-ExtractionContainers::ExtractionContainers()
+ExtractionContainers::ExtractionContainers(const std::filesystem::path &spill_directory,
+                                           const std::size_t memory_budget)
+    : spill_directory(spill_directory), memory_budget(memory_budget),
+      all_nodes_list(spill_directory, memory_budget / 2),
+      all_edges_list(spill_directory, memory_budget / 2)
 {
     // Insert four empty strings offsets for name, ref, destination, pronunciation, and exits
     name_offsets.push_back(0);
@@ -406,7 +410,8 @@ ExtractionContainers::ExtractionContainers()
  *
  */
 void ExtractionContainers::PrepareData(ScriptingEnvironment &scripting_environment,
-                                       const std::string &name_file_name)
+                                       const std::string &name_file_name,
+                                       const bool compress_names)
 {
     const auto restriction_ways = IdentifyRestrictionWays();
     const auto maneuver_override_ways = IdentifyManeuverOverrideWays();
@@ -418,18 +423,27 @@ void ExtractionContainers::PrepareData(ScriptingEnvironment &scripting_environme
 
     PrepareManeuverOverrides(maneuver_override_ways);
     PrepareRestrictions(restriction_ways);
-    WriteCharData(name_file_name);
+    WriteCharData(name_file_name, compress_names);
 }
 
-void ExtractionContainers::WriteCharData(const std::string &file_name)
+void ExtractionContainers::WriteCharData(const std::string &file_name, const bool compress_names)
 {
     util::UnbufferedLog log;
     log << "writing street name index ... ";
     TIMER_START(write_index);
 
-    files::writeNames(file_name,
-                      NameTable{NameTable::IndexedData(
-                          name_offsets.begin(), name_offsets.end(), name_char_data.begin())});
+    if (compress_names)
+    {
+        files::writeNames(file_name,
+                          NameTable::MakeCompressed(
+                              name_offsets.begin(), name_offsets.end(), name_char_data.begin()));
+    }
+    else
+    {
+        files::writeNames(file_name,
+                          NameTable{NameTable::IndexedData(
+                              name_offsets.begin(), name_offsets.end(), name_char_data.begin())});
+    }
 
     TIMER_STOP(write_index);
     log << "ok, after " << TIMER_SEC(write_index) << "s";
@@ -460,10 +474,8 @@ void ExtractionContainers::PrepareNodes()
         util::UnbufferedLog log;
         log << "Sorting all nodes         ... " << std::flush;
         TIMER_START(sorting_nodes);
-        tbb::parallel_sort(all_nodes_list.begin(),
-                           all_nodes_list.end(),
-                           [](const auto &left, const auto &right)
-                           { return left.node_id < right.node_id; });
+        all_nodes_list.sort([](const auto &left, const auto &right)
+                            { return left.node_id < right.node_id; });
         TIMER_STOP(sorting_nodes);
         log << "ok, after " << TIMER_SEC(sorting_nodes) << "s";
     }
@@ -472,31 +484,27 @@ void ExtractionContainers::PrepareNodes()
         util::UnbufferedLog log;
         log << "Building node id map      ... " << std::flush;
         TIMER_START(id_map);
-        auto node_iter = all_nodes_list.begin();
         auto ref_iter = used_node_id_list.begin();
         auto used_nodes_iter = used_node_id_list.begin();
-        const auto all_nodes_list_end = all_nodes_list.end();
         const auto used_node_id_list_end = used_node_id_list.end();
 
         // compute the intersection of nodes that were referenced and nodes we actually have
-        while (node_iter != all_nodes_list_end && ref_iter != used_node_id_list_end)
-        {
-            if (node_iter->node_id < *ref_iter)
-            {
-                node_iter++;
-                continue;
-            }
-            if (node_iter->node_id > *ref_iter)
+        all_nodes_list.for_each(
+            [&](const QueryNode &node)
             {
+                while (ref_iter != used_node_id_list_end && *ref_iter < node.node_id)
+                {
+                    ref_iter++;
+                }
+                if (ref_iter == used_node_id_list_end || node.node_id < *ref_iter)
+                {
+                    return;
+                }
+                BOOST_ASSERT(node.node_id == *ref_iter);
+                *used_nodes_iter = *ref_iter;
+                used_nodes_iter++;
                 ref_iter++;
-                continue;
-            }
-            BOOST_ASSERT(node_iter->node_id == *ref_iter);
-            *used_nodes_iter = *ref_iter;
-            used_nodes_iter++;
-            node_iter++;
-            ref_iter++;
-        }
+            });
 
         // Remove unused nodes and check maximal internal node id
         used_node_id_list.resize(std::distance(used_node_id_list.begin(), used_nodes_iter));
@@ -515,34 +523,27 @@ void ExtractionContainers::PrepareNodes()
         log << "Confirming/Writing used nodes     ... ";
         TIMER_START(write_nodes);
         // identify all used nodes by a merging step of two sorted lists
-        auto node_iterator = all_nodes_list.begin();
+        used_nodes.reserve(used_node_id_list.size());
         auto node_id_iterator = used_node_id_list.begin();
-        const auto all_nodes_list_end = all_nodes_list.end();
-
-        for (const auto index : util::irange<NodeID>(0, used_node_id_list.size()))
-        {
-            boost::ignore_unused(index);
-            BOOST_ASSERT(node_id_iterator != used_node_id_list.end());
-            BOOST_ASSERT(node_iterator != all_nodes_list_end);
-            BOOST_ASSERT(*node_id_iterator >= node_iterator->node_id);
-            while (*node_id_iterator > node_iterator->node_id &&
-                   node_iterator != all_nodes_list_end)
-            {
-                ++node_iterator;
-            }
-            if (node_iterator == all_nodes_list_end || *node_id_iterator < node_iterator->node_id)
+        all_nodes_list.for_each(
+            [&](const QueryNode &node)
             {
-                throw util::exception(
-                    "Invalid OSM data: Referenced non-existing node with ID " +
-                    std::to_string(static_cast<std::uint64_t>(*node_id_iterator)));
-            }
-            BOOST_ASSERT(*node_id_iterator == node_iterator->node_id);
-
-            ++node_id_iterator;
-
-            used_nodes.emplace_back(*node_iterator++);
+                if (node_id_iterator != used_node_id_list.end() &&
+                    *node_id_iterator == node.node_id)
+                {
+                    used_nodes.push_back(node);
+                    ++node_id_iterator;
+                }
+            });
+        if (node_id_iterator != used_node_id_list.end())
+        {
+            throw util::exception("Invalid OSM data: Referenced non-existing node with ID " +
+                                  std::to_string(static_cast<std::uint64_t>(*node_id_iterator)));
         }
 
+        // the edges are joined with the used nodes, the index of a node is its internal id
+        all_nodes_list.clear();
+
         TIMER_STOP(write_nodes);
         log << "ok, after " << TIMER_SEC(write_nodes) << "s";
     }
@@ -557,7 +558,7 @@ void ExtractionContainers::PrepareEdges(ScriptingEnvironment &scripting_environm
         util::UnbufferedLog log;
         log << "Sorting edges by start    ... " << std::flush;
         TIMER_START(sort_edges_by_start);
-        tbb::parallel_sort(all_edges_list.begin(), all_edges_list.end(), CmpEdgeByOSMStartID());
+        all_edges_list.sort(CmpEdgeByOSMStartID());
         TIMER_STOP(sort_edges_by_start);
         log << "ok, after " << TIMER_SEC(sort_edges_by_start) << "s";
     }
@@ -567,59 +568,53 @@ void ExtractionContainers::PrepareEdges(ScriptingEnvironment &scripting_environm
         log << "Setting start coords      ... " << std::flush;
         TIMER_START(set_start_coords);
         // Traverse list of edges and nodes in parallel and set start coord
-        auto node_iterator = all_nodes_list.begin();
-        auto edge_iterator = all_edges_list.begin();
-
-        const auto all_edges_list_end = all_edges_list.end();
-        const auto all_nodes_list_end = all_nodes_list.end();
+        auto node_iterator = used_nodes.begin();
+        const auto used_nodes_end = used_nodes.end();
 
-        while (edge_iterator != all_edges_list_end && node_iterator != all_nodes_list_end)
-        {
-            if (edge_iterator->result.osm_source_id < node_iterator->node_id)
+        all_edges_list.for_each(
+            [&](InternalExtractorEdge &edge)
             {
-                util::Log(logDEBUG)
-                    << "Found invalid node reference " << edge_iterator->result.source;
-                edge_iterator->result.source = SPECIAL_NODEID;
-                ++edge_iterator;
-                continue;
-            }
-            if (edge_iterator->result.osm_source_id > node_iterator->node_id)
-            {
-                node_iterator++;
-                continue;
-            }
-
-            // remove loops
-            if (edge_iterator->result.osm_source_id == edge_iterator->result.osm_target_id)
-            {
-                edge_iterator->result.source = SPECIAL_NODEID;
-                edge_iterator->result.target = SPECIAL_NODEID;
-                ++edge_iterator;
-                continue;
-            }
-
-            BOOST_ASSERT(edge_iterator->result.osm_source_id == node_iterator->node_id);
+                while (node_iterator != used_nodes_end &&
+                       node_iterator->node_id < edge.result.osm_source_id)
+                {
+                    node_iterator++;
+                }
+
+                // Remove all remaining edges. They are invalid because there are no corresponding
+                // nodes for them. This happens when using osmosis with bbox or polygon to extract
+                // smaller areas.
+                if (node_iterator == used_nodes_end)
+                {
+                    util::Log(logDEBUG) << "Found invalid node reference " << edge.result.source;
+                    edge.result.source = SPECIAL_NODEID;
+                    edge.result.osm_source_id = SPECIAL_OSM_NODEID;
+                    return;
+                }
+                if (edge.result.osm_source_id < node_iterator->node_id)
+                {
+                    util::Log(logDEBUG) << "Found invalid node reference " << edge.result.source;
+                    edge.result.source = SPECIAL_NODEID;
+                    return;
+                }
+
+                // remove loops
+                if (edge.result.osm_source_id == edge.result.osm_target_id)
+                {
+                    edge.result.source = SPECIAL_NODEID;
+                    edge.result.target = SPECIAL_NODEID;
+                    return;
+                }
+
+                BOOST_ASSERT(edge.result.osm_source_id == node_iterator->node_id);
+
+                // assign new node id
+                edge.result.source =
+                    static_cast<NodeID>(std::distance(used_nodes.begin(), node_iterator));
+
+                edge.source_coordinate.lat = node_iterator->lat;
+                edge.source_coordinate.lon = node_iterator->lon;
+            });
 
-            // assign new node id
-            const auto node_id = mapExternalToInternalNodeID(
-                used_node_id_list.begin(), used_node_id_list.end(), node_iterator->node_id);
-            BOOST_ASSERT(node_id != SPECIAL_NODEID);
-            edge_iterator->result.source = node_id;
-
-            edge_iterator->source_coordinate.lat = node_iterator->lat;
-            edge_iterator->source_coordinate.lon = node_iterator->lon;
-            ++edge_iterator;
-        }
-
-        // Remove all remaining edges. They are invalid because there are no corresponding nodes for
-        // them. This happens when using osmosis with bbox or polygon to extract smaller areas.
-        auto markSourcesInvalid = [](InternalExtractorEdge &edge)
-        {
-            util::Log(logDEBUG) << "Found invalid node reference " << edge.result.source;
-            edge.result.source = SPECIAL_NODEID;
-            edge.result.osm_source_id = SPECIAL_OSM_NODEID;
-        };
-        std::for_each(edge_iterator, all_edges_list_end, markSourcesInvalid);
         TIMER_STOP(set_start_coords);
         log << "ok, after " << TIMER_SEC(set_start_coords) << "s";
     }
@@ -629,7 +624,7 @@ void ExtractionContainers::PrepareEdges(ScriptingEnvironment &scripting_environm
         util::UnbufferedLog log;
         log << "Sorting edges by target   ... " << std::flush;
         TIMER_START(sort_edges_by_target);
-        tbb::parallel_sort(all_edges_list.begin(), all_edges_list.end(), CmpEdgeByOSMTargetID());
+        all_edges_list.sort(CmpEdgeByOSMTargetID());
         TIMER_STOP(sort_edges_by_target);
         log << "ok, after " << TIMER_SEC(sort_edges_by_target) << "s";
     }
@@ -639,101 +634,85 @@ void ExtractionContainers::PrepareEdges(ScriptingEnvironment &scripting_environm
         util::UnbufferedLog log;
         log << "Computing edge weights    ... " << std::flush;
         TIMER_START(compute_weights);
-        auto node_iterator = all_nodes_list.begin();
-        auto edge_iterator = all_edges_list.begin();
-        const auto all_edges_list_end_ = all_edges_list.end();
-        const auto all_nodes_list_end_ = all_nodes_list.end();
+        auto node_iterator = used_nodes.begin();
+        const auto used_nodes_end = used_nodes.end();
 
         const auto weight_multiplier =
             scripting_environment.GetProfileProperties().GetWeightMultiplier();
 
-        while (edge_iterator != all_edges_list_end_ && node_iterator != all_nodes_list_end_)
-        {
-            // skip all invalid edges
-            if (edge_iterator->result.source == SPECIAL_NODEID)
-            {
-                ++edge_iterator;
-                continue;
-            }
-
-            if (edge_iterator->result.osm_target_id < node_iterator->node_id)
-            {
-                util::Log(logDEBUG) << "Found invalid node reference "
-                                    << static_cast<uint64_t>(edge_iterator->result.osm_target_id);
-                edge_iterator->result.target = SPECIAL_NODEID;
-                ++edge_iterator;
-                continue;
-            }
-            if (edge_iterator->result.osm_target_id > node_iterator->node_id)
+        all_edges_list.for_each(
+            [&](InternalExtractorEdge &edge)
             {
-                ++node_iterator;
-                continue;
-            }
+                // skip all invalid edges
+                if (edge.result.source == SPECIAL_NODEID)
+                {
+                    return;
+                }
+
+                while (node_iterator != used_nodes_end &&
+                       node_iterator->node_id < edge.result.osm_target_id)
+                {
+                    node_iterator++;
+                }
+
+                if (node_iterator == used_nodes_end ||
+                    edge.result.osm_target_id < node_iterator->node_id)
+                {
+                    util::Log(logDEBUG) << "Found invalid node reference "
+                                        << static_cast<uint64_t>(edge.result.osm_target_id);
+                    edge.result.target = SPECIAL_NODEID;
+                    return;
+                }
+
+                BOOST_ASSERT(edge.result.osm_target_id == node_iterator->node_id);
+                BOOST_ASSERT(edge.source_coordinate.lat !=
+                             util::FixedLatitude{std::numeric_limits<std::int32_t>::min()});
+                BOOST_ASSERT(edge.source_coordinate.lon !=
+                             util::FixedLongitude{std::numeric_limits<std::int32_t>::min()});
+
+                util::Coordinate source_coord(edge.source_coordinate);
+                util::Coordinate target_coord{node_iterator->lon, node_iterator->lat};
+
+                // flip source and target coordinates if segment is in backward direction only
+                if (!edge.result.flags.forward && edge.result.flags.backward)
+                    std::swap(source_coord, target_coord);
+
+                const auto distance =
+                    util::coordinate_calculation::greatCircleDistance(source_coord, target_coord);
+                const auto weight = edge.weight_data(distance);
+                const auto duration = edge.duration_data(distance);
+
+                const auto accurate_distance =
+                    util::coordinate_calculation::greatCircleDistance(source_coord, target_coord);
+
+                ExtractionSegment segment(
+                    source_coord, target_coord, distance, weight, duration, edge.result.flags);
+                scripting_environment.ProcessSegment(segment);
+
+                auto &result = edge.result;
+                result.weight = std::max<EdgeWeight>(
+                    {1}, to_alias<EdgeWeight>(std::round(segment.weight * weight_multiplier)));
+                result.duration = std::max<EdgeDuration>(
+                    {1}, to_alias<EdgeDuration>(std::round(segment.duration * 10.)));
+                result.distance = to_alias<EdgeDistance>(accurate_distance);
+
+                // assign new node id
+                result.target =
+                    static_cast<NodeID>(std::distance(used_nodes.begin(), node_iterator));
+
+                // orient edges consistently: source id < target id
+                // important for multi-edge removal
+                if (result.source > result.target)
+                {
+                    std::swap(result.source, result.target);
+
+                    // std::swap does not work with bit-fields
+                    bool temp = result.flags.forward;
+                    result.flags.forward = result.flags.backward;
+                    result.flags.backward = temp;
+                }
+            });
 
-            BOOST_ASSERT(edge_iterator->result.osm_target_id == node_iterator->node_id);
-            BOOST_ASSERT(edge_iterator->source_coordinate.lat !=
-                         util::FixedLatitude{std::numeric_limits<std::int32_t>::min()});
-            BOOST_ASSERT(edge_iterator->source_coordinate.lon !=
-                         util::FixedLongitude{std::numeric_limits<std::int32_t>::min()});
-
-            util::Coordinate source_coord(edge_iterator->source_coordinate);
-            util::Coordinate target_coord{node_iterator->lon, node_iterator->lat};
-
-            // flip source and target coordinates if segment is in backward direction only
-            if (!edge_iterator->result.flags.forward && edge_iterator->result.flags.backward)
-                std::swap(source_coord, target_coord);
-
-            const auto distance =
-                util::coordinate_calculation::greatCircleDistance(source_coord, target_coord);
-            const auto weight = edge_iterator->weight_data(distance);
-            const auto duration = edge_iterator->duration_data(distance);
-
-            const auto accurate_distance =
-                util::coordinate_calculation::greatCircleDistance(source_coord, target_coord);
-
-            ExtractionSegment segment(source_coord,
-                                      target_coord,
-                                      distance,
-                                      weight,
-                                      duration,
-                                      edge_iterator->result.flags);
-            scripting_environment.ProcessSegment(segment);
-
-            auto &edge = edge_iterator->result;
-            edge.weight = std::max<EdgeWeight>(
-                {1}, to_alias<EdgeWeight>(std::round(segment.weight * weight_multiplier)));
-            edge.duration = std::max<EdgeDuration>(
-                {1}, to_alias<EdgeDuration>(std::round(segment.duration * 10.)));
-            edge.distance = to_alias<EdgeDistance>(accurate_distance);
-
-            // assign new node id
-            const auto node_id = mapExternalToInternalNodeID(
-                used_node_id_list.begin(), used_node_id_list.end(), node_iterator->node_id);
-            BOOST_ASSERT(node_id != SPECIAL_NODEID);
-            edge.target = node_id;
-
-            // orient edges consistently: source id < target id
-            // important for multi-edge removal
-            if (edge.source > edge.target)
-            {
-                std::swap(edge.source, edge.target);
-
-                // std::swap does not work with bit-fields
-                bool temp = edge.flags.forward;
-                edge.flags.forward = edge.flags.backward;
-                edge.flags.backward = temp;
-            }
-            ++edge_iterator;
-        }
-
-        // Remove all remaining edges. They are invalid because there are no corresponding nodes for
-        // them. This happens when using osmosis with bbox or polygon to extract smaller areas.
-        auto markTargetsInvalid = [](InternalExtractorEdge &edge)
-        {
-            util::Log(logDEBUG) << "Found invalid node reference " << edge.result.target;
-            edge.result.target = SPECIAL_NODEID;
-        };
-        std::for_each(edge_iterator, all_edges_list_end_, markTargetsInvalid);
         TIMER_STOP(compute_weights);
         log << "ok, after " << TIMER_SEC(compute_weights) << "s";
     }
@@ -743,131 +722,122 @@ void ExtractionContainers::PrepareEdges(ScriptingEnvironment &scripting_environm
         util::UnbufferedLog log;
         log << "Sorting edges by renumbered start ... ";
         TIMER_START(sort_edges_by_renumbered_start);
-        tbb::parallel_sort(all_edges_list.begin(),
-                           all_edges_list.end(),
-                           CmpEdgeByInternalSourceTargetAndName{
-                               all_edges_annotation_data_list, name_char_data, name_offsets});
+        all_edges_list.sort(CmpEdgeByInternalSourceTargetAndName{
+            all_edges_annotation_data_list, name_char_data, name_offsets});
         TIMER_STOP(sort_edges_by_renumbered_start);
         log << "ok, after " << TIMER_SEC(sort_edges_by_renumbered_start) << "s";
     }
 
     BOOST_ASSERT(all_edges_list.size() > 0);
-    for (std::size_t i = 0; i < all_edges_list.size();)
     {
-        // only invalid edges left
-        if (all_edges_list[i].result.source == SPECIAL_NODEID)
-        {
-            break;
-        }
-        // skip invalid edges
-        if (all_edges_list[i].result.target == SPECIAL_NODEID)
-        {
-            ++i;
-            continue;
-        }
-
-        std::size_t start_idx = i;
-        NodeID source = all_edges_list[i].result.source;
-        NodeID target = all_edges_list[i].result.target;
+        util::UnbufferedLog log;
+        log << "Writing used edges       ... " << std::flush;
+        TIMER_START(write_edges);
 
-        auto min_forward = std::make_pair(MAXIMAL_EDGE_WEIGHT, MAXIMAL_EDGE_DURATION);
-        auto min_backward = std::make_pair(MAXIMAL_EDGE_WEIGHT, MAXIMAL_EDGE_DURATION);
-        std::size_t min_forward_idx = std::numeric_limits<std::size_t>::max();
-        std::size_t min_backward_idx = std::numeric_limits<std::size_t>::max();
+        // The minimal edges are collected within the share of the budget that the node list
+        // no longer needs and are only copied into used_edges once the edge list is freed
+        util::ExternalVector<NodeBasedEdge> minimal_edges(spill_directory, memory_budget / 2);
 
-        // find minimal edge in both directions
-        while (i < all_edges_list.size() && all_edges_list[i].result.source == source &&
-               all_edges_list[i].result.target == target)
+        // all parallel edges between two nodes, only the minimal edge of each direction is used
+        std::vector<NodeBasedEdgeWithOSM> parallel_edges;
+        const auto write_minimal_edges = [&]
         {
-            const auto &result = all_edges_list[i].result;
-            const auto value = std::make_pair(result.weight, result.duration);
-            if (result.flags.forward && value < min_forward)
-            {
-                min_forward_idx = i;
-                min_forward = value;
-            }
-            if (result.flags.backward && value < min_backward)
+            auto min_forward = std::make_pair(MAXIMAL_EDGE_WEIGHT, MAXIMAL_EDGE_DURATION);
+            auto min_backward = std::make_pair(MAXIMAL_EDGE_WEIGHT, MAXIMAL_EDGE_DURATION);
+            std::size_t min_forward_idx = std::numeric_limits<std::size_t>::max();
+            std::size_t min_backward_idx = std::numeric_limits<std::size_t>::max();
+
+            // find minimal edge in both directions
+            for (const auto i : util::irange<std::size_t>(0, parallel_edges.size()))
             {
-                min_backward_idx = i;
-                min_backward = value;
+                const auto &result = parallel_edges[i];
+                const auto value = std::make_pair(result.weight, result.duration);
+                if (result.flags.forward && value < min_forward)
+                {
+                    min_forward_idx = i;
+                    min_forward = value;
+                }
+                if (result.flags.backward && value < min_backward)
+                {
+                    min_backward_idx = i;
+                    min_backward = value;
+                }
             }
 
-            // this also increments the outer loop counter!
-            i++;
-        }
-
-        BOOST_ASSERT(min_forward_idx == std::numeric_limits<std::size_t>::max() ||
-                     min_forward_idx < i);
-        BOOST_ASSERT(min_backward_idx == std::numeric_limits<std::size_t>::max() ||
-                     min_backward_idx < i);
-        BOOST_ASSERT(min_backward_idx != std::numeric_limits<std::size_t>::max() ||
-                     min_forward_idx != std::numeric_limits<std::size_t>::max());
+            BOOST_ASSERT(min_backward_idx != std::numeric_limits<std::size_t>::max() ||
+                         min_forward_idx != std::numeric_limits<std::size_t>::max());
 
-        if (min_backward_idx == min_forward_idx)
-        {
-            all_edges_list[min_forward_idx].result.flags.is_split = false;
-            all_edges_list[min_forward_idx].result.flags.forward = true;
-            all_edges_list[min_forward_idx].result.flags.backward = true;
-        }
-        else
-        {
-            bool has_forward = min_forward_idx != std::numeric_limits<std::size_t>::max();
-            bool has_backward = min_backward_idx != std::numeric_limits<std::size_t>::max();
-            if (has_forward)
+            if (min_backward_idx == min_forward_idx)
             {
-                all_edges_list[min_forward_idx].result.flags.forward = true;
-                all_edges_list[min_forward_idx].result.flags.backward = false;
-                all_edges_list[min_forward_idx].result.flags.is_split = has_backward;
+                parallel_edges[min_forward_idx].flags.is_split = false;
+                parallel_edges[min_forward_idx].flags.forward = true;
+                parallel_edges[min_forward_idx].flags.backward = true;
             }
-            if (has_backward)
+            else
             {
-                std::swap(all_edges_list[min_backward_idx].result.source,
-                          all_edges_list[min_backward_idx].result.target);
-                all_edges_list[min_backward_idx].result.flags.forward = true;
-                all_edges_list[min_backward_idx].result.flags.backward = false;
-                all_edges_list[min_backward_idx].result.flags.is_split = has_forward;
+                bool has_forward = min_forward_idx != std::numeric_limits<std::size_t>::max();
+                bool has_backward = min_backward_idx != std::numeric_limits<std::size_t>::max();
+                if (has_forward)
+                {
+                    parallel_edges[min_forward_idx].flags.forward = true;
+                    parallel_edges[min_forward_idx].flags.backward = false;
+                    parallel_edges[min_forward_idx].flags.is_split = has_backward;
+                }
+                if (has_backward)
+                {
+                    std::swap(parallel_edges[min_backward_idx].source,
+                              parallel_edges[min_backward_idx].target);
+                    parallel_edges[min_backward_idx].flags.forward = true;
+                    parallel_edges[min_backward_idx].flags.backward = false;
+                    parallel_edges[min_backward_idx].flags.is_split = has_forward;
+                }
             }
-        }
 
-        // invalidate all unused edges
-        for (std::size_t j = start_idx; j < i; j++)
-        {
-            if (j == min_forward_idx || j == min_backward_idx)
+            // IMPORTANT: here, we're using slicing to only write the data from the base
+            // class of NodeBasedEdgeWithOSM
+            for (const auto i : util::irange<std::size_t>(0, parallel_edges.size()))
             {
-                continue;
+                if (i == min_forward_idx || i == min_backward_idx)
+                {
+                    minimal_edges.push_back(parallel_edges[i]);
+                }
             }
-            all_edges_list[j].result.source = SPECIAL_NODEID;
-            all_edges_list[j].result.target = SPECIAL_NODEID;
-        }
-    }
-
-    all_nodes_list.clear(); // free all_nodes_list before allocation of used_edges
-    all_nodes_list.shrink_to_fit();
-
-    used_edges.reserve(all_edges_list.size());
-    {
-        util::UnbufferedLog log;
-        log << "Writing used edges       ... " << std::flush;
-        TIMER_START(write_edges);
-        // Traverse list of edges and nodes in parallel and set target coord
+            parallel_edges.clear();
+        };
 
-        for (const auto &edge : all_edges_list)
-        {
-            if (edge.result.source == SPECIAL_NODEID || edge.result.target == SPECIAL_NODEID)
+        all_edges_list.for_each(
+            [&](const InternalExtractorEdge &edge)
             {
-                continue;
-            }
-
-            // IMPORTANT: here, we're using slicing to only write the data from the base
-            // class of NodeBasedEdgeWithOSM
-            used_edges.push_back(edge.result);
+                // skip invalid edges, they are sorted to the end
+                if (edge.result.source == SPECIAL_NODEID || edge.result.target == SPECIAL_NODEID)
+                {
+                    return;
+                }
+
+                if (!parallel_edges.empty() &&
+                    (parallel_edges.front().source != edge.result.source ||
+                     parallel_edges.front().target != edge.result.target))
+                {
+                    write_minimal_edges();
+                }
+                parallel_edges.push_back(edge.result);
+            });
+        if (!parallel_edges.empty())
+        {
+            write_minimal_edges();
         }
 
-        if (used_edges.size() > std::numeric_limits<uint32_t>::max())
+        all_edges_list.clear();
+
+        if (minimal_edges.size() > std::numeric_limits<uint32_t>::max())
         {
             throw util::exception("There are too many edges, OSRM only supports 2^32" + SOURCE_REF);
         }
 
+        used_edges.reserve(minimal_edges.size());
+        minimal_edges.for_each([&](const NodeBasedEdge &edge) { used_edges.push_back(edge); });
+        minimal_edges.clear();
+
         TIMER_STOP(write_edges);
         log << "ok, after " << TIMER_SEC(write_edges) << "s";
         log << " -- Processed " << used_edges.size() << " edges";
@@ -12,7 +12,9 @@
 #include "extractor/maneuver_override_relation_parser.hpp"
 #include "extractor/name_table.hpp"
 #include "extractor/node_based_graph_factory.hpp"
+#include "extractor/node_renumbering.hpp"
 #include "extractor/node_restriction_map.hpp"
+#include "extractor/osm_change_merger.hpp"
 #include "extractor/restriction_graph.hpp"
 #include "extractor/restriction_parser.hpp"
 #include "extractor/scripting_environment.hpp"
@@ -38,7 +40,7 @@
 
 #include <boost/assert.hpp>
 
-#include <osmium/handler/node_locations_for_ways.hpp>
+#include <osmium/index/map/dense_file_array.hpp>
 #include <osmium/index/map/flex_mem.hpp>
 #include <osmium/io/any_input.hpp>
 #include <osmium/thread/pool.hpp>
@@ -46,8 +48,17 @@
 #include <tbb/global_control.h>
 #include <tbb/parallel_pipeline.h>
 
+#include <fcntl.h>
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+
 #include <algorithm>
+#include <filesystem>
 #include <memory>
+#include <numeric>
 #include <thread>
 #include <tuple>
 #include <type_traits>
@@ -166,13 +177,121 @@ std::vector<CompressedNodeBasedGraphEdge> toEdgeList(const util::NodeBasedDynami
 
     return edges;
 }
+
+// Node locations for the ways, needed by location dependent data. Nodes are stored in input order
+// by a serial pipeline stage. The input has all nodes before the ways, so once the first way
+// arrives the index is complete and the ways of all buffers are resolved in parallel.
+class NodeLocationIndex
+{
+  public:
+    using Index = osmium::index::map::Map<osmium::unsigned_object_id_type, osmium::Location>;
+
+    // Keeps the locations in memory or, if `path` is not empty, in a dense array in that file
+    explicit NodeLocationIndex(const std::filesystem::path &path)
+    {
+        if (path.empty())
+        {
+            index = std::make_unique<
+                osmium::index::map::FlexMem<osmium::unsigned_object_id_type, osmium::Location>>();
+            return;
+        }
+
+        auto flags = O_RDWR | O_CREAT | O_TRUNC;
+#ifdef _WIN32
+        flags |= O_BINARY;
+#endif
+        file_descriptor = ::open(path.string().c_str(), flags, 0644);
+        if (file_descriptor < 0)
+        {
+            throw util::exception("Could not open location index file " + path.string() +
+                                  SOURCE_REF);
+        }
+        index = std::make_unique<osmium::index::map::DenseFileArray<osmium::unsigned_object_id_type,
+                                                                    osmium::Location>>(
+            file_descriptor);
+    }
+
+    NodeLocationIndex(const NodeLocationIndex &) = delete;
+    NodeLocationIndex &operator=(const NodeLocationIndex &) = delete;
+
+    ~NodeLocationIndex()
+    {
+        index.reset();
+        if (file_descriptor >= 0)
+            ::close(file_descriptor);
+    }
+
+    // Must be called for all buffers in input order
+    void Store(const osmium::memory::Buffer &buffer)
+    {
+        for (const auto &item : buffer)
+        {
+            if (item.type() == osmium::item_type::way && !has_ways)
+            {
+                has_ways = true;
+                index->sort();
+            }
+            else if (item.type() == osmium::item_type::node)
+            {
+                if (has_ways)
+                {
+                    throw util::exception("Input file is not sorted: node locations are needed for "
+                                          "location dependent data, but nodes follow ways" +
+                                          SOURCE_REF);
+                }
+                const auto &node = static_cast<const osmium::Node &>(item);
+                if (node.id() >= 0)
+                    index->set(node.positive_id(), node.location());
+            }
+        }
+    }
+
+    // Can be called concurrently for buffers that went through Store
+    void Resolve(osmium::memory::Buffer &buffer) const
+    {
+        for (auto &way : buffer.select<osmium::Way>())
+        {
+            bool error = false;
+            for (auto &node_ref : way.nodes())
+            {
+                node_ref.set_location(node_ref.ref() >= 0
+                                          ? index->get_noexcept(node_ref.positive_ref())
+                                          : osmium::Location{});
+                error |= !node_ref.location();
+            }
+            if (error)
+            {
+                throw osmium::not_found{
+                    "location for one or more nodes not found in node location index"};
+            }
+        }
+    }
+
+  private:
+    int file_descriptor = -1;
+    std::unique_ptr<Index> index;
+    bool has_ways = false;
+};
+
+void checkCheckpoint(const std::filesystem::path &path)
+{
+    if (!std::filesystem::exists(path))
+    {
+        throw util::exception("Checkpoint " + path.string() +
+                              " not found, it is written by osrm-extract --checkpoints" +
+                              SOURCE_REF);
+    }
+    util::Log() << "Resuming from checkpoint " << path.string();
+}
 } // namespace
 
 /**
- * TODO: Refactor this function into smaller functions for better readability.
+ * This function is the entry point for the whole extraction process. It runs the stages of
+ * ExtractorConfig::Stage: ParseOSMData, ExpandGraph and BuildRTree. If checkpoints are enabled,
+ * each stage stores the input of the next one, so a later run can start at a given stage.
  *
- * This function is the entry point for the whole extraction process. The goal of the extraction
- * step is to filter and convert the OSM geometry to something more fitting for routing.
+ * The goal of the extraction step is to filter and convert the OSM geometry to something more
+ * fitting for routing.
  * That includes:
  *  - extracting turn restrictions
  *  - splitting ways into (directional!) edge segments
@@ -197,8 +316,90 @@ int Extractor::run(ScriptingEnvironment &scripting_environment)
     tbb::global_control gc(tbb::global_control::max_allowed_parallelism,
                            config.requested_num_threads);
 
-    auto parsed_osm_data = ParseOSMData(scripting_environment, number_of_threads);
+    std::vector<EdgeBasedNodeSegment> edge_based_node_segments;
+    std::vector<util::Coordinate> coordinates;
+
+    if (config.start_stage == ExtractorConfig::Stage::RTree)
+    {
+        checkCheckpoint(config.GetPath(".osrm.ebg_segments"));
+        files::readEdgeBasedNodeSegments(config.GetPath(".osrm.ebg_segments"),
+                                         edge_based_node_segments);
+        files::readNodeCoordinates(config.GetPath(".osrm.nbg_nodes"), coordinates);
+    }
+    else
+    {
+        ParsedOSMData parsed_osm_data;
+        if (config.start_stage == ExtractorConfig::Stage::Parse)
+        {
+            parsed_osm_data = ParseOSMData(scripting_environment, number_of_threads);
+            if (config.write_checkpoints)
+                WriteParsedOSMData(parsed_osm_data, scripting_environment);
+        }
+        else
+        {
+            parsed_osm_data = ReadParsedOSMData(scripting_environment);
+        }
+
+        edge_based_node_segments =
+            ExpandGraph(scripting_environment, std::move(parsed_osm_data), coordinates);
+        if (config.write_checkpoints)
+        {
+            files::writeEdgeBasedNodeSegments(config.GetPath(".osrm.ebg_segments"),
+                                              edge_based_node_segments);
+        }
+    }
 
+    util::Log() << "Building r-tree ...";
+    TIMER_START(rtree);
+    BuildRTree(std::move(edge_based_node_segments), coordinates);
+    TIMER_STOP(rtree);
+
+    util::Log() << "To prepare the data for routing, run: "
+                << "./osrm-partition " << config.base_path;
+
+    return 0;
+}
+
+void Extractor::WriteParsedOSMData(const ParsedOSMData &parsed_osm_data,
+                                   const ScriptingEnvironment &scripting_environment) const
+{
+    util::Log() << "Writing checkpoint " << config.GetPath(".osrm.parsed").string() << " ...";
+    TIMER_START(write_checkpoint);
+    files::writeParsedData(config.GetPath(".osrm.parsed"),
+                           parsed_osm_data.turn_lane_map,
+                           parsed_osm_data.turn_restrictions,
+                           parsed_osm_data.unresolved_maneuver_overrides,
+                           parsed_osm_data.osm_coordinates,
+                           parsed_osm_data.osm_node_ids,
+                           parsed_osm_data.edge_list,
+                           parsed_osm_data.annotation_data,
+                           scripting_environment.m_obstacle_map);
+    TIMER_STOP(write_checkpoint);
+    util::Log() << "ok, after " << TIMER_SEC(write_checkpoint) << "s";
+}
+
+Extractor::ParsedOSMData
+Extractor::ReadParsedOSMData(ScriptingEnvironment &scripting_environment) const
+{
+    checkCheckpoint(config.GetPath(".osrm.parsed"));
+    ParsedOSMData parsed_osm_data;
+    files::readParsedData(config.GetPath(".osrm.parsed"),
+                          parsed_osm_data.turn_lane_map,
+                          parsed_osm_data.turn_restrictions,
+                          parsed_osm_data.unresolved_maneuver_overrides,
+                          parsed_osm_data.osm_coordinates,
+                          parsed_osm_data.osm_node_ids,
+                          parsed_osm_data.edge_list,
+                          parsed_osm_data.annotation_data,
+                          scripting_environment.m_obstacle_map);
+    return parsed_osm_data;
+}
+
+std::vector<EdgeBasedNodeSegment>
+Extractor::ExpandGraph(ScriptingEnvironment &scripting_environment,
+                       ParsedOSMData parsed_osm_data,
+                       std::vector<util::Coordinate> &coordinates)
+{
     // Transform the node-based graph that OSM is based on into an edge-based graph
     // that is better for routing.  Every edge becomes a node, and every valid
     // movement (e.g. turn from A->B, and B->A) becomes an edge
@@ -236,9 +437,9 @@ int Extractor::run(ScriptingEnvironment &scripting_environment)
     util::Log() << "Segregated edges count = " << segregated_edges.size();
 
     util::Log() << "Writing nodes for nodes-based and edges-based graphs ...";
-    auto const &coordinates = node_based_graph_factory.GetCoordinates();
-    files::writeNodes(
-        config.GetPath(".osrm.nbg_nodes"), coordinates, node_based_graph_factory.GetOsmNodes());
+    files::writeNodes(config.GetPath(".osrm.nbg_nodes"),
+                      node_based_graph_factory.GetCoordinates(),
+                      node_based_graph_factory.GetOsmNodes());
     node_based_graph_factory.ReleaseOsmNodes();
 
     auto const &node_based_graph = node_based_graph_factory.GetGraph();
@@ -269,7 +470,7 @@ int Extractor::run(ScriptingEnvironment &scripting_environment)
 
     const auto number_of_edge_based_nodes =
         BuildEdgeExpandedGraph(node_based_graph,
-                               coordinates,
+                               node_based_graph_factory.GetCoordinates(),
                                node_based_graph_factory.GetCompressedEdges(),
                                restriction_graph,
                                segregated_edges,
@@ -287,7 +488,7 @@ int Extractor::run(ScriptingEnvironment &scripting_environment)
 
     ProcessGuidanceTurns(node_based_graph,
                          edge_based_nodes_container,
-                         coordinates,
+                         node_based_graph_factory.GetCoordinates(),
                          node_based_graph_factory.GetCompressedEdges(),
                          restriction_graph,
                          name_table,
@@ -298,9 +499,54 @@ int Extractor::run(ScriptingEnvironment &scripting_environment)
 
     // output the geometry of the node-based graph, needs to be done after the last usage, since it
     // destroys internal containers
-    files::writeSegmentData(config.GetPath(".osrm.geometry"),
-                            *node_based_graph_factory.GetCompressedEdges().ToSegmentData());
+    {
+        auto segment_data = node_based_graph_factory.GetCompressedEdges().ToSegmentData();
+        if (config.compress_geometry)
+        {
+            const auto plain_size = segment_data->GetNodesSizeInBytes();
+            segment_data->CompressNodes();
+            util::Log() << "Compressed geometry node lists from " << plain_size << " to "
+                        << segment_data->GetNodesSizeInBytes() << " bytes";
+        }
+        files::writeSegmentData(config.GetPath(".osrm.geometry"), *segment_data);
+    }
+
+    util::Log() << "Computing strictly connected components ...";
+    FindComponents(number_of_edge_based_nodes,
+                   edge_based_edge_list,
+                   edge_based_node_segments,
+                   edge_based_nodes_container);
+
+    if (config.use_locality_renumbering || !config.previous_dataset_path.empty())
+    {
+        std::vector<std::uint32_t> permutation;
+        if (config.use_locality_renumbering)
+        {
+            permutation = makeHilbertPermutation(number_of_edge_based_nodes,
+                                                 edge_based_node_segments,
+                                                 node_based_graph_factory.GetCoordinates());
+        }
+        else
+        {
+            permutation.resize(number_of_edge_based_nodes);
+            std::iota(permutation.begin(), permutation.end(), 0);
+        }
+        if (!config.previous_dataset_path.empty())
+        {
+            permutation = makeStablePermutation(MatchPreviousNodeIDs(number_of_edge_based_nodes),
+                                                permutation);
+        }
 
+        RenumberEdgeBasedNodes(permutation,
+                               edge_based_nodes_container,
+                               edge_based_node_segments,
+                               edge_based_node_weights,
+                               edge_based_node_durations,
+                               edge_based_node_distances,
+                               edge_based_edge_list);
+    }
+
+    // the node weights have to be written in the order of the renumbered nodes
     util::Log() << "Saving edge-based node weights to file.";
     TIMER_START(timer_write_node_weights);
     extractor::files::writeEdgeBasedNodeWeightsDurationsDistances(config.GetPath(".osrm.enw"),
@@ -310,18 +556,6 @@ int Extractor::run(ScriptingEnvironment &scripting_environment)
     TIMER_STOP(timer_write_node_weights);
     util::Log() << "Done writing. (" << TIMER_SEC(timer_write_node_weights) << ")";
 
-    util::Log() << "Computing strictly connected components ...";
-    FindComponents(number_of_edge_based_nodes,
-                   edge_based_edge_list,
-                   edge_based_node_segments,
-                   edge_based_nodes_container);
-
-    util::Log() << "Building r-tree ...";
-    TIMER_START(rtree);
-    BuildRTree(std::move(edge_based_node_segments), coordinates);
-
-    TIMER_STOP(rtree);
-
     files::writeNodeData(config.GetPath(".osrm.ebg_nodes"), edge_based_nodes_container);
 
     util::Log() << "Writing edge-based-graph edges       ... " << std::flush;
@@ -342,10 +576,9 @@ int Extractor::run(ScriptingEnvironment &scripting_environment)
 
     util::Log() << "Expansion: " << nodes_per_second << " nodes/sec and " << edges_per_second
                 << " edges/sec";
-    util::Log() << "To prepare the data for routing, run: "
-                << "./osrm-partition " << config.base_path;
 
-    return 0;
+    coordinates = std::move(node_based_graph_factory.GetCoordinates());
+    return edge_based_node_segments;
 }
 
 Extractor::ParsedOSMData Extractor::ParseOSMData(ScriptingEnvironment &scripting_environment,
@@ -395,7 +628,10 @@ Extractor::ParsedOSMData Extractor::ParseOSMData(ScriptingEnvironment &scripting
     }
 
     // Extraction containers and restriction parser
-    ExtractionContainers extraction_containers;
+    const auto spill_directory = config.spill_directory.empty()
+                                     ? config.GetPath(".osrm.nbg").parent_path()
+                                     : config.spill_directory;
+    ExtractionContainers extraction_containers(spill_directory, config.memory_budget);
     ExtractorCallbacks::ClassesMap classes_map;
     LaneDescriptionMap turn_lane_map;
     auto extractor_callbacks =
@@ -431,13 +667,18 @@ Extractor::ParsedOSMData Extractor::ParseOSMData(ScriptingEnvironment &scripting
 
     ExtractionRelationContainer relations;
 
-    const auto buffer_reader = [](osmium::io::Reader &reader)
+    // Changes are merged into the input while it is read
+    OSMChangeMerger change_merger(config.change_paths);
+
+    const auto buffer_reader =
+        [&change_merger](osmium::io::Reader &reader, osmium::osm_entity_bits::type entities)
     {
+        change_merger.Rewind(entities);
         return tbb::filter<void, SharedBuffer>(
             tbb::filter_mode::serial_in_order,
-            [&reader](tbb::flow_control &fc)
+            [&reader, &change_merger](tbb::flow_control &fc)
             {
-                if (auto buffer = reader.read())
+                if (auto buffer = change_merger.Read(reader))
                 {
                     return std::make_shared<osmium::memory::Buffer>(std::move(buffer));
                 }
@@ -450,18 +691,21 @@ Extractor::ParsedOSMData Extractor::ParseOSMData(ScriptingEnvironment &scripting
     };
 
     // Node locations cache (assumes nodes are placed before ways)
-    using osmium_index_type =
-        osmium::index::map::FlexMem<osmium::unsigned_object_id_type, osmium::Location>;
-    using osmium_location_handler_type = osmium::handler::NodeLocationsForWays<osmium_index_type>;
-
-    osmium_index_type location_cache;
-    osmium_location_handler_type location_handler(location_cache);
+    NodeLocationIndex location_index(config.location_index_path);
 
     tbb::filter<SharedBuffer, SharedBuffer> location_cacher(
         tbb::filter_mode::serial_in_order,
-        [&location_handler](SharedBuffer buffer)
+        [&location_index](SharedBuffer buffer)
+        {
+            location_index.Store(*buffer);
+            return buffer;
+        });
+
+    tbb::filter<SharedBuffer, SharedBuffer> location_resolver(
+        tbb::filter_mode::parallel,
+        [&location_index](SharedBuffer buffer)
         {
-            osmium::apply(buffer->begin(), buffer->end(), location_handler);
+            location_index.Resolve(*buffer);
             return buffer;
         });
 
@@ -575,24 +819,32 @@ Extractor::ParsedOSMData Extractor::ParseOSMData(ScriptingEnvironment &scripting
 
     { // Relations reading pipeline
         util::Log() << "Parse relations ...";
-        osmium::io::Reader reader(input_file, pool, osmium::osm_entity_bits::relation, read_meta);
-        tbb::parallel_pipeline(
-            num_threads, buffer_reader(reader) & buffer_relation_cache & buffer_storage_relation);
+        const auto entities = osmium::osm_entity_bits::relation;
+        osmium::io::Reader reader(input_file, pool, entities, read_meta);
+        tbb::parallel_pipeline(num_threads,
+                               buffer_reader(reader, entities) & buffer_relation_cache &
+                                   buffer_storage_relation);
     }
 
     { // Nodes and ways reading pipeline
         util::Log() << "Parse ways and nodes ...";
-        osmium::io::Reader reader(input_file,
-                                  pool,
-                                  osmium::osm_entity_bits::node | osmium::osm_entity_bits::way |
-                                      osmium::osm_entity_bits::relation,
-                                  read_meta);
+        const auto entities = osmium::osm_entity_bits::node | osmium::osm_entity_bits::way |
+                              osmium::osm_entity_bits::relation;
+        osmium::io::Reader reader(input_file, pool, entities, read_meta);
 
+        TIMER_START(parse_ways_and_nodes);
         const auto pipeline =
             scripting_environment.HasLocationDependentData() && config.use_locations_cache
-                ? buffer_reader(reader) & location_cacher & buffer_transformer & buffer_storage
-                : buffer_reader(reader) & buffer_transformer & buffer_storage;
+                ? buffer_reader(reader, entities) & location_cacher & location_resolver &
+                      buffer_transformer & buffer_storage
+                : buffer_reader(reader, entities) & buffer_transformer & buffer_storage;
         tbb::parallel_pipeline(num_threads, pipeline);
+        TIMER_STOP(parse_ways_and_nodes);
+
+        const auto input_megabytes = std::filesystem::file_size(config.input_path) / 1e6;
+        util::Log() << "Parsed ways and nodes at "
+                    << input_megabytes / std::max(TIMER_SEC(parse_ways_and_nodes), 1e-3)
+                    << " MB/s of input";
     }
 
     TIMER_STOP(parsing);
@@ -611,7 +863,8 @@ Extractor::ParsedOSMData Extractor::ParseOSMData(ScriptingEnvironment &scripting
     }
 
     extraction_containers.PrepareData(scripting_environment,
-                                      config.GetPath(".osrm.names").string());
+                                      config.GetPath(".osrm.names").string(),
+                                      config.compress_names);
 
     auto profile_properties = scripting_environment.GetProfileProperties();
     SetClassNames(scripting_environment.GetClassNames(), classes_map, profile_properties);
@@ -775,6 +1028,97 @@ EdgeID Extractor::BuildEdgeExpandedGraph(
     return number_of_edge_based_nodes;
 }
 
+/**
+    \brief Looks up the edge-based node ids of the previous dataset
+
+    Nodes are matched by the OSM nodes at the ends of their compressed edge, read from the
+    .osrm.nbg_nodes and .osrm.cnbg_to_ebg files of both datasets. Must run before the mapping of
+    the new dataset is renumbered.
+ */
+std::vector<NodeID> Extractor::MatchPreviousNodeIDs(const EdgeID number_of_edge_based_nodes) const
+{
+    util::Log() << "Matching edge-based nodes with " << config.previous_dataset_path.string()
+                << " ...";
+    TIMER_START(match);
+
+    ExtractorConfig previous_config;
+    previous_config.UseDefaultOutputNames(config.previous_dataset_path);
+
+    std::vector<util::Coordinate> coordinates;
+    PackedOSMIDs osm_node_ids;
+    std::vector<NBGToEBG> mapping;
+    files::readNodes(config.GetPath(".osrm.nbg_nodes"), coordinates, osm_node_ids);
+    files::readNBGMapping(config.GetPath(".osrm.cnbg_to_ebg"), mapping);
+
+    PackedOSMIDs previous_osm_node_ids;
+    std::vector<NBGToEBG> previous_mapping;
+    files::readNodes(
+        previous_config.GetPath(".osrm.nbg_nodes"), coordinates, previous_osm_node_ids);
+    files::readNBGMapping(previous_config.GetPath(".osrm.cnbg_to_ebg"), previous_mapping);
+    coordinates.clear();
+
+    auto previous_ids = matchPreviousNodeIDs(
+        number_of_edge_based_nodes, mapping, osm_node_ids, previous_mapping, previous_osm_node_ids);
+
+    const auto number_of_matched_nodes =
+        std::count_if(previous_ids.begin(),
+                      previous_ids.end(),
+                      [&](const auto id) { return id < number_of_edge_based_nodes; });
+
+    TIMER_STOP(match);
+    util::Log() << "Kept the ids of " << number_of_matched_nodes << " of "
+                << number_of_edge_based_nodes << " edge-based nodes, after " << TIMER_SEC(match)
+                << "s";
+
+    return previous_ids;
+}
+
+/**
+    \brief Renumbers edge-based nodes with the given permutation
+
+    Extraction order has little spatial locality. Sorting the per-node arrays by the location of
+    the node improves cache hit rates for every query that settles nearby nodes. Keeping the ids
+    of a previous dataset lets consumers of node ids carry their data over to the new one. Data
+    that was already written by the edge-based graph factory is patched on disk.
+ */
+void Extractor::RenumberEdgeBasedNodes(
+    const std::vector<std::uint32_t> &permutation,
+    EdgeBasedNodeDataContainer &edge_based_nodes_container,
+    std::vector<EdgeBasedNodeSegment> &edge_based_node_segments,
+    std::vector<EdgeWeight> &edge_based_node_weights,
+    std::vector<EdgeDuration> &edge_based_node_durations,
+    std::vector<EdgeDistance> &edge_based_node_distances,
+    util::DeallocatingVector<EdgeBasedEdge> &edge_based_edge_list)
+{
+    util::Log() << "Renumbering edge-based nodes ...";
+    TIMER_START(renumber);
+
+    edge_based_nodes_container.Renumber(permutation);
+    renumber(edge_based_node_segments, permutation);
+    renumber(edge_based_edge_list, permutation);
+    renumber(
+        edge_based_node_weights, edge_based_node_durations, edge_based_node_distances, permutation);
+
+    {
+        std::vector<NBGToEBG> mapping;
+        files::readNBGMapping(config.GetPath(".osrm.cnbg_to_ebg"), mapping);
+        renumber(mapping, permutation);
+        files::writeNBGMapping(config.GetPath(".osrm.cnbg_to_ebg"), mapping);
+    }
+    {
+        std::vector<StorageManeuverOverride> maneuver_overrides;
+        std::vector<NodeID> node_sequences;
+        files::readManeuverOverrides(
+            config.GetPath(".osrm.maneuver_overrides"), maneuver_overrides, node_sequences);
+        renumber(maneuver_overrides, node_sequences, permutation);
+        files::writeManeuverOverrides(
+            config.GetPath(".osrm.maneuver_overrides"), maneuver_overrides, node_sequences);
+    }
+
+    TIMER_STOP(renumber);
+    util::Log() << "ok, after " << TIMER_SEC(renumber) << "s";
+}
+
 /**
     \brief Building rtree-based nearest-neighbor data structure
 
@@ -12,6 +12,14 @@
 #include "util/log.hpp"
 
 #include <boost/assert.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_pipeline.h>
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <thread>
 #include <unordered_set>
 
 namespace osrm::extractor
@@ -19,6 +27,395 @@ namespace osrm::extractor
 
 static constexpr int SECOND_TO_DECISECOND = 10;
 
+namespace
+{
+
+using EdgeData = GraphCompressor::EdgeData;
+
+// u - v - w has been compressed to u - w
+struct CompressedNode
+{
+    NodeID node_u;
+    NodeID node_v;
+    NodeID node_w;
+};
+
+// A maximal path or cycle of compressible nodes. Its nodes are only adjacent to each other and to
+// its end nodes, so compressing a chain does not depend on other chains. The exception is an edge
+// between the two end nodes: other chains with the same end nodes may create one.
+struct Chain
+{
+    // nodes of the chain in ascending ID order, which is the order of compression
+    std::size_t nodes_begin;
+    std::size_t nodes_end;
+    // edges from the end nodes into the chain in ascending ID order
+    std::size_t end_edges_begin;
+    std::size_t end_edges_end;
+    // SPECIAL_NODEID for a cycle, both the same if the chain starts and ends at the same node
+    NodeID first_end;
+    NodeID second_end;
+    // the end nodes are connected by an edge that is not part of any chain
+    bool ends_connected;
+    // other chains have the same end nodes and have to be compressed in node order with this one
+    bool shares_ends;
+};
+
+// Graph access of the serial compression, all edges can be used
+class GraphEdges
+{
+  public:
+    GraphEdges(const util::NodeBasedDynamicGraph &graph, ObstacleMap &obstacle_map)
+        : graph(graph), obstacle_map(obstacle_map)
+    {
+    }
+
+    EdgeID FindEdge(const NodeID from, const NodeID to) const { return graph.FindEdge(from, to); }
+
+    bool HasEdgeInEitherDirection(const NodeID from, const NodeID to) const
+    {
+        return graph.FindEdgeInEitherDirection(from, to) != SPECIAL_EDGEID;
+    }
+
+    void CompressObstacles(const NodeID node_u, const NodeID node_v, const NodeID node_w) const
+    {
+        obstacle_map.compress(node_u, node_v, node_w);
+    }
+
+  private:
+    const util::NodeBasedDynamicGraph &graph;
+    ObstacleMap &obstacle_map;
+};
+
+// Graph access of the compression of a single chain. Only the nodes of the chain and the edges
+// from its end nodes into the chain are used, so that chains can be compressed concurrently.
+// Obstacles at the end nodes are shared with other chains and are updated by the caller.
+class ChainEdges
+{
+  public:
+    ChainEdges(const util::NodeBasedDynamicGraph &graph,
+               ObstacleMap &obstacle_map,
+               const std::vector<bool> &is_compressible,
+               const std::vector<std::pair<NodeID, EdgeID>> &end_edges,
+               const Chain &chain)
+        : graph(graph), obstacle_map(obstacle_map), is_compressible(is_compressible),
+          end_edges(end_edges), chain(chain)
+    {
+    }
+
+    EdgeID FindEdge(const NodeID from, const NodeID to) const
+    {
+        if (is_compressible[from])
+            return graph.FindEdge(from, to);
+
+        // only the edges of an end node into the chain can lead to a node of the chain
+        BOOST_ASSERT(is_compressible[to]);
+        for (auto index = chain.end_edges_begin; index < chain.end_edges_end; ++index)
+        {
+            const auto &[source, edge] = end_edges[index];
+            if (source == from && graph.GetTarget(edge) == to)
+                return edge;
+        }
+        return SPECIAL_EDGEID;
+    }
+
+    bool HasEdgeInEitherDirection(const NodeID from, const NodeID to) const
+    {
+        if (!is_compressible[from] && !is_compressible[to])
+        {
+            // no other chain can connect the end nodes, they are unique to this chain
+            BOOST_ASSERT(!chain.shares_ends);
+            return chain.ends_connected;
+        }
+        return FindEdge(from, to) != SPECIAL_EDGEID || FindEdge(to, from) != SPECIAL_EDGEID;
+    }
+
+    void CompressObstacles(const NodeID node_u, const NodeID node_v, const NodeID node_w) const
+    {
+        if (is_compressible[node_w])
+            obstacle_map.compressLeadingNode(node_u, node_v, node_w);
+        if (is_compressible[node_u])
+            obstacle_map.compressLeadingNode(node_w, node_v, node_u);
+    }
+
+  private:
+    const util::NodeBasedDynamicGraph &graph;
+    ObstacleMap &obstacle_map;
+    const std::vector<bool> &is_compressible;
+    const std::vector<std::pair<NodeID, EdgeID>> &end_edges;
+    const Chain &chain;
+};
+
+// Compresses the compressible node v with the neighbours u and w to u - w if the edges allow it
+template <typename Edges>
+std::optional<CompressedNode>
+compressNode(const NodeID node_v,
+             const Edges &edges,
+             ScriptingEnvironment &scripting_environment,
+             util::NodeBasedDynamicGraph &graph,
+             const std::vector<NodeBasedEdgeAnnotation> &node_data_container,
+             CompressedEdgeContainer &geometry_compressor)
+{
+    const auto weight_multiplier =
+        scripting_environment.GetProfileProperties().GetWeightMultiplier();
+    const std::vector<ExtractionTurnLeg> no_other_roads;
+
+    //    reverse_e2   forward_e2
+    // u <---------- v -----------> w
+    //    ----------> <-----------
+    //    forward_e1   reverse_e1
+    //
+    // Will be compressed to:
+    //
+    //    reverse_e1
+    // u <---------- w
+    //    ---------->
+    //    forward_e1
+    //
+    // If the edges are compatible.
+    const bool reverse_edge_order = graph.GetEdgeData(graph.BeginEdges(node_v)).reversed;
+    const EdgeID forward_e2 = graph.BeginEdges(node_v) + reverse_edge_order;
+    BOOST_ASSERT(SPECIAL_EDGEID != forward_e2);
+    BOOST_ASSERT(forward_e2 >= graph.BeginEdges(node_v) &&
+                 forward_e2 < graph.EndEdges(node_v));
+    const EdgeID reverse_e2 = graph.BeginEdges(node_v) + 1 - reverse_edge_order;
+
+    BOOST_ASSERT(SPECIAL_EDGEID != reverse_e2);
+    BOOST_ASSERT(reverse_e2 >= graph.BeginEdges(node_v) &&
+                 reverse_e2 < graph.EndEdges(node_v));
+
+    const EdgeData &fwd_edge_data2 = graph.GetEdgeData(forward_e2);
+    const EdgeData &rev_edge_data2 = graph.GetEdgeData(reverse_e2);
+
+    const NodeID node_w = graph.GetTarget(forward_e2);
+    BOOST_ASSERT(SPECIAL_NODEID != node_w);
+    BOOST_ASSERT(node_v != node_w);
+    const NodeID node_u = graph.GetTarget(reverse_e2);
+    BOOST_ASSERT(SPECIAL_NODEID != node_u);
+    BOOST_ASSERT(node_u != node_v);
+
+    const EdgeID forward_e1 = edges.FindEdge(node_u, node_v);
+    BOOST_ASSERT(SPECIAL_EDGEID != forward_e1);
+    BOOST_ASSERT(node_v == graph.GetTarget(forward_e1));
+    const EdgeID reverse_e1 = edges.FindEdge(node_w, node_v);
+    BOOST_ASSERT(SPECIAL_EDGEID != reverse_e1);
+    BOOST_ASSERT(node_v == graph.GetTarget(reverse_e1));
+
+    const EdgeData &fwd_edge_data1 = graph.GetEdgeData(forward_e1);
+    const EdgeData &rev_edge_data1 = graph.GetEdgeData(reverse_e1);
+    const auto fwd_annotation_data1 = node_data_container[fwd_edge_data1.annotation_data];
+    const auto fwd_annotation_data2 = node_data_container[fwd_edge_data2.annotation_data];
+    const auto rev_annotation_data1 = node_data_container[rev_edge_data1.annotation_data];
+    const auto rev_annotation_data2 = node_data_container[rev_edge_data2.annotation_data];
+
+    if (edges.HasEdgeInEitherDirection(node_u, node_w))
+    {
+        return std::nullopt;
+    }
+
+    // this case can happen if two ways with different names overlap
+    if ((fwd_annotation_data1.name_id != rev_annotation_data1.name_id) ||
+        (fwd_annotation_data2.name_id != rev_annotation_data2.name_id))
+    {
+        return std::nullopt;
+    }
+
+    if ((fwd_edge_data1.flags == fwd_edge_data2.flags) &&
+        (rev_edge_data1.flags == rev_edge_data2.flags) &&
+        (fwd_edge_data1.reversed == fwd_edge_data2.reversed) &&
+        (rev_edge_data1.reversed == rev_edge_data2.reversed) &&
+        // annotations need to match, except for the lane-id which can differ
+        fwd_annotation_data1.CanCombineWith(fwd_annotation_data2) &&
+        rev_annotation_data1.CanCombineWith(rev_annotation_data2))
+    {
+        BOOST_ASSERT(!(graph.GetEdgeData(forward_e1).reversed &&
+                       graph.GetEdgeData(reverse_e1).reversed));
+        /*
+         * Remember Lane Data for compressed parts. This handles scenarios where lane-data
+         * is only kept up until a traffic light.
+         *
+         *                |    |
+         * ----------------    |
+         *         -^ |        |
+         * -----------         |
+         *         -v |        |
+         * ---------------     |
+         *                |    |
+         *
+         *  u ------- v ---- w
+         *
+         * Since the edge is compressible, we can transfer: "left|right" (uv)
+         * and "" (uw) into a string with "left|right" (uw) for the compressed
+         * edge.  Doing so, we might mess up the point from where the lanes are
+         * shown. It should be reasonable, since the announcements have to come
+         * early anyhow. So there is a potential danger in here, but it saves us
+         * from adding a lot of additional edges for turn-lanes. Without this,
+         * we would have to treat any turn-lane beginning or ending just like an
+         * obstacle.
+         */
+        const auto selectAnnotation =
+            [&node_data_container](const AnnotationID front_annotation,
+                                   const AnnotationID back_annotation)
+        {
+            // A lane has tags: u - (front) - v - (back) - w
+            // During contraction, we keep only one of the tags. Usually the one closer
+            // to the intersection is preferred. If its empty, however, we keep the
+            // non-empty one
+            if (node_data_container[back_annotation].lane_description_id ==
+                INVALID_LANE_DESCRIPTIONID)
+                return front_annotation;
+            return back_annotation;
+        };
+
+        graph.GetEdgeData(forward_e1).annotation_data = selectAnnotation(
+            fwd_edge_data1.annotation_data, fwd_edge_data2.annotation_data);
+        graph.GetEdgeData(reverse_e1).annotation_data = selectAnnotation(
+            rev_edge_data1.annotation_data, rev_edge_data2.annotation_data);
+        graph.GetEdgeData(forward_e2).annotation_data = selectAnnotation(
+            fwd_edge_data2.annotation_data, fwd_edge_data1.annotation_data);
+        graph.GetEdgeData(reverse_e2).annotation_data = selectAnnotation(
+            rev_edge_data2.annotation_data, rev_edge_data1.annotation_data);
+
+        // we cannot handle this as node penalty, if it depends on turn direction
+        if (fwd_edge_data1.flags.restricted != fwd_edge_data2.flags.restricted)
+            return std::nullopt;
+
+        // Get weights before graph is modified
+        const auto forward_weight1 = fwd_edge_data1.weight;
+        const auto forward_weight2 = fwd_edge_data2.weight;
+        const auto forward_duration1 = fwd_edge_data1.duration;
+        const auto forward_duration2 = fwd_edge_data2.duration;
+
+        BOOST_ASSERT(EdgeWeight{0} != forward_weight1);
+        BOOST_ASSERT(EdgeWeight{0} != forward_weight2);
+
+        const auto reverse_weight1 = rev_edge_data1.weight;
+        const auto reverse_weight2 = rev_edge_data2.weight;
+        const auto reverse_duration1 = rev_edge_data1.duration;
+        const auto reverse_duration2 = rev_edge_data2.duration;
+
+#ifndef NDEBUG
+        // Because distances are symmetrical, we only need one
+        // per edge - here we double-check that they match
+        // their mirrors.
+        const auto reverse_distance1 = rev_edge_data1.distance;
+        const auto forward_distance1 = fwd_edge_data1.distance;
+        const auto forward_distance2 = fwd_edge_data2.distance;
+        const auto reverse_distance2 = rev_edge_data2.distance;
+        BOOST_ASSERT(forward_distance1 == reverse_distance2);
+        BOOST_ASSERT(forward_distance2 == reverse_distance1);
+#endif
+
+        BOOST_ASSERT(EdgeWeight{0} != reverse_weight1);
+        BOOST_ASSERT(EdgeWeight{0} != reverse_weight2);
+
+        struct EdgePenalties
+        {
+            EdgeDuration duration;
+            EdgeWeight weight;
+        };
+
+        auto update_edge =
+            [](EdgeData &to, const EdgeData &from, const EdgePenalties &penalties)
+        {
+            to.weight += from.weight;
+            to.duration += from.duration;
+            to.distance += from.distance;
+            to.weight += penalties.weight;
+            to.duration += penalties.duration;
+        };
+
+        // Add the obstacle's penalties to the edge when compressing an edge with
+        // an obstacle
+        auto get_obstacle_penalty = [&scripting_environment,
+                                     weight_multiplier,
+                                     no_other_roads](const NodeID from,
+                                                     const NodeID via,
+                                                     const NodeID to,
+                                                     const EdgeData &from_edge,
+                                                     const EdgeData &to_edge,
+                                                     EdgePenalties &penalties)
+        {
+            // generate an artificial turn for the turn penalty generation
+            ExtractionTurn fake_turn{
+                from, via, to, from_edge, to_edge, no_other_roads, no_other_roads};
+            scripting_environment.ProcessTurn(fake_turn);
+            penalties.duration +=
+                to_alias<EdgeDuration>(fake_turn.duration * SECOND_TO_DECISECOND);
+            penalties.weight += to_alias<EdgeWeight>(fake_turn.weight * weight_multiplier);
+        };
+
+        auto &f1_data = graph.GetEdgeData(forward_e1);
+        auto &b1_data = graph.GetEdgeData(reverse_e1);
+        const auto &f2_data = graph.GetEdgeData(forward_e2);
+        const auto &b2_data = graph.GetEdgeData(reverse_e2);
+
+        EdgePenalties forward_penalties{{0}, {0}};
+        EdgePenalties backward_penalties{{0}, {0}};
+
+        if (scripting_environment.m_obstacle_map.any(node_v))
+        {
+            get_obstacle_penalty(
+                node_u, node_v, node_w, f1_data, f2_data, forward_penalties);
+            get_obstacle_penalty(
+                node_w, node_v, node_u, b1_data, b2_data, backward_penalties);
+        }
+
+        update_edge(f1_data, f2_data, forward_penalties);
+        update_edge(b1_data, b2_data, backward_penalties);
+
+        // extend e1's to targets of e2's
+        graph.SetTarget(forward_e1, node_w);
+        graph.SetTarget(reverse_e1, node_u);
+
+        // remove e2's (if bidir, otherwise only one)
+        graph.DeleteEdge(node_v, forward_e2);
+        graph.DeleteEdge(node_v, reverse_e2);
+
+        // Update obstacle paths containing the compressed node.
+        edges.CompressObstacles(node_u, node_v, node_w);
+
+        // Forward and backward penalties must both be valid or both be invalid.
+        auto set_dummy_penalty = [](EdgePenalties &f, EdgePenalties &b)
+        {
+            if (f.weight == INVALID_EDGE_WEIGHT && b.weight != INVALID_EDGE_WEIGHT)
+            {
+                f.weight = {0};
+                f.duration = {0};
+            }
+        };
+        set_dummy_penalty(forward_penalties, backward_penalties);
+        set_dummy_penalty(backward_penalties, forward_penalties);
+
+        // store compressed geometry in container
+        geometry_compressor.CompressEdge(forward_e1,
+                                         forward_e2,
+                                         node_v,
+                                         node_w,
+                                         forward_weight1,
+                                         forward_weight2,
+                                         forward_duration1,
+                                         forward_duration2,
+                                         forward_penalties.weight,
+                                         forward_penalties.duration);
+        geometry_compressor.CompressEdge(reverse_e1,
+                                         reverse_e2,
+                                         node_v,
+                                         node_u,
+                                         reverse_weight1,
+                                         reverse_weight2,
+                                         reverse_duration1,
+                                         reverse_duration2,
+                                         backward_penalties.weight,
+                                         backward_penalties.duration);
+
+        return CompressedNode{node_u, node_v, node_w};
+    }
+
+    return std::nullopt;
+}
+
+} // namespace
+
 void GraphCompressor::Compress(ScriptingEnvironment &scripting_environment,
                                std::vector<TurnRestriction> &turn_restrictions,
                                std::vector<UnresolvedManeuverOverride> &maneuver_overrides,
@@ -28,9 +425,7 @@ void GraphCompressor::Compress(ScriptingEnvironment &scripting_environment,
 {
     const unsigned original_number_of_nodes = graph.GetNumberOfNodes();
     const unsigned original_number_of_edges = graph.GetNumberOfEdges();
-    const std::vector<ExtractionTurnLeg> no_other_roads;
-
-    TurnPathCompressor turn_path_compressor(turn_restrictions, maneuver_overrides);
+    auto &obstacle_map = scripting_environment.m_obstacle_map;
 
     // Some degree two nodes are not compressed if they act as entry/exit points into a
     // restriction path.
@@ -59,290 +454,254 @@ void GraphCompressor::Compress(ScriptingEnvironment &scripting_environment,
         incompressible_via_nodes.insert(maneuver.instruction_node);
     }
 
+    // Only degree two nodes without obstacles that prevent compression and that are not an
+    // entry/exit point of a restriction can be compressed. Compression does not change this.
+    std::vector<bool> is_compressible(original_number_of_nodes, false);
+    for (const NodeID node_v : util::irange(0u, original_number_of_nodes))
     {
-        const auto weight_multiplier =
-            scripting_environment.GetProfileProperties().GetWeightMultiplier();
-        util::UnbufferedLog log;
-        util::Percent progress(log, original_number_of_nodes);
+        is_compressible[node_v] =
+            2 == graph.GetOutDegree(node_v) &&
+            !obstacle_map.any(SPECIAL_NODEID, node_v, Obstacle::Type::Incompressible) &&
+            !incompressible_via_nodes.contains(node_v);
+    }
 
-        for (const NodeID node_v : util::irange(0u, original_number_of_nodes))
+    // Split the compressible nodes into chains, which are compressed independently
+    std::vector<Chain> chains;
+    std::vector<NodeID> chain_nodes;
+    std::vector<std::pair<NodeID, EdgeID>> end_edges;
+    {
+        std::vector<bool> visited(original_number_of_nodes, false);
+        std::vector<NodeID> stack;
+        std::vector<NodeID> ends;
+        for (const NodeID start : util::irange(0u, original_number_of_nodes))
         {
-            progress.PrintStatus(node_v);
-
-            // only contract degree 2 vertices
-            if (2 != graph.GetOutDegree(node_v))
-            {
+            if (!is_compressible[start] || visited[start])
                 continue;
-            }
 
-            // don't compress nodes with these obstacle types
-            if (scripting_environment.m_obstacle_map.any(
-                    SPECIAL_NODEID, node_v, Obstacle::Type::Incompressible))
+            Chain chain{chain_nodes.size(),
+                        0,
+                        end_edges.size(),
+                        0,
+                        SPECIAL_NODEID,
+                        SPECIAL_NODEID,
+                        false,
+                        false};
+            ends.clear();
+
+            visited[start] = true;
+            stack.push_back(start);
+            while (!stack.empty())
             {
-                continue;
-            }
+                const auto node = stack.back();
+                stack.pop_back();
+                chain_nodes.push_back(node);
 
-            // check if v is an entry/exit via node for a turn restriction
-            if (incompressible_via_nodes.contains(node_v))
-            {
-                continue;
-            }
+                for (const auto edge : graph.GetAdjacentEdgeRange(node))
+                {
+                    const auto target = graph.GetTarget(edge);
+                    if (is_compressible[target])
+                    {
+                        if (!visited[target])
+                        {
+                            visited[target] = true;
+                            stack.push_back(target);
+                        }
+                        continue;
+                    }
 
-            //    reverse_e2   forward_e2
-            // u <---------- v -----------> w
-            //    ----------> <-----------
-            //    forward_e1   reverse_e1
-            //
-            // Will be compressed to:
-            //
-            //    reverse_e1
-            // u <---------- w
-            //    ---------->
-            //    forward_e1
-            //
-            // If the edges are compatible.
-            const bool reverse_edge_order = graph.GetEdgeData(graph.BeginEdges(node_v)).reversed;
-            const EdgeID forward_e2 = graph.BeginEdges(node_v) + reverse_edge_order;
-            BOOST_ASSERT(SPECIAL_EDGEID != forward_e2);
-            BOOST_ASSERT(forward_e2 >= graph.BeginEdges(node_v) &&
-                         forward_e2 < graph.EndEdges(node_v));
-            const EdgeID reverse_e2 = graph.BeginEdges(node_v) + 1 - reverse_edge_order;
-
-            BOOST_ASSERT(SPECIAL_EDGEID != reverse_e2);
-            BOOST_ASSERT(reverse_e2 >= graph.BeginEdges(node_v) &&
-                         reverse_e2 < graph.EndEdges(node_v));
-
-            const EdgeData &fwd_edge_data2 = graph.GetEdgeData(forward_e2);
-            const EdgeData &rev_edge_data2 = graph.GetEdgeData(reverse_e2);
-
-            const NodeID node_w = graph.GetTarget(forward_e2);
-            BOOST_ASSERT(SPECIAL_NODEID != node_w);
-            BOOST_ASSERT(node_v != node_w);
-            const NodeID node_u = graph.GetTarget(reverse_e2);
-            BOOST_ASSERT(SPECIAL_NODEID != node_u);
-            BOOST_ASSERT(node_u != node_v);
-
-            const EdgeID forward_e1 = graph.FindEdge(node_u, node_v);
-            BOOST_ASSERT(SPECIAL_EDGEID != forward_e1);
-            BOOST_ASSERT(node_v == graph.GetTarget(forward_e1));
-            const EdgeID reverse_e1 = graph.FindEdge(node_w, node_v);
-            BOOST_ASSERT(SPECIAL_EDGEID != reverse_e1);
-            BOOST_ASSERT(node_v == graph.GetTarget(reverse_e1));
-
-            const EdgeData &fwd_edge_data1 = graph.GetEdgeData(forward_e1);
-            const EdgeData &rev_edge_data1 = graph.GetEdgeData(reverse_e1);
-            const auto fwd_annotation_data1 = node_data_container[fwd_edge_data1.annotation_data];
-            const auto fwd_annotation_data2 = node_data_container[fwd_edge_data2.annotation_data];
-            const auto rev_annotation_data1 = node_data_container[rev_edge_data1.annotation_data];
-            const auto rev_annotation_data2 = node_data_container[rev_edge_data2.annotation_data];
-
-            if (graph.FindEdgeInEitherDirection(node_u, node_w) != SPECIAL_EDGEID)
-            {
-                continue;
+                    ends.push_back(target);
+                    for (const auto end_edge : graph.GetAdjacentEdgeRange(target))
+                    {
+                        if (graph.GetTarget(end_edge) == node)
+                            end_edges.emplace_back(target, end_edge);
+                    }
+                }
             }
 
-            // this case can happen if two ways with different names overlap
-            if ((fwd_annotation_data1.name_id != rev_annotation_data1.name_id) ||
-                (fwd_annotation_data2.name_id != rev_annotation_data2.name_id))
+            chain.nodes_end = chain_nodes.size();
+            std::sort(chain_nodes.begin() + chain.nodes_begin, chain_nodes.end());
+
+            // parallel edges add an end edge more than once
+            const auto by_edge = [](const auto &lhs, const auto &rhs)
+            { return lhs.second < rhs.second; };
+            std::sort(end_edges.begin() + chain.end_edges_begin, end_edges.end(), by_edge);
+            end_edges.erase(std::unique(end_edges.begin() + chain.end_edges_begin,
+                                        end_edges.end()),
+                            end_edges.end());
+            chain.end_edges_end = end_edges.size();
+
+            std::sort(ends.begin(), ends.end());
+            ends.erase(std::unique(ends.begin(), ends.end()), ends.end());
+            BOOST_ASSERT(ends.size() <= 2);
+            if (!ends.empty())
             {
-                continue;
+                chain.first_end = ends.front();
+                chain.second_end = ends.back();
+                chain.ends_connected =
+                    graph.FindEdgeInEitherDirection(chain.first_end, chain.second_end) !=
+                    SPECIAL_EDGEID;
             }
 
-            if ((fwd_edge_data1.flags == fwd_edge_data2.flags) &&
-                (rev_edge_data1.flags == rev_edge_data2.flags) &&
-                (fwd_edge_data1.reversed == fwd_edge_data2.reversed) &&
-                (rev_edge_data1.reversed == rev_edge_data2.reversed) &&
-                // annotations need to match, except for the lane-id which can differ
-                fwd_annotation_data1.CanCombineWith(fwd_annotation_data2) &&
-                rev_annotation_data1.CanCombineWith(rev_annotation_data2))
-            {
-                BOOST_ASSERT(!(graph.GetEdgeData(forward_e1).reversed &&
-                               graph.GetEdgeData(reverse_e1).reversed));
-                /*
-                 * Remember Lane Data for compressed parts. This handles scenarios where lane-data
-                 * is only kept up until a traffic light.
-                 *
-                 *                |    |
-                 * ----------------    |
-                 *         -^ |        |
-                 * -----------         |
-                 *         -v |        |
-                 * ---------------     |
-                 *                |    |
-                 *
-                 *  u ------- v ---- w
-                 *
-                 * Since the edge is compressible, we can transfer: "left|right" (uv)
-                 * and "" (uw) into a string with "left|right" (uw) for the compressed
-                 * edge.  Doing so, we might mess up the point from where the lanes are
-                 * shown. It should be reasonable, since the announcements have to come
-                 * early anyhow. So there is a potential danger in here, but it saves us
-                 * from adding a lot of additional edges for turn-lanes. Without this,
-                 * we would have to treat any turn-lane beginning or ending just like an
-                 * obstacle.
-                 */
-                const auto selectAnnotation =
-                    [&node_data_container](const AnnotationID front_annotation,
-                                           const AnnotationID back_annotation)
-                {
-                    // A lane has tags: u - (front) - v - (back) - w
-                    // During contraction, we keep only one of the tags. Usually the one closer
-                    // to the intersection is preferred. If its empty, however, we keep the
-                    // non-empty one
-                    if (node_data_container[back_annotation].lane_description_id ==
-                        INVALID_LANE_DESCRIPTIONID)
-                        return front_annotation;
-                    return back_annotation;
-                };
-
-                graph.GetEdgeData(forward_e1).annotation_data = selectAnnotation(
-                    fwd_edge_data1.annotation_data, fwd_edge_data2.annotation_data);
-                graph.GetEdgeData(reverse_e1).annotation_data = selectAnnotation(
-                    rev_edge_data1.annotation_data, rev_edge_data2.annotation_data);
-                graph.GetEdgeData(forward_e2).annotation_data = selectAnnotation(
-                    fwd_edge_data2.annotation_data, fwd_edge_data1.annotation_data);
-                graph.GetEdgeData(reverse_e2).annotation_data = selectAnnotation(
-                    rev_edge_data2.annotation_data, rev_edge_data1.annotation_data);
-
-                // we cannot handle this as node penalty, if it depends on turn direction
-                if (fwd_edge_data1.flags.restricted != fwd_edge_data2.flags.restricted)
-                    continue;
-
-                // Get weights before graph is modified
-                const auto forward_weight1 = fwd_edge_data1.weight;
-                const auto forward_weight2 = fwd_edge_data2.weight;
-                const auto forward_duration1 = fwd_edge_data1.duration;
-                const auto forward_duration2 = fwd_edge_data2.duration;
-
-                BOOST_ASSERT(EdgeWeight{0} != forward_weight1);
-                BOOST_ASSERT(EdgeWeight{0} != forward_weight2);
-
-                const auto reverse_weight1 = rev_edge_data1.weight;
-                const auto reverse_weight2 = rev_edge_data2.weight;
-                const auto reverse_duration1 = rev_edge_data1.duration;
-                const auto reverse_duration2 = rev_edge_data2.duration;
+            chains.push_back(chain);
+        }
+    }
 
-#ifndef NDEBUG
-                // Because distances are symmetrical, we only need one
-                // per edge - here we double-check that they match
-                // their mirrors.
-                const auto reverse_distance1 = rev_edge_data1.distance;
-                const auto forward_distance1 = fwd_edge_data1.distance;
-                const auto forward_distance2 = fwd_edge_data2.distance;
-                const auto reverse_distance2 = rev_edge_data2.distance;
-                BOOST_ASSERT(forward_distance1 == reverse_distance2);
-                BOOST_ASSERT(forward_distance2 == reverse_distance1);
-#endif
+    // Chains with the same end nodes can both try to connect them. Whether the later one can is
+    // only known once the earlier one is compressed, so these are compressed serially.
+    {
+        std::vector<std::size_t> chains_with_ends;
+        for (const auto index : util::irange<std::size_t>(0, chains.size()))
+        {
+            if (chains[index].first_end != SPECIAL_NODEID)
+                chains_with_ends.push_back(index);
+        }
+        const auto ends_of = [&chains](const std::size_t index)
+        { return std::make_pair(chains[index].first_end, chains[index].second_end); };
+        std::sort(chains_with_ends.begin(),
+                  chains_with_ends.end(),
+                  [&](const auto lhs, const auto rhs) { return ends_of(lhs) < ends_of(rhs); });
+        for (std::size_t begin = 0, end = 0; begin < chains_with_ends.size(); begin = end)
+        {
+            end = begin + 1;
+            while (end < chains_with_ends.size() &&
+                   ends_of(chains_with_ends[begin]) == ends_of(chains_with_ends[end]))
+                ++end;
 
-                BOOST_ASSERT(EdgeWeight{0} != reverse_weight1);
-                BOOST_ASSERT(EdgeWeight{0} != reverse_weight2);
+            if (end - begin > 1)
+            {
+                for (const auto index : util::irange(begin, end))
+                    chains[chains_with_ends[index]].shares_ends = true;
+            }
+        }
+    }
 
-                struct EdgePenalties
-                {
-                    EdgeDuration duration;
-                    EdgeWeight weight;
-                };
+    // Compressed nodes in the order of compression, turn paths are updated afterwards
+    std::vector<CompressedNode> compressed_nodes;
 
-                auto update_edge =
-                    [](EdgeData &to, const EdgeData &from, const EdgePenalties &penalties)
-                {
-                    to.weight += from.weight;
-                    to.duration += from.duration;
-                    to.distance += from.distance;
-                    to.weight += penalties.weight;
-                    to.duration += penalties.duration;
-                };
-
-                // Add the obstacle's penalties to the edge when compressing an edge with
-                // an obstacle
-                auto get_obstacle_penalty = [&scripting_environment,
-                                             weight_multiplier,
-                                             no_other_roads](const NodeID from,
-                                                             const NodeID via,
-                                                             const NodeID to,
-                                                             const EdgeData &from_edge,
-                                                             const EdgeData &to_edge,
-                                                             EdgePenalties &penalties)
+    {
+        util::UnbufferedLog log;
+        util::Percent progress(log, chain_nodes.size());
+
+        // Chains are compressed in parallel into their own geometry containers that are merged
+        // in the order of the chains, so the result does not depend on the number of threads.
+        struct CompressionBuffer
+        {
+            CompressedEdgeContainer geometries;
+            std::vector<CompressedNode> compressed_nodes;
+            std::size_t nodes_processed = 0;
+        };
+        using CompressionBufferPtr = std::shared_ptr<CompressionBuffer>;
+
+        const constexpr std::size_t GRAINSIZE = 1000;
+        std::size_t current_chain = 0;
+        tbb::filter<void, tbb::blocked_range<std::size_t>> generator_stage(
+            tbb::filter_mode::serial_in_order,
+            [&](tbb::flow_control &fc)
+            {
+                if (current_chain < chains.size())
                 {
-                    // generate an artificial turn for the turn penalty generation
-                    ExtractionTurn fake_turn{
-                        from, via, to, from_edge, to_edge, no_other_roads, no_other_roads};
-                    scripting_environment.ProcessTurn(fake_turn);
-                    penalties.duration +=
-                        to_alias<EdgeDuration>(fake_turn.duration * SECOND_TO_DECISECOND);
-                    penalties.weight += to_alias<EdgeWeight>(fake_turn.weight * weight_multiplier);
-                };
-
-                auto &f1_data = graph.GetEdgeData(forward_e1);
-                auto &b1_data = graph.GetEdgeData(reverse_e1);
-                const auto &f2_data = graph.GetEdgeData(forward_e2);
-                const auto &b2_data = graph.GetEdgeData(reverse_e2);
-
-                EdgePenalties forward_penalties{{0}, {0}};
-                EdgePenalties backward_penalties{{0}, {0}};
-
-                if (scripting_environment.m_obstacle_map.any(node_v))
+                    auto next_chain = std::min(current_chain + GRAINSIZE, chains.size());
+                    auto result = tbb::blocked_range<std::size_t>(current_chain, next_chain);
+                    current_chain = next_chain;
+                    return result;
+                }
+                else
                 {
-                    get_obstacle_penalty(
-                        node_u, node_v, node_w, f1_data, f2_data, forward_penalties);
-                    get_obstacle_penalty(
-                        node_w, node_v, node_u, b1_data, b2_data, backward_penalties);
+                    fc.stop();
+                    return tbb::blocked_range<std::size_t>(chains.size(), chains.size());
                 }
+            });
 
-                update_edge(f1_data, f2_data, forward_penalties);
-                update_edge(b1_data, b2_data, backward_penalties);
+        tbb::filter<tbb::blocked_range<std::size_t>, CompressionBufferPtr> processor_stage(
+            tbb::filter_mode::parallel,
+            [&](const tbb::blocked_range<std::size_t> &chain_range)
+            {
+                auto buffer = std::make_shared<CompressionBuffer>();
+                for (const auto index : util::irange(chain_range.begin(), chain_range.end()))
+                {
+                    const auto &chain = chains[index];
+                    buffer->nodes_processed += chain.nodes_end - chain.nodes_begin;
+                    if (chain.shares_ends)
+                        continue;
 
-                // extend e1's to targets of e2's
-                graph.SetTarget(forward_e1, node_w);
-                graph.SetTarget(reverse_e1, node_u);
+                    const ChainEdges edges(graph, obstacle_map, is_compressible, end_edges, chain);
+                    for (const auto node_index : util::irange(chain.nodes_begin, chain.nodes_end))
+                    {
+                        if (const auto compressed_node = compressNode(chain_nodes[node_index],
+                                                                      edges,
+                                                                      scripting_environment,
+                                                                      graph,
+                                                                      node_data_container,
+                                                                      buffer->geometries))
+                        {
+                            buffer->compressed_nodes.push_back(*compressed_node);
+                        }
+                    }
+                }
+                return buffer;
+            });
 
-                // remove e2's (if bidir, otherwise only one)
-                graph.DeleteEdge(node_v, forward_e2);
-                graph.DeleteEdge(node_v, reverse_e2);
+        tbb::filter<CompressionBufferPtr, void> output_stage(
+            tbb::filter_mode::serial_in_order,
+            [&](auto buffer)
+            {
+                progress.PrintAddition(buffer->nodes_processed);
+                geometry_compressor.Merge(std::move(buffer->geometries));
+                compressed_nodes.insert(compressed_nodes.end(),
+                                        buffer->compressed_nodes.begin(),
+                                        buffer->compressed_nodes.end());
+            });
+
+        tbb::parallel_pipeline(std::thread::hardware_concurrency() * 5,
+                               generator_stage & processor_stage & output_stage);
+    }
 
-                // update any involved turn relations
-                turn_path_compressor.Compress(node_u, node_v, node_w);
+    // The obstacles at the end nodes of the chains are shared between chains
+    for (const auto &[node_u, node_v, node_w] : compressed_nodes)
+    {
+        if (!is_compressible[node_w])
+            obstacle_map.compressLeadingNode(node_u, node_v, node_w);
+        if (!is_compressible[node_u])
+            obstacle_map.compressLeadingNode(node_w, node_v, node_u);
+    }
 
-                // Update obstacle paths containing the compressed node.
-                scripting_environment.m_obstacle_map.compress(node_u, node_v, node_w);
+    // Compress the chains that share their end nodes in node order, like a serial compression
+    {
+        std::vector<NodeID> shared_ends_nodes;
+        for (const auto &chain : chains)
+        {
+            if (chain.shares_ends)
+                shared_ends_nodes.insert(shared_ends_nodes.end(),
+                                         chain_nodes.begin() + chain.nodes_begin,
+                                         chain_nodes.begin() + chain.nodes_end);
+        }
+        std::sort(shared_ends_nodes.begin(), shared_ends_nodes.end());
 
-                // Forward and backward penalties must both be valid or both be invalid.
-                auto set_dummy_penalty = [](EdgePenalties &f, EdgePenalties &b)
-                {
-                    if (f.weight == INVALID_EDGE_WEIGHT && b.weight != INVALID_EDGE_WEIGHT)
-                    {
-                        f.weight = {0};
-                        f.duration = {0};
-                    }
-                };
-                set_dummy_penalty(forward_penalties, backward_penalties);
-                set_dummy_penalty(backward_penalties, forward_penalties);
-
-                // store compressed geometry in container
-                geometry_compressor.CompressEdge(forward_e1,
-                                                 forward_e2,
-                                                 node_v,
-                                                 node_w,
-                                                 forward_weight1,
-                                                 forward_weight2,
-                                                 forward_duration1,
-                                                 forward_duration2,
-                                                 forward_penalties.weight,
-                                                 forward_penalties.duration);
-                geometry_compressor.CompressEdge(reverse_e1,
-                                                 reverse_e2,
-                                                 node_v,
-                                                 node_u,
-                                                 reverse_weight1,
-                                                 reverse_weight2,
-                                                 reverse_duration1,
-                                                 reverse_duration2,
-                                                 backward_penalties.weight,
-                                                 backward_penalties.duration);
+        const GraphEdges edges(graph, obstacle_map);
+        for (const auto node_v : shared_ends_nodes)
+        {
+            if (const auto compressed_node = compressNode(node_v,
+                                                          edges,
+                                                          scripting_environment,
+                                                          graph,
+                                                          node_data_container,
+                                                          geometry_compressor))
+            {
+                compressed_nodes.push_back(*compressed_node);
             }
         }
     }
 
+    // update any involved turn relations in the order of a serial compression
+    std::sort(compressed_nodes.begin(),
+              compressed_nodes.end(),
+              [](const auto &lhs, const auto &rhs) { return lhs.node_v < rhs.node_v; });
+    TurnPathCompressor turn_path_compressor(turn_restrictions, maneuver_overrides);
+    for (const auto &[node_u, node_v, node_w] : compressed_nodes)
+    {
+        turn_path_compressor.Compress(node_u, node_v, node_w);
+    }
+
     PrintStatistics(original_number_of_nodes, original_number_of_edges, graph);
 
     // Repeate the loop, but now add all edges as uncompressed values.
@@ -0,0 +1,264 @@
+#include "extractor/node_renumbering.hpp"
+
+#include "util/coordinate_calculation.hpp"
+#include "util/hilbert_value.hpp"
+#include "util/permutation.hpp"
+#include "util/web_mercator.hpp"
+
+#include <boost/assert.hpp>
+
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <tuple>
+
+namespace osrm::extractor
+{
+
+std::vector<std::uint32_t>
+makeHilbertPermutation(const std::uint32_t number_of_edge_based_nodes,
+                       const std::vector<EdgeBasedNodeSegment> &segments,
+                       const std::vector<util::Coordinate> &coordinates)
+{
+    // Nodes that are never referenced by a segment are sorted to the end
+    std::vector<std::uint64_t> hilbert_values(number_of_edge_based_nodes,
+                                              std::numeric_limits<std::uint64_t>::max());
+
+    // Every edge-based node has exactly one segment at position 0, so each entry is written once.
+    tbb::parallel_for(
+        tbb::blocked_range<std::size_t>(0, segments.size()),
+        [&](const tbb::blocked_range<std::size_t> &range)
+        {
+            for (auto index = range.begin(); index != range.end(); ++index)
+            {
+                const auto &segment = segments[index];
+                if (segment.fwd_segment_position != 0)
+                    continue;
+
+                BOOST_ASSERT(segment.u < coordinates.size());
+                BOOST_ASSERT(segment.v < coordinates.size());
+
+                // Same projection as the r-tree uses to sort its leaves
+                auto centroid = util::coordinate_calculation::centroid(coordinates[segment.u],
+                                                                       coordinates[segment.v]);
+                centroid.lat = util::FixedLatitude{static_cast<std::int32_t>(
+                    COORDINATE_PRECISION *
+                    util::web_mercator::latToY(util::toFloating(centroid.lat)))};
+                const auto hilbert_value = util::GetHilbertCode(centroid);
+
+                if (segment.forward_segment_id.enabled)
+                {
+                    BOOST_ASSERT(segment.forward_segment_id.id < number_of_edge_based_nodes);
+                    hilbert_values[segment.forward_segment_id.id] = hilbert_value;
+                }
+                if (segment.reverse_segment_id.enabled)
+                {
+                    BOOST_ASSERT(segment.reverse_segment_id.id < number_of_edge_based_nodes);
+                    hilbert_values[segment.reverse_segment_id.id] = hilbert_value;
+                }
+            }
+        });
+
+    std::vector<std::uint32_t> ordering(number_of_edge_based_nodes);
+    std::iota(ordering.begin(), ordering.end(), 0);
+
+    // Ties are broken by the old id to keep the result deterministic
+    tbb::parallel_sort(ordering.begin(),
+                       ordering.end(),
+                       [&hilbert_values](const auto lhs, const auto rhs)
+                       {
+                           return std::tie(hilbert_values[lhs], lhs) <
+                                  std::tie(hilbert_values[rhs], rhs);
+                       });
+
+    return util::orderingToPermutation(ordering);
+}
+
+namespace
+{
+struct NodeKey
+{
+    OSMNodeID from;
+    OSMNodeID to;
+    NodeID node;
+};
+
+// Keys every edge-based node by the OSM nodes at the start and end of its compressed edge, sorted
+// by key. Keys that occur more than once are dropped.
+std::vector<NodeKey> makeUniqueNodeKeys(const std::vector<NBGToEBG> &mapping,
+                                        const PackedOSMIDs &osm_node_ids)
+{
+    std::vector<NodeKey> keys;
+    keys.reserve(2 * mapping.size());
+    for (const auto &entry : mapping)
+    {
+        BOOST_ASSERT(entry.u < osm_node_ids.size());
+        BOOST_ASSERT(entry.v < osm_node_ids.size());
+        if (entry.forward_ebg_node != SPECIAL_NODEID)
+            keys.push_back({osm_node_ids[entry.u], osm_node_ids[entry.v], entry.forward_ebg_node});
+        if (entry.backward_ebg_node != SPECIAL_NODEID)
+            keys.push_back({osm_node_ids[entry.v], osm_node_ids[entry.u], entry.backward_ebg_node});
+    }
+
+    tbb::parallel_sort(keys.begin(),
+                       keys.end(),
+                       [](const auto &lhs, const auto &rhs)
+                       { return std::tie(lhs.from, lhs.to) < std::tie(rhs.from, rhs.to); });
+
+    const auto same_key = [](const auto &lhs, const auto &rhs)
+    { return lhs.from == rhs.from && lhs.to == rhs.to; };
+
+    auto output = keys.begin();
+    for (auto first = keys.begin(); first != keys.end();)
+    {
+        auto last = std::next(first);
+        while (last != keys.end() && same_key(*first, *last))
+            ++last;
+        if (std::distance(first, last) == 1)
+            *output++ = *first;
+        first = last;
+    }
+    keys.erase(output, keys.end());
+
+    return keys;
+}
+} // namespace
+
+std::vector<NodeID> matchPreviousNodeIDs(const std::uint32_t number_of_edge_based_nodes,
+                                         const std::vector<NBGToEBG> &mapping,
+                                         const PackedOSMIDs &osm_node_ids,
+                                         const std::vector<NBGToEBG> &previous_mapping,
+                                         const PackedOSMIDs &previous_osm_node_ids)
+{
+    const auto keys = makeUniqueNodeKeys(mapping, osm_node_ids);
+    const auto previous_keys = makeUniqueNodeKeys(previous_mapping, previous_osm_node_ids);
+
+    std::vector<NodeID> previous_ids(number_of_edge_based_nodes, SPECIAL_NODEID);
+
+    // both lists are sorted by key
+    auto previous_key = previous_keys.begin();
+    for (const auto &key : keys)
+    {
+        while (previous_key != previous_keys.end() &&
+               std::tie(previous_key->from, previous_key->to) < std::tie(key.from, key.to))
+            ++previous_key;
+        if (previous_key == previous_keys.end())
+            break;
+
+        if (previous_key->from == key.from && previous_key->to == key.to)
+        {
+            BOOST_ASSERT(key.node < number_of_edge_based_nodes);
+            previous_ids[key.node] = previous_key->node;
+        }
+    }
+
+    return previous_ids;
+}
+
+std::vector<std::uint32_t> makeStablePermutation(const std::vector<NodeID> &previous_ids,
+                                                 const std::vector<std::uint32_t> &permutation)
+{
+    BOOST_ASSERT(previous_ids.size() == permutation.size());
+    const auto number_of_nodes = static_cast<std::uint32_t>(previous_ids.size());
+
+    std::vector<std::uint32_t> stable_permutation(number_of_nodes, SPECIAL_NODEID);
+    std::vector<bool> is_used(number_of_nodes, false);
+    for (std::uint32_t node = 0; node < number_of_nodes; ++node)
+    {
+        const auto previous_id = previous_ids[node];
+        if (previous_id < number_of_nodes && !is_used[previous_id])
+        {
+            stable_permutation[node] = previous_id;
+            is_used[previous_id] = true;
+        }
+    }
+
+    // the inverse of a permutation is the ordering it was made from
+    const auto ordering = util::orderingToPermutation(permutation);
+    std::uint32_t free_id = 0;
+    for (const auto node : ordering)
+    {
+        if (stable_permutation[node] != SPECIAL_NODEID)
+            continue;
+
+        while (is_used[free_id])
+            ++free_id;
+        stable_permutation[node] = free_id;
+        is_used[free_id] = true;
+    }
+
+    return stable_permutation;
+}
+
+void renumber(std::vector<EdgeBasedNodeSegment> &segments,
+              const std::vector<std::uint32_t> &permutation)
+{
+    for (auto &segment : segments)
+    {
+        if (segment.forward_segment_id.enabled)
+            segment.forward_segment_id.id = permutation[segment.forward_segment_id.id];
+        if (segment.reverse_segment_id.enabled)
+            segment.reverse_segment_id.id = permutation[segment.reverse_segment_id.id];
+    }
+}
+
+void renumber(util::DeallocatingVector<EdgeBasedEdge> &edges,
+              const std::vector<std::uint32_t> &permutation)
+{
+    for (auto &edge : edges)
+    {
+        edge.source = permutation[edge.source];
+        edge.target = permutation[edge.target];
+    }
+}
+
+void renumber(std::vector<NBGToEBG> &mapping, const std::vector<std::uint32_t> &permutation)
+{
+    for (auto &entry : mapping)
+    {
+        if (entry.forward_ebg_node != SPECIAL_NODEID)
+            entry.forward_ebg_node = permutation[entry.forward_ebg_node];
+        if (entry.backward_ebg_node != SPECIAL_NODEID)
+            entry.backward_ebg_node = permutation[entry.backward_ebg_node];
+    }
+}
+
+void renumber(std::vector<EdgeWeight> &weights,
+              std::vector<EdgeDuration> &durations,
+              std::vector<EdgeDistance> &distances,
+              const std::vector<std::uint32_t> &permutation)
+{
+    BOOST_ASSERT(weights.size() == permutation.size());
+    BOOST_ASSERT(durations.size() == permutation.size());
+    BOOST_ASSERT(distances.size() == permutation.size());
+    util::inplacePermutation(weights.begin(), weights.end(), permutation);
+    util::inplacePermutation(durations.begin(), durations.end(), permutation);
+    util::inplacePermutation(distances.begin(), distances.end(), permutation);
+}
+
+void renumber(std::vector<StorageManeuverOverride> &maneuver_overrides,
+              std::vector<NodeID> &node_sequences,
+              const std::vector<std::uint32_t> &permutation)
+{
+    for (auto &maneuver_override : maneuver_overrides)
+    {
+        if (maneuver_override.start_node != SPECIAL_NODEID)
+            maneuver_override.start_node = permutation[maneuver_override.start_node];
+    }
+
+    for (auto &node_id : node_sequences)
+    {
+        if (node_id != SPECIAL_NODEID)
+            node_id = permutation[node_id];
+    }
+
+    // Lookups use a binary search on the start node
+    std::sort(maneuver_overrides.begin(),
+              maneuver_overrides.end(),
+              [](const auto &lhs, const auto &rhs) { return lhs.start_node < rhs.start_node; });
+}
+
+} // namespace osrm::extractor
@@ -141,19 +141,19 @@ void ObstacleMap::fixupNodes(const NodeIDVector &node_ids)
 
 void ObstacleMap::compress(NodeID node1, NodeID delendus, NodeID node2)
 {
-    auto comp = [this, delendus](NodeID first, NodeID last)
-    {
-        const auto &[begin, end] = obstacles.equal_range(last);
-        for (auto i = begin; i != end; ++i)
-        {
-            auto &[from, to, obstacle] = i->second;
-            if (from == delendus)
-                from = first;
-        }
-    };
+    compressLeadingNode(node1, delendus, node2);
+    compressLeadingNode(node2, delendus, node1);
+}
 
-    comp(node1, node2);
-    comp(node2, node1);
+void ObstacleMap::compressLeadingNode(NodeID first, NodeID delendus, NodeID last)
+{
+    const auto &[begin, end] = obstacles.equal_range(last);
+    for (auto i = begin; i != end; ++i)
+    {
+        auto &[from, to, obstacle] = i->second;
+        if (from == delendus)
+            from = first;
+    }
 }
 
 } // namespace osrm::extractor
@@ -0,0 +1,148 @@
+#include "extractor/osm_change_merger.hpp"
+
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/log.hpp"
+
+#include <osmium/io/any_input.hpp>
+#include <osmium/osm/object_comparisons.hpp>
+
+#include <algorithm>
+
+namespace osrm::extractor
+{
+
+OSMChangeMerger::OSMChangeMerger(const std::vector<std::filesystem::path> &change_paths)
+{
+    for (const auto &path : change_paths)
+    {
+        util::Log() << "Change file: " << path.filename().string();
+        osmium::io::Reader reader(osmium::io::File(path.string()), osmium::osm_entity_bits::object);
+        while (auto buffer = reader.read())
+        {
+            change_buffers.push_back(std::move(buffer));
+        }
+        reader.close();
+    }
+    Init();
+}
+
+OSMChangeMerger::OSMChangeMerger(std::vector<osmium::memory::Buffer> change_buffers_)
+    : change_buffers(std::move(change_buffers_))
+{
+    Init();
+}
+
+void OSMChangeMerger::Init()
+{
+    for (const auto &buffer : change_buffers)
+    {
+        for (const auto &object : buffer.select<osmium::OSMObject>())
+        {
+            changes.push_back(&object);
+        }
+    }
+
+    // the newest version of an object comes first and is the one that is kept
+    std::stable_sort(
+        changes.begin(), changes.end(), osmium::object_order_type_id_reverse_version{});
+    changes.erase(std::unique(changes.begin(), changes.end(), osmium::object_equal_type_id{}),
+                  changes.end());
+
+    if (!changes.empty())
+    {
+        util::Log() << "Applying changes to " << changes.size() << " objects";
+    }
+}
+
+void OSMChangeMerger::Rewind(osmium::osm_entity_bits::type entities_)
+{
+    entities = entities_;
+    next_change = 0;
+    input_exhausted = false;
+    last_input = {osmium::item_type::undefined, false, 0};
+}
+
+void OSMChangeMerger::Append(osmium::memory::Buffer &output,
+                             const osmium::OSMObject &change) const
+{
+    if (change.visible() && (entities & osmium::osm_entity_bits::from_item_type(change.type())))
+    {
+        output.add_item(change);
+        output.commit();
+    }
+}
+
+osmium::memory::Buffer OSMChangeMerger::Merge(osmium::memory::Buffer input)
+{
+    if (changes.empty())
+        return input;
+
+    for (const auto &object : input.select<osmium::OSMObject>())
+    {
+        const auto key = Key(object);
+        if (key < last_input)
+        {
+            throw util::exception("Input file is not sorted by type and ID, which is needed to "
+                                  "apply change files" +
+                                  SOURCE_REF);
+        }
+        last_input = key;
+    }
+
+    // most buffers are not touched by a small change file
+    if (next_change == changes.size() || Key(*changes[next_change]) > last_input)
+        return input;
+
+    osmium::memory::Buffer output{input.committed(), osmium::memory::Buffer::auto_grow::yes};
+    for (const auto &object : input.select<osmium::OSMObject>())
+    {
+        const auto key = Key(object);
+        while (next_change < changes.size() && Key(*changes[next_change]) < key)
+        {
+            Append(output, *changes[next_change++]);
+        }
+
+        if (next_change < changes.size() && Key(*changes[next_change]) == key)
+        {
+            Append(output, *changes[next_change++]);
+        }
+        else
+        {
+            output.add_item(object);
+            output.commit();
+        }
+    }
+
+    return output;
+}
+
+osmium::memory::Buffer OSMChangeMerger::Tail()
+{
+    if (next_change == changes.size())
+        return osmium::memory::Buffer{};
+
+    osmium::memory::Buffer output{1024, osmium::memory::Buffer::auto_grow::yes};
+    while (next_change < changes.size())
+    {
+        Append(output, *changes[next_change++]);
+    }
+
+    if (output.committed() == 0)
+        return osmium::memory::Buffer{};
+
+    return output;
+}
+
+osmium::memory::Buffer OSMChangeMerger::Read(osmium::io::Reader &reader)
+{
+    if (!input_exhausted)
+    {
+        if (auto buffer = reader.read())
+            return Merge(std::move(buffer));
+        input_exhausted = true;
+    }
+    return Tail();
+}
+
+} // namespace osrm::extractor
@@ -17,6 +17,7 @@
 
 #include "util/coordinate.hpp"
 #include "util/exception.hpp"
+#include "util/integer_range.hpp"
 #include "util/log.hpp"
 #include "util/lua_util.hpp"
 #include "util/typedefs.hpp"
@@ -86,6 +87,21 @@ struct to_lua_object : public boost::static_visitor<sol::object>
     auto operator()(boost::blank &) const { return sol::lua_nil; }
     sol::state &state;
 };
+
+// string list can be defined either as a Set(see profiles/lua/set.lua) or as a Sequence (see
+// profiles/lua/sequence.lua) `Set` is a table with keys that are actual values we are looking for
+// and values that always `true`. `Sequence` is a table with keys that are indices and values that
+// are actual values we are looking for.
+
+std::string GetSetOrSequenceValue(const std::pair<sol::object, sol::object> &pair)
+{
+    if (pair.second.is<std::string>())
+    {
+        return pair.second.as<std::string>();
+    }
+    BOOST_ASSERT(pair.first.is<std::string>());
+    return pair.first.as<std::string>();
+}
 } // namespace
 
 // Handle a lua error thrown in a protected function by printing the traceback and bubbling
@@ -846,6 +862,7 @@ void Sol2ScriptingEnvironment::InitContext(LuaScriptingContext &context)
 
     switch (context.api_version)
     {
+    case 5:
     case 4:
     {
         context.state.new_usertype<ExtractionTurnLeg>(
@@ -1003,6 +1020,30 @@ void Sol2ScriptingEnvironment::InitContext(LuaScriptingContext &context)
         BOOST_ASSERT(context.properties.GetWeightName() == "duration");
         break;
     }
+
+    // batch functions of api_version 5, they are used instead of process_node and process_way
+    if (context.api_version >= 5)
+    {
+        context.nodes_function = function_table.value()["process_nodes"];
+        context.ways_function = function_table.value()["process_ways"];
+        context.turns_function = function_table.value()["process_turns"];
+        context.has_nodes_function = context.nodes_function.valid();
+        context.has_ways_function = context.ways_function.valid();
+        context.has_turns_function = context.turns_function.valid();
+
+        sol::optional<sol::table> batch_tags = context.profile_table["batch_tags"];
+        if (batch_tags && batch_tags->valid())
+        {
+            for (auto &&pair : *batch_tags)
+            {
+                context.batch_tag_keys.emplace_back(GetSetOrSequenceValue(pair));
+            }
+        }
+        for (const auto column : util::irange<std::size_t>(0, context.batch_tag_keys.size()))
+        {
+            context.batch_tag_columns.emplace(context.batch_tag_keys[column], column);
+        }
+    }
 }
 
 const ProfileProperties &Sol2ScriptingEnvironment::GetProfileProperties()
@@ -1038,6 +1079,10 @@ void Sol2ScriptingEnvironment::ProcessElements(
     ExtractionWay result_way;
     auto &local_context = this->GetSol2Context();
 
+    // indexes into the resulting nodes and ways that are processed by the batch functions
+    std::vector<std::size_t> batch_nodes;
+    std::vector<std::size_t> batch_ways;
+
     for (auto entity = buffer.cbegin(), end = buffer.cend(); entity != end; ++entity)
     {
         switch (entity->type())
@@ -1045,13 +1090,18 @@ void Sol2ScriptingEnvironment::ProcessElements(
         case osmium::item_type::node:
         {
             const auto &node = static_cast<const osmium::Node &>(*entity);
-            result_node.node = &node;
-            if (local_context.has_node_function &&
-                (!node.tags().empty() || local_context.properties.call_tagless_node_function))
+            const auto process_node =
+                !node.tags().empty() || local_context.properties.call_tagless_node_function;
+            if (local_context.has_nodes_function && process_node)
+            {
+                batch_nodes.push_back(resulting_nodes.size());
+            }
+            else if (local_context.has_node_function && process_node)
             {
+                result_node.node = &node;
                 local_context.ProcessNode(node, result_node, relations);
+                result_node.node = nullptr;
             }
-            result_node.node = nullptr;
             resulting_nodes.push_back({node, result_node});
         }
         break;
@@ -1060,7 +1110,11 @@ void Sol2ScriptingEnvironment::ProcessElements(
             const osmium::Way &way = static_cast<const osmium::Way &>(*entity);
             // NOLINTNEXTLINE(bugprone-use-after-move)
             result_way.clear();
-            if (local_context.has_way_function)
+            if (local_context.has_ways_function)
+            {
+                batch_ways.push_back(resulting_ways.size());
+            }
+            else if (local_context.has_way_function)
             {
                 local_context.ProcessWay(way, result_way, relations);
             }
@@ -1086,6 +1140,34 @@ void Sol2ScriptingEnvironment::ProcessElements(
             break;
         }
     }
+
+    // the results do not move anymore
+    if (!batch_nodes.empty())
+    {
+        std::vector<std::pair<const osmium::Node *, ExtractionNode *>> nodes;
+        nodes.reserve(batch_nodes.size());
+        for (const auto index : batch_nodes)
+        {
+            auto &[node, result] = resulting_nodes[index];
+            result.node = &node;
+            nodes.emplace_back(&node, &result);
+        }
+        local_context.ProcessNodes(nodes, relations);
+        for (const auto &node : nodes)
+        {
+            node.second->node = nullptr;
+        }
+    }
+    if (!batch_ways.empty())
+    {
+        std::vector<std::pair<const osmium::Way *, ExtractionWay *>> ways;
+        ways.reserve(batch_ways.size());
+        for (const auto index : batch_ways)
+        {
+            ways.emplace_back(&resulting_ways[index].first, &resulting_ways[index].second);
+        }
+        local_context.ProcessWays(ways, relations);
+    }
 }
 
 std::vector<std::string>
@@ -1102,26 +1184,6 @@ Sol2ScriptingEnvironment::GetStringListFromFunction(const std::string &function_
     return strings;
 }
 
-namespace
-{
-
-// string list can be defined either as a Set(see profiles/lua/set.lua) or as a Sequence (see
-// profiles/lua/sequence.lua) `Set` is a table with keys that are actual values we are looking for
-// and values that always `true`. `Sequence` is a table with keys that are indices and values that
-// are actual values we are looking for.
-
-std::string GetSetOrSequenceValue(const std::pair<sol::object, sol::object> &pair)
-{
-    if (pair.second.is<std::string>())
-    {
-        return pair.second.as<std::string>();
-    }
-    BOOST_ASSERT(pair.first.is<std::string>());
-    return pair.first.as<std::string>();
-}
-
-} // namespace
-
 std::vector<std::string>
 Sol2ScriptingEnvironment::GetStringListFromTable(const std::string &table_name)
 {
@@ -1177,6 +1239,7 @@ std::vector<std::vector<std::string>> Sol2ScriptingEnvironment::GetExcludableCla
     auto &context = GetSol2Context();
     switch (context.api_version)
     {
+    case 5:
     case 4:
     case 3:
     case 2:
@@ -1191,6 +1254,7 @@ std::vector<std::string> Sol2ScriptingEnvironment::GetClassNames()
     auto &context = GetSol2Context();
     switch (context.api_version)
     {
+    case 5:
     case 4:
     case 3:
     case 2:
@@ -1205,6 +1269,7 @@ std::vector<std::string> Sol2ScriptingEnvironment::GetNameSuffixList()
     auto &context = GetSol2Context();
     switch (context.api_version)
     {
+    case 5:
     case 4:
     case 3:
     case 2:
@@ -1221,6 +1286,7 @@ std::vector<std::string> Sol2ScriptingEnvironment::GetRestrictions()
     auto &context = GetSol2Context();
     switch (context.api_version)
     {
+    case 5:
     case 4:
     case 3:
     case 2:
@@ -1237,6 +1303,7 @@ std::vector<std::string> Sol2ScriptingEnvironment::GetRelations()
     auto &context = GetSol2Context();
     switch (context.api_version)
     {
+    case 5:
     case 4:
     case 3:
         return Sol2ScriptingEnvironment::GetStringListFromTable("relation_types");
@@ -1247,72 +1314,12 @@ std::vector<std::string> Sol2ScriptingEnvironment::GetRelations()
 
 void Sol2ScriptingEnvironment::ProcessTurn(ExtractionTurn &turn)
 {
-    auto &context = GetSol2Context();
-
-    switch (context.api_version)
-    {
-    case 4:
-    case 3:
-    case 2:
-        if (context.has_turn_penalty_function)
-        {
-            auto luares = context.turn_function(context.profile_table, std::ref(turn));
-            if (!luares.valid())
-                handle_lua_error(luares);
-
-            // Turn weight falls back to the duration value in deciseconds
-            // or uses the extracted unit-less weight value
-            if (context.properties.fallback_to_duration)
-                turn.weight = turn.duration;
-            else
-                // cap turn weight to max turn weight, which depend on weight precision
-                turn.weight = std::min(turn.weight, context.properties.GetMaxTurnWeight());
-        }
-
-        break;
-    case 1:
-        if (context.has_turn_penalty_function)
-        {
-            auto luares = context.turn_function(std::ref(turn));
-            if (!luares.valid())
-                handle_lua_error(luares);
-
-            // Turn weight falls back to the duration value in deciseconds
-            // or uses the extracted unit-less weight value
-            if (context.properties.fallback_to_duration)
-                turn.weight = turn.duration;
-        }
-
-        break;
-    case 0:
-        if (context.has_turn_penalty_function)
-        {
-            if (turn.number_of_roads > 2)
-            {
-                // Get turn duration and convert deci-seconds to seconds
-                turn.duration = static_cast<double>(context.turn_function(turn.angle)) / 10.;
-                BOOST_ASSERT(turn.weight == 0);
-
-                // add U-turn penalty
-                if (turn.is_u_turn)
-                    turn.duration += context.properties.GetUturnPenalty();
-            }
-            else
-            {
-                // Use zero turn penalty if it is not an actual turn. This heuristic is necessary
-                // since OSRM cannot handle looping roads/parallel roads
-                turn.duration = 0.;
-            }
-        }
-
-        // Add traffic light penalty, back-compatibility of api_version=0
-        if (turn.has_traffic_light)
-            turn.duration += context.properties.GetTrafficSignalPenalty();
+    GetSol2Context().ProcessTurn(turn);
+}
 
-        // Turn weight falls back to the duration value in deciseconds
-        turn.weight = turn.duration;
-        break;
-    }
+void Sol2ScriptingEnvironment::ProcessTurns(std::vector<ExtractionTurn> &turns)
+{
+    GetSol2Context().ProcessTurns(turns);
 }
 
 void Sol2ScriptingEnvironment::ProcessSegment(ExtractionSegment &segment)
@@ -1324,6 +1331,7 @@ void Sol2ScriptingEnvironment::ProcessSegment(ExtractionSegment &segment)
         sol::protected_function_result luares;
         switch (context.api_version)
         {
+        case 5:
         case 4:
         case 3:
         case 2:
@@ -1357,6 +1365,7 @@ void LuaScriptingContext::ProcessNode(const osmium::Node &node,
     // TODO check for api version, make sure luares is always set
     switch (api_version)
     {
+    case 5:
     case 4:
     case 3:
         luares =
@@ -1386,6 +1395,7 @@ void LuaScriptingContext::ProcessWay(const osmium::Way &way,
     // TODO check for api version, make sure luares is always set
     switch (api_version)
     {
+    case 5:
     case 4:
     case 3:
         luares =
@@ -1404,4 +1414,163 @@ void LuaScriptingContext::ProcessWay(const osmium::Way &way,
         handle_lua_error(luares);
 }
 
+void LuaScriptingContext::ProcessTurn(ExtractionTurn &turn)
+{
+    BOOST_ASSERT(state.lua_state() != nullptr);
+
+    switch (api_version)
+    {
+    case 5:
+    case 4:
+    case 3:
+    case 2:
+        if (has_turn_penalty_function)
+        {
+            auto luares = turn_function(profile_table, std::ref(turn));
+            if (!luares.valid())
+                handle_lua_error(luares);
+
+            // Turn weight falls back to the duration value in deciseconds
+            // or uses the extracted unit-less weight value
+            if (properties.fallback_to_duration)
+                turn.weight = turn.duration;
+            else
+                // cap turn weight to max turn weight, which depend on weight precision
+                turn.weight = std::min(turn.weight, properties.GetMaxTurnWeight());
+        }
+
+        break;
+    case 1:
+        if (has_turn_penalty_function)
+        {
+            auto luares = turn_function(std::ref(turn));
+            if (!luares.valid())
+                handle_lua_error(luares);
+
+            // Turn weight falls back to the duration value in deciseconds
+            // or uses the extracted unit-less weight value
+            if (properties.fallback_to_duration)
+                turn.weight = turn.duration;
+        }
+
+        break;
+    case 0:
+        if (has_turn_penalty_function)
+        {
+            if (turn.number_of_roads > 2)
+            {
+                // Get turn duration and convert deci-seconds to seconds
+                turn.duration = static_cast<double>(turn_function(turn.angle)) / 10.;
+                BOOST_ASSERT(turn.weight == 0);
+
+                // add U-turn penalty
+                if (turn.is_u_turn)
+                    turn.duration += properties.GetUturnPenalty();
+            }
+            else
+            {
+                // Use zero turn penalty if it is not an actual turn. This heuristic is necessary
+                // since OSRM cannot handle looping roads/parallel roads
+                turn.duration = 0.;
+            }
+        }
+
+        // Add traffic light penalty, back-compatibility of api_version=0
+        if (turn.has_traffic_light)
+            turn.duration += properties.GetTrafficSignalPenalty();
+
+        // Turn weight falls back to the duration value in deciseconds
+        turn.weight = turn.duration;
+        break;
+    }
+}
+
+void LuaScriptingContext::ProcessTurns(std::vector<ExtractionTurn> &turns)
+{
+    BOOST_ASSERT(state.lua_state() != nullptr);
+
+    if (!has_turns_function)
+    {
+        for (auto &turn : turns)
+            ProcessTurn(turn);
+        return;
+    }
+
+    sol::table batch = state.create_table(turns.size(), 0);
+    for (const auto index : util::irange<std::size_t>(0, turns.size()))
+    {
+        batch.raw_set(index + 1, std::ref(turns[index]));
+    }
+
+    auto luares = turns_function(profile_table, batch);
+    if (!luares.valid())
+        handle_lua_error(luares);
+
+    for (auto &turn : turns)
+    {
+        // same as after process_turn of api_version 2 and later
+        if (properties.fallback_to_duration)
+            turn.weight = turn.duration;
+        else
+            turn.weight = std::min(turn.weight, properties.GetMaxTurnWeight());
+    }
+}
+
+template <typename Object, typename Result>
+void LuaScriptingContext::ProcessBatch(
+    sol::protected_function &function,
+    const char *objects_name,
+    const std::vector<std::pair<const Object *, Result *>> &batch,
+    const ExtractionRelationContainer &relations)
+{
+    BOOST_ASSERT(state.lua_state() != nullptr);
+
+    sol::table objects = state.create_table(batch.size(), 0);
+    sol::table results = state.create_table(batch.size(), 0);
+    sol::table tags = state.create_table(0, batch_tag_keys.size());
+    std::vector<sol::table> columns;
+    columns.reserve(batch_tag_keys.size());
+    for (const auto &key : batch_tag_keys)
+    {
+        columns.push_back(state.create_table());
+        tags.raw_set(key, columns.back());
+    }
+
+    for (const auto index : util::irange<std::size_t>(0, batch.size()))
+    {
+        const auto &[object, result] = batch[index];
+        objects.raw_set(index + 1, std::cref(*object));
+        results.raw_set(index + 1, std::ref(*result));
+        for (const auto &tag : object->tags())
+        {
+            // like get_value_by_key empty values are nil
+            const auto column = batch_tag_columns.find(tag.key());
+            if (column != batch_tag_columns.end() && *tag.value())
+            {
+                columns[column->second].raw_set(index + 1, tag.value());
+            }
+        }
+    }
+
+    sol::table input =
+        state.create_table_with("count", batch.size(), objects_name, objects, "tags", tags);
+    auto luares = function(profile_table, input, results, std::cref(relations));
+    if (!luares.valid())
+        handle_lua_error(luares);
+}
+
+void LuaScriptingContext::ProcessNodes(
+    const std::vector<std::pair<const osmium::Node *, ExtractionNode *>> &nodes,
+    const ExtractionRelationContainer &relations)
+{
+    ProcessBatch(nodes_function, "nodes", nodes, relations);
+}
+
+void LuaScriptingContext::ProcessWays(
+    const std::vector<std::pair<const osmium::Way *, ExtractionWay *>> &ways,
+    const ExtractionRelationContainer &relations)
+{
+    ProcessBatch(ways_function, "ways", ways, relations);
+}
+
 } // namespace osrm::extractor
@@ -0,0 +1,194 @@
+#include "extractor/scripting_environment_plugin.hpp"
+
+#include "extractor/maneuver_override_relation_parser.hpp"
+#include "extractor/restriction_parser.hpp"
+
+#include "util/exception.hpp"
+#include "util/log.hpp"
+
+#include <osmium/osm.hpp>
+
+// use std::filesystem instead of linking against Boost.Filesystem
+#define BOOST_DLL_USE_STD_FS
+#include <boost/dll/shared_library.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <system_error>
+
+namespace osrm::extractor
+{
+
+PluginScriptingEnvironment::PluginScriptingEnvironment(const std::filesystem::path &plugin_path)
+{
+    util::Log() << "Using profile plugin " << plugin_path.string();
+
+    std::error_code error;
+    library = std::make_unique<boost::dll::shared_library>(
+        plugin_path, boost::dll::load_mode::rtld_now | boost::dll::load_mode::rtld_local, error);
+    if (error)
+    {
+        throw util::exception("Could not load profile plugin " + plugin_path.string() + ": " +
+                              error.message());
+    }
+
+    if (!library->has("osrm_profile_plugin_abi_version") ||
+        !library->has("osrm_create_profile_plugin"))
+    {
+        throw util::exception(plugin_path.string() +
+                              " is no profile plugin, OSRM_PROFILE_PLUGIN(Type) is missing.");
+    }
+
+    const auto abi_version = library->get<unsigned()>("osrm_profile_plugin_abi_version")();
+    if (abi_version != OSRM_PROFILE_PLUGIN_ABI_VERSION)
+    {
+        throw util::exception("Profile plugin " + plugin_path.string() + " was built for ABI " +
+                              std::to_string(abi_version) + ", expected " +
+                              std::to_string(OSRM_PROFILE_PLUGIN_ABI_VERSION) +
+                              ". Rebuild it against the headers of this osrm-extract.");
+    }
+
+    const auto create =
+        library->get<ProfilePlugin *(ObstacleMap &)>("osrm_create_profile_plugin");
+    plugin.reset(create(m_obstacle_map));
+    if (!plugin)
+        throw util::exception("Profile plugin " + plugin_path.string() + " returned no profile");
+}
+
+PluginScriptingEnvironment::~PluginScriptingEnvironment()
+{
+    // the destructor of the plugin is code of the library
+    plugin.reset();
+}
+
+bool PluginScriptingEnvironment::IsPlugin(const std::filesystem::path &profile_path)
+{
+    const auto extension = profile_path.extension();
+    return extension == ".so" || extension == ".dylib" || extension == ".dll";
+}
+
+const ProfileProperties &PluginScriptingEnvironment::GetProfileProperties()
+{
+    return plugin->GetProfileProperties();
+}
+
+std::vector<std::vector<std::string>> PluginScriptingEnvironment::GetExcludableClasses()
+{
+    return plugin->GetExcludableClasses();
+}
+
+std::vector<std::string> PluginScriptingEnvironment::GetClassNames()
+{
+    return plugin->GetClassNames();
+}
+
+std::vector<std::string> PluginScriptingEnvironment::GetNameSuffixList()
+{
+    return plugin->GetNameSuffixList();
+}
+
+std::vector<std::string> PluginScriptingEnvironment::GetRestrictions()
+{
+    return plugin->GetRestrictions();
+}
+
+std::vector<std::string> PluginScriptingEnvironment::GetRelations()
+{
+    return plugin->GetRelations();
+}
+
+namespace
+{
+// same post-processing as for Lua profiles
+void clampTurnWeight(const ProfileProperties &properties, ExtractionTurn &turn)
+{
+    if (properties.fallback_to_duration)
+        turn.weight = turn.duration;
+    else
+        turn.weight = std::min(turn.weight, properties.GetMaxTurnWeight());
+}
+} // namespace
+
+void PluginScriptingEnvironment::ProcessTurn(ExtractionTurn &turn)
+{
+    plugin->ProcessTurn(turn);
+    clampTurnWeight(plugin->GetProfileProperties(), turn);
+}
+
+void PluginScriptingEnvironment::ProcessTurns(std::vector<ExtractionTurn> &turns)
+{
+    const auto &properties = plugin->GetProfileProperties();
+    for (auto &turn : turns)
+    {
+        plugin->ProcessTurn(turn);
+        clampTurnWeight(properties, turn);
+    }
+}
+
+void PluginScriptingEnvironment::ProcessSegment(ExtractionSegment &segment)
+{
+    plugin->ProcessSegment(segment);
+}
+
+void PluginScriptingEnvironment::ProcessElements(
+    const osmium::memory::Buffer &buffer,
+    const RestrictionParser &restriction_parser,
+    const ManeuverOverrideRelationParser &maneuver_override_parser,
+    const ExtractionRelationContainer &relations,
+    std::vector<std::pair<const osmium::Node &, ExtractionNode>> &resulting_nodes,
+    std::vector<std::pair<const osmium::Way &, ExtractionWay>> &resulting_ways,
+    std::vector<InputTurnRestriction> &resulting_restrictions,
+    std::vector<InputManeuverOverride> &resulting_maneuver_overrides)
+{
+    const auto call_tagless_node_function =
+        plugin->GetProfileProperties().call_tagless_node_function;
+    ExtractionNode result_node;
+    ExtractionWay result_way;
+
+    for (auto entity = buffer.cbegin(), end = buffer.cend(); entity != end; ++entity)
+    {
+        switch (entity->type())
+        {
+        case osmium::item_type::node:
+        {
+            const auto &node = static_cast<const osmium::Node &>(*entity);
+            if (!node.tags().empty() || call_tagless_node_function)
+            {
+                result_node.node = &node;
+                plugin->ProcessNode(node, result_node, relations);
+                result_node.node = nullptr;
+            }
+            resulting_nodes.push_back({node, result_node});
+        }
+        break;
+        case osmium::item_type::way:
+        {
+            const auto &way = static_cast<const osmium::Way &>(*entity);
+            // NOLINTNEXTLINE(bugprone-use-after-move)
+            result_way.clear();
+            plugin->ProcessWay(way, result_way, relations);
+            resulting_ways.push_back({way, std::move(result_way)});
+        }
+        break;
+        case osmium::item_type::relation:
+        {
+            const auto &relation = static_cast<const osmium::Relation &>(*entity);
+            auto results = restriction_parser.TryParse(relation);
+            if (!results.empty())
+            {
+                std::move(
+                    results.begin(), results.end(), std::back_inserter(resulting_restrictions));
+            }
+            else if (auto result_res = maneuver_override_parser.TryParse(relation))
+            {
+                resulting_maneuver_overrides.push_back(std::move(*result_res));
+            }
+        }
+        break;
+        default:
+            break;
+        }
+    }
+}
+
+} // namespace osrm::extractor
@@ -12,9 +12,41 @@
 #include <tbb/parallel_pipeline.h>
 
 #include <thread>
+#include <unordered_map>
 
 namespace osrm::guidance
 {
+namespace
+{
+
+// Deduplicates the classes of a single block without locking. The block-local IDs are translated
+// into the IDs of the shared map in block order, so the IDs do not depend on the thread schedule.
+template <typename ClassT, typename ClassIDT> struct LocalClassTable
+{
+    ClassIDT FindOrAdd(const ClassT &class_)
+    {
+        const auto [iter, inserted] =
+            ids.try_emplace(class_, static_cast<ClassIDT>(classes.size()));
+        if (inserted)
+            classes.push_back(class_);
+        return iter->second;
+    }
+
+    // maps the local IDs to the IDs of the shared map
+    template <typename ClassesMap> std::vector<ClassIDT> Merge(ClassesMap &classes_map) const
+    {
+        std::vector<ClassIDT> global_ids;
+        global_ids.reserve(classes.size());
+        for (const auto &class_ : classes)
+            global_ids.push_back(classes_map.ConcurrentFindOrAdd(class_));
+        return global_ids;
+    }
+
+    std::unordered_map<ClassT, ClassIDT> ids;
+    std::vector<ClassT> classes;
+};
+
+} // namespace
 
 void annotateTurns(const util::NodeBasedDynamicGraph &node_based_graph,
                    const extractor::EdgeBasedNodeDataContainer &edge_based_node_container,
@@ -78,6 +110,11 @@ void annotateTurns(const util::NodeBasedDynamicGraph &node_based_graph,
         std::vector<guidance::TurnData> delayed_turn_data;    // populate answers from guidance
 
         util::ConnectivityChecksum checksum;
+
+        // turn data and bearing classes refer to the local IDs of these tables
+        LocalClassTable<util::guidance::EntryClass, EntryClassID> entry_classes;
+        LocalClassTable<util::guidance::BearingClass, BearingClassID> bearing_classes;
+        std::vector<std::pair<NodeID, BearingClassID>> bearing_class_by_node;
     };
     using TurnsPipelineBufferPtr = std::shared_ptr<TurnsPipelineBuffer>;
 
@@ -166,6 +203,7 @@ void annotateTurns(const util::NodeBasedDynamicGraph &node_based_graph,
                     // `b` by an outgoing edge. Therefore, we have to search all connected edges for
                     // edges entering `b`
 
+                    auto bearing_class_id = std::numeric_limits<BearingClassID>::max();
                     for (const auto &incoming_edge : incoming_edges)
                     {
                         const auto intersection_view =
@@ -193,15 +231,10 @@ void annotateTurns(const util::NodeBasedDynamicGraph &node_based_graph,
                             classifyIntersection(intersection, node_coordinates[intersection_node]);
 
                         const auto entry_class_id =
-                            entry_class_hash.ConcurrentFindOrAdd(turn_classification.first);
+                            buffer->entry_classes.FindOrAdd(turn_classification.first);
 
-                        const auto bearing_class_id =
-                            bearing_class_hash.ConcurrentFindOrAdd(turn_classification.second);
-
-                        // Note - this is strictly speaking not thread safe, but we know we
-                        // should never be touching the same element twice, so we should
-                        // be fine.
-                        bearing_class_by_node_based_node[intersection_node] = bearing_class_id;
+                        bearing_class_id =
+                            buffer->bearing_classes.FindOrAdd(turn_classification.second);
 
                         // check if we on a restriction via edge
                         const auto is_restriction_via_edge =
@@ -297,6 +330,10 @@ void annotateTurns(const util::NodeBasedDynamicGraph &node_based_graph,
                             }
                         }
                     }
+
+                    if (!incoming_edges.empty())
+                        buffer->bearing_class_by_node.emplace_back(intersection_node,
+                                                                   bearing_class_id);
                 }
 
                 return buffer;
@@ -315,6 +352,16 @@ void annotateTurns(const util::NodeBasedDynamicGraph &node_based_graph,
 
                 connectivity_checksum = buffer->checksum.update_checksum(connectivity_checksum);
 
+                // Translate the classes of the block into the shared classes
+                const auto entry_class_ids = buffer->entry_classes.Merge(entry_class_hash);
+                const auto bearing_class_ids = buffer->bearing_classes.Merge(bearing_class_hash);
+                for (auto &turn_data : buffer->continuous_turn_data)
+                    turn_data.entry_class_id = entry_class_ids[turn_data.entry_class_id];
+                for (auto &turn_data : buffer->delayed_turn_data)
+                    turn_data.entry_class_id = entry_class_ids[turn_data.entry_class_id];
+                for (const auto &[node, bearing_class_id] : buffer->bearing_class_by_node)
+                    bearing_class_by_node_based_node[node] = bearing_class_ids[bearing_class_id];
+
                 // Guidance data
                 std::for_each(buffer->continuous_turn_data.begin(),
                               buffer->continuous_turn_data.end(),
@@ -22,7 +22,7 @@ struct EdgeInfo
 
     NodeID node;
 
-    std::string_view name;
+    extractor::NameString name;
 
     bool reversed;
 
@@ -2,6 +2,10 @@
 #include "extractor/extractor.hpp"
 #include "extractor/extractor_config.hpp"
 #include "extractor/scripting_environment_lua.hpp"
+#include "extractor/scripting_environment_plugin.hpp"
+
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
 
 namespace osrm
 {
@@ -10,6 +14,20 @@ namespace osrm
 
 void extract(const extractor::ExtractorConfig &config)
 {
+    if (extractor::PluginScriptingEnvironment::IsPlugin(config.profile_path))
+    {
+        // Plugins look up their data themselves, there is no way to hand the areas to them
+        if (!config.location_dependent_data_paths.empty())
+        {
+            throw util::exception("Location-dependent data is not supported by the profile "
+                                  "plugin " +
+                                  config.profile_path.string() + SOURCE_REF);
+        }
+        extractor::PluginScriptingEnvironment scripting_environment(config.profile_path);
+        extractor::Extractor(config).run(scripting_environment);
+        return;
+    }
+
     extractor::Sol2ScriptingEnvironment scripting_environment(config.profile_path.string(),
                                                               config.location_dependent_data_paths);
     extractor::Extractor(config).run(scripting_environment);
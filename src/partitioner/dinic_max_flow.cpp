@@ -1,10 +1,14 @@
 #include "partitioner/dinic_max_flow.hpp"
 #include "util/integer_range.hpp"
 
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <numeric>
-#include <queue>
 #include <stack>
 
 namespace osrm::partitioner
@@ -32,6 +36,17 @@ auto makeHasNeighborNotInCheck(const DinicMaxFlow::SourceSinkNodes &set,
 DinicMaxFlow::MinCut DinicMaxFlow::operator()(const BisectionGraphView &view,
                                               const SourceSinkNodes &source_nodes,
                                               const SourceSinkNodes &sink_nodes) const
+{
+    const FlowBound unbounded{std::numeric_limits<std::size_t>::max()};
+    auto cut = (*this)(view, source_nodes, sink_nodes, unbounded);
+    BOOST_ASSERT(cut);
+    return std::move(*cut);
+}
+
+std::optional<DinicMaxFlow::MinCut> DinicMaxFlow::operator()(const BisectionGraphView &view,
+                                                             const SourceSinkNodes &source_nodes,
+                                                             const SourceSinkNodes &sink_nodes,
+                                                             const FlowBound &bound) const
 {
     BOOST_ASSERT(Validate(view, source_nodes, sink_nodes));
     // for the inertial flow algorithm, we use quite a large set of nodes as source/sink nodes. Only
@@ -78,6 +93,10 @@ DinicMaxFlow::MinCut DinicMaxFlow::operator()(const BisectionGraphView &view,
         if (!separated)
         {
             flow_value += BlockingFlow(flow, levels, view, source_nodes, border_sink_nodes);
+
+            // the flow only grows, the final cut can't be within the bound anymore
+            if (flow_value > bound.load(std::memory_order_relaxed))
+                return std::nullopt;
         }
         else
         {
@@ -117,15 +136,15 @@ DinicMaxFlow::ComputeLevelGraph(const BisectionGraphView &view,
                                 const FlowEdges &flow) const
 {
     LevelGraph levels(view.NumberOfNodes(), INVALID_LEVEL);
-    std::queue<NodeID> level_queue;
+    std::vector<NodeID> frontier;
 
-    // set the front of the source nodes to zero and add them to the BFS queue. In addition, set all
-    // neighbors to zero as well (which allows direct usage of the levels to see what we visited,
-    // and still don't go back into the hughe set of sources)
+    // set the front of the source nodes to zero and add them to the BFS frontier. In addition, set
+    // all neighbors to zero as well (which allows direct usage of the levels to see what we
+    // visited, and still don't go back into the hughe set of sources)
     for (const auto node_id : border_source_nodes)
     {
         levels[node_id] = 0;
-        level_queue.push(node_id);
+        frontier.push_back(node_id);
         for (const auto &edge : view.Edges(node_id))
             if (source_nodes.contains(edge.target))
                 levels[edge.target] = 0;
@@ -134,14 +153,14 @@ DinicMaxFlow::ComputeLevelGraph(const BisectionGraphView &view,
     const auto has_flow = [&](const NodeID from, const NodeID to)
     { return flow[from].find(to) != flow[from].end(); };
 
-    // perform a relaxation step in the BFS algorithm
-    const auto relax_node = [&](const NodeID node_id)
+    // perform a relaxation step in the BFS algorithm, `visit` claims unvisited targets for the next
+    // level
+    const auto relax_node = [&](const NodeID node_id, const auto &visit)
     {
         // don't relax sink nodes
         if (sink_nodes.contains(node_id))
             return;
 
-        const auto level = levels[node_id] + 1;
         for (const auto &edge : view.Edges(node_id))
         {
             const auto target = edge.target;
@@ -149,20 +168,56 @@ DinicMaxFlow::ComputeLevelGraph(const BisectionGraphView &view,
             if (has_flow(node_id, target))
                 continue;
 
-            // don't go back, only follow edges to new nodes
-            if (levels[target] > level)
-            {
-                level_queue.push(target);
-                levels[target] = level;
-            }
+            visit(target);
         }
     };
 
-    // compute the levels of level graph using BFS
-    while (!level_queue.empty())
+    // compute the levels of level graph using BFS, one level at a time
+    std::vector<NodeID> next_frontier;
+    tbb::enumerable_thread_specific<std::vector<NodeID>> next_frontiers;
+    for (Level level = 1; !frontier.empty(); ++level)
     {
-        relax_node(level_queue.front());
-        level_queue.pop();
+        next_frontier.clear();
+        if (frontier.size() < PARALLEL_FRONTIER_SIZE)
+        {
+            const auto visit = [&](const NodeID target)
+            {
+                // don't go back, only follow edges to new nodes
+                if (levels[target] == INVALID_LEVEL)
+                {
+                    levels[target] = level;
+                    next_frontier.push_back(target);
+                }
+            };
+            for (const auto node_id : frontier)
+                relax_node(node_id, visit);
+        }
+        else
+        {
+            // all nodes of the next frontier get the same level, the first thread to claim a
+            // node adds it to its frontier
+            const auto visit = [&](const NodeID target)
+            {
+                std::atomic_ref<Level> target_level(levels[target]);
+                auto expected = INVALID_LEVEL;
+                if (target_level.load(std::memory_order_relaxed) == INVALID_LEVEL &&
+                    target_level.compare_exchange_strong(
+                        expected, level, std::memory_order_relaxed))
+                    next_frontiers.local().push_back(target);
+            };
+            tbb::parallel_for(tbb::blocked_range<std::size_t>(0, frontier.size(), 256),
+                              [&](const tbb::blocked_range<std::size_t> &range)
+                              {
+                                  for (auto index = range.begin(); index < range.end(); ++index)
+                                      relax_node(frontier[index], visit);
+                              });
+            for (auto &nodes : next_frontiers)
+            {
+                next_frontier.insert(next_frontier.end(), nodes.begin(), nodes.end());
+                nodes.clear();
+            }
+        }
+        std::swap(frontier, next_frontier);
     }
 
     return levels;
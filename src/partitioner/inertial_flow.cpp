@@ -7,6 +7,7 @@
 #include <cmath>
 #include <cstddef>
 #include <iterator>
+#include <limits>
 #include <mutex>
 #include <unordered_set>
 #include <utility>
@@ -113,6 +114,11 @@ DinicMaxFlow::MinCut bestMinCut(const BisectionGraphView &view,
 
     auto best_balance = 1;
 
+    // Cuts are only of interest while they can still beat the best cut: the balance penalty is at
+    // least one, so cuts with more than best.num_edges * best_balance edges lose. The flow
+    // computations of the other slopes stop as soon as their flow exceeds this bound.
+    DinicMaxFlow::FlowBound bound{std::numeric_limits<std::size_t>::max()};
+
     std::mutex lock;
 
     tbb::blocked_range<std::size_t> range{0, n, 1};
@@ -132,7 +138,12 @@ DinicMaxFlow::MinCut bestMinCut(const BisectionGraphView &view,
                               const auto slope = -1. + round * (2. / n);
 
                               auto order = makeSpatialOrder(view, ratio, slope);
-                              auto cut = DinicMaxFlow()(view, order.sources, order.sinks);
+                              auto bounded_cut =
+                                  DinicMaxFlow()(view, order.sources, order.sinks, bound);
+                              if (!bounded_cut)
+                                  continue;
+
+                              auto cut = std::move(*bounded_cut);
                               auto cut_balance = get_balance(cut.num_nodes_source);
 
                               {
@@ -147,6 +158,9 @@ DinicMaxFlow::MinCut bestMinCut(const BisectionGraphView &view,
                                   {
                                       best_balance = cut_balance;
                                       std::swap(best, cut);
+                                      bound.store(static_cast<std::size_t>(std::floor(
+                                                      best.num_edges * best_balance)),
+                                                  std::memory_order_relaxed);
                                   }
                               }
                               // cut gets destroyed here
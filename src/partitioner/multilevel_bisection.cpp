@@ -0,0 +1,618 @@
+#include "partitioner/multilevel_bisection.hpp"
+
+#include "util/integer_range.hpp"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace osrm::partitioner
+{
+namespace
+{
+// coarsening stops at this number of nodes
+const constexpr std::size_t COARSEST_GRAPH_SIZE = 512;
+// coarsening stops if a matching removes less than this share of the nodes
+const constexpr double MINIMAL_COARSENING_RATE = 0.05;
+// a refinement pass stops after this many moves that didn't improve the bisection
+const constexpr std::size_t MAX_FRUITLESS_MOVES = 512;
+const constexpr std::size_t MAX_REFINEMENT_PASSES = 8;
+
+using Weight = std::uint64_t;
+using Side = std::uint8_t;
+
+// Undirected graph in adjacency array form. Each node of a coarse graph stands for a set of nodes
+// of the input graph, it has their number as weight and the mean of their coordinates as
+// position. Edge weights are the number of input edges an edge replaces.
+struct WeightedGraph
+{
+    struct Position
+    {
+        double x;
+        double y;
+    };
+
+    std::vector<Weight> node_weights;
+    std::vector<Position> positions;
+    std::vector<std::size_t> first_edge;
+    std::vector<NodeID> targets;
+    std::vector<Weight> edge_weights;
+
+    std::size_t NumberOfNodes() const { return node_weights.size(); }
+
+    auto Edges(const NodeID node) const
+    {
+        return util::irange<std::size_t>(first_edge[node], first_edge[node + 1]);
+    }
+};
+
+WeightedGraph makeWeightedGraph(const BisectionGraphView &view)
+{
+    WeightedGraph graph;
+    const auto number_of_nodes = view.NumberOfNodes();
+    graph.node_weights.resize(number_of_nodes, 1);
+    graph.positions.reserve(number_of_nodes);
+    graph.first_edge.reserve(number_of_nodes + 1);
+    graph.first_edge.push_back(0);
+
+    for (const auto node : util::irange<NodeID>(0, number_of_nodes))
+    {
+        const auto &coordinate = view.Node(node).coordinate;
+        graph.positions.push_back({static_cast<double>(static_cast<std::int32_t>(coordinate.lon)),
+                                   static_cast<double>(static_cast<std::int32_t>(coordinate.lat))});
+        for (const auto &edge : view.Edges(node))
+        {
+            if (edge.target == node)
+                continue;
+            graph.targets.push_back(edge.target);
+            graph.edge_weights.push_back(1);
+        }
+        graph.first_edge.push_back(graph.targets.size());
+    }
+
+    return graph;
+}
+
+// Matches nodes with the neighbor that has the best rating weight(e)^2 / (weight(u) * weight(v)).
+// Preferring heavy edges removes as much of the edge weight as possible from the coarse graph,
+// the node weights in the rating keep the coarse nodes of similar size. Nodes are visited by
+// increasing degree, since nodes with few neighbors have the fewest chances to be matched.
+// Returns the coarse node of every node.
+std::vector<NodeID> heavyEdgeMatching(const WeightedGraph &graph, const Weight max_node_weight)
+{
+    const auto number_of_nodes = graph.NumberOfNodes();
+
+    std::vector<NodeID> order(number_of_nodes);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [&](const NodeID lhs, const NodeID rhs)
+                     { return graph.Edges(lhs).size() < graph.Edges(rhs).size(); });
+
+    std::vector<NodeID> mate(number_of_nodes, SPECIAL_NODEID);
+    for (const auto node : order)
+    {
+        if (mate[node] != SPECIAL_NODEID)
+            continue;
+
+        auto best_neighbor = node;
+        auto best_rating = 0.;
+        for (const auto edge : graph.Edges(node))
+        {
+            const auto target = graph.targets[edge];
+            if (mate[target] != SPECIAL_NODEID ||
+                graph.node_weights[node] + graph.node_weights[target] > max_node_weight)
+                continue;
+
+            const auto edge_weight = static_cast<double>(graph.edge_weights[edge]);
+            const auto rating = edge_weight * edge_weight /
+                                (graph.node_weights[node] * graph.node_weights[target]);
+            if (rating > best_rating)
+            {
+                best_rating = rating;
+                best_neighbor = target;
+            }
+        }
+
+        mate[node] = best_neighbor;
+        mate[best_neighbor] = node;
+    }
+
+    std::vector<NodeID> coarse_ids(number_of_nodes, SPECIAL_NODEID);
+    NodeID number_of_coarse_nodes = 0;
+    for (const auto node : util::irange<NodeID>(0, number_of_nodes))
+    {
+        if (coarse_ids[node] != SPECIAL_NODEID)
+            continue;
+        coarse_ids[node] = number_of_coarse_nodes;
+        coarse_ids[mate[node]] = number_of_coarse_nodes;
+        ++number_of_coarse_nodes;
+    }
+
+    return coarse_ids;
+}
+
+// Contracts all nodes with the same coarse id into a single node and merges their edges
+WeightedGraph contract(const WeightedGraph &graph,
+                       const std::vector<NodeID> &coarse_ids,
+                       const std::size_t number_of_coarse_nodes)
+{
+    // group the nodes by their coarse id
+    std::vector<std::size_t> first_member(number_of_coarse_nodes + 1, 0);
+    for (const auto coarse_id : coarse_ids)
+        ++first_member[coarse_id + 1];
+    std::partial_sum(first_member.begin(), first_member.end(), first_member.begin());
+    std::vector<NodeID> members(coarse_ids.size());
+    {
+        auto next_member = first_member;
+        for (const auto node : util::irange<NodeID>(0, coarse_ids.size()))
+            members[next_member[coarse_ids[node]]++] = node;
+    }
+
+    WeightedGraph coarse;
+    coarse.node_weights.resize(number_of_coarse_nodes, 0);
+    coarse.positions.resize(number_of_coarse_nodes, {0, 0});
+    coarse.first_edge.reserve(number_of_coarse_nodes + 1);
+    coarse.first_edge.push_back(0);
+
+    // position of the edge to a coarse target in the edges of the current coarse node
+    const auto no_edge = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> edge_to(number_of_coarse_nodes, no_edge);
+    for (const auto coarse_node : util::irange<NodeID>(0, number_of_coarse_nodes))
+    {
+        const auto edges_begin = coarse.targets.size();
+        for (const auto index :
+             util::irange(first_member[coarse_node], first_member[coarse_node + 1]))
+        {
+            const auto node = members[index];
+            const auto node_weight = graph.node_weights[node];
+            coarse.node_weights[coarse_node] += node_weight;
+            coarse.positions[coarse_node].x += node_weight * graph.positions[node].x;
+            coarse.positions[coarse_node].y += node_weight * graph.positions[node].y;
+
+            for (const auto edge : graph.Edges(node))
+            {
+                const auto target = coarse_ids[graph.targets[edge]];
+                if (target == coarse_node)
+                    continue;
+
+                if (edge_to[target] == no_edge || edge_to[target] < edges_begin)
+                {
+                    edge_to[target] = coarse.targets.size();
+                    coarse.targets.push_back(target);
+                    coarse.edge_weights.push_back(graph.edge_weights[edge]);
+                }
+                else
+                {
+                    coarse.edge_weights[edge_to[target]] += graph.edge_weights[edge];
+                }
+            }
+        }
+        coarse.positions[coarse_node].x /= coarse.node_weights[coarse_node];
+        coarse.positions[coarse_node].y /= coarse.node_weights[coarse_node];
+        coarse.first_edge.push_back(coarse.targets.size());
+    }
+
+    return coarse;
+}
+
+struct BisectionQuality
+{
+    bool feasible;
+    Weight cut;
+    Weight heavier_side;
+
+    bool operator<(const BisectionQuality &other) const
+    {
+        // infeasible bisections are compared by their balance first to get closer to a feasible one
+        if (feasible != other.feasible)
+            return feasible;
+        if (!feasible && heavier_side != other.heavier_side)
+            return heavier_side < other.heavier_side;
+        return std::tie(cut, heavier_side) < std::tie(other.cut, other.heavier_side);
+    }
+};
+
+// Two-way Fiduccia-Mattheyses refinement. Every pass moves each node at most once, always taking
+// the move with the highest gain that keeps the bisection balanced (or improves the balance of an
+// unbalanced one), and keeps the best prefix of the moves.
+class Refinement
+{
+  public:
+    Refinement(const WeightedGraph &graph, std::vector<Side> &sides, const Weight max_side_weight)
+        : graph(graph), sides(sides), max_side_weight(max_side_weight),
+          gains(graph.NumberOfNodes(), 0), side_weights{0, 0}, cut(0)
+    {
+        for (const auto node : util::irange<NodeID>(0, graph.NumberOfNodes()))
+        {
+            side_weights[sides[node]] += graph.node_weights[node];
+            for (const auto edge : graph.Edges(node))
+            {
+                const auto external = sides[graph.targets[edge]] != sides[node];
+                const auto weight = static_cast<std::int64_t>(graph.edge_weights[edge]);
+                gains[node] += external ? weight : -weight;
+                cut += external ? graph.edge_weights[edge] : 0;
+            }
+        }
+        // every cut edge was counted from both sides
+        cut /= 2;
+    }
+
+    BisectionQuality Quality() const
+    {
+        const auto heavier_side = std::max(side_weights[0], side_weights[1]);
+        return {heavier_side <= max_side_weight, cut, heavier_side};
+    }
+
+    void Run()
+    {
+        for (std::size_t pass = 0; pass < MAX_REFINEMENT_PASSES; ++pass)
+        {
+            if (!RunPass())
+                break;
+        }
+    }
+
+  private:
+    using QueueEntry = std::pair<std::int64_t, NodeID>;
+    using Queue = std::priority_queue<QueueEntry>;
+
+    // Moves a node to the other side and updates the gains of it and its neighbors
+    void Flip(const NodeID node)
+    {
+        const auto from = sides[node];
+        const auto to = static_cast<Side>(1 - from);
+        side_weights[from] -= graph.node_weights[node];
+        side_weights[to] += graph.node_weights[node];
+        cut = static_cast<Weight>(static_cast<std::int64_t>(cut) - gains[node]);
+        sides[node] = to;
+        gains[node] = -gains[node];
+
+        for (const auto edge : graph.Edges(node))
+        {
+            const auto target = graph.targets[edge];
+            const auto weight = static_cast<std::int64_t>(graph.edge_weights[edge]);
+            gains[target] += sides[target] == to ? -2 * weight : 2 * weight;
+        }
+    }
+
+    bool CanMove(const NodeID node) const
+    {
+        const auto from = sides[node];
+        return side_weights[1 - from] + graph.node_weights[node] <= max_side_weight ||
+               side_weights[from] > side_weights[1 - from] + graph.node_weights[node];
+    }
+
+    // Returns true if the pass improved the bisection
+    bool RunPass()
+    {
+        std::vector<bool> locked(graph.NumberOfNodes(), false);
+        std::array<Queue, 2> queues;
+        const auto push = [&](const NodeID node)
+        { queues[sides[node]].push({gains[node], node}); };
+
+        for (const auto node : util::irange<NodeID>(0, graph.NumberOfNodes()))
+        {
+            const auto edges = graph.Edges(node);
+            const auto is_boundary = std::any_of(edges.begin(),
+                                                 edges.end(),
+                                                 [&](const auto edge)
+                                                 { return sides[graph.targets[edge]] != sides[node]; });
+            if (is_boundary)
+                push(node);
+        }
+
+        // skips entries of locked nodes and entries with outdated gains
+        const auto top = [&](Queue &queue) -> const QueueEntry *
+        {
+            while (!queue.empty() &&
+                   (locked[queue.top().second] || gains[queue.top().second] != queue.top().first))
+                queue.pop();
+            return queue.empty() ? nullptr : &queue.top();
+        };
+
+        const auto initial_quality = Quality();
+        auto best_quality = initial_quality;
+        std::vector<NodeID> moves;
+        std::size_t best_number_of_moves = 0;
+
+        while (moves.size() - best_number_of_moves < MAX_FRUITLESS_MOVES)
+        {
+            std::array<const QueueEntry *, 2> candidates = {top(queues[0]), top(queues[1])};
+            for (auto &candidate : candidates)
+            {
+                if (candidate && !CanMove(candidate->second))
+                    candidate = nullptr;
+            }
+            if (!candidates[0] && !candidates[1])
+                break;
+
+            // prefer moves from the heavier side on equal gains
+            const auto from_heavier = side_weights[0] >= side_weights[1] ? 0 : 1;
+            auto side = from_heavier;
+            if (!candidates[side] ||
+                (candidates[1 - side] && candidates[1 - side]->first > candidates[side]->first))
+                side = 1 - side;
+
+            const auto node = candidates[side]->second;
+            queues[side].pop();
+            locked[node] = true;
+            Flip(node);
+            moves.push_back(node);
+
+            for (const auto edge : graph.Edges(node))
+            {
+                const auto target = graph.targets[edge];
+                if (!locked[target])
+                    push(target);
+            }
+
+            const auto quality = Quality();
+            if (quality < best_quality)
+            {
+                best_quality = quality;
+                best_number_of_moves = moves.size();
+            }
+        }
+
+        // undo all moves after the best bisection
+        while (moves.size() > best_number_of_moves)
+        {
+            Flip(moves.back());
+            moves.pop_back();
+        }
+
+        return best_quality < initial_quality;
+    }
+
+    const WeightedGraph &graph;
+    std::vector<Side> &sides;
+    const Weight max_side_weight;
+
+    std::vector<std::int64_t> gains;
+    std::array<Weight, 2> side_weights;
+    Weight cut;
+};
+
+// Grows the side 1 by a breadth first search from the node that comes first in the spatial order
+// until it contains half of the weight. Restarts in the next unvisited node of the order if the
+// graph is not connected.
+std::vector<Side> growRegion(const WeightedGraph &graph, const double slope)
+{
+    const auto project = [&](const NodeID node)
+    {
+        const auto &position = graph.positions[node];
+        return slope * position.x + (1. - std::fabs(slope)) * position.y;
+    };
+
+    std::vector<NodeID> order(graph.NumberOfNodes());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [&](const NodeID lhs, const NodeID rhs)
+                     { return project(lhs) < project(rhs); });
+
+    const auto total_weight =
+        std::accumulate(graph.node_weights.begin(), graph.node_weights.end(), Weight{0});
+
+    std::vector<Side> sides(graph.NumberOfNodes(), 0);
+    std::vector<bool> visited(graph.NumberOfNodes(), false);
+    std::queue<NodeID> queue;
+    Weight grown_weight = 0;
+    auto next_seed = order.begin();
+
+    while (2 * grown_weight < total_weight)
+    {
+        if (queue.empty())
+        {
+            while (visited[*next_seed])
+                ++next_seed;
+            visited[*next_seed] = true;
+            queue.push(*next_seed);
+        }
+
+        const auto node = queue.front();
+        queue.pop();
+        sides[node] = 1;
+        grown_weight += graph.node_weights[node];
+
+        for (const auto edge : graph.Edges(node))
+        {
+            const auto target = graph.targets[edge];
+            if (!visited[target])
+            {
+                visited[target] = true;
+                queue.push(target);
+            }
+        }
+    }
+
+    return sides;
+}
+
+// Number of edges from side 1 to side 0, counts every undirected edge once
+std::size_t countCutEdges(const BisectionGraphView &view, const std::vector<Side> &sides)
+{
+    std::size_t num_edges = 0;
+    for (const auto node : util::irange<NodeID>(0, view.NumberOfNodes()))
+    {
+        if (sides[node] == 0)
+            continue;
+        for (const auto &edge : view.Edges(node))
+            num_edges += sides[edge.target] == 0 ? 1 : 0;
+    }
+    return num_edges;
+}
+
+// Flow based improvement of a bisection of the input graph: a corridor is grown around the cut by
+// a breadth first search on each side, as long as moving the whole corridor part of a side to the
+// other side keeps the bisection balanced. The remaining nodes of the sides are the sources and
+// sinks of a max-flow computation. Its min cut is the best cut within the corridor and balanced.
+void improveWithFlow(const BisectionGraphView &view,
+                     std::vector<Side> &sides,
+                     const Weight max_side_weight)
+{
+    const auto number_of_nodes = view.NumberOfNodes();
+    std::array<Weight, 2> side_weights = {0, 0};
+    for (const auto side : sides)
+        ++side_weights[side];
+
+    std::vector<bool> in_corridor(number_of_nodes, false);
+    for (const Side side : {0, 1})
+    {
+        const auto other_side_weight = side_weights[1 - side];
+        const auto budget =
+            max_side_weight > other_side_weight ? max_side_weight - other_side_weight : 0;
+
+        std::queue<NodeID> queue;
+        Weight corridor_weight = 0;
+        const auto add = [&](const NodeID node)
+        {
+            if (corridor_weight >= budget || in_corridor[node])
+                return;
+            in_corridor[node] = true;
+            ++corridor_weight;
+            queue.push(node);
+        };
+
+        for (const auto node : util::irange<NodeID>(0, number_of_nodes))
+        {
+            if (sides[node] != side)
+                continue;
+            for (const auto &edge : view.Edges(node))
+            {
+                if (sides[edge.target] != side)
+                {
+                    add(node);
+                    break;
+                }
+            }
+        }
+
+        while (!queue.empty())
+        {
+            const auto node = queue.front();
+            queue.pop();
+            for (const auto &edge : view.Edges(node))
+            {
+                if (sides[edge.target] == side)
+                    add(edge.target);
+            }
+        }
+    }
+
+    DinicMaxFlow::SourceSinkNodes sources, sinks;
+    for (const auto node : util::irange<NodeID>(0, number_of_nodes))
+    {
+        if (!in_corridor[node])
+            (sides[node] == 1 ? sources : sinks).insert(node);
+    }
+    if (sources.empty() || sinks.empty())
+        return;
+
+    const auto num_edges = countCutEdges(view, sides);
+    const DinicMaxFlow::FlowBound bound{num_edges};
+    const auto cut = DinicMaxFlow()(view, sources, sinks, bound);
+    if (!cut)
+        return;
+
+    const auto heavier_side = [number_of_nodes](const std::size_t num_nodes_source)
+    { return std::max(num_nodes_source, number_of_nodes - num_nodes_source); };
+    if (cut->num_edges < num_edges || heavier_side(cut->num_nodes_source) <
+                                          heavier_side(static_cast<std::size_t>(side_weights[1])))
+        std::copy(cut->flags.begin(), cut->flags.end(), sides.begin());
+}
+} // namespace
+
+DinicMaxFlow::MinCut computeMultilevelCut(const BisectionGraphView &view,
+                                          const std::size_t num_initial_cuts,
+                                          const double balance)
+{
+    const auto number_of_nodes = view.NumberOfNodes();
+    const Weight total_weight = number_of_nodes;
+    // same limit as the balance penalty of the inertial flow cut
+    const auto max_side_weight =
+        std::max<Weight>((total_weight + 1) / 2, balance * (total_weight / 2));
+    // keep coarse nodes small enough for balanced bisections of the coarsest graph
+    const auto max_node_weight = std::max<Weight>(2, 4 * total_weight / COARSEST_GRAPH_SIZE);
+
+    // coarsening phase, hierarchy.front() is the input graph
+    std::vector<WeightedGraph> hierarchy;
+    std::vector<std::vector<NodeID>> coarse_ids;
+    hierarchy.push_back(makeWeightedGraph(view));
+    while (hierarchy.back().NumberOfNodes() > COARSEST_GRAPH_SIZE)
+    {
+        const auto &graph = hierarchy.back();
+        auto matching = heavyEdgeMatching(graph, max_node_weight);
+        const std::size_t number_of_coarse_nodes =
+            matching.empty() ? 0 : *std::max_element(matching.begin(), matching.end()) + 1;
+        if (number_of_coarse_nodes > (1. - MINIMAL_COARSENING_RATE) * graph.NumberOfNodes())
+            break;
+
+        auto coarse = contract(graph, matching, number_of_coarse_nodes);
+        coarse_ids.push_back(std::move(matching));
+        hierarchy.push_back(std::move(coarse));
+    }
+
+    // initial bisections of the coarsest graph, the slopes are chosen like for the inertial flow
+    const auto &coarsest = hierarchy.back();
+    const auto num_cuts = std::max<std::size_t>(1, num_initial_cuts);
+    std::vector<std::vector<Side>> initial_sides(num_cuts);
+    std::vector<BisectionQuality> initial_qualities(num_cuts);
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, num_cuts, 1),
+                      [&](const tbb::blocked_range<std::size_t> &range)
+                      {
+                          for (auto round = range.begin(); round != range.end(); ++round)
+                          {
+                              const auto slope = -1. + round * (2. / num_cuts);
+                              initial_sides[round] = growRegion(coarsest, slope);
+                              Refinement refinement(
+                                  coarsest, initial_sides[round], max_side_weight);
+                              refinement.Run();
+                              initial_qualities[round] = refinement.Quality();
+                          }
+                      });
+    const auto best = std::distance(
+        initial_qualities.begin(),
+        std::min_element(initial_qualities.begin(), initial_qualities.end()));
+    auto sides = std::move(initial_sides[best]);
+
+    // uncoarsening phase, project the bisection to the finer graph and refine it there
+    for (auto level = hierarchy.size() - 1; level > 0; --level)
+    {
+        const auto &mapping = coarse_ids[level - 1];
+        std::vector<Side> fine_sides(mapping.size());
+        std::transform(mapping.begin(),
+                       mapping.end(),
+                       fine_sides.begin(),
+                       [&](const NodeID coarse_node) { return sides[coarse_node]; });
+        sides = std::move(fine_sides);
+
+        Refinement refinement(hierarchy[level - 1], sides, max_side_weight);
+        refinement.Run();
+    }
+
+    // the flow can straighten cuts that local moves can't, the moves polish the result
+    improveWithFlow(view, sides, max_side_weight);
+    Refinement refinement(hierarchy.front(), sides, max_side_weight);
+    refinement.Run();
+
+    // the nodes on side 1 are the source side
+    std::vector<bool> flags(sides.begin(), sides.end());
+    const std::size_t num_nodes_source = std::count(sides.begin(), sides.end(), 1);
+    const auto num_edges = countCutEdges(view, sides);
+
+    return {num_nodes_source, num_edges, std::move(flags)};
+}
+
+} // namespace osrm::partitioner
@@ -0,0 +1,329 @@
+#include "partitioner/partition_report.hpp"
+
+#include "util/integer_range.hpp"
+#include "util/log.hpp"
+#include "util/typedefs.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace osrm::partitioner
+{
+namespace
+{
+
+util::json::Object makeDistribution(std::vector<std::size_t> values)
+{
+    std::sort(values.begin(), values.end());
+    const auto percentile = [&values](const double fraction) -> double
+    {
+        if (values.empty())
+            return 0;
+        const auto index = static_cast<std::size_t>(fraction * values.size());
+        return values[std::min(index, values.size() - 1)];
+    };
+    const auto total = std::accumulate(values.begin(), values.end(), std::size_t{0});
+
+    util::json::Object distribution;
+    distribution.values["min"] = util::json::Number(values.empty() ? 0. : values.front());
+    distribution.values["max"] = util::json::Number(values.empty() ? 0. : values.back());
+    distribution.values["mean"] =
+        util::json::Number(values.empty() ? 0. : static_cast<double>(total) / values.size());
+    distribution.values["p50"] = util::json::Number(percentile(0.5));
+    distribution.values["p90"] = util::json::Number(percentile(0.9));
+    distribution.values["p99"] = util::json::Number(percentile(0.99));
+    distribution.values["total"] = util::json::Number(static_cast<double>(total));
+    return distribution;
+}
+
+// Forward MLD searches on the overlay graph of a partition. The clique weights of a cell are the
+// shortest paths between its boundary nodes on the overlay graph of the level below (like
+// osrm-customize computes them), they are computed for one source at a time when a search needs
+// them and kept for later searches.
+class OverlaySearch
+{
+  public:
+    struct Statistics
+    {
+        std::size_t settled_nodes;
+        std::size_t relaxed_arcs;
+        bool found;
+    };
+
+    OverlaySearch(const MultiLevelPartition &partition,
+                  const CellStorage &storage,
+                  const DynamicEdgeBasedGraph &graph)
+        : partition(partition), storage(storage), graph(graph)
+    {
+    }
+
+    Statistics Query(const NodeID source, const NodeID target)
+    {
+        Statistics statistics{0, 0, false};
+        Search(
+            source,
+            [&](const NodeID node) { return partition.GetQueryLevel(source, target, node); },
+            [&](const NodeID node)
+            {
+                ++statistics.settled_nodes;
+                statistics.found = node == target;
+                return statistics.found;
+            },
+            statistics.relaxed_arcs);
+        return statistics;
+    }
+
+  private:
+    // boundary nodes of a cell and the clique weights from the sources computed so far
+    struct Cliques
+    {
+        std::unordered_map<NodeID, std::size_t> source_index;
+        std::vector<NodeID> destinations;
+        std::vector<std::vector<EdgeWeight>> rows;
+    };
+
+    struct Label
+    {
+        EdgeWeight weight;
+        bool from_clique;
+        bool settled;
+    };
+
+    Cliques &GetCliques(const LevelID level, const CellID cell_id)
+    {
+        auto [entry, inserted] = cliques.try_emplace({level, cell_id});
+        if (inserted)
+        {
+            const auto cell = storage.GetUnfilledCell(level, cell_id);
+            std::size_t index = 0;
+            for (const auto node : cell.GetSourceNodes())
+                entry->second.source_index[node] = index++;
+            const auto destinations = cell.GetDestinationNodes();
+            entry->second.destinations.assign(destinations.begin(), destinations.end());
+            entry->second.rows.resize(index);
+        }
+        return entry->second;
+    }
+
+    // Returns the clique weights from `source` to the destination nodes of the cell or nothing if
+    // `source` is no source node of the cell
+    const std::vector<EdgeWeight> *
+    GetCliqueRow(const LevelID level, const CellID cell_id, Cliques &cell, const NodeID source)
+    {
+        const auto index = cell.source_index.find(source);
+        if (index == cell.source_index.end())
+            return nullptr;
+
+        auto &row = cell.rows[index->second];
+        if (row.empty() && !cell.destinations.empty())
+        {
+            // search the level below, restricted to the cell
+            const auto sub_level = static_cast<LevelID>(level - 1);
+            std::size_t relaxed_arcs = 0;
+            const auto labels = Search(
+                source,
+                [&](const NodeID node)
+                {
+                    return partition.GetCell(level, node) == cell_id ? sub_level
+                                                                     : INVALID_LEVEL_ID;
+                },
+                [](const NodeID) { return false; },
+                relaxed_arcs);
+
+            row.reserve(cell.destinations.size());
+            for (const auto destination : cell.destinations)
+            {
+                const auto label = labels.find(destination);
+                row.push_back(label == labels.end() ? INVALID_EDGE_WEIGHT : label->second.weight);
+            }
+        }
+        return &row;
+    }
+
+    // Dijkstra that uses the arcs of the level returned by `get_level` at every node, nodes with
+    // an invalid level are not visited. Stops when `settle` returns true.
+    template <typename GetLevel, typename Settle>
+    std::unordered_map<NodeID, Label> Search(const NodeID source,
+                                             const GetLevel &get_level,
+                                             const Settle &settle,
+                                             std::size_t &relaxed_arcs)
+    {
+        using QueueEntry = std::pair<EdgeWeight, NodeID>;
+        std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> queue;
+        std::unordered_map<NodeID, Label> labels;
+
+        const auto relax = [&](const NodeID node, const EdgeWeight weight, const bool from_clique)
+        {
+            ++relaxed_arcs;
+            auto [label, inserted] = labels.try_emplace(node, Label{weight, from_clique, false});
+            if (!inserted)
+            {
+                if (label->second.settled || label->second.weight <= weight)
+                    return;
+                label->second = {weight, from_clique, false};
+            }
+            queue.push({weight, node});
+        };
+
+        labels[source] = {EdgeWeight{0}, false, false};
+        queue.push({EdgeWeight{0}, source});
+        while (!queue.empty())
+        {
+            const auto [weight, node] = queue.top();
+            queue.pop();
+            auto &label = labels[node];
+            if (label.settled || label.weight != weight)
+                continue;
+            label.settled = true;
+            const auto from_clique = label.from_clique;
+            if (settle(node))
+                break;
+
+            const auto level = get_level(node);
+            if (level > 0 && !from_clique)
+            {
+                // cells are never removed from the map, so the reference stays valid
+                const auto cell_id = partition.GetCell(level, node);
+                auto &cell = GetCliques(level, cell_id);
+                if (const auto row = GetCliqueRow(level, cell_id, cell, node))
+                {
+                    for (const auto index : util::irange<std::size_t>(0, row->size()))
+                    {
+                        if ((*row)[index] != INVALID_EDGE_WEIGHT)
+                            relax(cell.destinations[index], weight + (*row)[index], true);
+                    }
+                }
+            }
+
+            // on the overlay only the edges that leave the cell of the level are used
+            for (const auto edge : graph.GetAdjacentEdgeRange(node))
+            {
+                const auto &data = graph.GetEdgeData(edge);
+                const auto target = graph.GetTarget(edge);
+                if (!data.forward || get_level(target) == INVALID_LEVEL_ID)
+                    continue;
+                if (level == 0 ||
+                    partition.GetCell(level, node) != partition.GetCell(level, target))
+                    relax(target, weight + data.weight, false);
+            }
+        }
+
+        return labels;
+    }
+
+    const MultiLevelPartition &partition;
+    const CellStorage &storage;
+    const DynamicEdgeBasedGraph &graph;
+
+    std::map<std::pair<LevelID, CellID>, Cliques> cliques;
+};
+
+util::json::Array makeLevelReports(const MultiLevelPartition &partition,
+                                   const CellStorage &storage,
+                                   const std::size_t num_metrics,
+                                   std::size_t &cell_metrics_bytes)
+{
+    const auto bytes_per_entry = sizeof(EdgeWeight) + sizeof(EdgeDuration) + sizeof(EdgeDistance);
+
+    util::json::Array levels;
+    for (LevelID level = 1; level < partition.GetNumberOfLevels(); ++level)
+    {
+        const auto num_cells = partition.GetNumberOfCells(level);
+        std::vector<std::size_t> sources, destinations, boundary_nodes, clique_arcs;
+        sources.reserve(num_cells);
+        destinations.reserve(num_cells);
+        boundary_nodes.reserve(num_cells);
+        clique_arcs.reserve(num_cells);
+        for (const auto cell_id : util::irange<CellID>(0, num_cells))
+        {
+            const auto cell = storage.GetUnfilledCell(level, cell_id);
+            const auto cell_sources = cell.GetSourceNodes();
+            const auto cell_destinations = cell.GetDestinationNodes();
+            std::unordered_set<NodeID> boundary(cell_sources.begin(), cell_sources.end());
+            boundary.insert(cell_destinations.begin(), cell_destinations.end());
+
+            sources.push_back(cell_sources.size());
+            destinations.push_back(cell_destinations.size());
+            boundary_nodes.push_back(boundary.size());
+            clique_arcs.push_back(cell_sources.size() * cell_destinations.size());
+        }
+
+        const auto level_arcs =
+            std::accumulate(clique_arcs.begin(), clique_arcs.end(), std::size_t{0});
+        const auto level_bytes = num_metrics * bytes_per_entry * level_arcs;
+        cell_metrics_bytes += level_bytes;
+
+        util::json::Object report;
+        report.values["level"] = util::json::Number(level);
+        report.values["cells"] = util::json::Number(num_cells);
+        report.values["sources"] = makeDistribution(std::move(sources));
+        report.values["destinations"] = makeDistribution(std::move(destinations));
+        report.values["boundary_nodes"] = makeDistribution(std::move(boundary_nodes));
+        report.values["clique_arcs"] = makeDistribution(std::move(clique_arcs));
+        report.values["cell_metrics_bytes"] = util::json::Number(level_bytes);
+        levels.values.push_back(std::move(report));
+    }
+    return levels;
+}
+
+util::json::Object makeQueryReport(const MultiLevelPartition &partition,
+                                   const CellStorage &storage,
+                                   const DynamicEdgeBasedGraph &graph,
+                                   const std::size_t num_queries,
+                                   const std::uint32_t seed)
+{
+    OverlaySearch search(partition, storage, graph);
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<NodeID> random_node(0, graph.GetNumberOfNodes() - 1);
+
+    std::vector<std::size_t> settled_nodes, relaxed_arcs;
+    std::size_t unreachable = 0;
+    for (std::size_t query = 0; query < num_queries && graph.GetNumberOfNodes() > 0; ++query)
+    {
+        const auto source = random_node(generator);
+        const auto target = random_node(generator);
+        const auto statistics = search.Query(source, target);
+        if (!statistics.found)
+        {
+            ++unreachable;
+            continue;
+        }
+        settled_nodes.push_back(statistics.settled_nodes);
+        relaxed_arcs.push_back(statistics.relaxed_arcs);
+    }
+
+    util::json::Object report;
+    report.values["queries"] = util::json::Number(num_queries);
+    report.values["seed"] = util::json::Number(seed);
+    report.values["unreachable"] = util::json::Number(unreachable);
+    report.values["settled_nodes"] = makeDistribution(std::move(settled_nodes));
+    report.values["relaxed_arcs"] = makeDistribution(std::move(relaxed_arcs));
+    return report;
+}
+} // namespace
+
+util::json::Object makePartitionReport(const MultiLevelPartition &partition,
+                                       const CellStorage &storage,
+                                       const DynamicEdgeBasedGraph &graph,
+                                       const std::size_t num_metrics,
+                                       const std::size_t num_queries,
+                                       const std::uint32_t seed)
+{
+    util::json::Object report;
+    std::size_t cell_metrics_bytes = 0;
+    report.values["levels"] = makeLevelReports(partition, storage, num_metrics, cell_metrics_bytes);
+    report.values["metrics"] = util::json::Number(num_metrics);
+    report.values["cell_metrics_bytes"] = util::json::Number(cell_metrics_bytes);
+    report.values["queries"] = makeQueryReport(partition, storage, graph, num_queries, seed);
+    return report;
+}
+
+} // namespace osrm::partitioner
@@ -6,6 +6,7 @@
 #include "partitioner/edge_based_graph_reader.hpp"
 #include "partitioner/files.hpp"
 #include "partitioner/multi_level_partition.hpp"
+#include "partitioner/partition_report.hpp"
 #include "partitioner/recursive_bisection.hpp"
 #include "partitioner/remove_unconnected.hpp"
 #include "partitioner/renumber.hpp"
@@ -14,9 +15,12 @@
 #include "extractor/files.hpp"
 
 #include "util/coordinate.hpp"
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
 #include "util/geojson_debug_logger.hpp"
 #include "util/integer_range.hpp"
 #include "util/json_container.hpp"
+#include "util/json_renderer.hpp"
 #include "util/log.hpp"
 #include "util/mmap_file.hpp"
 #include "util/timing_util.hpp"
@@ -26,6 +30,7 @@
 
 #include <algorithm>
 #include <filesystem>
+#include <fstream>
 #include <iterator>
 #include <vector>
 
@@ -54,7 +59,8 @@ auto getGraphBisection(const PartitionerConfig &config)
                                            config.balance,
                                            config.boundary_factor,
                                            config.num_optimizing_cuts,
-                                           config.small_component_size);
+                                           config.small_component_size,
+                                           config.bisection_algorithm);
 
     // Return bisection ids, keyed by node based graph nodes
     return recursive_bisection.BisectionIDs();
@@ -201,6 +207,37 @@ int Partitioner::Run(const PartitionerConfig &config)
 
     printCellStatistics(mlp, storage);
 
+    if (!config.report_path.empty())
+    {
+        TIMER_START(report);
+        // osrm-customize computes one metric per exclude class
+        std::size_t num_metrics = 1;
+        if (std::filesystem::exists(config.GetPath(".osrm.properties")))
+        {
+            extractor::ProfileProperties properties;
+            extractor::files::readProfileProperties(config.GetPath(".osrm.properties"),
+                                                    properties);
+            num_metrics = std::max<std::size_t>(
+                1,
+                std::count_if(properties.excludable_classes.begin(),
+                              properties.excludable_classes.end(),
+                              [](const auto mask)
+                              { return mask != extractor::INAVLID_CLASS_DATA; }));
+        }
+
+        const auto report = makePartitionReport(
+            mlp, storage, edge_based_graph, num_metrics, config.num_report_queries);
+        std::ofstream out(config.report_path);
+        util::json::render(out, report);
+        out << std::endl;
+        if (!out)
+            throw util::exception("Could not write partition report to " +
+                                  config.report_path.string() + SOURCE_REF);
+        TIMER_STOP(report);
+        util::Log() << "Partition report written to " << config.report_path << " in "
+                    << TIMER_SEC(report) << " seconds";
+    }
+
     return 0;
 }
 
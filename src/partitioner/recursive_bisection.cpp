@@ -1,5 +1,6 @@
 #include "partitioner/recursive_bisection.hpp"
 #include "partitioner/inertial_flow.hpp"
+#include "partitioner/multilevel_bisection.hpp"
 
 #include "partitioner/bisection_graph_view.hpp"
 #include "partitioner/recursive_bisection_state.hpp"
@@ -24,7 +25,8 @@ RecursiveBisection::RecursiveBisection(BisectionGraph &bisection_graph_,
                                        const double balance,
                                        const double boundary_factor,
                                        const std::size_t num_optimizing_cuts,
-                                       const std::size_t small_component_size)
+                                       const std::size_t small_component_size,
+                                       const PartitionerConfig::BisectionAlgorithm algorithm)
     : bisection_graph(bisection_graph_), internal_state(bisection_graph_)
 {
     auto components = internal_state.PrePartitionWithSCC(small_component_size);
@@ -75,7 +77,10 @@ RecursiveBisection::RecursiveBisection(BisectionGraph &bisection_graph_,
         [&](const TreeNode &node, Feeder &feeder)
         {
             const auto cut =
-                computeInertialFlowCut(node.graph, num_optimizing_cuts, balance, boundary_factor);
+                algorithm == PartitionerConfig::BisectionAlgorithm::Multilevel
+                    ? computeMultilevelCut(node.graph, num_optimizing_cuts, balance)
+                    : computeInertialFlowCut(
+                          node.graph, num_optimizing_cuts, balance, boundary_factor);
             const auto center = internal_state.ApplyBisection(
                 node.graph.Begin(), node.graph.End(), node.depth, cut.flags);
 
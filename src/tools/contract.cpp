@@ -44,6 +44,11 @@ return_code parseArguments(int argc,
         boost::program_options::value<unsigned int>(&contractor_config.requested_num_threads)
             ->default_value(std::thread::hardware_concurrency()),
         "Number of threads to use")(
+        "customizable",
+        boost::program_options::bool_switch(&contractor_config.customizable)->default_value(false),
+        "Derive the contraction order from the .osrm.partition file of osrm-partition. The "
+        "shortcuts are stored in the .osrm.cch file and only their weights are recomputed on "
+        "traffic updates")(
         "segment-speed-file",
         boost::program_options::value<std::vector<std::string>>(
             &contractor_config.updater_config.segment_speed_lookup_paths)
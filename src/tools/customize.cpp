@@ -69,7 +69,17 @@ return_code parseArguments(int argc,
                 &customization_config.updater_config.tz_file_path)
                 ->default_value(""),
             "Required for conditional turn restriction parsing, provide a geojson file containing "
-            "time zone boundaries");
+            "time zone boundaries")(
+            "incremental",
+            boost::program_options::bool_switch(&customization_config.incremental)
+                ->default_value(false),
+            "Update the existing .osrm.cell_metrics and only recompute the cells that contain "
+            "edges updated by this or the previous customization")(
+            "matrix-min-sources",
+            boost::program_options::value<std::size_t>(&customization_config.matrix_min_sources),
+            "Experimental: customize cells above level 1 with at least this many boundary nodes "
+            "with one vectorized search from all of them at once. Paths of equal weight may get "
+            "different durations and distances than with the default search");
 
     // hidden options, will be allowed on command line, but will not be
     // shown to the user
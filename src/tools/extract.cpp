@@ -1,10 +1,12 @@
 #include "osrm/exception.hpp"
 #include "osrm/extractor.hpp"
 #include "osrm/extractor_config.hpp"
+#include "extractor/scripting_environment_plugin.hpp"
 #include "util/log.hpp"
 #include "util/meminfo.hpp"
 #include "util/version.hpp"
 
+#include <boost/algorithm/string/case_conv.hpp>
 #include <boost/program_options.hpp>
 #include <cstdlib>
 #include <filesystem>
@@ -14,6 +16,39 @@
 
 using namespace osrm;
 
+namespace osrm::extractor
+{
+std::istream &operator>>(std::istream &in, ExtractorConfig::Stage &stage)
+{
+    std::string token;
+    in >> token;
+    boost::to_lower(token);
+
+    if (token == "parse")
+        stage = ExtractorConfig::Stage::Parse;
+    else if (token == "expansion")
+        stage = ExtractorConfig::Stage::Expansion;
+    else if (token == "rtree")
+        stage = ExtractorConfig::Stage::RTree;
+    else
+        throw boost::program_options::invalid_option_value(token);
+    return in;
+}
+
+std::ostream &operator<<(std::ostream &out, const ExtractorConfig::Stage stage)
+{
+    switch (stage)
+    {
+    case ExtractorConfig::Stage::Expansion:
+        return out << "expansion";
+    case ExtractorConfig::Stage::RTree:
+        return out << "rtree";
+    default:
+        return out << "parse";
+    }
+}
+} // namespace osrm::extractor
+
 enum class return_code : unsigned
 {
     ok,
@@ -39,7 +74,7 @@ return_code parseArguments(int argc,
         "profile,p",
         boost::program_options::value<std::filesystem::path>(&extractor_config.profile_path)
             ->default_value("profiles/car.lua"),
-        "Path to LUA routing profile")(
+        "Path to LUA routing profile or compiled profile plugin (.so, .dylib or .dll)")(
         "data_version,d",
         boost::program_options::value<std::string>(&extractor_config.data_version)
             ->default_value(""),
@@ -48,6 +83,15 @@ return_code parseArguments(int argc,
         boost::program_options::value<unsigned int>(&extractor_config.requested_num_threads)
             ->default_value(std::thread::hardware_concurrency()),
         "Number of threads to use")(
+        "memory-budget",
+        boost::program_options::value<std::size_t>()->default_value(0)->notifier(
+            [&extractor_config](const std::size_t megabytes)
+            { extractor_config.memory_budget = megabytes * 1024 * 1024; }),
+        "Memory in MiB for the node and edge lists, the rest is spilled to disk and sorted "
+        "there. 0 keeps everything in memory.")(
+        "spill-directory",
+        boost::program_options::value<std::filesystem::path>(&extractor_config.spill_directory),
+        "Directory for the spilled node and edge lists, defaults to the output directory")(
         "small-component-size",
         boost::program_options::value<unsigned int>(&extractor_config.small_component_size)
             ->default_value(1000),
@@ -68,16 +112,65 @@ return_code parseArguments(int argc,
                                   &extractor_config.location_dependent_data_paths)
                                   ->composing(),
                               "GeoJSON files with location-dependent data")(
+        "apply-changes",
+        boost::program_options::value<std::vector<std::filesystem::path>>(
+            &extractor_config.change_paths)
+            ->composing(),
+        "OSM change files (.osc) to apply to the input file, e.g. daily diffs. The input has to be "
+        "sorted by type and ID. The graph is still built from scratch, see --previous-dataset "
+        "to keep node ids stable.")(
+        "previous-dataset",
+        boost::program_options::value<std::filesystem::path>(
+            &extractor_config.previous_dataset_path),
+        "Keep the edge-based node ids of this earlier extraction (.osrm) wherever a compressed "
+        "edge still connects the same OSM nodes, e.g. to carry per-node data over to a refreshed "
+        "dataset. The extraction itself still runs in full.")(
         "disable-location-cache",
         boost::program_options::bool_switch(&extractor_config.use_locations_cache)
             ->implicit_value(false)
             ->default_value(true),
         "Use internal nodes locations cache for location-dependent data lookups")(
+        "location-index-file",
+        boost::program_options::value<std::filesystem::path>(
+            &extractor_config.location_index_path),
+        "Keep the nodes locations cache in a dense memory mapped array in this file instead of "
+        "memory. The file needs 8 bytes per node ID up to the largest node ID.")(
         "dump-nbg-graph",
         boost::program_options::bool_switch(&extractor_config.dump_nbg_graph)
             ->implicit_value(true)
             ->default_value(false),
-        "Dump raw node-based graph to *.osrm file for debug purposes.");
+        "Dump raw node-based graph to *.osrm file for debug purposes.")(
+        "locality-renumbering",
+        boost::program_options::bool_switch(&extractor_config.use_locality_renumbering)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Renumber edge-based nodes along a Hilbert curve to improve cache locality of queries. "
+        "osrm-partition applies its own ordering on top.")(
+        "compress-geometry",
+        boost::program_options::bool_switch(&extractor_config.compress_geometry)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Store the node lists of the segment geometry delta-encoded in blocks. Reduces memory "
+        "usage at the cost of decoding on every geometry access.")(
+        "compress-names",
+        boost::program_options::bool_switch(&extractor_config.compress_names)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Store street names, refs, pronunciations, destinations and exits compressed with a "
+        "symbol table. Reduces memory usage at the cost of decoding on every name lookup.")(
+        "checkpoints",
+        boost::program_options::bool_switch(&extractor_config.write_checkpoints)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Write the intermediate results after parsing (.osrm.parsed) and after the expansion into "
+        "the edge-based graph (.osrm.ebg_segments), so that a later run can use --start-stage.")(
+        "start-stage",
+        boost::program_options::value<extractor::ExtractorConfig::Stage>(
+            &extractor_config.start_stage)
+            ->default_value(extractor_config.start_stage),
+        "Stage to start from: parse, expansion (node-based graph, compression, edge expansion and "
+        "guidance, reads .osrm.parsed) or rtree (reads .osrm.ebg_segments). The outputs of the "
+        "earlier stages have to be left from a run with --checkpoints.");
 
     bool dummy;
     // hidden options, will be allowed on command line, but will not be
@@ -173,7 +266,8 @@ try
         return EXIT_FAILURE;
     }
 
-    if (!std::filesystem::is_regular_file(extractor_config.input_path))
+    if (extractor_config.start_stage == extractor::ExtractorConfig::Stage::Parse &&
+        !std::filesystem::is_regular_file(extractor_config.input_path))
     {
         util::Log(logERROR) << "Input file " << extractor_config.input_path.string()
                             << " not found!";
@@ -187,6 +281,36 @@ try
         return EXIT_FAILURE;
     }
 
+    if (!extractor_config.location_dependent_data_paths.empty() &&
+        extractor::PluginScriptingEnvironment::IsPlugin(extractor_config.profile_path))
+    {
+        util::Log(logERROR) << "--location-dependent-data can not be used with the profile plugin "
+                            << extractor_config.profile_path.string();
+        return EXIT_FAILURE;
+    }
+
+    if (!extractor_config.previous_dataset_path.empty())
+    {
+        extractor::ExtractorConfig previous_config;
+        previous_config.UseDefaultOutputNames(extractor_config.previous_dataset_path);
+        for (const auto *file : {".osrm.nbg_nodes", ".osrm.cnbg_to_ebg"})
+        {
+            if (!std::filesystem::is_regular_file(previous_config.GetPath(file)))
+            {
+                util::Log(logERROR) << "Previous dataset file "
+                                    << previous_config.GetPath(file).string() << " not found!";
+                return EXIT_FAILURE;
+            }
+        }
+        // the files of the previous dataset are read after the new ones have been written
+        if (std::filesystem::weakly_canonical(previous_config.base_path) ==
+            std::filesystem::weakly_canonical(extractor_config.base_path))
+        {
+            util::Log(logERROR) << "--previous-dataset has to differ from the output of this run";
+            return EXIT_FAILURE;
+        }
+    }
+
     osrm::extract(extractor_config);
 
     util::DumpMemoryStats();
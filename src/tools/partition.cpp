@@ -2,11 +2,13 @@
 #include "partitioner/partitioner_config.hpp"
 
 #include "osrm/exception.hpp"
+#include "util/exception_utils.hpp"
 #include "util/log.hpp"
 #include "util/meminfo.hpp"
 #include "util/timing_util.hpp"
 #include "util/version.hpp"
 
+#include <boost/algorithm/string/case_conv.hpp>
 #include <boost/algorithm/string/join.hpp>
 #include <boost/program_options.hpp>
 #include <boost/range/adaptor/transformed.hpp>
@@ -19,6 +21,31 @@
 
 using namespace osrm;
 
+namespace osrm::partitioner
+{
+std::istream &operator>>(std::istream &in, PartitionerConfig::BisectionAlgorithm &algorithm)
+{
+    std::string token;
+    in >> token;
+    boost::to_lower(token);
+
+    if (token == "inertial-flow")
+        algorithm = PartitionerConfig::BisectionAlgorithm::InertialFlow;
+    else if (token == "multilevel")
+        algorithm = PartitionerConfig::BisectionAlgorithm::Multilevel;
+    else
+        throw util::RuntimeError(token, ErrorCode::UnknownAlgorithm, SOURCE_REF);
+    return in;
+}
+
+std::ostream &operator<<(std::ostream &out, const PartitionerConfig::BisectionAlgorithm algorithm)
+{
+    return out << (algorithm == PartitionerConfig::BisectionAlgorithm::Multilevel
+                       ? "multilevel"
+                       : "inertial-flow");
+}
+} // namespace osrm::partitioner
+
 enum class return_code : unsigned
 {
     ok,
@@ -103,11 +130,28 @@ return_code parseArguments(int argc,
              ->default_value(config.num_optimizing_cuts),
          "Number of cuts to use for optimizing a single bisection")
         //
+        ("bisection",
+         boost::program_options::value<partitioner::PartitionerConfig::BisectionAlgorithm>(
+             &config.bisection_algorithm)
+             ->default_value(config.bisection_algorithm),
+         "Algorithm for single bisections: inertial-flow (max-flow on the whole graph) or "
+         "multilevel (coarsening with local refinement, ignores --boundary)")
+        //
         ("small-component-size",
          boost::program_options::value<std::size_t>(&config.small_component_size)
              ->default_value(config.small_component_size),
          "Size threshold for small components.")
         //
+        ("report",
+         boost::program_options::value<std::filesystem::path>(&config.report_path),
+         "Write a JSON report about the partition to this file: boundary nodes and clique arcs "
+         "per cell and level, the size of the cell metrics and the cost of sampled queries")
+        //
+        ("report-queries",
+         boost::program_options::value<std::size_t>(&config.num_report_queries)
+             ->default_value(config.num_report_queries),
+         "Number of random queries the report uses to estimate the query cost")
+        //
         ("max-cell-sizes",
          boost::program_options::value<MaxCellSizesArgument>()->default_value(
              MaxCellSizesArgument{config.max_cell_sizes}),
@@ -156,6 +156,10 @@ inline unsigned generateServerProgramOptions(const int argc,
         ("dataset-name",
          value<std::string>(&config.dataset_name),
          "Name of the shared memory dataset to connect to.") //
+        ("traffic-update-directory",
+         value<std::filesystem::path>(&config.traffic_update_directory),
+         "Directory that is watched for segment speed files to apply to the shared memory "
+         "dataset. Requires the MLD algorithm.") //
         ("algorithm,a",
          value<EngineConfig::Algorithm>(&config.algorithm)
              ->default_value(EngineConfig::Algorithm::CH, "CH"),
@@ -306,6 +310,10 @@ try
         {
             util::Log(logWARNING) << "Path settings and shared memory conflicts.";
         }
+        if (!config.traffic_update_directory.empty())
+        {
+            util::Log(logWARNING) << "Traffic updates require shared memory and the MLD algorithm.";
+        }
         return EXIT_FAILURE;
     }
 
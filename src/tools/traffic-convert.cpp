@@ -0,0 +1,69 @@
+#include "updater/csv_source.hpp"
+#include "updater/files.hpp"
+#include "updater/source.hpp"
+
+#include "util/log.hpp"
+
+#include <cstdlib>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace osrm::tools
+{
+
+// The lookup tables are sorted descending, the binary files ascending
+template <typename LookupTableT> auto toRecords(const LookupTableT &table)
+{
+    std::vector<decltype(updater::toRecord(table.lookup.front().first,
+                                           table.lookup.front().second))>
+        records;
+    records.reserve(table.lookup.size());
+    for (auto entry = table.lookup.rbegin(); entry != table.lookup.rend(); ++entry)
+    {
+        records.push_back(updater::toRecord(entry->first, entry->second));
+    }
+    return records;
+}
+
+} // namespace osrm::tools
+
+int main(int argc, char *argv[])
+try
+{
+    using namespace osrm;
+
+    util::LogPolicy::GetInstance().Unmute();
+
+    const std::string type = argc > 1 ? argv[1] : "";
+    if (argc < 4 || (type != "segment-speeds" && type != "turn-penalties"))
+    {
+        util::Log(logWARNING) << "Usage: " << argv[0]
+                              << " segment-speeds|turn-penalties input.csv... output";
+        return EXIT_FAILURE;
+    }
+
+    // Later input files take precedence like for osrm-customize and osrm-contract
+    const std::vector<std::string> inputs(argv + 2, argv + argc - 1);
+    const std::string output{argv[argc - 1]};
+
+    if (type == "segment-speeds")
+    {
+        const auto records = tools::toRecords(updater::csv::readSegmentValues(inputs));
+        updater::files::writeTrafficFile(output, records);
+        util::Log() << "Wrote " << records.size() << " segment speeds to " << output;
+    }
+    else
+    {
+        const auto records = tools::toRecords(updater::csv::readTurnValues(inputs));
+        updater::files::writeTrafficFile(output, records);
+        util::Log() << "Wrote " << records.size() << " turn penalties to " << output;
+    }
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    osrm::util::Log(logERROR) << "Error: " << e.what();
+    return EXIT_FAILURE;
+}
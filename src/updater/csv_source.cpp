@@ -2,39 +2,29 @@
 
 #include "updater/csv_file_parser.hpp"
 
-#include <boost/fusion/adapted/std_pair.hpp>
-#include <boost/fusion/include/adapt_adt.hpp>
-
-// clang-format off
-BOOST_FUSION_ADAPT_STRUCT(osrm::updater::Segment,
-                         (decltype(osrm::updater::Segment::from), from)
-                         (decltype(osrm::updater::Segment::to), to))
-BOOST_FUSION_ADAPT_STRUCT(osrm::updater::SpeedSource,
-                          (decltype(osrm::updater::SpeedSource::speed), speed)
-                          (decltype(osrm::updater::SpeedSource::rate), rate))
-BOOST_FUSION_ADAPT_STRUCT(osrm::updater::Turn,
-                          (decltype(osrm::updater::Turn::from), from)
-                          (decltype(osrm::updater::Turn::via), via)
-                          (decltype(osrm::updater::Turn::to), to))
-BOOST_FUSION_ADAPT_STRUCT(osrm::updater::PenaltySource,
-                          (decltype(osrm::updater::PenaltySource::duration), duration)
-                          (decltype(osrm::updater::PenaltySource::weight), weight))
-// clang-format on
-namespace
-{
-namespace qi = boost::spirit::qi;
-}
-
 namespace osrm::updater::csv
 {
 SegmentLookupTable readSegmentValues(const std::vector<std::string> &paths)
 {
-    static const auto value_if_blank = std::numeric_limits<double>::quiet_NaN();
-    const qi::real_parser<double, qi::ureal_policies<double>> unsigned_double;
     CSVFilesParser<Segment, SpeedSource> parser(
         1,
-        qi::ulong_long >> ',' >> qi::ulong_long,
-        unsigned_double >> -(',' >> (qi::double_ | qi::attr(value_if_blank))));
+        [](CSVLineParser &line, Segment &segment)
+        {
+            return line.UnsignedInteger(segment.from) && line.Separator() &&
+                   line.UnsignedInteger(segment.to);
+        },
+        [](CSVLineParser &line, SpeedSource &source)
+        {
+            if (!line.UnsignedReal(source.speed))
+                return false;
+            // A blank rate keeps the existing weight
+            if (line.Separator())
+            {
+                double rate;
+                source.rate = line.Real(rate) ? rate : std::numeric_limits<double>::quiet_NaN();
+            }
+            return true;
+        });
 
     // Check consistency of keys in the result lookup table
     auto result = parser(paths);
@@ -53,10 +43,24 @@ SegmentLookupTable readSegmentValues(const std::vector<std::string> &paths)
 
 TurnLookupTable readTurnValues(const std::vector<std::string> &paths)
 {
-    CSVFilesParser<Turn, PenaltySource> parser(1,
-                                               qi::ulong_long >> ',' >> qi::ulong_long >> ',' >>
-                                                   qi::ulong_long,
-                                               qi::double_ >> -(',' >> qi::double_));
+    CSVFilesParser<Turn, PenaltySource> parser(
+        1,
+        [](CSVLineParser &line, Turn &turn)
+        {
+            return line.UnsignedInteger(turn.from) && line.Separator() &&
+                   line.UnsignedInteger(turn.via) && line.Separator() &&
+                   line.UnsignedInteger(turn.to);
+        },
+        [](CSVLineParser &line, PenaltySource &source)
+        {
+            if (!line.Real(source.duration))
+                return false;
+            // The weight is optional, a following field that is no number is the comment
+            auto weight_line = line;
+            if (weight_line.Separator() && weight_line.Real(source.weight))
+                line = weight_line;
+            return true;
+        });
     return parser(paths);
 }
 } // namespace osrm::updater::csv
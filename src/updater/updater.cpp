@@ -1,5 +1,7 @@
 #include "updater/updater.hpp"
 #include "updater/csv_source.hpp"
+#include "updater/edge_weight.hpp"
+#include "updater/speed_conversion.hpp"
 
 #include "extractor/compressed_edge_container.hpp"
 #include "extractor/edge_based_graph_factory.hpp"
@@ -53,25 +55,6 @@ template <typename T> inline bool is_aligned(const void *pointer)
     return reinterpret_cast<uintptr_t>(pointer) % alignof(T) == 0;
 }
 
-// Returns duration in deci-seconds
-inline SegmentDuration convertToDuration(double speed_in_kmh, double distance_in_meters)
-{
-    if (speed_in_kmh <= 0.)
-        return INVALID_SEGMENT_DURATION;
-
-    const auto speed_in_ms = speed_in_kmh / 3.6;
-    const auto duration = distance_in_meters / speed_in_ms;
-    auto segment_duration = std::max<SegmentDuration>(
-        {1}, {boost::numeric_cast<SegmentDuration::value_type>(std::round(duration * 10.))});
-    if (segment_duration >= INVALID_SEGMENT_DURATION)
-    {
-        util::Log(logWARNING) << "Clamping segment duration " << segment_duration << " to "
-                              << MAX_SEGMENT_DURATION;
-        segment_duration = MAX_SEGMENT_DURATION;
-    }
-    return segment_duration;
-}
-
 #if !defined(NDEBUG)
 void checkWeightsConsistency(
     const UpdaterConfig &config,
@@ -140,43 +123,14 @@ updateSegmentData(const UpdaterConfig &config,
                                                       const SpeedSource &value,
                                                       double distance_in_meters)
     {
-        double rate = std::numeric_limits<double>::quiet_NaN();
-
-        // if value.rate is not set, we fall back to duration
-        //    this happens when there is no 4th column in the input CSV
-        // if value.rate is set but NaN, we keep the existing weight
-        //    this happens when there is an empty 4th column in the input CSV
-        // otherwise, we use the value as the new rate
         if (!value.rate)
         {
             ++fallbacks_to_duration;
-            rate = value.speed / 3.6;
-        }
-        else
-        {
-            rate = *value.rate;
-            if (!std::isfinite(rate))
-            {
-                return existing_weight;
-            }
         }
-
-        if (rate <= 0.)
-            return INVALID_SEGMENT_WEIGHT;
-
-        const auto weight_multiplier = profile_properties.GetWeightMultiplier();
-        const auto weight = distance_in_meters / rate;
-        auto segment_weight =
-            std::max<SegmentWeight>({1},
-                                    {boost::numeric_cast<SegmentWeight::value_type>(
-                                        std::round(weight * weight_multiplier))});
-        if (segment_weight >= INVALID_SEGMENT_WEIGHT)
-        {
-            util::Log(logWARNING) << "Clamping segment weight " << segment_weight << " to "
-                                  << MAX_SEGMENT_WEIGHT;
-            segment_weight = MAX_SEGMENT_WEIGHT;
-        }
-        return segment_weight;
+        return updater::convertToWeight(profile_properties.GetWeightMultiplier(),
+                                        existing_weight,
+                                        value,
+                                        distance_in_meters);
     };
 
     // The check here is enabled by the `--edge-weight-updates-over-factor` flag it logs a
@@ -537,8 +491,21 @@ Updater::LoadAndUpdateEdgeExpandedGraph(std::vector<extractor::EdgeBasedEdge> &e
                                         std::vector<EdgeWeight> &node_weights,
                                         std::vector<EdgeDuration> &node_durations,
                                         std::uint32_t &connectivity_checksum) const
+{
+    std::vector<NodeID> updated_nodes;
+    return LoadAndUpdateEdgeExpandedGraph(
+        edge_based_edge_list, node_weights, node_durations, updated_nodes, connectivity_checksum);
+}
+
+EdgeID
+Updater::LoadAndUpdateEdgeExpandedGraph(std::vector<extractor::EdgeBasedEdge> &edge_based_edge_list,
+                                        std::vector<EdgeWeight> &node_weights,
+                                        std::vector<EdgeDuration> &node_durations,
+                                        std::vector<NodeID> &updated_nodes,
+                                        std::uint32_t &connectivity_checksum) const
 {
     TIMER_START(load_edges);
+    updated_nodes.clear();
 
     EdgeID number_of_edge_based_nodes = 0;
     std::vector<util::Coordinate> coordinates;
@@ -680,43 +647,13 @@ Updater::LoadAndUpdateEdgeExpandedGraph(std::vector<extractor::EdgeBasedEdge> &e
     const auto compute_new_weight_and_duration =
         [&](const GeometryID geometry_id) -> WeightAndDuration
     {
-        EdgeWeight new_weight = {0};
-        EdgeDuration new_duration = {0};
         if (geometry_id.forward)
         {
-            const auto weights = segment_data.GetForwardWeights(geometry_id.id);
-            for (const SegmentWeight weight : weights)
-            {
-                if (weight == INVALID_SEGMENT_WEIGHT)
-                {
-                    new_weight = INVALID_EDGE_WEIGHT;
-                    break;
-                }
-                new_weight += alias_cast<EdgeWeight>(weight);
-            }
-            const auto durations = segment_data.GetForwardDurations(geometry_id.id);
-            // NOLINTNEXTLINE(bugprone-fold-init-type)
-            new_duration = alias_cast<EdgeDuration>(
-                std::accumulate(durations.begin(), durations.end(), SegmentDuration{0}));
+            return sumSegments(segment_data.GetForwardWeights(geometry_id.id),
+                               segment_data.GetForwardDurations(geometry_id.id));
         }
-        else
-        {
-            const auto weights = segment_data.GetReverseWeights(geometry_id.id);
-            for (const SegmentWeight weight : weights)
-            {
-                if (weight == INVALID_SEGMENT_WEIGHT)
-                {
-                    new_weight = INVALID_EDGE_WEIGHT;
-                    break;
-                }
-                new_weight += alias_cast<EdgeWeight>(SegmentWeight(weight));
-            }
-            const auto durations = segment_data.GetReverseDurations(geometry_id.id);
-            // NOLINTNEXTLINE(bugprone-fold-init-type)
-            new_duration = alias_cast<EdgeDuration>(
-                std::accumulate(durations.begin(), durations.end(), SegmentDuration{0}));
-        }
-        return std::make_tuple(new_weight, new_duration);
+        return sumSegments(segment_data.GetReverseWeights(geometry_id.id),
+                           segment_data.GetReverseDurations(geometry_id.id));
     };
 
     std::vector<WeightAndDuration> accumulated_segment_data(updated_segments.size());
@@ -730,6 +667,7 @@ Updater::LoadAndUpdateEdgeExpandedGraph(std::vector<extractor::EdgeBasedEdge> &e
                           }
                       });
 
+    tbb::concurrent_vector<NodeID> updated_sources;
     const auto update_edge = [&](extractor::EdgeBasedEdge &edge)
     {
         const auto node_id = edge.source;
@@ -759,6 +697,7 @@ Updater::LoadAndUpdateEdgeExpandedGraph(std::vector<extractor::EdgeBasedEdge> &e
                     ? new_weight | EdgeWeight{static_cast<EdgeWeight::value_type>(0x80000000)}
                     : new_weight;
             node_durations[edge.source] = new_duration;
+            updated_sources.push_back(edge.source);
 
             // We found a zero-speed edge, so we'll skip this whole edge-based-edge
             // which
@@ -774,24 +713,16 @@ Updater::LoadAndUpdateEdgeExpandedGraph(std::vector<extractor::EdgeBasedEdge> &e
             auto turn_duration_penalty = turn_duration_penalties[edge.data.turn_id];
             const auto num_nodes = segment_data.GetForwardGeometry(geometry_id.id).size();
             const auto weight_min_value = to_alias<EdgeWeight>(num_nodes);
-            if (alias_cast<EdgeWeight>(turn_weight_penalty) + new_weight < weight_min_value)
+            const auto original_turn_weight_penalty = turn_weight_penalty;
+            edge.data.weight = computeEdgeWeight(new_weight, turn_weight_penalty, weight_min_value);
+            if (turn_weight_penalty != original_turn_weight_penalty)
             {
-                if (turn_weight_penalty < TurnPenalty{0})
-                {
-                    util::Log(logWARNING)
-                        << "turn penalty " << turn_weight_penalty
-                        << " is too negative: clamping turn weight to " << weight_min_value;
-                    turn_weight_penalty = alias_cast<TurnPenalty>(weight_min_value - new_weight);
-                    turn_weight_penalties[edge.data.turn_id] = turn_weight_penalty;
-                }
-                else
-                {
-                    new_weight = weight_min_value;
-                }
+                util::Log(logWARNING) << "turn penalty " << original_turn_weight_penalty
+                                      << " is too negative: clamping turn weight to "
+                                      << weight_min_value;
+                turn_weight_penalties[edge.data.turn_id] = turn_weight_penalty;
             }
 
-            // Update edge weight
-            edge.data.weight = new_weight + alias_cast<EdgeWeight>(turn_weight_penalty);
             edge.data.duration = from_alias<EdgeDuration::value_type>(
                 new_duration + alias_cast<EdgeDuration>(turn_duration_penalty));
         }
@@ -809,6 +740,11 @@ Updater::LoadAndUpdateEdgeExpandedGraph(std::vector<extractor::EdgeBasedEdge> &e
                           });
     }
 
+    updated_nodes.assign(updated_sources.begin(), updated_sources.end());
+    tbb::parallel_sort(updated_nodes.begin(), updated_nodes.end());
+    updated_nodes.erase(std::unique(updated_nodes.begin(), updated_nodes.end()),
+                        updated_nodes.end());
+
     if (update_turn_penalties || update_conditional_turns)
     {
         tbb::parallel_invoke(
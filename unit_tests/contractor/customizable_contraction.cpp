@@ -0,0 +1,248 @@
+#include "contractor/customizable_contraction.hpp"
+
+#include "extractor/edge_based_edge.hpp"
+#include "partitioner/multi_level_partition.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <vector>
+
+using namespace osrm;
+using namespace osrm::contractor;
+
+namespace
+{
+constexpr NodeID GRID_SIZE = 4;
+
+// 4x4 grid with bidirectional rows and columns that are partly oneway
+std::vector<extractor::EdgeBasedEdge> makeGridEdges()
+{
+    std::vector<extractor::EdgeBasedEdge> edges;
+    NodeID turn_id = 0;
+    for (const auto row : util::irange<NodeID>(0, GRID_SIZE))
+    {
+        for (const auto column : util::irange<NodeID>(0, GRID_SIZE))
+        {
+            const auto node = row * GRID_SIZE + column;
+            if (column + 1 < GRID_SIZE)
+            {
+                edges.emplace_back(node,
+                                   node + 1,
+                                   turn_id++,
+                                   EdgeWeight{static_cast<int>(row + column + 1)},
+                                   EdgeDuration{static_cast<int>(2 * (row + column + 1))},
+                                   EdgeDistance{1},
+                                   true,
+                                   true);
+            }
+            if (row + 1 < GRID_SIZE)
+            {
+                edges.emplace_back(node,
+                                   node + GRID_SIZE,
+                                   turn_id++,
+                                   EdgeWeight{2},
+                                   EdgeDuration{4},
+                                   EdgeDistance{1},
+                                   true,
+                                   column % 2 == 0);
+            }
+        }
+    }
+    return edges;
+}
+
+partitioner::MultiLevelPartition makeGridPartition()
+{
+    std::vector<CellID> l1, l2;
+    for (const auto row : util::irange<NodeID>(0, GRID_SIZE))
+    {
+        for (const auto column : util::irange<NodeID>(0, GRID_SIZE))
+        {
+            l1.push_back((row / 2) * 2 + column / 2);
+            l2.push_back(column / 2);
+        }
+    }
+    return partitioner::MultiLevelPartition{{l1, l2}, {4, 2}};
+}
+
+// Shortest path weights on the input edges
+std::vector<EdgeWeight> dijkstra(const std::vector<extractor::EdgeBasedEdge> &edges,
+                                 const std::vector<bool> &node_filter,
+                                 const NodeID source)
+{
+    std::vector<EdgeWeight> weights(node_filter.size(), INVALID_EDGE_WEIGHT);
+    using Entry = std::pair<EdgeWeight, NodeID>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    weights[source] = {0};
+    queue.emplace(EdgeWeight{0}, source);
+    while (!queue.empty())
+    {
+        const auto [weight, node] = queue.top();
+        queue.pop();
+        if (weight > weights[node])
+            continue;
+        for (const auto &edge : edges)
+        {
+            if (!node_filter[edge.source] || !node_filter[edge.target])
+                continue;
+            const auto relax = [&](const NodeID from, const NodeID to)
+            {
+                if (from == node && weight + edge.data.weight < weights[to])
+                {
+                    weights[to] = weight + edge.data.weight;
+                    queue.emplace(weights[to], to);
+                }
+            };
+            if (edge.data.forward)
+                relax(edge.source, edge.target);
+            if (edge.data.backward)
+                relax(edge.target, edge.source);
+        }
+    }
+    return weights;
+}
+
+// Searches on the upward edges like the query of a contraction hierarchy
+std::vector<EdgeWeight> upwardSearch(const QueryGraph &graph,
+                                     const std::vector<bool> &edge_filter,
+                                     const NodeID source,
+                                     const bool forward)
+{
+    std::vector<EdgeWeight> weights(graph.GetNumberOfNodes(), INVALID_EDGE_WEIGHT);
+    using Entry = std::pair<EdgeWeight, NodeID>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    weights[source] = {0};
+    queue.emplace(EdgeWeight{0}, source);
+    while (!queue.empty())
+    {
+        const auto [weight, node] = queue.top();
+        queue.pop();
+        if (weight > weights[node])
+            continue;
+        for (const auto edge : graph.GetAdjacentEdgeRange(node))
+        {
+            const auto &data = graph.GetEdgeData(edge);
+            const auto target = graph.GetTarget(edge);
+            if (!edge_filter[edge] || target == node || !(forward ? data.forward : data.backward))
+                continue;
+            BOOST_CHECK(data.weight > EdgeWeight{0});
+            if (weight + data.weight < weights[target])
+            {
+                weights[target] = weight + data.weight;
+                queue.emplace(weights[target], target);
+            }
+        }
+    }
+    return weights;
+}
+
+void checkShortestPaths(const QueryGraph &graph,
+                        const std::vector<bool> &edge_filter,
+                        const std::vector<extractor::EdgeBasedEdge> &edges,
+                        const std::vector<bool> &node_filter)
+{
+    for (const auto source : util::irange<NodeID>(0, graph.GetNumberOfNodes()))
+    {
+        if (!node_filter[source])
+            continue;
+
+        const auto expected = dijkstra(edges, node_filter, source);
+        const auto forward = upwardSearch(graph, edge_filter, source, true);
+        for (const auto target : util::irange<NodeID>(0, graph.GetNumberOfNodes()))
+        {
+            if (!node_filter[target])
+                continue;
+
+            const auto backward = upwardSearch(graph, edge_filter, target, false);
+            EdgeWeight weight = INVALID_EDGE_WEIGHT;
+            for (const auto middle : util::irange<NodeID>(0, graph.GetNumberOfNodes()))
+            {
+                if (forward[middle] != INVALID_EDGE_WEIGHT &&
+                    backward[middle] != INVALID_EDGE_WEIGHT)
+                {
+                    weight = std::min(weight, forward[middle] + backward[middle]);
+                }
+            }
+            BOOST_CHECK_EQUAL(weight, expected[target]);
+        }
+    }
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(customizable_contraction)
+
+BOOST_AUTO_TEST_CASE(contraction_order)
+{
+    const auto edges = makeGridEdges();
+    const auto partition = makeGridPartition();
+    const auto graph = makeCustomizableGraph(partition, GRID_SIZE * GRID_SIZE, edges);
+
+    BOOST_REQUIRE_EQUAL(graph.GetNumberOfNodes(), GRID_SIZE * GRID_SIZE);
+    for (const auto rank : util::irange<NodeID>(0, graph.GetNumberOfNodes()))
+    {
+        BOOST_CHECK_EQUAL(graph.ranks[graph.order[rank]], rank);
+    }
+
+    // the nodes next to the cut of the top level are contracted last
+    const auto is_top_level_border = [](const NodeID node)
+    { return node % GRID_SIZE == 1 || node % GRID_SIZE == 2; };
+    for (const auto rank : util::irange<NodeID>(GRID_SIZE * GRID_SIZE / 2, GRID_SIZE * GRID_SIZE))
+    {
+        BOOST_CHECK(is_top_level_border(graph.order[rank]));
+    }
+
+    for (const auto &edge : edges)
+    {
+        const auto source_rank = graph.ranks[edge.source];
+        const auto target_rank = graph.ranks[edge.target];
+        BOOST_CHECK(graph.FindArc(std::min(source_rank, target_rank),
+                                  std::max(source_rank, target_rank)) != SPECIAL_EDGEID);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(shortest_paths)
+{
+    auto edges = makeGridEdges();
+    const auto partition = makeGridPartition();
+    const auto graph = makeCustomizableGraph(partition, GRID_SIZE * GRID_SIZE, edges);
+    const std::vector<bool> node_filter(GRID_SIZE * GRID_SIZE, true);
+
+    const auto check = [&]
+    {
+        const auto [query_graph, edge_filters] =
+            customizeExcludableGraph(graph, edges, {node_filter});
+        BOOST_REQUIRE_EQUAL(edge_filters.size(), 1);
+        checkShortestPaths(query_graph, edge_filters.front(), edges, node_filter);
+    };
+    check();
+
+    // new weights with the same topology
+    for (auto &edge : edges)
+    {
+        edge.data.weight = EdgeWeight{static_cast<int>(1 + (edge.source * 7 + edge.target) % 5)};
+    }
+    check();
+}
+
+BOOST_AUTO_TEST_CASE(exclude_filters)
+{
+    const auto edges = makeGridEdges();
+    const auto partition = makeGridPartition();
+    const auto graph = makeCustomizableGraph(partition, GRID_SIZE * GRID_SIZE, edges);
+
+    std::vector<bool> all_nodes(GRID_SIZE * GRID_SIZE, true);
+    std::vector<bool> without_center = all_nodes;
+    without_center[5] = false;
+    without_center[10] = false;
+
+    const auto [query_graph, edge_filters] =
+        customizeExcludableGraph(graph, edges, {all_nodes, without_center});
+    BOOST_REQUIRE_EQUAL(edge_filters.size(), 2);
+    checkShortestPaths(query_graph, edge_filters[0], edges, all_nodes);
+    checkShortestPaths(query_graph, edge_filters[1], edges, without_center);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -55,4 +55,30 @@ BOOST_AUTO_TEST_CASE(read_write_hsgr)
                             reference_metrics["duration"].edge_filter[3]);
 }
 
+BOOST_AUTO_TEST_CASE(read_write_cch)
+{
+    auto reference_connectivity_checksum = 0xDEADBEEF;
+    CustomizableGraph reference_graph;
+    reference_graph.order = {2, 0, 1};
+    reference_graph.ranks = {1, 2, 0};
+    reference_graph.first_arc = {0, 2, 3, 3};
+    reference_graph.heads = {1, 2, 2};
+
+    TemporaryFile tmp{TEST_DATA_DIR "/read_write_cch_test.osrm.cch"};
+    contractor::files::writeCustomizableGraph(
+        tmp.path, reference_graph, reference_connectivity_checksum);
+
+    unsigned connectivity_checksum;
+    CustomizableGraph graph;
+    contractor::files::readCustomizableGraph(tmp.path, graph, connectivity_checksum);
+
+    BOOST_CHECK_EQUAL(connectivity_checksum, reference_connectivity_checksum);
+    CHECK_EQUAL_COLLECTIONS(graph.order, reference_graph.order);
+    CHECK_EQUAL_COLLECTIONS(graph.ranks, reference_graph.ranks);
+    CHECK_EQUAL_COLLECTIONS(graph.first_arc, reference_graph.first_arc);
+    CHECK_EQUAL_COLLECTIONS(graph.heads, reference_graph.heads);
+    BOOST_CHECK_EQUAL(graph.FindArc(0, 2), 1);
+    BOOST_CHECK_EQUAL(graph.FindArc(1, 2), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
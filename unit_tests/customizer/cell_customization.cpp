@@ -7,6 +7,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <limits>
+
 using namespace osrm;
 using namespace osrm::customizer;
 using namespace osrm::partitioner;
@@ -428,4 +430,88 @@ BOOST_AUTO_TEST_CASE(exclude_test)
     CHECK_EQUAL_RANGE(cell_2_1.GetInWeight(5), EdgeWeight{1}, EdgeWeight{0});
 }
 
+BOOST_AUTO_TEST_CASE(incremental_test)
+{
+    // node:                0  1  2  3  4  5  6  7  8  9 10 11 12 13 14 15
+    std::vector<CellID> l1{{0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3}};
+    std::vector<CellID> l2{{0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1}};
+    std::vector<CellID> l3{{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}};
+    MultiLevelPartition mlp{{l1, l2, l3}, {4, 2, 1}};
+
+    std::vector<MockEdge> edges = {
+        {0, 1, {1}},  {0, 2, {1}},  {3, 1, {1}},  {3, 2, {1}},   {4, 5, {1}},   {4, 6, {1}},
+        {5, 7, {1}},  {6, 7, {1}},  {9, 11, {1}}, {10, 8, {1}},  {11, 10, {1}}, {13, 12, {10}},
+        {15, 14, {1}}, {2, 4, {1}}, {5, 12, {1}}, {8, 3, {1}},   {9, 3, {1}},   {12, 5, {1}},
+        {13, 7, {1}}, {14, 9, {1}}, {14, 11, {1}}};
+
+    auto graph = makeGraph(mlp, edges);
+    std::vector<bool> node_filter(graph.GetNumberOfNodes(), true);
+    CellStorage storage(mlp, graph);
+    CellCustomizer customizer(mlp);
+
+    auto metric = storage.MakeMetric();
+    customizer.Customize(graph, storage, node_filter, metric);
+
+    // edge inside of cell (1, 0, 0) and edge between cells (0, 0, 0) -> (1, 0, 0)
+    edges[4].weight = EdgeWeight{5};
+    edges[13].weight = EdgeWeight{7};
+    auto updated_graph = makeGraph(mlp, edges);
+
+    const auto dirty_cells = customizer.GetDirtyCells(updated_graph, {2, 4});
+    BOOST_REQUIRE_EQUAL(dirty_cells.size(), 4);
+    CHECK_EQUAL_COLLECTIONS(dirty_cells[1], std::vector<bool>({false, true, false, false}));
+    CHECK_EQUAL_COLLECTIONS(dirty_cells[2], std::vector<bool>({true, false}));
+    CHECK_EQUAL_COLLECTIONS(dirty_cells[3], std::vector<bool>({true}));
+
+    auto expected_metric = storage.MakeMetric();
+    customizer.Customize(updated_graph, storage, node_filter, expected_metric);
+    BOOST_CHECK(expected_metric.weights != metric.weights);
+
+    customizer.Customize(updated_graph, storage, node_filter, metric, dirty_cells);
+    CHECK_EQUAL_COLLECTIONS(metric.weights, expected_metric.weights);
+    CHECK_EQUAL_COLLECTIONS(metric.durations, expected_metric.durations);
+    CHECK_EQUAL_COLLECTIONS(metric.distances, expected_metric.distances);
+}
+
+BOOST_AUTO_TEST_CASE(matrix_test)
+{
+    // node:                0  1  2  3  4  5  6  7  8  9 10 11 12 13 14 15
+    std::vector<CellID> l1{{0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3}};
+    std::vector<CellID> l2{{0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1}};
+    std::vector<CellID> l3{{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}};
+    MultiLevelPartition mlp{{l1, l2, l3}, {4, 2, 1}};
+
+    std::vector<MockEdge> edges = {
+        {0, 1, {1}},  {0, 2, {2}},  {3, 1, {4}},   {3, 2, {1}},   {4, 5, {3}},   {4, 6, {1}},
+        {5, 7, {2}},  {6, 7, {5}},  {7, 4, {1}},   {9, 11, {3}},  {10, 8, {1}},  {11, 10, {2}},
+        {13, 12, {10}}, {15, 14, {1}}, {2, 4, {1}}, {5, 12, {2}}, {8, 3, {3}},   {9, 3, {1}},
+        {12, 5, {4}}, {13, 7, {1}}, {14, 9, {2}},  {14, 11, {1}}, {3, 13, {6}},  {10, 15, {2}}};
+
+    auto graph = makeGraph(mlp, edges);
+    CellStorage storage(mlp, graph);
+
+    // without and with excluded nodes
+    std::vector<bool> all_nodes(graph.GetNumberOfNodes(), true);
+    std::vector<bool> some_nodes = all_nodes;
+    some_nodes[6] = false;
+    some_nodes[11] = false;
+
+    // only use Dijkstra or use the matrix search for all cells above level 1
+    CellCustomizer dijkstra_customizer(mlp, std::numeric_limits<std::size_t>::max());
+    CellCustomizer matrix_customizer(mlp, 0);
+
+    for (const auto &node_filter : {all_nodes, some_nodes})
+    {
+        auto expected_metric = storage.MakeMetric();
+        dijkstra_customizer.Customize(graph, storage, node_filter, expected_metric);
+
+        auto metric = storage.MakeMetric();
+        matrix_customizer.Customize(graph, storage, node_filter, metric);
+
+        CHECK_EQUAL_COLLECTIONS(metric.weights, expected_metric.weights);
+        CHECK_EQUAL_COLLECTIONS(metric.durations, expected_metric.durations);
+        CHECK_EQUAL_COLLECTIONS(metric.distances, expected_metric.distances);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
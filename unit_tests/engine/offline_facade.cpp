@@ -244,6 +244,28 @@ class ContiguousInternalMemoryDataFacade<routing_algorithms::offline::Algorithm>
         return {};
     };
 
+    std::vector<std::vector<engine::PhantomNodeWithDistance>>
+    NearestPhantomNodesInRange(const std::vector<engine::SnappingQuery> &queries,
+                               const bool /*use_all_edges*/) const override
+    {
+        return std::vector<std::vector<engine::PhantomNodeWithDistance>>(queries.size());
+    };
+
+    std::vector<std::vector<engine::PhantomNodeWithDistance>>
+    NearestPhantomNodes(const std::vector<engine::SnappingQuery> &queries,
+                        const size_t /*max_results*/) const override
+    {
+        return std::vector<std::vector<engine::PhantomNodeWithDistance>>(queries.size());
+    };
+
+    std::vector<engine::PhantomCandidateAlternatives>
+    NearestCandidatesWithAlternativeFromBigComponent(
+        const std::vector<engine::SnappingQuery> &queries,
+        const bool /*use_all_edges*/) const override
+    {
+        return std::vector<engine::PhantomCandidateAlternatives>(queries.size());
+    };
+
     util::guidance::LaneTupleIdPair GetLaneData(const EdgeID /*id*/) const override
     {
         return util::guidance::LaneTupleIdPair{};
@@ -263,20 +285,17 @@ class ContiguousInternalMemoryDataFacade<routing_algorithms::offline::Algorithm>
 
     bool HasLaneData(const EdgeID /*id*/) const override { return false; }
     NameID GetNameIndex(const NodeID /*nodeID*/) const override { return EMPTY_NAMEID; }
-    std::string_view GetNameForID(const NameID /*id*/) const override { return std::string_view{}; }
-    std::string_view GetRefForID(const NameID /*id*/) const override { return std::string_view{}; }
-    std::string_view GetPronunciationForID(const NameID /*id*/) const override
-    {
-        return std::string_view{};
-    }
-    std::string_view GetDestinationsForID(const NameID /*id*/) const override
+    extractor::NameString GetNameForID(const NameID /*id*/) const override { return {}; }
+    extractor::NameString GetRefForID(const NameID /*id*/) const override { return {}; }
+    extractor::NameString GetPronunciationForID(const NameID /*id*/) const override
     {
-        return std::string_view{};
+        return {};
     }
-    std::string_view GetExitsForID(const NameID /*id*/) const override
+    extractor::NameString GetDestinationsForID(const NameID /*id*/) const override
     {
-        return std::string_view{};
+        return {};
     }
+    extractor::NameString GetExitsForID(const NameID /*id*/) const override { return {}; }
     bool GetContinueStraightDefault() const override { return false; }
     std::string GetTimestamp() const override { return ""; }
     double GetMapMatchingMaxSpeed() const override { return 0; }
@@ -0,0 +1,76 @@
+#include "engine/datafacade/shadow_memory_allocator.hpp"
+
+#include "storage/shared_datatype.hpp"
+
+#include "../common/range_tools.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(shadow_memory_allocator)
+
+using namespace osrm;
+using namespace osrm::engine::datafacade;
+
+namespace
+{
+class BufferAllocator final : public ContiguousBlockAllocator
+{
+  public:
+    BufferAllocator()
+    {
+        auto layout = std::make_shared<storage::ContiguousDataLayout>();
+        layout->SetBlock("/a/0/values", storage::make_block<std::uint32_t>(4));
+        layout->SetBlock("/a/1/values", storage::make_block<std::uint32_t>(2));
+        layout->SetBlock("/b", storage::make_block<std::uint64_t>(1));
+        memory.resize(layout->GetSizeOfLayout());
+        index = storage::SharedDataIndex{{{memory.data(), std::move(layout)}}};
+
+        auto values = index.GetBlockPtr<std::uint32_t>("/a/0/values");
+        std::iota(values, values + 4, 1);
+    }
+
+    const storage::SharedDataIndex &GetIndex() override final { return index; }
+
+  private:
+    std::vector<char> memory;
+    storage::SharedDataIndex index;
+};
+} // namespace
+
+BOOST_AUTO_TEST_CASE(shadow_blocks)
+{
+    auto base = std::make_shared<BufferAllocator>();
+    const auto &base_index = base->GetIndex();
+
+    ShadowMemoryAllocator first(base, base_index, {"/a/0/values"});
+    const auto &first_index = first.GetIndex();
+    BOOST_CHECK_EQUAL(first_index.GetBlockEntries("/a/0/values"), 4);
+    BOOST_CHECK_EQUAL(first_index.GetBlockSize("/a/0/values"), 4 * sizeof(std::uint32_t));
+    BOOST_CHECK_EQUAL(first_index.GetBlockPtr<std::uint32_t>("/a/0/values")[3], 4);
+
+    // changes of the copy are not visible in the base
+    first_index.GetBlockPtr<std::uint32_t>("/a/0/values")[0] = 42;
+    BOOST_CHECK_EQUAL(base_index.GetBlockPtr<std::uint32_t>("/a/0/values")[0], 1);
+    BOOST_CHECK_EQUAL(base_index.GetBlockPtr<std::uint32_t>("/a/1/values"),
+                      first_index.GetBlockPtr<std::uint32_t>("/a/1/values"));
+
+    // overlaid blocks are listed once
+    std::vector<std::string> names;
+    first_index.List("/a/", std::back_inserter(names));
+    CHECK_EQUAL_RANGE(names, "/a/0", "/a/1");
+
+    // a later generation starts from the earlier one
+    ShadowMemoryAllocator second(base, first_index, {"/a/0/values", "/b"});
+    const auto &second_index = second.GetIndex();
+    BOOST_CHECK_EQUAL(second_index.GetBlockPtr<std::uint32_t>("/a/0/values")[0], 42);
+    BOOST_CHECK_NE(second_index.GetBlockPtr<std::uint32_t>("/a/0/values"),
+                   first_index.GetBlockPtr<std::uint32_t>("/a/0/values"));
+    BOOST_CHECK_EQUAL(second_index.GetBlockEntries("/b"), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
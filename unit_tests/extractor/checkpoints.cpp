@@ -0,0 +1,150 @@
+#include "extractor/files.hpp"
+#include "extractor/packed_osm_ids.hpp"
+
+#include "../common/temporary_file.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <ctime>
+
+BOOST_AUTO_TEST_SUITE(checkpoints)
+
+using namespace osrm;
+using namespace osrm::extractor;
+
+BOOST_AUTO_TEST_CASE(parsed_data_roundtrip)
+{
+    TemporaryFile tmp;
+
+    LaneDescriptionMap turn_lane_map;
+    turn_lane_map.ConcurrentFindOrAdd(TurnLaneDescription{});
+    turn_lane_map.ConcurrentFindOrAdd(
+        TurnLaneDescription{TurnLaneType::left, TurnLaneType::straight | TurnLaneType::right});
+    turn_lane_map.ConcurrentFindOrAdd(TurnLaneDescription{TurnLaneType::uturn});
+
+    std::vector<TurnRestriction> turn_restrictions;
+    turn_restrictions.emplace_back(TurnPath{ViaNodePath{0, 1, 2}}, true);
+    turn_restrictions.emplace_back(TurnPath{ViaWayPath{3, {4, 5, 6}, 7}}, false);
+    turn_restrictions.back().condition = util::ParseOpeningHours("Mo-Fr 07:00-09:00");
+
+    std::vector<UnresolvedManeuverOverride> maneuver_overrides(1);
+    maneuver_overrides[0].turn_path = TurnPath{ViaWayPath{8, {9}, 10}};
+    maneuver_overrides[0].instruction_node = 9;
+    maneuver_overrides[0].override_type = guidance::TurnType::Turn;
+    maneuver_overrides[0].direction = guidance::DirectionModifier::Left;
+
+    std::vector<util::Coordinate> coordinates = {
+        {util::FloatLongitude{7.41}, util::FloatLatitude{43.73}},
+        {util::FloatLongitude{7.42}, util::FloatLatitude{43.74}}};
+    PackedOSMIDs osm_node_ids;
+    osm_node_ids.push_back(OSMNodeID{123});
+    osm_node_ids.push_back(OSMNodeID{(1ull << 33) + 1});
+
+    std::vector<NodeBasedEdge> edges(1);
+    edges[0].source = 0;
+    edges[0].target = 1;
+    edges[0].weight = {10};
+    std::vector<NodeBasedEdgeAnnotation> annotations(1);
+    annotations[0].name_id = 42;
+
+    ObstacleMap obstacle_map;
+    obstacle_map.emplace(SPECIAL_NODEID, 1, {Obstacle::Type::TrafficSignals});
+    obstacle_map.emplace(0, 1, {Obstacle::Type::Barrier, Obstacle::Direction::Forward, 5, 7});
+
+    files::writeParsedData(tmp.path,
+                           turn_lane_map,
+                           turn_restrictions,
+                           maneuver_overrides,
+                           coordinates,
+                           osm_node_ids,
+                           edges,
+                           annotations,
+                           obstacle_map);
+
+    LaneDescriptionMap read_turn_lane_map;
+    std::vector<TurnRestriction> read_turn_restrictions;
+    std::vector<UnresolvedManeuverOverride> read_maneuver_overrides;
+    std::vector<util::Coordinate> read_coordinates;
+    PackedOSMIDs read_osm_node_ids;
+    std::vector<NodeBasedEdge> read_edges;
+    std::vector<NodeBasedEdgeAnnotation> read_annotations;
+    ObstacleMap read_obstacle_map;
+
+    files::readParsedData(tmp.path,
+                          read_turn_lane_map,
+                          read_turn_restrictions,
+                          read_maneuver_overrides,
+                          read_coordinates,
+                          read_osm_node_ids,
+                          read_edges,
+                          read_annotations,
+                          read_obstacle_map);
+
+    // lane descriptions have to keep their IDs, the edges refer to them
+    BOOST_CHECK_EQUAL(read_turn_lane_map.data.size(), turn_lane_map.data.size());
+    for (const auto &[description, id] : turn_lane_map.data)
+        BOOST_CHECK_EQUAL(read_turn_lane_map.ConcurrentFindOrAdd(description), id);
+
+    BOOST_REQUIRE_EQUAL(read_turn_restrictions.size(), 2);
+    BOOST_CHECK(read_turn_restrictions[0] == turn_restrictions[0]);
+    BOOST_CHECK(read_turn_restrictions[0].IsUnconditional());
+    BOOST_CHECK(read_turn_restrictions[1] == turn_restrictions[1]);
+    BOOST_CHECK_EQUAL(read_turn_restrictions[1].condition.size(), 1);
+    std::tm monday_morning{};
+    monday_morning.tm_year = 124;
+    monday_morning.tm_mon = 0;
+    monday_morning.tm_mday = 1;
+    monday_morning.tm_wday = 1;
+    monday_morning.tm_hour = 8;
+    BOOST_CHECK(util::CheckOpeningHours(read_turn_restrictions[1].condition, monday_morning));
+
+    BOOST_REQUIRE_EQUAL(read_maneuver_overrides.size(), 1);
+    BOOST_CHECK(read_maneuver_overrides[0].turn_path == maneuver_overrides[0].turn_path);
+    BOOST_CHECK_EQUAL(read_maneuver_overrides[0].instruction_node, 9);
+    BOOST_CHECK_EQUAL(read_maneuver_overrides[0].override_type, guidance::TurnType::Turn);
+    BOOST_CHECK_EQUAL(read_maneuver_overrides[0].direction, guidance::DirectionModifier::Left);
+
+    BOOST_REQUIRE_EQUAL(read_coordinates.size(), 2);
+    BOOST_CHECK(read_coordinates[1] == coordinates[1]);
+    BOOST_REQUIRE_EQUAL(read_osm_node_ids.size(), 2);
+    BOOST_CHECK_EQUAL(static_cast<OSMNodeID>(read_osm_node_ids[1]), OSMNodeID{(1ull << 33) + 1});
+
+    BOOST_REQUIRE_EQUAL(read_edges.size(), 1);
+    BOOST_CHECK_EQUAL(read_edges[0].target, 1);
+    BOOST_CHECK_EQUAL(read_edges[0].weight, edges[0].weight);
+    BOOST_REQUIRE_EQUAL(read_annotations.size(), 1);
+    BOOST_CHECK_EQUAL(read_annotations[0].name_id, 42);
+
+    BOOST_CHECK_EQUAL(read_obstacle_map.get(1).size(), 1);
+    BOOST_CHECK_EQUAL(read_obstacle_map.get(0, 1).size(), 2);
+    BOOST_CHECK_EQUAL(read_obstacle_map.get(2, 1).size(), 1);
+    const auto barrier = read_obstacle_map.get(0, 1, Obstacle::Type::Barrier);
+    BOOST_REQUIRE_EQUAL(barrier.size(), 1);
+    BOOST_CHECK(barrier[0].direction == Obstacle::Direction::Forward);
+    BOOST_CHECK_EQUAL(barrier[0].duration, 5);
+    BOOST_CHECK_EQUAL(barrier[0].weight, 7);
+}
+
+BOOST_AUTO_TEST_CASE(edge_based_node_segments_roundtrip)
+{
+    TemporaryFile tmp;
+
+    std::vector<EdgeBasedNodeSegment> segments(2);
+    segments[0].u = 1;
+    segments[0].v = 2;
+    segments[0].fwd_segment_position = 3;
+    segments[1].u = 4;
+    segments[1].v = 5;
+
+    files::writeEdgeBasedNodeSegments(tmp.path, segments);
+
+    std::vector<EdgeBasedNodeSegment> read_segments;
+    files::readEdgeBasedNodeSegments(tmp.path, read_segments);
+
+    BOOST_REQUIRE_EQUAL(read_segments.size(), 2);
+    BOOST_CHECK_EQUAL(read_segments[0].u, 1);
+    BOOST_CHECK_EQUAL(read_segments[0].fwd_segment_position, 3);
+    BOOST_CHECK_EQUAL(read_segments[1].v, 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,119 @@
+#include "extractor/segment_data_container.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(compressed_segment_nodes)
+
+using namespace osrm;
+using namespace osrm::extractor;
+
+namespace
+{
+SegmentDataContainer makeSegmentData(const std::vector<std::vector<NodeID>> &geometries)
+{
+    std::vector<std::uint32_t> index;
+    std::vector<NodeID> nodes;
+    for (const auto &geometry : geometries)
+    {
+        index.push_back(nodes.size());
+        nodes.insert(nodes.end(), geometry.begin(), geometry.end());
+    }
+    index.push_back(nodes.size());
+
+    const auto num_nodes = nodes.size();
+    SegmentDataContainer::SegmentWeightVector weights(num_nodes);
+    SegmentDataContainer::SegmentDurationVector durations(num_nodes);
+    SegmentDataContainer::SegmentDatasourceVector datasources(num_nodes);
+
+    return SegmentDataContainer(std::move(index),
+                                std::move(nodes),
+                                weights,
+                                weights,
+                                durations,
+                                durations,
+                                datasources,
+                                datasources);
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(roundtrip)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<NodeID> node_distribution(0, SPECIAL_NODEID - 1);
+    std::uniform_int_distribution<std::size_t> length_distribution(2, 20);
+
+    // spans several blocks, mixes consecutive and random node ids including large jumps
+    std::vector<std::vector<NodeID>> geometries;
+    for (std::size_t geometry = 0; geometry < 300; ++geometry)
+    {
+        std::vector<NodeID> nodes(length_distribution(generator));
+        auto current = node_distribution(generator);
+        for (auto &node : nodes)
+        {
+            node = geometry % 3 == 0 ? node_distribution(generator) : current++;
+        }
+        geometries.push_back(nodes);
+    }
+    geometries.push_back({0, SPECIAL_NODEID - 1, 0});
+
+    auto segment_data = makeSegmentData(geometries);
+    const auto plain_size = segment_data.GetNodesSizeInBytes();
+    BOOST_CHECK(!segment_data.HasCompressedNodes());
+
+    segment_data.CompressNodes();
+    BOOST_CHECK(segment_data.HasCompressedNodes());
+    BOOST_CHECK_LT(segment_data.GetNodesSizeInBytes(), plain_size);
+    BOOST_REQUIRE_EQUAL(segment_data.GetNumberOfGeometries(), geometries.size());
+
+    for (std::uint32_t id = 0; id < geometries.size(); ++id)
+    {
+        const auto forward = segment_data.GetForwardGeometry(id);
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            forward.begin(), forward.end(), geometries[id].begin(), geometries[id].end());
+
+        const auto reverse = segment_data.GetReverseGeometry(id);
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            reverse.begin(), reverse.end(), geometries[id].rbegin(), geometries[id].rend());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(random_access)
+{
+    auto segment_data = makeSegmentData({{1, 2, 3}, {7, 5}, {100, 101, 102, 103}});
+    segment_data.CompressNodes();
+
+    const auto geometry = segment_data.GetForwardGeometry(2);
+    BOOST_REQUIRE_EQUAL(geometry.size(), 4);
+    BOOST_CHECK_EQUAL(geometry[0], 100);
+    BOOST_CHECK_EQUAL(geometry[3], 103);
+    BOOST_CHECK_EQUAL(segment_data.GetForwardGeometry(1).front(), 7);
+    BOOST_CHECK_EQUAL(segment_data.GetReverseGeometry(1).front(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(reuse_decode_buffers)
+{
+    auto segment_data = makeSegmentData({{1, 2, 3}, {7, 5}, {100, 101, 102, 103}});
+    segment_data.CompressNodes();
+
+    // copies share the decoded nodes and keep them alive
+    auto first = segment_data.GetForwardGeometry(0);
+    const auto copy = first;
+    BOOST_CHECK_EQUAL(copy.begin(), first.begin());
+    const auto second = segment_data.GetForwardGeometry(2);
+    BOOST_CHECK_NE(second.begin(), first.begin());
+    first = segment_data.GetForwardGeometry(1);
+    BOOST_CHECK_EQUAL(copy.front(), 1);
+    BOOST_CHECK_EQUAL(copy.back(), 3);
+    BOOST_CHECK_EQUAL(second.front(), 100);
+    BOOST_CHECK_EQUAL(first.front(), 7);
+
+    // the buffer of a released geometry is used for the next one
+    const auto *nodes = [&] { return segment_data.GetForwardGeometry(2).begin(); }();
+    BOOST_CHECK_EQUAL(segment_data.GetForwardGeometry(1).begin(), nodes);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,14 +1,25 @@
 #include "extractor/graph_compressor.hpp"
 #include "extractor/compressed_edge_container.hpp"
+#include "extractor/files.hpp"
 #include "extractor/maneuver_override.hpp"
 #include "extractor/restriction.hpp"
+#include "util/integer_range.hpp"
 #include "util/node_based_graph.hpp"
 #include "util/typedefs.hpp"
 
+#include "../common/temporary_file.hpp"
 #include "../unit_tests/mocks/mock_scripting_environment.hpp"
 
 #include <boost/test/unit_test.hpp>
 
+#include <tbb/global_control.h>
+#include <tbb/task_arena.h>
+
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <tuple>
 #include <unordered_set>
 #include <vector>
 
@@ -241,4 +252,170 @@ BOOST_AUTO_TEST_CASE(direction_changes)
     BOOST_CHECK(graph.FindEdge(1, 2) != SPECIAL_EDGEID);
 }
 
+BOOST_AUTO_TEST_CASE(parallel_roads_test)
+{
+    //
+    // 4---0---1---3---5
+    //     |       |
+    //     +---2---+
+    //
+    GraphCompressor compressor;
+
+    std::vector<TurnRestriction> restrictions;
+    std::vector<NodeBasedEdgeAnnotation> annotations(1);
+    CompressedEdgeContainer container;
+    test::MockScriptingEnvironment scripting_environment;
+    std::vector<UnresolvedManeuverOverride> maneuver_overrides;
+
+    std::vector<InputEdge> edges = {MakeUnitEdge(0, 1),
+                                    MakeUnitEdge(0, 2),
+                                    MakeUnitEdge(0, 4),
+                                    MakeUnitEdge(1, 0),
+                                    MakeUnitEdge(1, 3),
+                                    MakeUnitEdge(2, 0),
+                                    MakeUnitEdge(2, 3),
+                                    MakeUnitEdge(3, 1),
+                                    MakeUnitEdge(3, 2),
+                                    MakeUnitEdge(3, 5),
+                                    MakeUnitEdge(4, 0),
+                                    MakeUnitEdge(5, 3)};
+
+    Graph graph(6, edges);
+    compressor.Compress(
+        scripting_environment, restrictions, maneuver_overrides, graph, annotations, container);
+
+    // only the first road can become an edge between 0 and 3
+    BOOST_CHECK_EQUAL(graph.FindEdge(0, 1), SPECIAL_EDGEID);
+    BOOST_CHECK_EQUAL(graph.FindEdge(1, 3), SPECIAL_EDGEID);
+    BOOST_CHECK(graph.FindEdge(0, 3) != SPECIAL_EDGEID);
+    BOOST_CHECK(graph.FindEdge(0, 2) != SPECIAL_EDGEID);
+    BOOST_CHECK(graph.FindEdge(2, 3) != SPECIAL_EDGEID);
+}
+
+BOOST_AUTO_TEST_CASE(many_roads_test)
+{
+    //
+    // 0---1---2   3---4---5   ...
+    //
+    GraphCompressor compressor;
+
+    std::vector<TurnRestriction> restrictions;
+    std::vector<NodeBasedEdgeAnnotation> annotations(1);
+    CompressedEdgeContainer container;
+    test::MockScriptingEnvironment scripting_environment;
+    std::vector<UnresolvedManeuverOverride> maneuver_overrides;
+
+    const NodeID number_of_roads = 5000;
+    std::vector<InputEdge> edges;
+    for (const NodeID road : util::irange<NodeID>(0, number_of_roads))
+    {
+        const NodeID first = 3 * road;
+        edges.push_back(MakeUnitEdge(first, first + 1));
+        edges.push_back(MakeUnitEdge(first + 1, first));
+        edges.push_back(MakeUnitEdge(first + 1, first + 2));
+        edges.push_back(MakeUnitEdge(first + 2, first + 1));
+    }
+
+    Graph graph(3 * number_of_roads, edges);
+    compressor.Compress(
+        scripting_environment, restrictions, maneuver_overrides, graph, annotations, container);
+
+    for (const NodeID road : util::irange<NodeID>(0, number_of_roads))
+    {
+        const NodeID first = 3 * road;
+        BOOST_REQUIRE_EQUAL(graph.FindEdge(first, first + 1), SPECIAL_EDGEID);
+        const auto edge = graph.FindEdge(first, first + 2);
+        BOOST_REQUIRE(edge != SPECIAL_EDGEID);
+        BOOST_REQUIRE(container.HasEntryForID(edge));
+        const auto &bucket = container.GetBucketReference(edge);
+        BOOST_REQUIRE(!bucket.empty());
+        BOOST_CHECK_EQUAL(bucket.front().node_id, first + 1);
+        BOOST_CHECK_EQUAL(bucket.back().node_id, first + 2);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(serial_and_parallel_geometry_test)
+{
+    // roads with up to four nodes between random junctions, some of them connect the same
+    // junctions
+    std::mt19937 generator(7);
+    const NodeID number_of_junctions = 200;
+    std::uniform_int_distribution<NodeID> junction_distribution(0, number_of_junctions - 1);
+    std::uniform_int_distribution<NodeID> length_distribution(0, 4);
+    std::uniform_int_distribution<int> weight_distribution(1, 10);
+
+    std::vector<InputEdge> edges;
+    NodeID number_of_nodes = number_of_junctions;
+    const auto add_segment = [&](const NodeID from, const NodeID to)
+    {
+        const EdgeWeight weight{weight_distribution(generator)};
+        for (const auto &[source, target] : {std::tuple{from, to}, std::tuple{to, from}})
+        {
+            auto edge = MakeUnitEdge(source, target);
+            edge.data.weight = weight;
+            edges.push_back(edge);
+        }
+    };
+    for (std::size_t road = 0; road < 3000; ++road)
+    {
+        const auto from = junction_distribution(generator);
+        const auto to = junction_distribution(generator);
+        if (from == to)
+            continue;
+
+        auto last = from;
+        for (auto length = length_distribution(generator); length > 0; --length)
+        {
+            add_segment(last, number_of_nodes);
+            last = number_of_nodes++;
+        }
+        add_segment(last, to);
+    }
+
+    // Compresses the graph and writes the geometry like osrm-extract does, returns the edges of
+    // the compressed graph and the bytes of the .osrm.geometry file
+    const auto compress = [&]
+    {
+        GraphCompressor compressor;
+        std::vector<TurnRestriction> restrictions;
+        std::vector<NodeBasedEdgeAnnotation> annotations(1);
+        CompressedEdgeContainer container;
+        test::MockScriptingEnvironment scripting_environment;
+        std::vector<UnresolvedManeuverOverride> maneuver_overrides;
+
+        auto sorted_edges = edges;
+        std::sort(sorted_edges.begin(), sorted_edges.end());
+        Graph graph(number_of_nodes, sorted_edges);
+        compressor.Compress(
+            scripting_environment, restrictions, maneuver_overrides, graph, annotations, container);
+
+        std::vector<std::tuple<NodeID, NodeID, EdgeWeight>> compressed_edges;
+        for (const auto node_u : util::irange<NodeID>(0, graph.GetNumberOfNodes()))
+        {
+            for (const auto edge : graph.GetAdjacentEdgeRange(node_u))
+            {
+                const auto node_v = graph.GetTarget(edge);
+                compressed_edges.emplace_back(node_u, node_v, graph.GetEdgeData(edge).weight);
+                if (node_u < node_v)
+                    container.ZipEdges(edge, graph.FindEdge(node_v, node_u));
+            }
+        }
+
+        TemporaryFile tmp;
+        extractor::files::writeSegmentData(tmp.path, *container.ToSegmentData());
+        std::ifstream file(tmp.path, std::ios::binary);
+        return std::make_tuple(compressed_edges,
+                               std::string(std::istreambuf_iterator<char>(file), {}));
+    };
+
+    tbb::global_control control(tbb::global_control::max_allowed_parallelism, 8);
+    const auto [serial_edges, serial_geometry] = tbb::task_arena(1).execute(compress);
+    const auto [parallel_edges, parallel_geometry] = tbb::task_arena(8).execute(compress);
+
+    BOOST_CHECK_LT(serial_edges.size(), edges.size());
+    BOOST_CHECK(serial_edges == parallel_edges);
+    BOOST_CHECK_EQUAL(serial_geometry.size(), parallel_geometry.size());
+    BOOST_CHECK(serial_geometry == parallel_geometry);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
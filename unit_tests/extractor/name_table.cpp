@@ -15,12 +15,11 @@ BOOST_AUTO_TEST_SUITE(name_table)
 using namespace osrm;
 using namespace osrm::extractor;
 
-NameTable::IndexedData PrapareNameTableData(std::vector<std::string> &data, bool fill_all)
+void PrapareNameTableStrings(std::vector<std::string> &data,
+                             bool fill_all,
+                             std::vector<std::uint32_t> &name_offsets,
+                             std::vector<unsigned char> &name_char_data)
 {
-    NameTable::IndexedData indexed_data;
-    std::vector<unsigned char> name_char_data;
-    std::vector<std::uint32_t> name_offsets;
-
     for (auto s : data)
     {
         name_offsets.push_back(name_char_data.size());
@@ -55,6 +54,13 @@ NameTable::IndexedData PrapareNameTableData(std::vector<std::string> &data, bool
         }
     }
     name_offsets.push_back(name_char_data.size());
+}
+
+NameTable::IndexedData PrapareNameTableData(std::vector<std::string> &data, bool fill_all)
+{
+    std::vector<unsigned char> name_char_data;
+    std::vector<std::uint32_t> name_offsets;
+    PrapareNameTableStrings(data, fill_all, name_offsets, name_char_data);
 
     return NameTable::IndexedData(name_offsets.begin(), name_offsets.end(), name_char_data.begin());
 }
@@ -103,6 +109,57 @@ BOOST_AUTO_TEST_CASE(check_name_table_nofill)
     // CALLGRIND_STOP_INSTRUMENTATION;
 }
 
+BOOST_AUTO_TEST_CASE(check_compressed_name_table)
+{
+    std::vector<std::string> expected_names = {
+        "",     "A", "check_name", "ccc", "dDDd", "E", "ff", "ggg", "hhhh", "I", "jj", "",  "kkk",
+        "llll", "M", "nn",         "ooo", "pppp", "q", "r",  "S",   "T",    "",  "u",  "V", "W",
+        "X",    "Y", "Z",          "",    "",     "",  "",   "",    "",     "",  "0",  ""};
+    // bytes that have to be escaped
+    expected_names.push_back(std::string("\xff\0z", 3));
+
+    std::vector<unsigned char> name_char_data;
+    std::vector<std::uint32_t> name_offsets;
+    PrapareNameTableStrings(expected_names, true, name_offsets, name_char_data);
+
+    const auto name_table =
+        NameTable::MakeCompressed(name_offsets.begin(), name_offsets.end(), name_char_data.begin());
+    BOOST_CHECK(name_table.IsCompressed());
+
+    for (std::size_t index = 0; index < expected_names.size(); ++index)
+    {
+        const NameID id = 5 * index;
+        BOOST_CHECK_EQUAL(name_table.GetNameForID(id), expected_names[index]);
+        BOOST_CHECK_EQUAL(name_table.GetRefForID(id), expected_names[index] + "_ref");
+        BOOST_CHECK_EQUAL(name_table.GetDestinationsForID(id), expected_names[index] + "_des");
+        BOOST_CHECK_EQUAL(name_table.GetPronunciationForID(id), expected_names[index] + "_pro");
+        BOOST_CHECK_EQUAL(name_table.GetExitsForID(id), expected_names[index] + "_ext");
+    }
+    BOOST_CHECK_EQUAL(name_table.GetNameForID(INVALID_NAMEID), "");
+}
+
+BOOST_AUTO_TEST_CASE(check_compressed_name_table_without_symbols)
+{
+    // Nothing to train the symbol table on, the strings are stored plain
+    std::vector<std::string> expected_names(10, "");
+
+    std::vector<unsigned char> name_char_data;
+    std::vector<std::uint32_t> name_offsets;
+    PrapareNameTableStrings(expected_names, false, name_offsets, name_char_data);
+
+    const auto name_table =
+        NameTable::MakeCompressed(name_offsets.begin(), name_offsets.end(), name_char_data.begin());
+    BOOST_CHECK(!name_table.IsCompressed());
+
+    for (std::size_t index = 0; index < expected_names.size(); ++index)
+    {
+        const NameID id = 5 * index;
+        BOOST_CHECK(name_table.GetNameForID(id).empty());
+        BOOST_CHECK(name_table.GetRefForID(id).empty());
+        BOOST_CHECK(name_table.GetExitsForID(id).empty());
+    }
+}
+
 BOOST_AUTO_TEST_CASE(check_invalid_ids)
 {
     NameTable name_table;
@@ -0,0 +1,162 @@
+#include "extractor/files.hpp"
+#include "extractor/node_renumbering.hpp"
+
+#include "util/coordinate.hpp"
+#include "util/typedefs.hpp"
+
+#include "../common/temporary_file.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+
+BOOST_AUTO_TEST_SUITE(node_renumbering)
+
+using namespace osrm;
+using namespace osrm::extractor;
+
+namespace
+{
+EdgeBasedNodeSegment makeSegment(NodeID forward, NodeID reverse, NodeID u, NodeID v)
+{
+    return EdgeBasedNodeSegment{{forward, true},
+                                {reverse, reverse != SPECIAL_NODEID},
+                                u,
+                                v,
+                                0,
+                                true};
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(hilbert_permutation)
+{
+    // 0---1 ... 2---3, far apart from each other
+    std::vector<util::Coordinate> coordinates = {
+        {util::FloatLongitude{13.00}, util::FloatLatitude{52.00}},
+        {util::FloatLongitude{13.01}, util::FloatLatitude{52.00}},
+        {util::FloatLongitude{-70.00}, util::FloatLatitude{-30.00}},
+        {util::FloatLongitude{-70.01}, util::FloatLatitude{-30.00}}};
+
+    // Edge-based nodes 0 and 3 belong to the same compressed edge 0-1, 1 and 2 to 2-3.
+    // Node 4 has no segment, e.g. a duplicated via-way node.
+    std::vector<EdgeBasedNodeSegment> segments = {makeSegment(0, 3, 0, 1),
+                                                  makeSegment(1, 2, 2, 3)};
+
+    const auto permutation = makeHilbertPermutation(5, segments, coordinates);
+
+    BOOST_REQUIRE_EQUAL(permutation.size(), 5);
+
+    auto sorted = permutation;
+    std::sort(sorted.begin(), sorted.end());
+    for (std::uint32_t index = 0; index < sorted.size(); ++index)
+        BOOST_CHECK_EQUAL(sorted[index], index);
+
+    // forward and reverse node of a segment are neighbours
+    BOOST_CHECK_EQUAL(std::max(permutation[0], permutation[3]) -
+                          std::min(permutation[0], permutation[3]),
+                      1);
+    BOOST_CHECK_EQUAL(std::max(permutation[1], permutation[2]) -
+                          std::min(permutation[1], permutation[2]),
+                      1);
+    // nodes without segments go last
+    BOOST_CHECK_EQUAL(permutation[4], 4);
+
+    renumber(segments, permutation);
+    BOOST_CHECK_EQUAL(segments[0].forward_segment_id.id, permutation[0]);
+    BOOST_CHECK_EQUAL(segments[0].reverse_segment_id.id, permutation[3]);
+    BOOST_CHECK_EQUAL(segments[1].forward_segment_id.id, permutation[1]);
+    BOOST_CHECK_EQUAL(segments[1].reverse_segment_id.id, permutation[2]);
+}
+
+BOOST_AUTO_TEST_CASE(match_previous_node_ids)
+{
+    PackedOSMIDs previous_osm_node_ids;
+    for (const std::uint64_t id : {10, 20, 30, 40})
+        previous_osm_node_ids.push_back(OSMNodeID{id});
+    // 10<->20, oneway 20->30 and two parallel oneways 30->40 and one way back
+    const std::vector<NBGToEBG> previous_mapping = {
+        {0, 1, 0, 1}, {1, 2, 2, SPECIAL_NODEID}, {2, 3, 3, 4}, {2, 3, 5, SPECIAL_NODEID}};
+
+    // node 40 was deleted, node 50 added and the node-based nodes are ordered differently
+    PackedOSMIDs osm_node_ids;
+    for (const std::uint64_t id : {20, 10, 30, 50})
+        osm_node_ids.push_back(OSMNodeID{id});
+    const std::vector<NBGToEBG> mapping = {{1, 0, 2, 0}, {0, 2, 1, SPECIAL_NODEID}, {2, 3, 3, 4}};
+
+    const auto previous_ids =
+        matchPreviousNodeIDs(5, mapping, osm_node_ids, previous_mapping, previous_osm_node_ids);
+
+    BOOST_REQUIRE_EQUAL(previous_ids.size(), 5);
+    BOOST_CHECK_EQUAL(previous_ids[0], 1);
+    BOOST_CHECK_EQUAL(previous_ids[1], 2);
+    BOOST_CHECK_EQUAL(previous_ids[2], 0);
+    BOOST_CHECK_EQUAL(previous_ids[3], SPECIAL_NODEID);
+    BOOST_CHECK_EQUAL(previous_ids[4], SPECIAL_NODEID);
+
+    // the other nodes fill the free ids in the preferred order
+    const auto permutation = makeStablePermutation(previous_ids, {4, 3, 2, 1, 0});
+    const std::vector<std::uint32_t> expected = {1, 2, 0, 4, 3};
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        permutation.begin(), permutation.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(stable_permutation)
+{
+    // previous ids out of range can not be kept
+    const auto permutation = makeStablePermutation({7, 0, SPECIAL_NODEID}, {0, 1, 2});
+    const std::vector<std::uint32_t> expected = {1, 0, 2};
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        permutation.begin(), permutation.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(renumber_maneuver_overrides)
+{
+    const std::vector<std::uint32_t> permutation = {2, 0, 1};
+
+    std::vector<StorageManeuverOverride> maneuver_overrides(2);
+    maneuver_overrides[0].start_node = 0;
+    maneuver_overrides[1].start_node = 1;
+    std::vector<NodeID> node_sequences = {0, 1, 2};
+
+    renumber(maneuver_overrides, node_sequences, permutation);
+
+    // sorted by the new start node again
+    BOOST_CHECK_EQUAL(maneuver_overrides[0].start_node, 0);
+    BOOST_CHECK_EQUAL(maneuver_overrides[1].start_node, 2);
+    BOOST_CHECK_EQUAL(node_sequences[0], 2);
+    BOOST_CHECK_EQUAL(node_sequences[1], 0);
+    BOOST_CHECK_EQUAL(node_sequences[2], 1);
+}
+
+BOOST_AUTO_TEST_CASE(renumber_node_weights_roundtrip)
+{
+    TemporaryFile tmp;
+    const std::vector<std::uint32_t> permutation = {2, 0, 1};
+
+    std::vector<EdgeWeight> weights = {EdgeWeight{10}, EdgeWeight{20}, EdgeWeight{30}};
+    std::vector<EdgeDuration> durations = {EdgeDuration{1}, EdgeDuration{2}, EdgeDuration{3}};
+    std::vector<EdgeDistance> distances = {EdgeDistance{100}, EdgeDistance{200}, EdgeDistance{300}};
+
+    renumber(weights, durations, distances, permutation);
+    files::writeEdgeBasedNodeWeightsDurationsDistances(tmp.path, weights, durations, distances);
+
+    std::vector<EdgeWeight> read_weights;
+    std::vector<EdgeDuration> read_durations;
+    std::vector<EdgeDistance> read_distances;
+    files::readEdgeBasedNodeWeightsDurations(tmp.path, read_weights, read_durations);
+    files::readEdgeBasedNodeDistances(tmp.path, read_distances);
+
+    // old node 0 is now node 2
+    BOOST_REQUIRE_EQUAL(read_weights.size(), 3);
+    BOOST_REQUIRE_EQUAL(read_durations.size(), 3);
+    BOOST_REQUIRE_EQUAL(read_distances.size(), 3);
+    BOOST_CHECK_EQUAL(read_weights[2], EdgeWeight{10});
+    BOOST_CHECK_EQUAL(read_durations[2], EdgeDuration{1});
+    BOOST_CHECK_EQUAL(read_distances[2], EdgeDistance{100});
+    BOOST_CHECK_EQUAL(read_weights[0], EdgeWeight{20});
+    BOOST_CHECK_EQUAL(read_weights[1], EdgeWeight{30});
+    BOOST_CHECK_EQUAL(read_durations[1], EdgeDuration{3});
+    BOOST_CHECK_EQUAL(read_distances[0], EdgeDistance{200});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,170 @@
+#include "extractor/osm_change_merger.hpp"
+#include "util/exception.hpp"
+
+#include "../common/temporary_file.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <osmium/builder/attr.hpp>
+#include <osmium/io/any_input.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(osm_change_merger)
+
+using namespace osrm;
+using namespace osrm::extractor;
+using namespace osmium::builder::attr;
+
+namespace
+{
+osmium::memory::Buffer makeBuffer()
+{
+    return osmium::memory::Buffer{1024, osmium::memory::Buffer::auto_grow::yes};
+}
+
+// type letter, id and version of all objects, e.g. "n1v2"
+std::vector<std::string> objects(const std::vector<osmium::memory::Buffer> &buffers)
+{
+    std::vector<std::string> result;
+    for (const auto &buffer : buffers)
+    {
+        for (const auto &object : buffer.select<osmium::OSMObject>())
+        {
+            result.push_back(osmium::item_type_to_char(object.type()) +
+                             std::to_string(object.id()) + "v" +
+                             std::to_string(object.version()));
+        }
+    }
+    return result;
+}
+
+// osmium detects the file format from the suffix
+std::string temporaryPath(const std::string &suffix)
+{
+    return (std::filesystem::temp_directory_path() / (random_string(8) + suffix)).string();
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(merge_changes)
+{
+    std::vector<osmium::memory::Buffer> changes;
+    changes.push_back(makeBuffer());
+    osmium::builder::add_node(changes.back(), _id(2), _version(2));
+    osmium::builder::add_node(changes.back(), _id(4), _version(1));
+    osmium::builder::add_way(changes.back(), _id(10), _version(2), _nodes({1, 2, 4}));
+    osmium::builder::add_way(changes.back(), _id(30), _version(1), _nodes({4, 5}));
+    // a second change file with newer versions
+    changes.push_back(makeBuffer());
+    osmium::builder::add_node(changes.back(), _id(5), _version(1));
+    osmium::builder::add_node(changes.back(), _id(3), _version(2), _deleted());
+    osmium::builder::add_way(changes.back(), _id(10), _version(3), _nodes({1, 2}));
+
+    OSMChangeMerger merger(std::move(changes));
+    BOOST_CHECK_EQUAL(merger.GetNumberOfChanges(), 6);
+
+    std::vector<osmium::memory::Buffer> input;
+    input.push_back(makeBuffer());
+    osmium::builder::add_node(input.back(), _id(1), _version(1));
+    osmium::builder::add_node(input.back(), _id(2), _version(1));
+    osmium::builder::add_node(input.back(), _id(3), _version(1));
+    input.push_back(makeBuffer());
+    osmium::builder::add_way(input.back(), _id(10), _version(1), _nodes({1, 2, 3}));
+    osmium::builder::add_way(input.back(), _id(20), _version(1), _nodes({1, 3}));
+
+    merger.Rewind(osmium::osm_entity_bits::node | osmium::osm_entity_bits::way);
+    std::vector<osmium::memory::Buffer> output;
+    for (auto &buffer : input)
+        output.push_back(merger.Merge(std::move(buffer)));
+    output.push_back(merger.Tail());
+    BOOST_CHECK(!merger.Tail());
+
+    const std::vector<std::string> expected = {
+        "n1v1", "n2v2", "n4v1", "n5v1", "w10v3", "w20v1", "w30v1"};
+    const auto merged = objects(output);
+    BOOST_CHECK_EQUAL_COLLECTIONS(merged.begin(), merged.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(filter_entities)
+{
+    std::vector<osmium::memory::Buffer> changes;
+    changes.push_back(makeBuffer());
+    osmium::builder::add_node(changes.back(), _id(1), _version(2));
+    osmium::builder::add_relation(changes.back(), _id(7), _version(1));
+
+    OSMChangeMerger merger(std::move(changes));
+
+    merger.Rewind(osmium::osm_entity_bits::relation);
+    auto input = makeBuffer();
+    osmium::builder::add_relation(input, _id(8), _version(1));
+
+    std::vector<osmium::memory::Buffer> output;
+    output.push_back(merger.Merge(std::move(input)));
+    BOOST_CHECK(!merger.Tail());
+
+    const std::vector<std::string> expected = {"r7v1", "r8v1"};
+    const auto merged = objects(output);
+    BOOST_CHECK_EQUAL_COLLECTIONS(merged.begin(), merged.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(unsorted_input)
+{
+    std::vector<osmium::memory::Buffer> changes;
+    changes.push_back(makeBuffer());
+    osmium::builder::add_node(changes.back(), _id(1), _version(2));
+
+    OSMChangeMerger merger(std::move(changes));
+    merger.Rewind(osmium::osm_entity_bits::node | osmium::osm_entity_bits::way);
+
+    auto ways = makeBuffer();
+    osmium::builder::add_way(ways, _id(1), _version(1));
+    auto nodes = makeBuffer();
+    osmium::builder::add_node(nodes, _id(2), _version(1));
+
+    merger.Merge(std::move(ways));
+    BOOST_CHECK_THROW(merger.Merge(std::move(nodes)), util::exception);
+}
+
+BOOST_AUTO_TEST_CASE(read_changes_after_end_of_input)
+{
+    TemporaryFile input{temporaryPath(".osm")};
+    std::ofstream{input.path} << R"(<?xml version="1.0" encoding="UTF-8"?>
+<osm version="0.6">
+  <node id="1" version="1" lat="1.0" lon="1.0"/>
+  <node id="2" version="1" lat="1.0" lon="1.1"/>
+  <way id="10" version="1"><nd ref="1"/><nd ref="2"/></way>
+</osm>
+)";
+    // creates objects with IDs past the last ones of the input
+    TemporaryFile change{temporaryPath(".osc")};
+    std::ofstream{change.path} << R"(<?xml version="1.0" encoding="UTF-8"?>
+<osmChange version="0.6">
+  <create>
+    <node id="3" version="1" lat="1.0" lon="1.2"/>
+    <way id="20" version="1"><nd ref="2"/><nd ref="3"/></way>
+  </create>
+</osmChange>
+)";
+
+    OSMChangeMerger merger(std::vector<std::filesystem::path>{change.path});
+    BOOST_CHECK_EQUAL(merger.GetNumberOfChanges(), 2);
+
+    const auto entities = osmium::osm_entity_bits::node | osmium::osm_entity_bits::way;
+    osmium::io::Reader reader(osmium::io::File(input.path.string()), entities);
+    merger.Rewind(entities);
+
+    std::vector<osmium::memory::Buffer> output;
+    while (auto buffer = merger.Read(reader))
+        output.push_back(std::move(buffer));
+    // the pass is done, the reader is not read again
+    BOOST_CHECK(!merger.Read(reader));
+    reader.close();
+
+    const std::vector<std::string> expected = {"n1v1", "n2v1", "n3v1", "w10v1", "w20v1"};
+    const auto merged = objects(output);
+    BOOST_CHECK_EQUAL_COLLECTIONS(merged.begin(), merged.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,155 @@
+#include <boost/test/unit_test.hpp>
+
+#include "engine/algorithm.hpp"
+#include "engine/api/base_parameters.hpp"
+#include "engine/data_watchdog.hpp"
+#include "engine/datafacade/contiguous_internalmem_datafacade.hpp"
+#include "storage/shared_datatype.hpp"
+#include "storage/shared_memory.hpp"
+#include "storage/shared_monitor.hpp"
+#include "storage/storage.hpp"
+#include "storage/storage_config.hpp"
+#include "util/coordinate_calculation.hpp"
+
+#include "../common/temporary_file.hpp"
+
+#include <boost/interprocess/sync/scoped_lock.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+BOOST_AUTO_TEST_SUITE(traffic_updates)
+
+using namespace osrm;
+
+namespace
+{
+using Watchdog = engine::DataWatchdog<engine::routing_algorithms::mld::Algorithm,
+                                      engine::datafacade::ContiguousInternalMemoryDataFacade>;
+
+// Loads a data set into shared memory like osrm-datastore and removes it again
+struct SharedDataset
+{
+    SharedDataset(const std::string &base_path, std::string name_) : name(std::move(name_))
+    {
+        storage::Storage storage{storage::StorageConfig{base_path}};
+        storage.Run(-1, name, false);
+#ifdef __linux__
+        // osrm-datastore locks its memory, the test process does not need to
+        munlockall();
+#endif
+    }
+
+    ~SharedDataset()
+    {
+        storage::SharedMonitor<storage::SharedRegionRegister> monitor;
+        boost::interprocess::scoped_lock<
+            storage::SharedMonitor<storage::SharedRegionRegister>::mutex_type>
+            lock(monitor.get_mutex());
+        auto &shared_register = monitor.data();
+        for (const auto &region_name : {name + "/static", name + "/updatable"})
+        {
+            const auto id = shared_register.Find(region_name);
+            if (id == storage::SharedRegionRegister::INVALID_REGION_ID)
+                continue;
+
+            auto &region = shared_register.GetRegion(id);
+            storage::SharedMemory::Remove(region.shm_key);
+            shared_register.ReleaseKey(region.shm_key);
+            region = storage::SharedRegion{};
+        }
+    }
+
+    const std::string name;
+};
+
+struct TemporaryDirectory
+{
+    TemporaryDirectory() : path(std::filesystem::temp_directory_path() / random_string(8))
+    {
+        std::filesystem::create_directory(path);
+    }
+    ~TemporaryDirectory() { std::filesystem::remove_all(path); }
+
+    const std::filesystem::path path;
+};
+} // namespace
+
+BOOST_AUTO_TEST_CASE(publish_speed_updates)
+{
+    const SharedDataset dataset(OSRM_TEST_DATA_DIR "/mld/monaco.osrm",
+                                "traffic_updates_" + random_string(8));
+    const TemporaryDirectory updates;
+    const engine::api::BaseParameters params;
+
+    Watchdog watchdog(dataset.name, updates.path);
+    const auto old_facade = watchdog.Get(params);
+
+    // the first node that starts with a segment of some length that can be used forward
+    NodeID node = 0;
+    PackedGeometryID geometry_id = 0;
+    for (; node < old_facade->GetNumberOfNodes(); ++node)
+    {
+        geometry_id = old_facade->GetGeometryIndex(node).id;
+        const auto geometry = old_facade->GetUncompressedForwardGeometry(geometry_id);
+        if (old_facade->GetUncompressedForwardWeights(geometry_id).front() !=
+                INVALID_SEGMENT_WEIGHT &&
+            util::coordinate_calculation::greatCircleDistance(
+                old_facade->GetCoordinateOfNode(geometry[0]),
+                old_facade->GetCoordinateOfNode(geometry[1])) > 10.)
+            break;
+    }
+    BOOST_REQUIRE_LT(node, old_facade->GetNumberOfNodes());
+
+    const auto geometry = old_facade->GetUncompressedForwardGeometry(geometry_id);
+    const auto from = old_facade->GetOSMNodeIDOfNode(geometry[0]);
+    const auto to = old_facade->GetOSMNodeIDOfNode(geometry[1]);
+    const auto old_weight = old_facade->GetUncompressedForwardWeights(geometry_id).front();
+    const auto old_duration = old_facade->GetUncompressedForwardDurations(geometry_id).front();
+    const auto old_node_weight = old_facade->GetNodeWeight(node);
+    const auto old_node_duration = old_facade->GetNodeDuration(node);
+
+    // walking speed in both directions, written under a hidden name until it is complete
+    {
+        std::ofstream file(updates.path / ".speeds.csv");
+        file << from << "," << to << ",1\n" << to << "," << from << ",1\n";
+    }
+    std::filesystem::rename(updates.path / ".speeds.csv", updates.path / "speeds.csv");
+
+    auto new_facade = watchdog.Get(params);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+    while (new_facade == old_facade && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        new_facade = watchdog.Get(params);
+    }
+    BOOST_REQUIRE(new_facade != old_facade);
+    BOOST_CHECK(!std::filesystem::exists(updates.path / "speeds.csv"));
+
+    // the new generation has the updated weights and durations
+    BOOST_CHECK_GT(new_facade->GetUncompressedForwardWeights(geometry_id).front(), old_weight);
+    BOOST_CHECK_GT(new_facade->GetUncompressedForwardDurations(geometry_id).front(),
+                   old_duration);
+    BOOST_CHECK_EQUAL(new_facade->GetDatasourceName(
+                          new_facade->GetUncompressedForwardDatasources(geometry_id).front()),
+                      updates.path.filename().string());
+    BOOST_CHECK_GT(new_facade->GetNodeWeight(node), old_node_weight);
+    BOOST_CHECK_GT(new_facade->GetNodeDuration(node), old_node_duration);
+
+    // the previous generation is still readable and unchanged
+    BOOST_CHECK_EQUAL(old_facade->GetUncompressedForwardWeights(geometry_id).front(), old_weight);
+    BOOST_CHECK_EQUAL(old_facade->GetUncompressedForwardDurations(geometry_id).front(),
+                      old_duration);
+    BOOST_CHECK_EQUAL(old_facade->GetNodeWeight(node), old_node_weight);
+    BOOST_CHECK_EQUAL(old_facade->GetNodeDuration(node), old_node_duration);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -53,8 +53,7 @@ class MockBaseDataFacade : public engine::datafacade::BaseDataFacade
     NodeForwardRange GetUncompressedForwardGeometry(const EdgeID /* id */) const override
     {
         static NodeID data[] = {0, 1, 2, 3};
-        static extractor::SegmentDataView::SegmentNodeVector nodes(data, 4);
-        return std::ranges::subrange(nodes.cbegin(), nodes.cend());
+        return NodeForwardRange(data, data + 4);
     }
     NodeReverseRange GetUncompressedReverseGeometry(const EdgeID id) const override
     {
@@ -134,6 +133,28 @@ class MockBaseDataFacade : public engine::datafacade::BaseDataFacade
         return {};
     };
 
+    std::vector<std::vector<engine::PhantomNodeWithDistance>>
+    NearestPhantomNodesInRange(const std::vector<engine::SnappingQuery> &queries,
+                               const bool /*use_all_edges*/) const override
+    {
+        return std::vector<std::vector<engine::PhantomNodeWithDistance>>(queries.size());
+    };
+
+    std::vector<std::vector<engine::PhantomNodeWithDistance>>
+    NearestPhantomNodes(const std::vector<engine::SnappingQuery> &queries,
+                        const size_t /*max_results*/) const override
+    {
+        return std::vector<std::vector<engine::PhantomNodeWithDistance>>(queries.size());
+    };
+
+    std::vector<engine::PhantomCandidateAlternatives>
+    NearestCandidatesWithAlternativeFromBigComponent(
+        const std::vector<engine::SnappingQuery> &queries,
+        const bool /*use_all_edges*/) const override
+    {
+        return std::vector<engine::PhantomCandidateAlternatives>(queries.size());
+    };
+
     std::uint32_t GetCheckSum() const override { return 0; }
 
     extractor::TravelMode GetTravelMode(const NodeID /* id */) const override
@@ -150,11 +171,17 @@ class MockBaseDataFacade : public engine::datafacade::BaseDataFacade
 
     NameID GetNameIndex(const NodeID /* id */) const override { return 0; }
 
-    std::string_view GetNameForID(const NameID) const override final { return {}; }
-    std::string_view GetRefForID(const NameID) const override final { return {}; }
-    std::string_view GetPronunciationForID(const NameID) const override final { return {}; }
-    std::string_view GetDestinationsForID(const NameID) const override final { return {}; }
-    std::string_view GetExitsForID(const NameID) const override final { return {}; }
+    extractor::NameString GetNameForID(const NameID) const override final { return {}; }
+    extractor::NameString GetRefForID(const NameID) const override final { return {}; }
+    extractor::NameString GetPronunciationForID(const NameID) const override final
+    {
+        return {};
+    }
+    extractor::NameString GetDestinationsForID(const NameID) const override final
+    {
+        return {};
+    }
+    extractor::NameString GetExitsForID(const NameID) const override final { return {}; }
 
     bool GetContinueStraightDefault() const override { return true; }
     double GetMapMatchingMaxSpeed() const override { return 180 / 3.6; }
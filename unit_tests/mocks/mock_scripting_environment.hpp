@@ -31,6 +31,7 @@ class MockScriptingEnvironment : public extractor::ScriptingEnvironment
 
     std::vector<std::string> GetRestrictions() override final { return {}; }
     void ProcessTurn(extractor::ExtractionTurn &) override final {}
+    void ProcessTurns(std::vector<extractor::ExtractionTurn> &) override final {}
     void ProcessSegment(extractor::ExtractionSegment &) override final {}
 
     void ProcessElements(const osmium::memory::Buffer &,
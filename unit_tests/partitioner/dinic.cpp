@@ -71,6 +71,41 @@ BOOST_AUTO_TEST_CASE(horizontal_cut_between_two_grids)
     DinicMaxFlow flow;
     const auto cut = flow(view, sources, sinks);
     BOOST_CHECK(cut.num_edges == 4);
+
+    // the search gives up once the flow exceeds the bound
+    const DinicMaxFlow::FlowBound too_small{3};
+    BOOST_CHECK(!flow(view, sources, sinks, too_small));
+
+    const DinicMaxFlow::FlowBound exact{4};
+    const auto bounded_cut = flow(view, sources, sinks, exact);
+    BOOST_REQUIRE(bounded_cut);
+    BOOST_CHECK_EQUAL(bounded_cut->num_edges, 4);
+    BOOST_CHECK(bounded_cut->flags == cut.flags);
+}
+
+BOOST_AUTO_TEST_CASE(cut_with_parallel_level_graph)
+{
+    // wide enough for the BFS frontiers to be relaxed in parallel
+    const int rows = 6;
+    const int cols = DinicMaxFlow::PARALLEL_FRONTIER_SIZE + 10;
+
+    auto grid_edges = makeGridEdges(rows, cols, 0);
+    groupEdgesBySource(grid_edges.begin(), grid_edges.end());
+    const auto graph = makeBisectionGraph(makeGridCoordinates(rows, cols, 0.001, 0, 0),
+                                          adaptToBisectionEdge(std::move(grid_edges)));
+    BisectionGraphView view(graph);
+
+    // first two rows are sources, last two rows sinks
+    DinicMaxFlow::SourceSinkNodes sources, sinks;
+    for (int c = 0; c < 2 * cols; ++c)
+    {
+        sources.insert(static_cast<NodeID>(c));
+        sinks.insert(static_cast<NodeID>((rows - 2) * cols + c));
+    }
+
+    const auto cut = DinicMaxFlow()(view, sources, sinks);
+    BOOST_CHECK_EQUAL(cut.num_edges, cols);
+    BOOST_CHECK_EQUAL(cut.num_nodes_source, 2 * cols);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,76 @@
+#include "partitioner/multilevel_bisection.hpp"
+#include "partitioner/bisection_graph_view.hpp"
+#include "partitioner/graph_generator.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace osrm::partitioner;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_SUITE(multilevel_bisection)
+
+BOOST_AUTO_TEST_CASE(cut_long_grid)
+{
+    // large enough to be coarsened a few times
+    const int rows = 40;
+    const int cols = 100;
+
+    auto grid_edges = makeGridEdges(rows, cols, 0);
+    groupEdgesBySource(grid_edges.begin(), grid_edges.end());
+    const auto graph = makeBisectionGraph(makeGridCoordinates(rows, cols, 0.01, 0, 0),
+                                          adaptToBisectionEdge(std::move(grid_edges)));
+    BisectionGraphView view(graph);
+
+    const double balance = 1.2;
+    const auto cut = computeMultilevelCut(view, 10, balance);
+
+    BOOST_REQUIRE_EQUAL(cut.flags.size(), rows * cols);
+    BOOST_CHECK_EQUAL(cut.num_nodes_source, std::count(cut.flags.begin(), cut.flags.end(), true));
+
+    // within the balance of the inertial flow cut
+    const auto bigger_side = std::max(cut.num_nodes_source, rows * cols - cut.num_nodes_source);
+    BOOST_CHECK_LE(bigger_side, balance * (rows * cols / 2));
+
+    // a straight cut through the short side has `rows` edges
+    BOOST_CHECK_LE(cut.num_edges, rows + rows / 4);
+}
+
+BOOST_AUTO_TEST_CASE(cut_between_two_grids)
+{
+    const int rows = 20;
+    const int cols = 20;
+    const int size = rows * cols;
+
+    std::vector<Coordinate> grid_coordinates = makeGridCoordinates(rows, cols, 0.01, 0, 0);
+    const auto right_coordinates = makeGridCoordinates(rows, cols, 0.01, cols * 0.01, 0);
+    grid_coordinates.insert(
+        grid_coordinates.end(), right_coordinates.begin(), right_coordinates.end());
+
+    auto grid_edges = makeGridEdges(rows, cols, 0);
+    const auto right_edges = makeGridEdges(rows, cols, size);
+    grid_edges.insert(grid_edges.end(), right_edges.begin(), right_edges.end());
+
+    // connect the grids in a few places that don't line up spatially
+    for (const auto &[left, right] : {std::pair<NodeID, NodeID>{5, size + 390},
+                                     {105, size + 20},
+                                     {299, size + 250}})
+    {
+        grid_edges.push_back({left, right, 1});
+        grid_edges.push_back({right, left, 1});
+    }
+    groupEdgesBySource(grid_edges.begin(), grid_edges.end());
+    const auto graph = makeBisectionGraph(grid_coordinates,
+                                          adaptToBisectionEdge(std::move(grid_edges)));
+    BisectionGraphView view(graph);
+
+    const auto cut = computeMultilevelCut(view, 4, 1.1);
+    BOOST_CHECK_EQUAL(cut.num_edges, 3);
+    BOOST_CHECK_EQUAL(cut.num_nodes_source, size);
+    for (int node = 1; node < 2 * size; ++node)
+        BOOST_CHECK_EQUAL(cut.flags[node], cut.flags[node / size * size]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
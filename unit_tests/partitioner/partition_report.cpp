@@ -0,0 +1,87 @@
+#include "partitioner/partition_report.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace osrm;
+using namespace osrm::partitioner;
+
+namespace
+{
+// bidirectional path 0 - 1 - ... - (number_of_nodes - 1)
+auto makePath(const NodeID number_of_nodes)
+{
+    using InputEdge = DynamicEdgeBasedGraph::InputEdge;
+    std::vector<InputEdge> edges;
+    for (NodeID node = 0; node + 1 < number_of_nodes; ++node)
+    {
+        edges.push_back(InputEdge{
+            node, node + 1, EdgeBasedGraphEdgeData{SPECIAL_NODEID, {1}, {1}, {1}, true, false}});
+        edges.push_back(InputEdge{
+            node + 1, node, EdgeBasedGraphEdgeData{SPECIAL_NODEID, {1}, {1}, {1}, false, true}});
+        edges.push_back(InputEdge{
+            node + 1, node, EdgeBasedGraphEdgeData{SPECIAL_NODEID, {1}, {1}, {1}, true, false}});
+        edges.push_back(InputEdge{
+            node, node + 1, EdgeBasedGraphEdgeData{SPECIAL_NODEID, {1}, {1}, {1}, false, true}});
+    }
+    std::sort(edges.begin(), edges.end());
+    return DynamicEdgeBasedGraph(number_of_nodes, edges);
+}
+
+double number(const util::json::Object &object, const char *key)
+{
+    return std::get<util::json::Number>(object.values.at(key)).value;
+}
+
+const util::json::Object &object(const util::json::Object &object, const char *key)
+{
+    return std::get<util::json::Object>(object.values.at(key));
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(partition_report_tests)
+
+BOOST_AUTO_TEST_CASE(path_report)
+{
+    // node:                0  1  2  3  4  5  6  7
+    std::vector<CellID> l1{{0, 0, 1, 1, 2, 2, 3, 3}};
+    std::vector<CellID> l2{{0, 0, 0, 0, 1, 1, 1, 1}};
+    std::vector<CellID> l3{{0, 0, 0, 0, 0, 0, 0, 0}};
+    MultiLevelPartition mlp{{l1, l2, l3}, {4, 2, 1}};
+
+    const auto graph = makePath(8);
+    CellStorage storage(mlp, graph);
+
+    const auto report = makePartitionReport(mlp, storage, graph, 2, 50);
+
+    const auto &levels = std::get<util::json::Array>(report.values.at("levels")).values;
+    BOOST_REQUIRE_EQUAL(levels.size(), 3);
+
+    // the outer cells have one boundary node, the inner ones two
+    const auto &level_1 = std::get<util::json::Object>(levels[0]);
+    BOOST_CHECK_EQUAL(number(level_1, "cells"), 4);
+    BOOST_CHECK_EQUAL(number(object(level_1, "boundary_nodes"), "total"), 6);
+    BOOST_CHECK_EQUAL(number(object(level_1, "boundary_nodes"), "max"), 2);
+    BOOST_CHECK_EQUAL(number(object(level_1, "clique_arcs"), "total"), 1 + 4 + 4 + 1);
+
+    const auto &level_2 = std::get<util::json::Object>(levels[1]);
+    BOOST_CHECK_EQUAL(number(level_2, "cells"), 2);
+    BOOST_CHECK_EQUAL(number(object(level_2, "clique_arcs"), "total"), 2);
+
+    const auto &level_3 = std::get<util::json::Object>(levels[2]);
+    BOOST_CHECK_EQUAL(number(level_3, "cells"), 1);
+    BOOST_CHECK_EQUAL(number(object(level_3, "clique_arcs"), "total"), 0);
+
+    const auto bytes_per_entry = sizeof(EdgeWeight) + sizeof(EdgeDuration) + sizeof(EdgeDistance);
+    BOOST_CHECK_EQUAL(number(report, "cell_metrics_bytes"), 2 * bytes_per_entry * (10 + 2));
+
+    // all queries find their target and settle at most all nodes
+    const auto &queries = object(report, "queries");
+    BOOST_CHECK_EQUAL(number(queries, "unreachable"), 0);
+    BOOST_CHECK_GE(number(object(queries, "settled_nodes"), "min"), 1);
+    BOOST_CHECK_LE(number(object(queries, "settled_nodes"), "max"), 8);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
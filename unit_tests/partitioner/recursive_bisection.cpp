@@ -12,59 +12,58 @@ using namespace osrm::util;
 
 BOOST_AUTO_TEST_SUITE(recursive_bisection)
 
-BOOST_AUTO_TEST_CASE(dividing_four_grid_cells)
+namespace
+{
+// 40 entries of left/right edges
+const double step_size = 0.01;
+const int rows = 10;
+const int cols = 10;
+const int cut_edges = 4;
+
+BisectionGraph makeFourGridCells()
 {
-    // 40 entries of left/right edges
-    const double step_size = 0.01;
-    const int rows = 10;
-    const int cols = 10;
-    const int cut_edges = 4;
+    std::vector<Coordinate> grid_coordinates;
+    std::vector<EdgeWithSomeAdditionalData> grid_edges;
 
-    auto graph = [&]()
+    const auto connect = [&grid_edges](int min_left, int max_left, int min_right, int max_right)
     {
-        std::vector<Coordinate> grid_coordinates;
-        std::vector<EdgeWithSomeAdditionalData> grid_edges;
-
-        const auto connect = [&grid_edges](int min_left, int max_left, int min_right, int max_right)
-        {
-            const NodeID source = (rand() % (max_left - min_left)) + min_left;
-            const NodeID target = (rand() % (max_right - min_right)) + min_right;
-
-            grid_edges.push_back({source, target, 1});
-            grid_edges.push_back({target, source, 1});
-        };
-
-        // generate 10 big components
-        for (int i = 0; i < 4; ++i)
-        {
-            // 10 rows of large components, interrupted by small disconnected components
-            const auto coordinates = makeGridCoordinates(
-                rows, cols, step_size, cols * (i % 2), (i * rows / 2) * step_size);
-            grid_coordinates.insert(grid_coordinates.end(), coordinates.begin(), coordinates.end());
-
-            // connect the grid edges, starting with i * (rows * cols + 1) as first id (0,11,22...)
-            const auto edges = makeGridEdges(rows, cols, i * (rows * cols));
-            grid_edges.insert(grid_edges.end(), edges.begin(), edges.end());
-        }
-
-        // add cut edges between neighboring cells
-        int n = rows * cols;
-        for (int i = 0; i < cut_edges; ++i)
-        {
-            // left/right
-            connect(0, n, n, 2 * n);
-            connect(2 * n, 3 * n, 3 * n, 4 * n);
-            // top/bottom
-            connect(0, n, 2 * n, 3 * n);
-            connect(n, 2 * n, 3 * n, 4 * n);
-        }
-        groupEdgesBySource(grid_edges.begin(), grid_edges.end());
-        return makeBisectionGraph(grid_coordinates, adaptToBisectionEdge(std::move(grid_edges)));
-    }();
+        const NodeID source = (rand() % (max_left - min_left)) + min_left;
+        const NodeID target = (rand() % (max_right - min_right)) + min_right;
 
-    RecursiveBisection bisection(graph, 120, 1.1, 0.25, 10, 1);
+        grid_edges.push_back({source, target, 1});
+        grid_edges.push_back({target, source, 1});
+    };
+
+    // generate 10 big components
+    for (int i = 0; i < 4; ++i)
+    {
+        // 10 rows of large components, interrupted by small disconnected components
+        const auto coordinates = makeGridCoordinates(
+            rows, cols, step_size, cols * (i % 2), (i * rows / 2) * step_size);
+        grid_coordinates.insert(grid_coordinates.end(), coordinates.begin(), coordinates.end());
+
+        // connect the grid edges, starting with i * (rows * cols + 1) as first id (0,11,22...)
+        const auto edges = makeGridEdges(rows, cols, i * (rows * cols));
+        grid_edges.insert(grid_edges.end(), edges.begin(), edges.end());
+    }
+
+    // add cut edges between neighboring cells
+    int n = rows * cols;
+    for (int i = 0; i < cut_edges; ++i)
+    {
+        // left/right
+        connect(0, n, n, 2 * n);
+        connect(2 * n, 3 * n, 3 * n, 4 * n);
+        // top/bottom
+        connect(0, n, 2 * n, 3 * n);
+        connect(n, 2 * n, 3 * n, 4 * n);
+    }
+    groupEdgesBySource(grid_edges.begin(), grid_edges.end());
+    return makeBisectionGraph(grid_coordinates, adaptToBisectionEdge(std::move(grid_edges)));
+}
 
-    const auto &result = bisection.BisectionIDs();
+void checkFourGridCells(const std::vector<BisectionID> &result)
+{
     // all same IDs withing a group
     for (int i = 0; i < 4; ++i)
         for (int j = 0; j < rows * cols; ++j)
@@ -75,5 +74,21 @@ BOOST_AUTO_TEST_CASE(dividing_four_grid_cells)
         for (int j = 0; j < 4; ++j)
             BOOST_CHECK(i == j || result[i * (rows * cols)] != result[j * (rows * cols)]);
 }
+} // namespace
+
+BOOST_AUTO_TEST_CASE(dividing_four_grid_cells)
+{
+    auto graph = makeFourGridCells();
+    RecursiveBisection bisection(graph, 120, 1.1, 0.25, 10, 1);
+    checkFourGridCells(bisection.BisectionIDs());
+}
+
+BOOST_AUTO_TEST_CASE(dividing_four_grid_cells_multilevel)
+{
+    auto graph = makeFourGridCells();
+    RecursiveBisection bisection(
+        graph, 120, 1.1, 0.25, 10, 1, PartitionerConfig::BisectionAlgorithm::Multilevel);
+    checkFourGridCells(bisection.BisectionIDs());
+}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,151 @@
+#include "updater/csv_file_parser.hpp"
+#include "updater/csv_source.hpp"
+
+#include "util/exception.hpp"
+
+#include "../common/temporary_file.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(csv_source)
+
+using namespace osrm;
+using namespace osrm::updater;
+
+namespace
+{
+std::string writeFile(const TemporaryFile &file, const std::string &content)
+{
+    std::ofstream out(file.path, std::ios::binary);
+    out << content;
+    return file.path.string();
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(read_segment_values)
+{
+    TemporaryFile first_file;
+    const auto first = writeFile(first_file,
+                                 "1,2,50\n"
+                                 "2,3,30.5,0.8\n"
+                                 "3,4,20,,blank rate\r\n"
+                                 "4,5,10,1.5,comment, with separator\n"
+                                 "\n");
+    TemporaryFile second_file;
+    const auto second = writeFile(second_file, "2,1,5\n1,2,60");
+
+    const auto lookup = csv::readSegmentValues({first, second});
+    BOOST_CHECK_EQUAL(lookup.lookup.size(), 5);
+
+    // the later file takes precedence
+    BOOST_REQUIRE(lookup({1, 2}));
+    BOOST_CHECK_EQUAL(lookup({1, 2})->speed, 60);
+    BOOST_CHECK_EQUAL(lookup({1, 2})->source, 2);
+    BOOST_CHECK(!lookup({1, 2})->rate);
+
+    BOOST_REQUIRE(lookup({2, 3}));
+    BOOST_CHECK_EQUAL(lookup({2, 3})->speed, 30.5);
+    BOOST_CHECK_EQUAL(*lookup({2, 3})->rate, 0.8);
+    BOOST_CHECK_EQUAL(lookup({2, 3})->source, 1);
+
+    BOOST_REQUIRE(lookup({3, 4}));
+    BOOST_REQUIRE(lookup({3, 4})->rate);
+    BOOST_CHECK(std::isnan(*lookup({3, 4})->rate));
+
+    BOOST_REQUIRE(lookup({4, 5}));
+    BOOST_CHECK_EQUAL(*lookup({4, 5})->rate, 1.5);
+
+    BOOST_CHECK(!lookup({5, 6}));
+}
+
+BOOST_AUTO_TEST_CASE(read_turn_values)
+{
+    TemporaryFile file;
+    const auto path = writeFile(file,
+                                "1,2,3,-5.5\n"
+                                "3,2,1,+7,2.5\n"
+                                "4,5,6,1,comment\n");
+
+    const auto lookup = csv::readTurnValues({path});
+    BOOST_CHECK_EQUAL(lookup.lookup.size(), 3);
+
+    BOOST_REQUIRE(lookup({1, 2, 3}));
+    BOOST_CHECK_EQUAL(lookup({1, 2, 3})->duration, -5.5);
+    BOOST_CHECK(std::isnan(lookup({1, 2, 3})->weight));
+
+    BOOST_REQUIRE(lookup({3, 2, 1}));
+    BOOST_CHECK_EQUAL(lookup({3, 2, 1})->duration, 7);
+    BOOST_CHECK_EQUAL(lookup({3, 2, 1})->weight, 2.5);
+
+    BOOST_REQUIRE(lookup({4, 5, 6}));
+    BOOST_CHECK(std::isnan(lookup({4, 5, 6})->weight));
+}
+
+BOOST_AUTO_TEST_CASE(malformed_lines)
+{
+    TemporaryFile negative_speed_file;
+    const auto negative_speed = writeFile(negative_speed_file, "1,2,50\n2,3,-30\n");
+    BOOST_CHECK_THROW(csv::readSegmentValues({negative_speed}), util::exception);
+
+    TemporaryFile missing_value_file;
+    const auto missing_value = writeFile(missing_value_file, "1,2\n");
+    BOOST_CHECK_THROW(csv::readSegmentValues({missing_value}), util::exception);
+
+    TemporaryFile garbage_file;
+    const auto garbage = writeFile(garbage_file, "1,2,3,4x\n");
+    BOOST_CHECK_THROW(csv::readTurnValues({garbage}), util::exception);
+
+    try
+    {
+        csv::readSegmentValues({negative_speed});
+        BOOST_ERROR("expected an exception");
+    }
+    catch (const util::exception &e)
+    {
+        BOOST_CHECK(std::string(e.what()).find("malformed on line 2") != std::string::npos);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(parse_chunks)
+{
+    // larger than a chunk to be split on line boundaries
+    std::string content;
+    std::size_t lines = 0;
+    while (content.size() < 3 * CSVFilesParser<Segment, SpeedSource>::CHUNK_SIZE)
+    {
+        content += std::to_string(lines) + "," + std::to_string(lines + 1) + "," +
+                   std::to_string(lines % 100) + ",1.25,some comment to make the line longer\n";
+        ++lines;
+    }
+    TemporaryFile file;
+    const auto path = writeFile(file, content);
+
+    const auto lookup = csv::readSegmentValues({path});
+    BOOST_REQUIRE_EQUAL(lookup.lookup.size(), lines);
+    for (std::size_t line = 0; line < lines; ++line)
+    {
+        const auto value = lookup({line, line + 1});
+        BOOST_REQUIRE(value);
+        BOOST_CHECK_EQUAL(value->speed, line % 100);
+    }
+
+    content += "1,2,3,4,5\n1,2,x\n";
+    TemporaryFile malformed_file;
+    const auto malformed = writeFile(malformed_file, content);
+    try
+    {
+        csv::readSegmentValues({malformed});
+        BOOST_ERROR("expected an exception");
+    }
+    catch (const util::exception &e)
+    {
+        const auto expected = "malformed on line " + std::to_string(lines + 2);
+        BOOST_CHECK(std::string(e.what()).find(expected) != std::string::npos);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,85 @@
+#include "updater/csv_source.hpp"
+#include "updater/edge_weight.hpp"
+#include "updater/speed_conversion.hpp"
+
+#include "../common/temporary_file.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <tuple>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(edge_weight)
+
+using namespace osrm;
+using namespace osrm::updater;
+
+BOOST_AUTO_TEST_CASE(apply_speed_file)
+{
+    TemporaryFile speeds;
+    {
+        std::ofstream out(speeds.path);
+        out << "1,2,36\n"
+               "2,3,18,2\n"
+               "3,4,0\n";
+    }
+    const auto lookup = csv::readSegmentValues({speeds.path.string()});
+
+    struct Segment
+    {
+        OSMNodeID::value_type from;
+        OSMNodeID::value_type to;
+        double distance;
+    };
+    const auto update = [&](const std::vector<Segment> &segments)
+    {
+        std::vector<SegmentWeight> weights;
+        std::vector<SegmentDuration> durations;
+        for (const auto &segment : segments)
+        {
+            const auto value = lookup({segment.from, segment.to});
+            BOOST_REQUIRE(value);
+            weights.push_back(convertToWeight(10., SegmentWeight{1}, *value, segment.distance));
+            durations.push_back(convertToDuration(value->speed, segment.distance));
+        }
+        return sumSegments(weights, durations);
+    };
+
+    // 100m at 10m/s and 50m at 5m/s with a rate of 2m/s
+    const auto [weight, duration] = update({{1, 2, 100.}, {2, 3, 50.}});
+    BOOST_CHECK_EQUAL(weight, EdgeWeight{100 + 250});
+    BOOST_CHECK_EQUAL(duration, EdgeDuration{100 + 100});
+
+    TurnPenalty turn_penalty{20};
+    BOOST_CHECK_EQUAL(computeEdgeWeight(weight, turn_penalty, EdgeWeight{3}), EdgeWeight{370});
+    BOOST_CHECK_EQUAL(turn_penalty, TurnPenalty{20});
+
+    // a segment with zero speed blocks the whole node
+    const auto blocked_weight = std::get<0>(update({{2, 3, 50.}, {3, 4, 10.}}));
+    BOOST_CHECK_EQUAL(blocked_weight, INVALID_EDGE_WEIGHT);
+    BOOST_CHECK_EQUAL(computeEdgeWeight(blocked_weight, turn_penalty, EdgeWeight{3}),
+                      INVALID_EDGE_WEIGHT);
+}
+
+BOOST_AUTO_TEST_CASE(clamp_edge_weight)
+{
+    // too negative turn penalties are raised
+    TurnPenalty turn_penalty{-5};
+    BOOST_CHECK_EQUAL(computeEdgeWeight(EdgeWeight{2}, turn_penalty, EdgeWeight{3}),
+                      EdgeWeight{3});
+    BOOST_CHECK_EQUAL(turn_penalty, TurnPenalty{1});
+
+    // otherwise the node weight is raised
+    turn_penalty = TurnPenalty{2};
+    BOOST_CHECK_EQUAL(computeEdgeWeight(EdgeWeight{0}, turn_penalty, EdgeWeight{3}),
+                      EdgeWeight{5});
+    BOOST_CHECK_EQUAL(turn_penalty, TurnPenalty{2});
+
+    turn_penalty = TurnPenalty{-1};
+    BOOST_CHECK_EQUAL(computeEdgeWeight(EdgeWeight{5}, turn_penalty, EdgeWeight{3}),
+                      EdgeWeight{4});
+    BOOST_CHECK_EQUAL(turn_penalty, TurnPenalty{-1});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,128 @@
+#include "updater/csv_source.hpp"
+#include "updater/files.hpp"
+
+#include "util/exception.hpp"
+
+#include "../common/temporary_file.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(files)
+
+using namespace osrm;
+using namespace osrm::updater;
+
+namespace
+{
+SegmentSpeedRecord makeSpeed(std::uint64_t from, std::uint64_t to, double speed)
+{
+    SegmentSpeedRecord record{};
+    record.from = from;
+    record.to = to;
+    record.speed = speed;
+    return record;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(read_write_segment_speeds)
+{
+    auto with_rate = makeSpeed(2, 3, 30);
+    with_rate.rate = 7.5;
+    with_rate.has_rate = true;
+    auto keep_weight = makeSpeed(3, 4, 20);
+    keep_weight.rate = std::numeric_limits<double>::quiet_NaN();
+    keep_weight.has_rate = true;
+    const std::vector<SegmentSpeedRecord> records = {
+        makeSpeed(1, 2, 50), with_rate, keep_weight, makeSpeed(5, 1, 10)};
+
+    TemporaryFile file;
+    const auto path = file.path.string();
+    updater::files::writeTrafficFile(path, records);
+    BOOST_CHECK(updater::files::isTrafficFile(path));
+
+    const auto lookup = csv::readSegmentValues({path});
+    BOOST_REQUIRE_EQUAL(lookup.lookup.size(), records.size());
+
+    BOOST_REQUIRE(lookup({1, 2}));
+    BOOST_CHECK_EQUAL(lookup({1, 2})->speed, 50);
+    BOOST_CHECK(!lookup({1, 2})->rate);
+    BOOST_CHECK_EQUAL(lookup({1, 2})->source, 1);
+
+    BOOST_REQUIRE(lookup({2, 3}));
+    BOOST_CHECK_EQUAL(*lookup({2, 3})->rate, 7.5);
+
+    BOOST_REQUIRE(lookup({3, 4}));
+    BOOST_REQUIRE(lookup({3, 4})->rate);
+    BOOST_CHECK(std::isnan(*lookup({3, 4})->rate));
+
+    BOOST_REQUIRE(lookup({5, 1}));
+    BOOST_CHECK_EQUAL(lookup({5, 1})->speed, 10);
+
+    BOOST_CHECK(!lookup({2, 1}));
+}
+
+BOOST_AUTO_TEST_CASE(mixed_inputs)
+{
+    TemporaryFile binary_file;
+    const auto binary = binary_file.path.string();
+    updater::files::writeTrafficFile(
+        binary, std::vector<SegmentSpeedRecord>{makeSpeed(1, 2, 50), makeSpeed(2, 3, 30)});
+
+    TemporaryFile csv_file;
+    const auto csv = csv_file.path.string();
+    {
+        std::ofstream out(csv);
+        out << "2,3,60\n4,5,70\n";
+    }
+    BOOST_CHECK(!updater::files::isTrafficFile(csv));
+
+    // the later file takes precedence regardless of the format
+    const auto lookup = csv::readSegmentValues({binary, csv});
+    BOOST_REQUIRE_EQUAL(lookup.lookup.size(), 3);
+    BOOST_CHECK_EQUAL(lookup({1, 2})->source, 1);
+    BOOST_CHECK_EQUAL(lookup({2, 3})->speed, 60);
+    BOOST_CHECK_EQUAL(lookup({2, 3})->source, 2);
+    BOOST_CHECK_EQUAL(lookup({4, 5})->source, 2);
+
+    const auto reversed = csv::readSegmentValues({csv, binary});
+    BOOST_CHECK_EQUAL(reversed({2, 3})->speed, 30);
+    BOOST_CHECK_EQUAL(reversed({2, 3})->source, 2);
+}
+
+BOOST_AUTO_TEST_CASE(read_write_turn_penalties)
+{
+    TurnPenaltyRecord with_weight{};
+    with_weight.from = 1;
+    with_weight.via = 2;
+    with_weight.to = 3;
+    with_weight.duration = -1.5;
+    with_weight.weight = 4;
+    TurnPenaltyRecord without_weight{};
+    without_weight.from = 3;
+    without_weight.via = 2;
+    without_weight.to = 1;
+    without_weight.duration = 2;
+    without_weight.weight = std::numeric_limits<double>::quiet_NaN();
+
+    TemporaryFile file;
+    const auto path = file.path.string();
+    updater::files::writeTrafficFile(path,
+                                     std::vector<TurnPenaltyRecord>{with_weight, without_weight});
+
+    const auto lookup = csv::readTurnValues({path});
+    BOOST_REQUIRE_EQUAL(lookup.lookup.size(), 2);
+    BOOST_REQUIRE(lookup({1, 2, 3}));
+    BOOST_CHECK_EQUAL(lookup({1, 2, 3})->duration, -1.5);
+    BOOST_CHECK_EQUAL(lookup({1, 2, 3})->weight, 4);
+    BOOST_REQUIRE(lookup({3, 2, 1}));
+    BOOST_CHECK(std::isnan(lookup({3, 2, 1})->weight));
+
+    // a turn penalty file is no segment speed file
+    BOOST_CHECK_THROW(csv::readSegmentValues({path}), util::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
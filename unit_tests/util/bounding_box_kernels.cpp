@@ -0,0 +1,106 @@
+#include "util/bounding_box_kernels.hpp"
+#include "util/rectangle.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(bounding_box_kernels_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+namespace
+{
+struct RandomBoxes
+{
+    explicit RandomBoxes(const std::size_t count)
+    {
+        std::mt19937 generator(42);
+        // projected coordinates are in [-180, 180] degrees on both axes
+        const auto max_position = static_cast<std::int32_t>(180 * COORDINATE_PRECISION);
+        std::uniform_int_distribution<std::int32_t> position(-max_position, max_position);
+        std::uniform_int_distribution<std::int32_t> extent(0, COORDINATE_PRECISION);
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            const auto lon = position(generator);
+            const auto lat = position(generator);
+            min_lons.push_back(lon);
+            max_lons.push_back(lon + extent(generator));
+            min_lats.push_back(lat);
+            max_lats.push_back(lat + extent(generator));
+        }
+    }
+
+    RectangleInt2D operator[](const std::size_t index) const
+    {
+        return RectangleInt2D{FixedLongitude{min_lons[index]},
+                              FixedLongitude{max_lons[index]},
+                              FixedLatitude{min_lats[index]},
+                              FixedLatitude{max_lats[index]}};
+    }
+
+    std::vector<std::int32_t> min_lons, max_lons, min_lats, max_lats;
+};
+} // namespace
+
+BOOST_AUTO_TEST_CASE(min_squared_distances)
+{
+    const RandomBoxes boxes(64);
+    const std::vector<Coordinate> locations = {
+        Coordinate{FixedLongitude{0}, FixedLatitude{0}},
+        Coordinate{FloatLongitude{-180.}, FloatLatitude{180.}},
+        // inside of the first box
+        boxes[0].Centroid()};
+
+    for (const auto location : locations)
+    {
+        // all remainders of the vectorized loops
+        for (std::size_t count = 0; count <= 64; ++count)
+        {
+            std::vector<std::uint64_t> distances(count);
+            bounding_box_kernels::minSquaredDistances(boxes.min_lons.data(),
+                                                      boxes.max_lons.data(),
+                                                      boxes.min_lats.data(),
+                                                      boxes.max_lats.data(),
+                                                      count,
+                                                      location,
+                                                      distances.data());
+
+            for (std::size_t index = 0; index < count; ++index)
+                BOOST_CHECK_EQUAL(distances[index], boxes[index].GetMinSquaredDist(location));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(intersecting_boxes)
+{
+    const RandomBoxes boxes(64);
+    const std::vector<RectangleInt2D> queries = {
+        RectangleInt2D{
+            FloatLongitude{-90.}, FloatLongitude{90.}, FloatLatitude{-90.}, FloatLatitude{90.}},
+        boxes[3],
+        RectangleInt2D{FixedLongitude{0}, FixedLongitude{1}, FixedLatitude{0}, FixedLatitude{1}}};
+
+    for (const auto &query : queries)
+    {
+        for (std::size_t count = 0; count <= 64; ++count)
+        {
+            const auto mask = bounding_box_kernels::intersectingBoxes(boxes.min_lons.data(),
+                                                                      boxes.max_lons.data(),
+                                                                      boxes.min_lats.data(),
+                                                                      boxes.max_lats.data(),
+                                                                      count,
+                                                                      query);
+
+            for (std::size_t index = 0; index < 64; ++index)
+            {
+                const bool expected = index < count && boxes[index].Intersects(query);
+                BOOST_CHECK_EQUAL(((mask >> index) & 1) == 1, expected);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
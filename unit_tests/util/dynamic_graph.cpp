@@ -158,4 +158,54 @@ BOOST_AUTO_TEST_CASE(filter_test)
                       filtered_simple_graph.FindEdge(4, 1));
 }
 
+BOOST_AUTO_TEST_CASE(insert_edges_test)
+{
+    /*
+     *  (0) -1-> (1)
+     *  ^ ^
+     *  2 5
+     *  | |
+     *  (3) -3-> (4)
+     *      <-4-
+     */
+    std::vector<TestInputEdge> input_edges = {TestInputEdge{0, 1, TestData{1}},
+                                              TestInputEdge{3, 0, TestData{2}},
+                                              TestInputEdge{3, 0, TestData{5}},
+                                              TestInputEdge{3, 4, TestData{3}},
+                                              TestInputEdge{4, 3, TestData{4}}};
+    TestDynamicGraph simple_graph(5, input_edges);
+
+    // free space after the edges of 3
+    simple_graph.DeleteEdgesTo(3, 4);
+
+    std::vector<TestInputEdge> new_edges = {TestInputEdge{0, 4, TestData{6}},
+                                            TestInputEdge{0, 3, TestData{7}},
+                                            TestInputEdge{2, 1, TestData{8}},
+                                            TestInputEdge{3, 1, TestData{9}},
+                                            TestInputEdge{4, 0, TestData{10}}};
+    simple_graph.InsertEdges(new_edges);
+
+    BOOST_CHECK_EQUAL(simple_graph.GetNumberOfEdges(), 9);
+    BOOST_CHECK_EQUAL(simple_graph.GetOutDegree(0), 3);
+    BOOST_CHECK_EQUAL(simple_graph.GetOutDegree(1), 0);
+    BOOST_CHECK_EQUAL(simple_graph.GetOutDegree(2), 1);
+    BOOST_CHECK_EQUAL(simple_graph.GetOutDegree(3), 3);
+    BOOST_CHECK_EQUAL(simple_graph.GetOutDegree(4), 2);
+
+    const std::vector<std::tuple<NodeID, NodeID, EdgeID>> expected_edges = {{0, 1, 1},
+                                                                            {0, 4, 6},
+                                                                            {0, 3, 7},
+                                                                            {2, 1, 8},
+                                                                            {3, 1, 9},
+                                                                            {4, 3, 4},
+                                                                            {4, 0, 10}};
+    for (const auto &[source, target, id] : expected_edges)
+    {
+        const auto edge = simple_graph.FindEdge(source, target);
+        BOOST_REQUIRE(edge != SPECIAL_EDGEID);
+        BOOST_CHECK_EQUAL(simple_graph.GetEdgeData(edge).id, id);
+    }
+    BOOST_CHECK_EQUAL(simple_graph.FindEdge(3, 4), SPECIAL_EDGEID);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
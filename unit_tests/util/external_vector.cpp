@@ -0,0 +1,84 @@
+#include "util/external_vector.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(external_vector_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+namespace
+{
+std::vector<int> collect(ExternalVector<int> &vector)
+{
+    std::vector<int> values;
+    vector.for_each([&](const int value) { values.push_back(value); });
+    return values;
+}
+
+std::size_t countSpillFiles()
+{
+    const auto directory = std::filesystem::temp_directory_path();
+    return std::count_if(std::filesystem::directory_iterator(directory),
+                         std::filesystem::directory_iterator(),
+                         [](const auto &entry)
+                         { return entry.path().filename().string().rfind("osrm-spill-", 0) == 0; });
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(sort_in_memory)
+{
+    ExternalVector<int> vector;
+    for (const auto value : {3, 1, 2})
+        vector.push_back(value);
+
+    vector.sort(std::less<>());
+    BOOST_CHECK(!vector.spilled());
+    BOOST_CHECK_EQUAL(vector.size(), 3);
+    const auto values = collect(vector);
+    const std::vector<int> reference = {1, 2, 3};
+    BOOST_CHECK_EQUAL_COLLECTIONS(values.begin(), values.end(), reference.begin(), reference.end());
+}
+
+BOOST_AUTO_TEST_CASE(sort_spilled)
+{
+    const auto spill_files = countSpillFiles();
+    {
+        // chunks of 100 records
+        ExternalVector<int> vector(std::filesystem::temp_directory_path(), 100 * sizeof(int));
+        std::mt19937 generator(1337);
+        std::vector<int> reference;
+        for (int index = 0; index < 1050; ++index)
+        {
+            reference.push_back(generator() % 500);
+            vector.push_back(reference.back());
+        }
+        BOOST_CHECK(vector.spilled());
+        BOOST_CHECK_EQUAL(vector.size(), reference.size());
+
+        vector.sort(std::less<>());
+        std::sort(reference.begin(), reference.end());
+        auto values = collect(vector);
+        BOOST_CHECK_EQUAL(vector.size(), reference.size());
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            values.begin(), values.end(), reference.begin(), reference.end());
+
+        // changes made while visiting are kept and can be sorted again
+        vector.for_each([](int &value) { value = -value; });
+        vector.sort(std::less<>());
+        std::transform(reference.begin(), reference.end(), reference.begin(), std::negate<>());
+        std::reverse(reference.begin(), reference.end());
+        values = collect(vector);
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            values.begin(), values.end(), reference.begin(), reference.end());
+    }
+    BOOST_CHECK_EQUAL(countSpillFiles(), spill_files);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -232,9 +232,10 @@ auto make_rtree(const std::filesystem::path &path, FixtureT &fixture)
 }
 
 template <typename RTreeT = TestStaticRTree, typename FixtureT>
-void construction_test(const std::string &path, FixtureT &fixture)
+void construction_test(FixtureT &fixture)
 {
-    auto rtree = make_rtree<RTreeT>(path, fixture);
+    TemporaryFile tmp;
+    auto rtree = make_rtree<RTreeT>(tmp.path, fixture);
     LinearSearchNN<TestData> lsnn(fixture.coords, fixture.edges);
 
     simple_verify_rtree(rtree, fixture.coords, fixture.edges);
@@ -244,32 +245,32 @@ void construction_test(const std::string &path, FixtureT &fixture)
 BOOST_FIXTURE_TEST_CASE(construct_tiny, TestRandomGraphFixture_10_30)
 {
     using TinyTestTree = StaticRTree<TestData, osrm::storage::Ownership::Container, 2, 64>;
-    construction_test<TinyTestTree>("test_tiny", *this);
+    construction_test<TinyTestTree>(*this);
 }
 
 BOOST_FIXTURE_TEST_CASE(construct_half_leaf_test, TestRandomGraphFixture_LeafHalfFull)
 {
-    construction_test("test_1", *this);
+    construction_test(*this);
 }
 
 BOOST_FIXTURE_TEST_CASE(construct_full_leaf_test, TestRandomGraphFixture_LeafFull)
 {
-    construction_test("test_2", *this);
+    construction_test(*this);
 }
 
 BOOST_FIXTURE_TEST_CASE(construct_two_leaves_test, TestRandomGraphFixture_TwoLeaves)
 {
-    construction_test("test_3", *this);
+    construction_test(*this);
 }
 
 BOOST_FIXTURE_TEST_CASE(construct_branch_test, TestRandomGraphFixture_Branch)
 {
-    construction_test("test_4", *this);
+    construction_test(*this);
 }
 
 BOOST_FIXTURE_TEST_CASE(construct_multiple_levels_test, TestRandomGraphFixture_MultipleLevels)
 {
-    construction_test("test_5", *this);
+    construction_test(*this);
 }
 
 // Bug: If you querry a point that lies between two BBs that have a gap,
@@ -530,4 +531,103 @@ BOOST_AUTO_TEST_CASE(bbox_search_tests)
     }
 }
 
+BOOST_AUTO_TEST_CASE(batch_snapping_tests)
+{
+    using Coord = std::pair<FloatLongitude, FloatLatitude>;
+    using Edge = std::tuple<unsigned, unsigned, bool>;
+
+    // rows of parallel streets
+    std::vector<Coord> coords;
+    std::vector<Edge> edges;
+    for (unsigned row = 0; row < 20; ++row)
+    {
+        for (unsigned column = 0; column < 20; ++column)
+        {
+            coords.emplace_back(FloatLongitude{0.01 * column}, FloatLatitude{0.01 * row});
+            if (column > 0)
+                edges.emplace_back(coords.size() - 2, coords.size() - 1, true);
+        }
+    }
+    GraphFixture fixture(coords, edges);
+
+    TemporaryFile tmp;
+    auto rtree = make_rtree<MiniStaticRTree>(tmp.path, fixture);
+    TestDataFacade mockfacade;
+    engine::GeospatialQuery<MiniStaticRTree, TestDataFacade> query(
+        rtree, fixture.coords, mockfacade);
+
+    // enough queries to be answered in parallel
+    std::mt19937 g(RANDOM_SEED);
+    std::uniform_real_distribution<> position(-0.01, 0.2);
+    std::vector<engine::SnappingQuery> queries;
+    for (unsigned i = 0; i < 1000; ++i)
+    {
+        queries.push_back(engine::SnappingQuery{
+            Coordinate{FloatLongitude{position(g)}, FloatLatitude{position(g)}},
+            i % 2 == 0 ? std::optional<double>{500.} : std::nullopt,
+            std::nullopt,
+            engine::Approach::UNRESTRICTED});
+    }
+
+    const auto same_phantom_nodes = [](const auto &lhs, const auto &rhs)
+    {
+        return std::equal(lhs.begin(),
+                          lhs.end(),
+                          rhs.begin(),
+                          rhs.end(),
+                          [](const auto &lhs, const auto &rhs)
+                          {
+                              return lhs.phantom_node.forward_segment_id.id ==
+                                         rhs.phantom_node.forward_segment_id.id &&
+                                     lhs.phantom_node.reverse_segment_id.id ==
+                                         rhs.phantom_node.reverse_segment_id.id &&
+                                     lhs.distance == rhs.distance;
+                          });
+    };
+
+    const auto nearest = query.NearestPhantomNodes(queries, 2);
+    BOOST_REQUIRE_EQUAL(nearest.size(), queries.size());
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        const auto expected = query.NearestPhantomNodes(queries[i].input_coordinate,
+                                                        queries[i].approach,
+                                                        2,
+                                                        queries[i].max_distance,
+                                                        queries[i].bearing,
+                                                        std::nullopt);
+        BOOST_CHECK(same_phantom_nodes(nearest[i], expected));
+    }
+
+    std::vector<engine::SnappingQuery> range_queries(queries.begin(), queries.begin() + 100);
+    for (auto &range_query : range_queries)
+        range_query.max_distance = 500.;
+    const auto in_range = query.NearestPhantomNodesInRange(range_queries, false);
+    BOOST_REQUIRE_EQUAL(in_range.size(), range_queries.size());
+    for (std::size_t i = 0; i < range_queries.size(); ++i)
+    {
+        const auto expected = query.NearestPhantomNodes(range_queries[i].input_coordinate,
+                                                        range_queries[i].approach,
+                                                        *range_queries[i].max_distance,
+                                                        range_queries[i].bearing,
+                                                        false);
+        BOOST_CHECK(same_phantom_nodes(in_range[i], expected));
+    }
+
+    const auto candidates = query.NearestCandidatesWithAlternativeFromBigComponent(queries, false);
+    BOOST_REQUIRE_EQUAL(candidates.size(), queries.size());
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        const auto expected =
+            query.NearestCandidatesWithAlternativeFromBigComponent(queries[i].input_coordinate,
+                                                                   queries[i].approach,
+                                                                   queries[i].max_distance,
+                                                                   queries[i].bearing,
+                                                                   false);
+        BOOST_REQUIRE_EQUAL(candidates[i].first.size(), expected.first.size());
+        for (std::size_t j = 0; j < expected.first.size(); ++j)
+            BOOST_CHECK_EQUAL(candidates[i].first[j].forward_segment_id.id,
+                              expected.first[j].forward_segment_id.id);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,104 @@
+#include "util/string_symbol_table.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(string_symbol_table)
+
+using namespace osrm;
+using namespace osrm::util;
+
+namespace
+{
+StringSymbolTable train(const std::vector<std::string> &strings)
+{
+    std::vector<std::size_t> offsets = {0};
+    std::string data;
+    for (const auto &value : strings)
+    {
+        data += value;
+        offsets.push_back(data.size());
+    }
+    return StringSymbolTable(offsets.begin(), offsets.end(), data.begin());
+}
+
+std::string roundtrip(const StringSymbolTable &symbol_table, const std::string &value)
+{
+    std::string encoded;
+    StringSymbolTable::Encoder(symbol_table).Encode(value, std::back_inserter(encoded));
+    std::string decoded;
+    symbol_table.Decode(encoded, decoded);
+    return decoded;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(compress_frequent_substrings)
+{
+    std::vector<std::string> strings;
+    for (auto index = 0; index < 100; ++index)
+    {
+        strings.push_back("Hauptstraße " + std::to_string(index));
+        strings.push_back("Bahnhofstraße");
+    }
+    const auto symbol_table = train(strings);
+    BOOST_CHECK(!symbol_table.empty());
+
+    std::string encoded;
+    StringSymbolTable::Encoder(symbol_table)
+        .Encode("Bahnhofstraße", std::back_inserter(encoded));
+    BOOST_CHECK_LT(encoded.size(), std::string("Bahnhofstraße").size() / 2);
+
+    for (const auto &value : strings)
+        BOOST_CHECK_EQUAL(roundtrip(symbol_table, value), value);
+}
+
+BOOST_AUTO_TEST_CASE(escape_unknown_bytes)
+{
+    const auto symbol_table = train({"aaaa", "bbbb", "abab"});
+
+    // none of these bytes were part of the training data
+    std::string unknown;
+    for (auto byte = 0; byte < 256; ++byte)
+    {
+        if (byte != 'a' && byte != 'b')
+            unknown.push_back(static_cast<char>(byte));
+    }
+
+    BOOST_CHECK_EQUAL(roundtrip(symbol_table, unknown), unknown);
+    BOOST_CHECK_EQUAL(roundtrip(symbol_table, "ab" + unknown + "ba"), "ab" + unknown + "ba");
+    BOOST_CHECK_EQUAL(roundtrip(symbol_table, ""), "");
+}
+
+BOOST_AUTO_TEST_CASE(empty_input)
+{
+    const auto symbol_table = train({});
+    BOOST_CHECK(symbol_table.empty());
+    BOOST_CHECK_EQUAL(roundtrip(symbol_table, "abc"), "abc");
+}
+
+BOOST_AUTO_TEST_CASE(sample_interleaved_strings)
+{
+    // Groups of five strings like in the name table, only the fourth one is set. The input is
+    // large enough to be sampled with a stride of five.
+    const std::string ref = "A 42 ref";
+    const auto number_of_groups = 11 * StringSymbolTable::SAMPLE_SIZE / 2 / ref.size();
+    std::vector<std::string> strings;
+    strings.reserve(5 * number_of_groups);
+    for (std::size_t group = 0; group < number_of_groups; ++group)
+    {
+        strings.insert(strings.end(), {"", "", "", ref, ""});
+    }
+
+    const auto symbol_table = train(strings);
+    BOOST_CHECK(!symbol_table.empty());
+
+    std::string encoded;
+    StringSymbolTable::Encoder(symbol_table).Encode(ref, std::back_inserter(encoded));
+    BOOST_CHECK_LT(encoded.size(), ref.size());
+    BOOST_CHECK_EQUAL(roundtrip(symbol_table, ref), ref);
+}
+
+BOOST_AUTO_TEST_SUITE_END()